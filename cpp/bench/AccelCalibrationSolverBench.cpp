@@ -0,0 +1,73 @@
+// Throughput of AccelCalibrationSolver::processLog on ImuData text log, samples per second
+// of parsing, segment detection and fit over 10M samples (log rendered once, streamed
+// repeatedly), with recovered scale diagonal as sanity check.
+
+#include "common/AccelCalibrationSolver.hpp"
+
+#include "SkyBench.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <sstream>
+#include <string>
+
+static std::string renderLog(const unsigned samples)
+{
+    std::mt19937 generator(5);
+    std::normal_distribution<double> noise(0.0, 0.02);
+    const double g = roboLib::gravity;
+    const Vect3Dd bias(0.3, -0.2, 0.15);
+    const Vect3Dd scale(1.02, 0.97, 1.05);
+
+    std::ostringstream log;
+    char line[160];
+    for (unsigned i = 0; i < samples; i++)
+    {
+        // 600 static samples per position, 100 samples of motion between positions
+        const unsigned position = (i / 700) % AccelCalibrationSolver::ORIENTATIONS_COUNT;
+        Vect3Dd calibrated = Vect3Dd::zeros();
+        if (i % 700 < 600)
+        {
+            calibrated(position / 2 + 1) = position % 2 ? -g : g;
+        }
+        else
+        {
+            calibrated = Vect3Dd(5.0 * std::sin(0.3 * i), 3.0 * std::cos(0.2 * i), g);
+        }
+        const Vect3Dd raw((calibrated.x - bias.x) / scale.x,
+                          (calibrated.y - bias.y) / scale.y,
+                          (calibrated.z - bias.z) / scale.z);
+        std::snprintf(line, sizeof(line), "%.3f 0.012 -0.034 0.005 %.4f %.4f %.4f 0.21 0.05 0.43 1013.25\n",
+                      i * 0.002, raw.x + noise(generator), raw.y + noise(generator), raw.z + noise(generator));
+        log << line;
+    }
+    return log.str();
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned blockSamples = quick ? 100000 : 1000000;
+    const unsigned repeats = quick ? 1 : 10;
+
+    const std::string log = renderLog(blockSamples);
+
+    AccelCalibrationSolver solver;
+    unsigned parsed = 0;
+    skybench::Stopwatch stopwatch;
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        std::istringstream stream(log);
+        parsed += solver.processLog(stream);
+    }
+    const bool solved = solver.solve();
+    const double elapsed = stopwatch.seconds();
+
+    std::printf("processLog %u samples (%.1f MB) in %.2f s: %.2f Msamples/s, %u segments, solved %d,"
+                " scale diagonal %.4f %.4f %.4f residual %.4f\n",
+                parsed, log.size() * repeats / 1e6, elapsed, parsed / 1e6 / elapsed, solver.getSegmentsCount(),
+                (int)solved, solver.getScale().mat[0], solver.getScale().mat[4], solver.getScale().mat[8],
+                solver.getResidual());
+    return solved ? 0 : 1;
+}
@@ -0,0 +1,117 @@
+// ControlDataSlot against mutex protected ControlData: write and read cost percentiles
+// with busy reader, and write to visible latency (time from write until reader sees value).
+
+#include "endpoint/device/ControlDataSlot.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+class LockedControlData
+{
+public:
+    void write(const ControlData& data)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        value = data;
+    }
+
+    ControlData read(void)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        return value;
+    }
+
+private:
+    std::mutex mutex;
+    ControlData value;
+};
+
+double percentile(const std::vector<double>& sorted, const double quantile)
+{
+    return sorted[(size_t)(quantile * (sorted.size() - 1))];
+}
+
+void print(const char* name, const char* what, std::vector<double>& samples)
+{
+    if (samples.empty())
+    {
+        // on single core writer can finish before reader was scheduled
+        std::printf("%-12s %-8s no samples\n", name, what);
+        return;
+    }
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-12s %-8s p50 %8.0f p99 %8.0f p999 %9.0f max %10.0f ns\n", name, what,
+                percentile(samples, 0.5), percentile(samples, 0.99), percentile(samples, 0.999), samples.back());
+}
+
+template <class _Slot>
+void run(const char* name, const unsigned writes)
+{
+    _Slot slot;
+    std::atomic<bool> done(false);
+    std::vector<Clock::time_point> writeTimes(writes + 1);
+    std::vector<double> writeCost, readCost, visible;
+    writeCost.reserve(writes / 64 + 1);
+
+    std::thread writer([&]()
+    {
+        ControlData data;
+        for (unsigned i = 1; i <= writes; i++)
+        {
+            data.setThrottle((float)i);
+            writeTimes[i] = Clock::now();
+            slot.write(data);
+            if (0 == i % 64)
+            {
+                writeCost.push_back(std::chrono::duration<double, std::nano>(Clock::now() - writeTimes[i]).count());
+            }
+        }
+        done = true;
+    });
+
+    unsigned last = 0;
+    unsigned long reads = 0;
+    while (false == done)
+    {
+        const Clock::time_point start = Clock::now();
+        const unsigned value = (unsigned)slot.read().getThrottle();
+        const Clock::time_point end = Clock::now();
+        if (0 == ++reads % 64)
+        {
+            readCost.push_back(std::chrono::duration<double, std::nano>(end - start).count());
+        }
+        if (value != last)
+        {
+            visible.push_back(std::chrono::duration<double, std::nano>(end - writeTimes[value]).count());
+            last = value;
+        }
+    }
+    writer.join();
+
+    print(name, "write", writeCost);
+    print(name, "read", readCost);
+    print(name, "visible", visible);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned writes = skybench::quick(argc, argv) ? 50000 : 3000000;
+    std::printf("hardware threads %u, %u writes, costs include clock read\n",
+                std::thread::hardware_concurrency(), writes);
+    run<ControlDataSlot>("slot", writes);
+    run<LockedControlData>("mutex", writes);
+    return 0;
+}
@@ -0,0 +1,116 @@
+// DeviceEventRing throughput with two producers (devices) and consumer draining batches
+// of 64, heap allocations per event counted by replaced operator new, compared with
+// legacy path converting every record to heap DeviceEvent.
+
+#include "endpoint/device/DeviceEventRing.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+std::atomic<unsigned long> allocations(0);
+
+}
+
+void* operator new(size_t size)
+{
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    void* result = std::malloc(size > 0 ? size : 1);
+    if (nullptr == result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, size_t) noexcept
+{
+    std::free(pointer);
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned producersCount = 2;
+    const unsigned records = skybench::quick(argc, argv) ? 20000 : 2000000;
+
+    DeviceEventRing ring(4096);
+    std::vector<DeviceEventRecord> batch(64);
+    std::atomic<unsigned> started(0);
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < producersCount; p++)
+    {
+        producers.push_back(std::thread([&]()
+        {
+            started++;
+            while (producersCount != started)
+            {
+                std::this_thread::yield();
+            }
+            const DebugData debugData;
+            const ControlData controlData;
+            for (unsigned i = 0; i < records; i++)
+            {
+                const DeviceEventRecord record = i & 1 ? DeviceEventRecord(DeviceEvent::DATA_RECEIVED, debugData)
+                                                       : DeviceEventRecord(DeviceEvent::DATA_SENT, controlData);
+                while (false == ring.push(record))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+    while (producersCount != started)
+    {
+        std::this_thread::yield();
+    }
+    const unsigned long allocationsBefore = allocations.load();
+    skybench::Stopwatch stopwatch;
+    unsigned long delivered = 0;
+    while (delivered < (unsigned long)producersCount * records)
+    {
+        const size_t count = ring.drain(batch.data(), batch.size());
+        delivered += count;
+        if (0 == count)
+        {
+            std::this_thread::yield();
+        }
+    }
+    const double ringTime = stopwatch.seconds();
+    const unsigned long ringAllocations = allocations.load() - allocationsBefore;
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    // legacy consumers get heap DeviceEvent for every record
+    const DebugData debugData;
+    const DeviceEventRecord record(DeviceEvent::DATA_RECEIVED, debugData);
+    const unsigned long legacyBefore = allocations.load();
+    stopwatch.restart();
+    for (unsigned i = 0; i < records; i++)
+    {
+        std::unique_ptr<const DeviceEvent> event = record.toDeviceEvent();
+        skybench::keep(event->getType());
+    }
+    const double legacyTime = stopwatch.seconds();
+    const unsigned long legacyAllocations = allocations.load() - legacyBefore;
+
+    std::printf("ring: %lu events from %u producers in %.3f s, %.1f Mevents/s, %.3f allocations per event\n",
+                delivered, producersCount, ringTime, delivered / ringTime / 1e6, (double)ringAllocations / delivered);
+    std::printf("legacy DeviceEvent: %.1f Mevents/s single thread, %.1f allocations per event\n",
+                records / legacyTime / 1e6, (double)legacyAllocations / records);
+    return 0;
+}
@@ -0,0 +1,78 @@
+// Throughput of GeoKernels batch calls against scalar Vect2Dd::getGeoDistance loop,
+// one to many distances and bearings, distance matrix and nearest point search.
+
+#include "common/GeoKernels.hpp"
+
+#include "SkyBench.hpp"
+
+#include <cstdio>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned count = quick ? 1u << 14 : 1u << 22;
+    const unsigned matrixSize = quick ? 200 : 4000;
+    const unsigned repeats = quick ? 1 : 5;
+
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> anyLat(-90.0, 90.0), anyLon(-180.0, 180.0);
+    std::vector<double> lat(count), lon(count), result(count);
+    std::vector<Vect2Dd> points(count);
+    for (unsigned i = 0; i < count; i++)
+    {
+        lat[i] = anyLat(generator);
+        lon[i] = anyLon(generator);
+        points[i] = Vect2Dd(lat[i], lon[i]);
+    }
+    const Vect2Dd origin(50.0, 20.0);
+
+    skybench::Stopwatch stopwatch;
+    double sum = 0.0;
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        for (unsigned i = 0; i < count; i++)
+        {
+            sum += origin.getGeoDistance(points[i]);
+        }
+    }
+    skybench::keep(sum);
+    const double scalarRate = (double)count * repeats / stopwatch.seconds() / 1e6;
+
+    stopwatch.restart();
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        GeoKernels::distances(origin.x, origin.y, lat.data(), lon.data(), count, result.data());
+    }
+    const double distancesRate = (double)count * repeats / stopwatch.seconds() / 1e6;
+
+    stopwatch.restart();
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        GeoKernels::bearings(origin.x, origin.y, lat.data(), lon.data(), count, result.data());
+    }
+    const double bearingsRate = (double)count * repeats / stopwatch.seconds() / 1e6;
+
+    stopwatch.restart();
+    unsigned nearest = 0;
+    for (unsigned r = 0; r < repeats; r++)
+    {
+        nearest += GeoKernels::nearest(10.0, 10.0, lat.data(), lon.data(), count);
+    }
+    skybench::keep(nearest);
+    const double nearestRate = (double)count * repeats / stopwatch.seconds() / 1e6;
+
+    std::vector<double> matrix((size_t)matrixSize * matrixSize);
+    stopwatch.restart();
+    GeoKernels::distanceMatrix(lat.data(), lon.data(), matrixSize, matrix.data());
+    const double matrixRate = (double)matrixSize * matrixSize / stopwatch.seconds() / 1e6;
+
+    std::printf("points %u\n", count);
+    std::printf("scalar getGeoDistance %8.1f Mpoints/s\n", scalarRate);
+    std::printf("distances             %8.1f Mpoints/s (x%.1f)\n", distancesRate, distancesRate / scalarRate);
+    std::printf("bearings              %8.1f Mpoints/s\n", bearingsRate);
+    std::printf("nearest               %8.1f Mpoints/s\n", nearestRate);
+    std::printf("distance matrix %u^2  %8.1f Mpairs/s\n", matrixSize, matrixRate);
+    return 0;
+}
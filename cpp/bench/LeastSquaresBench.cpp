@@ -0,0 +1,95 @@
+// Throughput of streaming least squares engines for 6 - 12 parameter models,
+// samples per second of HouseholderLeastSquares (add + solve) and RecursiveLeastSquares,
+// with largest parameter error against known model and merge of two half solvers.
+
+#include "common/LeastSquares.hpp"
+
+#include "SkyBench.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+template <unsigned N>
+static void run(const unsigned samples)
+{
+    std::mt19937 generator(1);
+    std::normal_distribution<double> noise(0.0, 1.0);
+
+    double truth[N];
+    for (unsigned i = 0; i < N; i++)
+    {
+        truth[i] = i + 1.0;
+    }
+    std::vector<double> regressors(samples * N);
+    std::vector<double> measurements(samples);
+    for (unsigned s = 0; s < samples; s++)
+    {
+        double y = 0.0;
+        for (unsigned i = 0; i < N; i++)
+        {
+            regressors[s * N + i] = noise(generator);
+            y += regressors[s * N + i] * truth[i];
+        }
+        measurements[s] = y + 0.01 * noise(generator);
+    }
+
+    HouseholderLeastSquares<double, N> qr;
+    RecursiveLeastSquares<double, N> rls;
+    double theta[N];
+
+    skybench::Stopwatch stopwatch;
+    for (unsigned s = 0; s < samples; s++)
+    {
+        qr.add(&regressors[s * N], measurements[s]);
+    }
+    qr.solve(theta);
+    const double qrTime = stopwatch.seconds();
+
+    stopwatch.restart();
+    for (unsigned s = 0; s < samples; s++)
+    {
+        rls.update(&regressors[s * N], measurements[s]);
+    }
+    const double rlsTime = stopwatch.seconds();
+
+    double qrError = 0.0;
+    double rlsError = 0.0;
+    for (unsigned i = 0; i < N; i++)
+    {
+        qrError = std::max(qrError, std::fabs(theta[i] - truth[i]));
+        rlsError = std::max(rlsError, std::fabs(rls.getParameters()[i] - truth[i]));
+    }
+
+    HouseholderLeastSquares<double, N> first, second;
+    for (unsigned s = 0; s < samples / 2; s++)
+    {
+        first.add(&regressors[s * N], measurements[s]);
+    }
+    for (unsigned s = samples / 2; s < samples; s++)
+    {
+        second.add(&regressors[s * N], measurements[s]);
+    }
+    first.merge(second);
+    first.solve(theta);
+    double mergeError = 0.0;
+    for (unsigned i = 0; i < N; i++)
+    {
+        mergeError = std::max(mergeError, std::fabs(theta[i] - truth[i]));
+    }
+
+    std::printf("N=%2u householder %6.2f Msamples/s err %.2e | recursive %6.2f Msamples/s err %.2e"
+                " | merged err %.2e\n",
+                N, samples / 1e6 / qrTime, qrError, samples / 1e6 / rlsTime, rlsError, mergeError);
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned samples = skybench::quick(argc, argv) ? 20000 : 2000000;
+    run<6>(samples);
+    run<8>(samples);
+    run<10>(samples);
+    run<12>(samples);
+    return 0;
+}
@@ -0,0 +1,288 @@
+// Time to recover from lost signal exchange with adaptive signal timeouts compared with
+// fixed 3.5 s used before. Link RTT is learned from 200 pings, then 20000 payload uploads
+// with acknowledge are simulated, each with up to 3 attempts and 10% loss in both ways.
+
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+class IdleTimer : public ISkyTimer
+{
+public:
+    IdleTimer(std::function<void(void)> _exec):
+        ISkyTimer(_exec)
+    {
+    }
+
+    void start(const double) override
+    {
+    }
+
+    void stop(void) override
+    {
+    }
+};
+
+// only link quality is used by getSignalTimeout
+class LinkListener : public ISkyDeviceAction::Listener
+{
+public:
+    SkyLinkQuality linkQuality;
+
+    ISkyDeviceMonitor* getMonitor(void) override
+    {
+        return nullptr;
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void releaseTimer(ISkyTimer* timer) override
+    {
+        delete timer;
+    }
+
+    bool setupProtocolVersion(const unsigned) override
+    {
+        return true;
+    }
+
+    SkyActionPool& getActionPool(void) override
+    {
+        return actionPool;
+    }
+
+    void startAction(ISkyDeviceAction*, bool) override
+    {
+    }
+
+    void onPongReception(const SignalData&) override
+    {
+    }
+
+    void onSignalResponse(const SignalData::Command, const std::chrono::steady_clock::duration) override
+    {
+    }
+
+    const SkyLinkQuality& getLinkQuality(void) const override
+    {
+        return linkQuality;
+    }
+
+    const SkyRateController* getRateController(void) const override
+    {
+        return nullptr;
+    }
+
+    void onError(const std::string&) override
+    {
+    }
+
+    void onError(const SkyError&) override
+    {
+    }
+
+    void send(const IMessage&) override
+    {
+    }
+
+    void send(const ISignalPayloadMessage&) override
+    {
+    }
+
+    void enablePingTask(bool) override
+    {
+    }
+
+    void enableConnectionTimeoutTask(bool) override
+    {
+    }
+
+    void connectInterface(ISkyCommInterface*) override
+    {
+    }
+
+    void disconnectInterface(void) override
+    {
+    }
+
+private:
+    SkyActionPool actionPool;
+};
+
+class TimeoutProbe : public ISkyDeviceAction
+{
+public:
+    TimeoutProbe(Listener* const _listener):
+        ISkyDeviceAction(_listener)
+    {
+    }
+
+    unsigned getTimeout(const unsigned payloadSize, const unsigned attempt) const
+    {
+        return getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, payloadSize, attempt);
+    }
+
+    void start(void) override
+    {
+    }
+
+    void handleReception(const IMessage&) override
+    {
+    }
+
+    bool isActionDone(void) const override
+    {
+        return true;
+    }
+
+    Type getType(void) const override
+    {
+        return IDLE_ACTION;
+    }
+
+    const char* getStateName(void) const override
+    {
+        return "PROBE";
+    }
+};
+
+struct Link
+{
+    const char* name;
+    double rtt; // [ms]
+    double jitter; // [ms]
+    unsigned throughput; // [B/s]
+    unsigned payloadSize; // [B]
+};
+
+const unsigned FIXED_TIMEOUT = 3500; // [ms]
+const unsigned ATTEMPTS = 3;
+const double LOSS = 0.1;
+
+// [ms] payload goes in fixed size signal messages
+double getTransmitTime(const Link& link)
+{
+    const unsigned messages = (link.payloadSize + IMessage::SIGNAL_DATA_PAYLOAD_SIZE - 1) / IMessage::SIGNAL_DATA_PAYLOAD_SIZE;
+    return 1000.0 * messages * IMessage::SIGNAL_DATA_MESSAGE_SIZE / link.throughput;
+}
+
+void simulate(const Link& link, const unsigned exchanges)
+{
+    LinkListener listener;
+    listener.linkQuality.setThroughput(link.throughput);
+    TimeoutProbe probe(&listener);
+
+    std::mt19937 random(7);
+    std::normal_distribution<double> rttDistribution(link.rtt, link.jitter);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    SkyLinkQuality::Clock::time_point time = SkyLinkQuality::Clock::now();
+    for (int i = 0; i < 200; i++)
+    {
+        time += std::chrono::milliseconds(100);
+        listener.linkQuality.expire(time);
+        listener.linkQuality.onPingSent(i, time);
+        if (uniform(random) > LOSS)
+        {
+            const double rtt = std::max(1.0, rttDistribution(random));
+            listener.linkQuality.onPongReceived(i, time + std::chrono::microseconds((long)(rtt * 1000)));
+        }
+    }
+
+    const double transmitTime = getTransmitTime(link);
+    for (int adaptive = 0; adaptive < 2; adaptive++)
+    {
+        std::vector<double> completed;
+        std::vector<double> recovered;
+        unsigned spurious = 0;
+        unsigned failed = 0;
+        for (unsigned n = 0; n < exchanges; n++)
+        {
+            double elapsed = 0.0;
+            bool done = false;
+            bool lostAny = false;
+            for (unsigned attempt = 0; attempt < ATTEMPTS && false == done; attempt++)
+            {
+                const double response = std::max(1.0, rttDistribution(random)) + transmitTime;
+                const double timeout = adaptive ? probe.getTimeout(link.payloadSize, attempt) : FIXED_TIMEOUT;
+                const bool lost = uniform(random) < LOSS || uniform(random) < LOSS;
+                if (false == lost && response <= timeout)
+                {
+                    elapsed += response;
+                    done = true;
+                }
+                else
+                {
+                    spurious += lost ? 0 : 1;
+                    lostAny = true;
+                    elapsed += timeout;
+                }
+            }
+            if (done)
+            {
+                completed.push_back(elapsed);
+                if (lostAny)
+                {
+                    recovered.push_back(elapsed);
+                }
+            }
+            else
+            {
+                failed++;
+            }
+        }
+
+        std::sort(completed.begin(), completed.end());
+        double mean = 0.0;
+        for (const double value : completed)
+        {
+            mean += value;
+        }
+        mean /= completed.empty() ? 1 : completed.size();
+        double recoverMean = 0.0;
+        for (const double value : recovered)
+        {
+            recoverMean += value;
+        }
+        recoverMean /= recovered.empty() ? 1 : recovered.size();
+
+        std::printf("%-32s %-8s timeout %5u/%5u/%5u ms, mean %5.0f ms, p99 %5.0f ms, "
+                    "time to recover %5.0f ms, spurious %u, failed %u/%u\n",
+                    link.name, adaptive ? "adaptive" : "fixed",
+                    adaptive ? probe.getTimeout(link.payloadSize, 0) : FIXED_TIMEOUT,
+                    adaptive ? probe.getTimeout(link.payloadSize, 1) : FIXED_TIMEOUT,
+                    adaptive ? probe.getTimeout(link.payloadSize, 2) : FIXED_TIMEOUT,
+                    mean, completed.empty() ? 0.0 : completed[completed.size() * 99 / 100],
+                    recoverMean, spurious, failed, exchanges);
+    }
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned exchanges = skybench::quick(argc, argv) ? 1000 : 20000;
+
+    const Link links[] =
+    {
+        {"usb 5 ms, 1 kB", 5.0, 1.0, 1000000, 1024},
+        {"radio 120 ms 2.4 kB/s, 1 kB", 120.0, 40.0, 2400, 1024},
+        {"radio 300 ms 1.2 kB/s, 4 kB", 300.0, 120.0, 1200, 4096}
+    };
+    for (const Link& link : links)
+    {
+        simulate(link, exchanges);
+    }
+    return 0;
+}
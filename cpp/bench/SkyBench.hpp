@@ -0,0 +1,65 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYBENCH_HPP
+#define SKYBENCH_HPP
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+
+/**
+ * =============================================================================================
+ * SkyBench
+ * Helpers shared by tree benchmarks. Every benchmark accepts "--quick" argument
+ * which scales work down, so it can be run as smoke check.
+ * =============================================================================================
+ */
+namespace skybench
+{
+
+class Stopwatch
+{
+public:
+    Stopwatch(void):
+        start(std::chrono::steady_clock::now())
+    {
+    }
+
+    double seconds(void) const
+    {
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    void restart(void)
+    {
+        start = std::chrono::steady_clock::now();
+    }
+
+private:
+    std::chrono::steady_clock::time_point start;
+};
+
+inline bool quick(const int argc, char** argv)
+{
+    for (int i = 1; i < argc; i++)
+    {
+        if (0 == std::strcmp(argv[i], "--quick"))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+// keeps value computed by benchmark from being optimized out
+template <typename _Tp>
+inline void keep(const _Tp& value)
+{
+    // empty asm reading value address, compiler has to materialize value in memory
+    asm volatile("" : : "g"(&value) : "memory");
+}
+
+} // skybench
+
+#endif // SKYBENCH_HPP
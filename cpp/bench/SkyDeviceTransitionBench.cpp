@@ -0,0 +1,172 @@
+// Action transitions per second of device in APP -> FLIGHT_INITIALIZATION -> APP cycles,
+// board answers FLIGHT_LOOP START with NOT_ALLOWED synchronously, pilot events are
+// preallocated. Heap allocations per transition counted by SkyAllocationGuard
+// (its object built with __SKYDIVE_ALLOCATION_GUARD__ is linked in).
+
+#include "endpoint/SkyAllocationGuard.hpp"
+#include "endpoint/device/SkyDevice.hpp"
+
+#include "communication/CommDispatcher.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+class IdleTimer : public ISkyTimer
+{
+public:
+    IdleTimer(std::function<void(void)> _exec):
+        ISkyTimer(_exec)
+    {
+    }
+
+    void start(const double) override
+    {
+    }
+
+    void stop(void) override
+    {
+    }
+};
+
+class RingMonitor : public ISkyDeviceMonitor
+{
+public:
+    unsigned long errors;
+
+    RingMonitor(void):
+        errors(0)
+    {
+        enableEventRing(1 << 16);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        size_t count;
+        while ((count = drainDeviceEvents(events, EVENTS_BATCH)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                errors += DeviceEvent::MESSAGE == events[i].getType() ? 1 : 0;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t EVENTS_BATCH = 512;
+    DeviceEventRecord events[EVENTS_BATCH];
+};
+
+constexpr size_t RingMonitor::EVENTS_BATCH;
+
+// refuses every flight, acknowledges break
+class RefusingBoard : public ISkyCommInterface
+{
+public:
+    void connect(void) override
+    {
+        onConnected();
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char* data, const size_t length) override
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            const IMessage::PreambleType preamble = dispatcher.putChar(data[i]);
+            if (IMessage::SIGNAL == preamble && SignalData::FLIGHT_LOOP == dispatcher.getCommand()
+                    && SignalData::READY != dispatcher.getParameter())
+            {
+                answer(SignalData::BREAK == dispatcher.getParameter() ? SignalData::BREAK_ACK : SignalData::NOT_ALLOWED);
+            }
+        }
+    }
+
+    void answer(const SignalData::Parameter parameter)
+    {
+        const SignalData reply(SignalData::FLIGHT_LOOP, parameter);
+        reply.serializeMessage(buffer);
+        onReceived(buffer, reply.getMessageSize());
+    }
+
+private:
+    CommDispatcher dispatcher;
+    unsigned char buffer[IMessage::SIGNAL_DATA_MESSAGE_SIZE];
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned cycles = skybench::quick(argc, argv) ? 10000 : 200000;
+    const unsigned runs = skybench::quick(argc, argv) ? 1 : 7;
+
+    RingMonitor monitor;
+    RefusingBoard board;
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+
+    // direct flight is left to application loop
+    device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::DIRECT_FLIGHT, &board));
+    device.pushPilotEvent(new PilotEvent(PilotEvent::BREAK_FLIGHT_LOOP));
+    board.answer(SignalData::BREAK_ACK);
+    std::printf("state %s\n", ISkyDeviceAction::toString(device.getState()));
+
+    std::vector<double> rates;
+    double allocationsPerTransition = 0.0;
+    std::vector<const PilotEvent*> events(cycles);
+    for (unsigned run = 0; run < runs + 1; run++)
+    {
+        for (const PilotEvent*& event : events)
+        {
+            event = new PilotEventAction(ISkyDeviceAction::FLIGHT_INITIALIZATION);
+        }
+        monitor.drain();
+        const SkyAllocationGuard guard;
+        skybench::Stopwatch stopwatch;
+        for (unsigned i = 0; i < cycles; i++)
+        {
+            device.pushPilotEvent(events[i]);
+            if (0 == i % 1000)
+            {
+                monitor.drain();
+            }
+        }
+        const double seconds = stopwatch.seconds();
+        // first run warms pools up
+        if (run > 0)
+        {
+            rates.push_back(2.0 * cycles / seconds);
+            allocationsPerTransition = guard.getAllocationsCount() / (2.0 * cycles);
+        }
+    }
+    monitor.drain();
+
+    std::sort(rates.begin(), rates.end());
+    std::printf("state %s, errors %lu\n", ISkyDeviceAction::toString(device.getState()), monitor.errors);
+    std::printf("%u cycles APP -> FLIGHT_INITIALIZATION -> APP: median %.0f transitions/s, "
+                "%.2f allocations per transition\n",
+                cycles, rates[rates.size() / 2], allocationsPerTransition);
+    return 0;
+}
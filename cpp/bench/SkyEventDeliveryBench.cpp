@@ -0,0 +1,150 @@
+// SkyEventDelivery with dedicated thread and consumer sleeping after every batch (0, 200
+// and 2000 us), device publishing unpaced DebugData, sent ControlData, connection status
+// and state events. Reports publish cost, what was coalesced, dropped or kept and state
+// events delivered after DebugData published later than them.
+
+#include "endpoint/device/ISkyDeviceMonitor.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <thread>
+
+namespace
+{
+
+class SlowMonitor : public ISkyDeviceMonitor
+{
+public:
+    std::atomic<unsigned long> states;
+    std::atomic<unsigned long> debugs;
+    std::atomic<unsigned long> controls;
+    std::atomic<unsigned long> statuses;
+    unsigned long disorders;
+    unsigned long stateDisorders;
+    float lastDebug;
+
+    SlowMonitor(const unsigned _delayUs):
+        states(0),
+        debugs(0),
+        controls(0),
+        statuses(0),
+        disorders(0),
+        stateDisorders(0),
+        lastDebug(-1.0f),
+        delayUs(_delayUs)
+    {
+        enableBatchDelivery(1024, 64);
+        startBatchDelivery();
+    }
+
+    ~SlowMonitor(void)
+    {
+        stopBatchDelivery();
+    }
+
+    void notifyDeviceEvents(const DeviceEventRecord* events, const size_t count) override
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            switch (events[i].getType())
+            {
+            case DeviceEvent::DATA_RECEIVED:
+            {
+                const float value = static_cast<const DebugData&>(events[i].getMessage()).euler.x;
+                if (value < lastDebug)
+                {
+                    disorders++;
+                }
+                lastDebug = value;
+                debugs++;
+                break;
+            }
+            case DeviceEvent::DATA_SENT:
+                controls++;
+                break;
+            case DeviceEvent::CONNECTION_STATUS:
+                statuses++;
+                break;
+            default:
+                // state events are published right after DebugData of every 1000th iteration
+                if (0 != static_cast<unsigned long>(lastDebug) % 1000)
+                {
+                    stateDisorders++;
+                }
+                states++;
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(delayUs));
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)>) override
+    {
+        return nullptr;
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+private:
+    const unsigned delayUs;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned iterations = skybench::quick(argc, argv) ? 2000 : 20000;
+
+    for (unsigned delayUs : {0u, 200u, 2000u})
+    {
+        SlowMonitor monitor(delayUs);
+        unsigned long statesSent = 0;
+        DebugData debugData;
+        const ControlData controlData;
+        skybench::Stopwatch stopwatch;
+        for (unsigned i = 0; i < iterations; i++)
+        {
+            debugData.euler.x = static_cast<float>(i);
+            monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_RECEIVED, debugData));
+            monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_SENT, controlData));
+            if (0 == i % 100)
+            {
+                monitor.notifyDeviceEvent(DeviceEventRecord(10, 1, 0));
+            }
+            if (0 == i % 1000)
+            {
+                monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CONNECTION_LOST));
+                monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_ENDED));
+                statesSent += 2;
+            }
+        }
+        const double publishTime = stopwatch.seconds();
+        monitor.stopBatchDelivery();
+
+        const SkyEventDelivery& delivery = *monitor.getEventDelivery();
+        std::printf("consumer sleep %4u us/batch: publish %.0f ns/event, published %lu, "
+                    "delivered %lu in %lu batches, coalesced %lu, dropped %lu, overflow %lu\n",
+                    delayUs, publishTime * 1e9 / delivery.getPublishedCount(),
+                    (unsigned long)delivery.getPublishedCount(),
+                    (unsigned long)delivery.getDeliveredCount(),
+                    (unsigned long)delivery.getBatchesCount(),
+                    (unsigned long)delivery.getCoalescedCount(),
+                    (unsigned long)delivery.getDroppedCount(),
+                    (unsigned long)delivery.getOverflowCount());
+        std::printf("    states %lu/%lu (after newer DebugData %lu), debug %lu (last %.0f, out of order %lu), "
+                    "control %lu, status %lu\n",
+                    monitor.states.load(), statesSent, monitor.stateDisorders, monitor.debugs.load(), monitor.lastDebug,
+                    monitor.disorders, monitor.controls.load(), monitor.statuses.load());
+    }
+    return 0;
+}
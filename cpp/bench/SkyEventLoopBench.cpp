@@ -0,0 +1,430 @@
+// Devices multiplexed by SkyEventLoop: SkyDevice instances in flight loop (50 Hz control,
+// 20 Hz DebugData telemetry) talking over socketpairs to SkyBoardSimulator instances served
+// by separate board loop, hosted on one loop and on SkyEventLoopGroup. Reports CPU time
+// of device loops per device and latency from board sending telemetry frame to device
+// monitor handling it (p50, p99, max of SkyLatencyHistogram).
+
+#include "endpoint/SkyBoardSimulator.hpp"
+#include "endpoint/SkyEventLoop.hpp"
+#include "endpoint/SkyFdCommInterface.hpp"
+#include "endpoint/SkyLatencyHistogram.hpp"
+#include "endpoint/device/SkyDevice.hpp"
+
+#include "SkyBench.hpp"
+
+#include <sys/socket.h>
+#include <time.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <future>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+typedef SkyBoardSimulator Board;
+
+const double CONTROL_RATE = 50.0; // [Hz]
+const double TELEMETRY_RATE = 20.0; // [Hz]
+
+uint64_t now(void)
+{
+    return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// CPU time of calling thread [s]
+double threadCpuTime(void)
+{
+    timespec time;
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+// runs task on loop thread and waits for it
+void runOnLoop(SkyEventLoop& loop, std::function<void(void)> task)
+{
+    std::promise<void> done;
+    loop.execute([&]()
+    {
+        task();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+// send times of telemetry frames, written by board loop, read by device loop
+class StampQueue
+{
+public:
+    StampQueue(void):
+        head(0),
+        tail(0)
+    {
+    }
+
+    void push(const uint64_t stamp)
+    {
+        const unsigned position = tail.load(std::memory_order_relaxed);
+        if (position - head.load(std::memory_order_acquire) < CAPACITY)
+        {
+            stamps[position % CAPACITY] = stamp;
+            tail.store(position + 1, std::memory_order_release);
+        }
+    }
+
+    bool pop(uint64_t& stamp)
+    {
+        const unsigned position = head.load(std::memory_order_relaxed);
+        if (position == tail.load(std::memory_order_acquire))
+        {
+            return false;
+        }
+        stamp = stamps[position % CAPACITY];
+        head.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    static constexpr unsigned CAPACITY = 256;
+    uint64_t stamps[CAPACITY];
+    std::atomic<unsigned> head;
+    std::atomic<unsigned> tail;
+};
+
+constexpr unsigned StampQueue::CAPACITY;
+
+// passes bytes between board and its socket, stamps telemetry frames sent by board
+class Forward : public ISkyCommInterface::Listener
+{
+public:
+    Forward(ISkyCommInterface* const _target, StampQueue* const _stamps):
+        target(_target),
+        stamps(_stamps)
+    {
+    }
+
+    void onConnected(void) override
+    {
+    }
+
+    void onDisconnected(void) override
+    {
+    }
+
+    void onError(const std::string&) override
+    {
+    }
+
+    void onReceived(const unsigned char* data, const size_t length) override
+    {
+        // board calls listener with single frame
+        static const DebugData telemetry;
+        if (nullptr != stamps && telemetry.getMessageSize() == length
+                && IMessage::getPreambleCharByType(telemetry.getPreambleType()) == data[0])
+        {
+            stamps->push(now());
+        }
+        target->send(data, length);
+    }
+
+private:
+    ISkyCommInterface* const target;
+    StampQueue* const stamps;
+};
+
+struct BoardEnd
+{
+    Forward toSocket;
+    Forward toBoard;
+    Board board;
+    SkyFdCommInterface socket;
+
+    BoardEnd(SkyEventLoop* const loop, const int fd, StampQueue* const stamps, const Board::Settings& settings):
+        toSocket(&socket, stamps),
+        toBoard(&board, nullptr),
+        board([loop](std::function<void(void)> exec) { return loop->createTimer(exec); }, settings),
+        socket(loop, fd)
+    {
+        board.setListener(&toSocket);
+        socket.setListener(&toBoard);
+        socket.connect();
+        board.connect();
+    }
+};
+
+class LoopMonitor : public ISkyDeviceMonitor
+{
+public:
+    const SkyDevice* device;
+    unsigned long errors;
+
+    LoopMonitor(SkyEventLoop* const _loop, StampQueue* const _stamps,
+                SkyLatencyHistogram* const _latency, const std::atomic<bool>* const _measuring):
+        device(nullptr),
+        errors(0),
+        loop(_loop),
+        stamps(_stamps),
+        latency(_latency),
+        measuring(_measuring),
+        coalesced(0)
+    {
+        ControlData control;
+        control.setControllerCommand(ControlData::MANUAL);
+        control.setSolverMode(ControlData::ANGLE);
+        control.setThrottle(0.4f);
+        pushControlData(control);
+    }
+
+    void notifyDeviceEvent(const DeviceEventRecord& event) override
+    {
+        if (event.getError().isError())
+        {
+            errors++;
+        }
+        if (DeviceEvent::DATA_RECEIVED != event.getType()
+                || IMessage::DEBUG_DATA != event.getMessage().getMessageType())
+        {
+            return;
+        }
+        // frames coalesced by reception stage are skipped, handled one is the latest
+        const uint64_t coalescedNow = device->getReceptionStage().getCoalescedCount();
+        uint64_t skipped = coalescedNow - coalesced;
+        coalesced = coalescedNow;
+        uint64_t stamp;
+        bool stamped = stamps->pop(stamp);
+        for (; stamped && skipped > 0; skipped--)
+        {
+            stamped = stamps->pop(stamp);
+        }
+        if (stamped && measuring->load(std::memory_order_relaxed))
+        {
+            latency->record(now() - stamp);
+        }
+    }
+
+    double getControlDataSendingFreq(void) override
+    {
+        return CONTROL_RATE;
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return getPushedControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return loop->createTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+private:
+    SkyEventLoop* const loop;
+    StampQueue* const stamps;
+    SkyLatencyHistogram* const latency;
+    const std::atomic<bool>* const measuring;
+    uint64_t coalesced;
+};
+
+struct DeviceEnd
+{
+    LoopMonitor monitor;
+    SkyFdCommInterface socket;
+    SkyDevice device;
+
+    DeviceEnd(SkyEventLoop* const loop, const int fd, StampQueue* const stamps,
+              SkyLatencyHistogram* const latency, const std::atomic<bool>* const measuring):
+        monitor(loop, stamps, latency, measuring),
+        socket(loop, fd),
+        device(&monitor, 1.0, CONTROL_RATE, 2.0, loop)
+    {
+        monitor.device = &device;
+    }
+};
+
+struct Link
+{
+    SkyEventLoop* loop;
+    StampQueue stamps;
+    BoardEnd* board;
+    DeviceEnd* device;
+};
+
+// waits until every device reaches state, false on timeout
+bool waitFor(const std::vector<Link>& links, const ISkyDeviceAction::Type state)
+{
+    for (unsigned i = 0; i < 3000; i++)
+    {
+        bool reached = true;
+        for (const Link& link : links)
+        {
+            reached = reached && state == link.device->device.getState();
+        }
+        if (reached)
+        {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+Board::Statistics boardStatistics(SkyEventLoop& boardLoop, const std::vector<Link>& links)
+{
+    Board::Statistics sum = Board::Statistics();
+    runOnLoop(boardLoop, [&]()
+    {
+        for (const Link& link : links)
+        {
+            const Board::Statistics& statistics = link.board->board.getStatistics();
+            sum.controlFrames += statistics.controlFrames;
+            sum.telemetryFrames += statistics.telemetryFrames;
+        }
+    });
+    return sum;
+}
+
+std::vector<double> loopsCpuTime(const std::vector<SkyEventLoop*>& loops)
+{
+    std::vector<double> result;
+    for (SkyEventLoop* loop : loops)
+    {
+        double time = 0.0;
+        runOnLoop(*loop, [&]() { time = threadCpuTime(); });
+        result.push_back(time);
+    }
+    return result;
+}
+
+// devices are assigned to loops round robin, returns false when flight was not reached
+bool run(const char* name, const std::vector<SkyEventLoop*>& loops, const unsigned devicesCount,
+         const double seconds)
+{
+    SkyEventLoop boardLoop;
+    std::thread boardThread([&]() { boardLoop.run(); });
+    runOnLoop(boardLoop, []() {});
+
+    Board::Settings settings;
+    settings.flightTelemetryRate = TELEMETRY_RATE;
+    SkyLatencyHistogram latency;
+    std::atomic<bool> measuring(false);
+
+    std::vector<Link> links(devicesCount);
+    for (unsigned i = 0; i < devicesCount; i++)
+    {
+        Link& link = links[i];
+        int sockets[2];
+        if (0 != socketpair(AF_UNIX, SOCK_STREAM, 0, sockets))
+        {
+            std::perror("socketpair");
+            return false;
+        }
+        link.loop = loops[i % loops.size()];
+        runOnLoop(boardLoop, [&]()
+        {
+            link.board = new BoardEnd(&boardLoop, sockets[1], &link.stamps, settings);
+        });
+        runOnLoop(*link.loop, [&]()
+        {
+            link.device = new DeviceEnd(link.loop, sockets[0], &link.stamps, &latency, &measuring);
+            link.device->device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::APP, &link.device->socket));
+        });
+    }
+
+    bool flying = waitFor(links, ISkyDeviceAction::APP);
+    if (flying)
+    {
+        for (Link& link : links)
+        {
+            link.device->device.pushPilotEvent(new PilotEventAction(ISkyDeviceAction::FLIGHT_INITIALIZATION));
+        }
+        flying = waitFor(links, ISkyDeviceAction::FLIGHT);
+    }
+
+    if (flying)
+    {
+        // telemetry stream settles after flight starts
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+        const Board::Statistics before = boardStatistics(boardLoop, links);
+        const std::vector<double> cpuBefore = loopsCpuTime(loops);
+        measuring = true;
+        skybench::Stopwatch stopwatch;
+        std::this_thread::sleep_for(std::chrono::duration<double>(seconds));
+        measuring = false;
+        const std::vector<double> cpuAfter = loopsCpuTime(loops);
+        const double elapsed = stopwatch.seconds();
+        const Board::Statistics after = boardStatistics(boardLoop, links);
+
+        double cpu = 0.0;
+        for (unsigned i = 0; i < loops.size(); i++)
+        {
+            cpu += cpuAfter[i] - cpuBefore[i];
+        }
+        std::printf("%s: %u devices on %u loops, %.0f control frames/s, %.0f telemetry frames/s, "
+                    "CPU %.3f%% per device (%.1f%% total), telemetry latency p50 %.0f us p99 %.0f us "
+                    "max %.0f us (%lu samples)\n",
+                    name, devicesCount, (unsigned)loops.size(),
+                    (after.controlFrames - before.controlFrames) / elapsed,
+                    (after.telemetryFrames - before.telemetryFrames) / elapsed,
+                    100.0 * cpu / elapsed / devicesCount, 100.0 * cpu / elapsed,
+                    latency.getPercentile(0.5) / 1e3, latency.getPercentile(0.99) / 1e3, latency.getMax() / 1e3,
+                    (unsigned long)latency.getCount());
+    }
+    else
+    {
+        std::printf("%s: devices did not reach flight\n", name);
+    }
+
+    unsigned long errors = 0;
+    for (Link& link : links)
+    {
+        runOnLoop(*link.loop, [&]()
+        {
+            errors += link.device->monitor.errors;
+            delete link.device;
+        });
+        runOnLoop(boardLoop, [&]() { delete link.board; });
+    }
+    boardLoop.stop();
+    boardThread.join();
+    if (errors > 0)
+    {
+        std::printf("%s: %lu device errors\n", name, errors);
+    }
+    return flying && 0 == errors && latency.getCount() > 0;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned devicesCount = quick ? 50 : 500;
+    const double seconds = quick ? 1.0 : 10.0;
+
+    SkyEventLoop loop;
+    std::thread loopThread([&]() { loop.run(); });
+    const bool single = run("single loop", std::vector<SkyEventLoop*>(1, &loop), devicesCount, seconds);
+    loop.stop();
+    loopThread.join();
+
+    const unsigned hardware = std::thread::hardware_concurrency();
+    SkyEventLoopGroup group(std::max(2u, std::min(8u, hardware)), false);
+    group.start();
+    std::vector<SkyEventLoop*> loops;
+    for (unsigned i = 0; i < group.size(); i++)
+    {
+        loops.push_back(&group.getLoop(i));
+    }
+    const bool grouped = run("loop group", loops, devicesCount, seconds);
+    group.stop();
+    return single && grouped ? 0 : 1;
+}
@@ -0,0 +1,103 @@
+// Mailbox item take and return, as SkyDevice::post and drain do, by 1 to 4 threads:
+// SkyFreeList compared with vector of free items guarded by mutex used before.
+
+#include "endpoint/SkyFreeList.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const size_t POOL_SIZE = 64;
+
+class MutexFreeList
+{
+public:
+    MutexFreeList(const size_t capacity)
+    {
+        for (size_t i = 0; i < capacity; i++)
+        {
+            free.push_back(i);
+        }
+    }
+
+    bool pop(size_t& index)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (free.empty())
+        {
+            return false;
+        }
+        index = free.back();
+        free.pop_back();
+        return true;
+    }
+
+    void push(const size_t index)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        free.push_back(index);
+    }
+
+private:
+    std::mutex mutex;
+    std::vector<size_t> free;
+};
+
+template <typename _FreeList>
+double measure(const unsigned threadsCount, const unsigned iterations)
+{
+    _FreeList freeList(POOL_SIZE);
+    std::atomic<unsigned> started(0);
+    std::vector<std::thread> threads;
+    skybench::Stopwatch stopwatch;
+    for (unsigned t = 0; t < threadsCount; t++)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            started++;
+            while (threadsCount != started)
+            {
+                std::this_thread::yield();
+            }
+            size_t sum = 0;
+            for (unsigned i = 0; i < iterations; i++)
+            {
+                size_t index;
+                if (freeList.pop(index))
+                {
+                    sum += index;
+                    freeList.push(index);
+                }
+            }
+            skybench::keep(sum);
+        }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return stopwatch.seconds() * 1e9 / ((double)iterations * threadsCount);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned iterations = skybench::quick(argc, argv) ? 100000 : 5000000;
+    std::printf("hardware threads %u\n", std::thread::hardware_concurrency());
+    for (const unsigned threads : {1u, 2u, 4u})
+    {
+        const double mutex = measure<MutexFreeList>(threads, iterations);
+        const double lockFree = measure<SkyFreeList>(threads, iterations);
+        std::printf("%u threads: mutex %6.1f ns, SkyFreeList %6.1f ns per take and return\n",
+                    threads, mutex, lockFree);
+    }
+    return 0;
+}
@@ -0,0 +1,146 @@
+// SkyMailbox against mutex protected std::deque: throughput with 1 - 8 producers
+// and one consumer, and push to pop latency percentiles of single producer.
+
+#include "endpoint/SkyMailbox.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Item : public SkyMailbox::Node
+{
+    std::chrono::steady_clock::time_point pushTime;
+};
+
+class LockedQueue
+{
+public:
+    void push(SkyMailbox::Node* node)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        queue.push_back(node);
+    }
+
+    SkyMailbox::Node* pop(void)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        if (queue.empty())
+        {
+            return nullptr;
+        }
+        SkyMailbox::Node* node = queue.front();
+        queue.pop_front();
+        return node;
+    }
+
+private:
+    std::mutex mutex;
+    std::deque<SkyMailbox::Node*> queue;
+};
+
+template <class _Queue>
+double throughput(const unsigned producersCount, const unsigned itemsCount)
+{
+    _Queue queue;
+    std::vector<Item> items(producersCount * itemsCount);
+    skybench::Stopwatch stopwatch;
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < producersCount; p++)
+    {
+        producers.push_back(std::thread([&, p]()
+        {
+            for (unsigned i = 0; i < itemsCount; i++)
+            {
+                queue.push(&items[p * itemsCount + i]);
+            }
+        }));
+    }
+    unsigned long popped = 0;
+    while (popped < items.size())
+    {
+        if (nullptr != queue.pop())
+        {
+            popped++;
+        }
+        else
+        {
+            std::this_thread::yield();
+        }
+    }
+    const double seconds = stopwatch.seconds();
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+    return popped / seconds / 1e6;
+}
+
+template <class _Queue>
+void latency(const char* name, const unsigned itemsCount)
+{
+    _Queue queue;
+    std::vector<Item> items(itemsCount);
+    std::vector<double> samples;
+    samples.reserve(itemsCount);
+    std::thread consumer([&]()
+    {
+        while (samples.size() < itemsCount)
+        {
+            SkyMailbox::Node* node = queue.pop();
+            if (nullptr != node)
+            {
+                samples.push_back(std::chrono::duration<double, std::nano>(
+                        std::chrono::steady_clock::now() - static_cast<Item*>(node)->pushTime).count());
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    });
+    for (unsigned i = 0; i < itemsCount; i++)
+    {
+        // paced producer, queue is mostly empty so latency of single handoff is measured
+        const std::chrono::steady_clock::time_point next =
+                std::chrono::steady_clock::now() + std::chrono::microseconds(2);
+        items[i].pushTime = std::chrono::steady_clock::now();
+        queue.push(&items[i]);
+        while (std::chrono::steady_clock::now() < next)
+        {
+            std::this_thread::yield();
+        }
+    }
+    consumer.join();
+    std::sort(samples.begin(), samples.end());
+    std::printf("%-12s latency p50 %8.0f ns p99 %8.0f ns p999 %9.0f ns max %10.0f ns\n", name,
+                samples[samples.size() / 2], samples[samples.size() * 99 / 100],
+                samples[samples.size() * 999 / 1000], samples.back());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned itemsCount = quick ? 20000 : 1000000;
+
+    std::printf("hardware threads %u\n", std::thread::hardware_concurrency());
+    for (unsigned producers = 1; producers <= 8; producers *= 2)
+    {
+        std::printf("producers %u  SkyMailbox %6.2f Mitems/s  mutex deque %6.2f Mitems/s\n", producers,
+                    throughput<SkyMailbox>(producers, itemsCount / producers),
+                    throughput<LockedQueue>(producers, itemsCount / producers));
+    }
+    latency<SkyMailbox>("SkyMailbox", quick ? 2000 : 200000);
+    latency<LockedQueue>("mutex deque", quick ? 2000 : 200000);
+    return 0;
+}
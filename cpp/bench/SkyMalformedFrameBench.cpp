@@ -0,0 +1,175 @@
+// Cost of frames which end in error while device is idle: unexpected DebugData, one
+// and eight per received chunk, and frame broken by CRC, which is only counted.
+// Heap allocations per chunk counted by SkyAllocationGuard
+// (its object built with __SKYDIVE_ALLOCATION_GUARD__ is linked in).
+
+#include "endpoint/SkyAllocationGuard.hpp"
+#include "endpoint/device/SkyDevice.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+class IdleTimer : public ISkyTimer
+{
+public:
+    IdleTimer(std::function<void(void)> _exec):
+        ISkyTimer(_exec)
+    {
+    }
+
+    void start(const double) override
+    {
+    }
+
+    void stop(void) override
+    {
+    }
+};
+
+class RingMonitor : public ISkyDeviceMonitor
+{
+public:
+    unsigned long errors;
+
+    RingMonitor(void):
+        errors(0)
+    {
+        enableEventRing(4096);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        size_t count;
+        while ((count = drainDeviceEvents(events, EVENTS_BATCH)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                errors += DeviceEvent::MESSAGE == events[i].getType() ? 1 : 0;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t EVENTS_BATCH = 512;
+    DeviceEventRecord events[EVENTS_BATCH];
+};
+
+constexpr size_t RingMonitor::EVENTS_BATCH;
+
+class FeedingBoard : public ISkyCommInterface
+{
+public:
+    void connect(void) override
+    {
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char*, const size_t) override
+    {
+    }
+
+    void feed(const unsigned char* data, const size_t length)
+    {
+        onReceived(data, length);
+    }
+};
+
+struct Case
+{
+    const char* name;
+    const unsigned char* data;
+    size_t length;
+    unsigned frames;
+};
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned chunks = skybench::quick(argc, argv) ? 5000 : 200000;
+    const unsigned runs = skybench::quick(argc, argv) ? 1 : 5;
+
+    RingMonitor monitor;
+    FeedingBoard board;
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+    board.setListener(&device);
+
+    static constexpr unsigned FRAMES = 8;
+    unsigned char frames[IMessage::MAX_DATA_SIZE * FRAMES];
+    const DebugData debugData;
+    debugData.serializeMessage(frames);
+    const size_t length = debugData.getMessageSize();
+    for (unsigned i = 1; i < FRAMES; i++)
+    {
+        std::copy(frames, frames + length, frames + i * length);
+    }
+    unsigned char broken[IMessage::MAX_DATA_SIZE];
+    std::copy(frames, frames + length, broken);
+    broken[length / 2] ^= 0x5A;
+
+    const Case cases[] =
+    {
+        {"unexpected DebugData, 1 per chunk", frames, length, 1},
+        {"unexpected DebugData, 8 per chunk", frames, FRAMES * length, FRAMES},
+        {"CRC broken frame", broken, length, 1}
+    };
+
+    for (const Case& test : cases)
+    {
+        // warm up pools and ring
+        for (unsigned i = 0; i < 10000; i++)
+        {
+            board.feed(test.data, test.length);
+        }
+        monitor.drain();
+
+        std::vector<double> times;
+        double errorsPerChunk = 0.0;
+        double allocationsPerChunk = 0.0;
+        for (unsigned run = 0; run < runs; run++)
+        {
+            const unsigned long errorsBefore = monitor.errors;
+            const SkyAllocationGuard guard;
+            skybench::Stopwatch stopwatch;
+            for (unsigned i = 0; i < chunks; i++)
+            {
+                board.feed(test.data, test.length);
+                if (0 == i % 256)
+                {
+                    monitor.drain();
+                }
+            }
+            times.push_back(stopwatch.seconds() * 1e9 / ((double)chunks * test.frames));
+            monitor.drain();
+            errorsPerChunk = (double)(monitor.errors - errorsBefore) / chunks;
+            allocationsPerChunk = (double)guard.getAllocationsCount() / chunks;
+        }
+        std::sort(times.begin(), times.end());
+        std::printf("%-36s median %7.1f ns/frame, %.2f errors/chunk, %.2f allocations/chunk\n",
+                    test.name, times[times.size() / 2], errorsPerChunk, allocationsPerChunk);
+    }
+    return 0;
+}
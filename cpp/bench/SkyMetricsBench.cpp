@@ -0,0 +1,303 @@
+// Device receive path of DebugData frame in direct flight loop with link metrics,
+// and metrics update done for each frame (chunk and frame counters) alone, so its share
+// of receive path is shown. Prometheus text of flight metrics formatted by exporter.
+
+#include "endpoint/device/SkyDevice.hpp"
+#include "endpoint/device/SkyMetricsExporter.hpp"
+
+#include "communication/CommDispatcher.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+// timers fired by simulation loop in virtual time
+class ManualClock
+{
+public:
+    class Timer : public ISkyTimer
+    {
+    public:
+        Timer(ManualClock* const _clock, std::function<void(void)> _exec):
+            ISkyTimer(_exec),
+            clock(_clock),
+            period(0),
+            next(0),
+            running(false)
+        {
+            clock->timers.push_back(this);
+        }
+
+        ~Timer(void)
+        {
+            for (Timer*& timer : clock->timers)
+            {
+                timer = this == timer ? nullptr : timer;
+            }
+        }
+
+        void start(const double frequency) override
+        {
+            period = (uint64_t)(1e6 / frequency);
+            period = 0 == period ? 1 : period;
+            next = clock->now + period;
+            running = true;
+        }
+
+        void stop(void) override
+        {
+            running = false;
+        }
+
+    private:
+        friend class ManualClock;
+
+        ManualClock* const clock;
+        uint64_t period; // [us]
+        uint64_t next; // [us]
+        bool running;
+    };
+
+    uint64_t now; // [us]
+
+    ManualClock(void):
+        now(0)
+    {
+        // device creates all its timers before flight, slots are never added during it
+        timers.reserve(64);
+    }
+
+    void step(const uint64_t duration)
+    {
+        now += duration;
+        for (size_t i = 0; i < timers.size(); i++)
+        {
+            Timer* const timer = timers[i];
+            if (nullptr != timer && timer->running && timer->next <= now)
+            {
+                timer->next += timer->period;
+                timer->onTimeout();
+            }
+        }
+    }
+
+private:
+    std::vector<Timer*> timers;
+};
+
+class RingMonitor : public ISkyDeviceMonitor
+{
+public:
+    uint64_t received, sent, errors;
+
+    RingMonitor(ManualClock* const _clock):
+        received(0),
+        sent(0),
+        errors(0),
+        clock(_clock)
+    {
+        enableEventRing(4096);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new ManualClock::Timer(clock, exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        size_t count;
+        while ((count = drainDeviceEvents(events, EVENTS_BATCH)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                switch (events[i].getType())
+                {
+                case DeviceEvent::DATA_RECEIVED: received++; break;
+                case DeviceEvent::DATA_SENT: sent++; break;
+                case DeviceEvent::MESSAGE: errors++; break; // errors and warnings
+                default: break;
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t EVENTS_BATCH = 512;
+
+    ManualClock* const clock;
+    DeviceEventRecord events[EVENTS_BATCH];
+};
+
+constexpr size_t RingMonitor::EVENTS_BATCH;
+
+// board in flight loop, streams DebugData and answers pings in the same chunk,
+// or feeds chunks given by benchmark
+class FlightBoard : public ISkyCommInterface
+{
+public:
+    uint64_t controls, pings;
+
+    FlightBoard(void):
+        controls(0),
+        pings(0),
+        pongsCount(0)
+    {
+    }
+
+    void connect(void) override
+    {
+        onConnected();
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char* data, const size_t length) override
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            const IMessage::PreambleType preamble = dispatcher.putChar(data[i]);
+            if (IMessage::CONTROL == preamble)
+            {
+                controls++;
+            }
+            else if (IMessage::SIGNAL == preamble && SignalData::PING_VALUE == dispatcher.getCommand())
+            {
+                pings++;
+                if (pongsCount < MAX_PONGS)
+                {
+                    pongs[pongsCount++] = dispatcher.getSignalData();
+                }
+            }
+        }
+    }
+
+    void stream(const unsigned sample)
+    {
+        DebugData debugData;
+        debugData.euler.x = (float)sample;
+        debugData.serializeMessage(chunk);
+        size_t length = debugData.getMessageSize();
+        for (unsigned i = 0; i < pongsCount; i++)
+        {
+            pongs[i].serializeMessage(chunk + length);
+            length += pongs[i].getMessageSize();
+        }
+        pongsCount = 0;
+        onReceived(chunk, length);
+    }
+
+    void feed(const unsigned char* data, const size_t length)
+    {
+        onReceived(data, length);
+    }
+
+private:
+    static constexpr unsigned MAX_PONGS = 8;
+
+    CommDispatcher dispatcher;
+    SignalData pongs[MAX_PONGS];
+    unsigned pongsCount;
+    unsigned char chunk[IMessage::MAX_DATA_SIZE * (MAX_PONGS + 1)];
+};
+
+double median(std::vector<double> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned frames = skybench::quick(argc, argv) ? 20000 : 500000;
+    const unsigned runs = skybench::quick(argc, argv) ? 1 : 7;
+
+    ManualClock clock;
+    RingMonitor monitor(&clock);
+    FlightBoard board;
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+    device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::DIRECT_FLIGHT, &board));
+
+    // 10 s of flight on virtual clock, signal round trips and state dwell are sampled
+    for (unsigned sample = 0; clock.now < 10000000;)
+    {
+        clock.step(1000);
+        if (0 == clock.now % 20000)
+        {
+            board.stream(sample++);
+        }
+        if (0 == clock.now % 100000)
+        {
+            monitor.drain();
+        }
+    }
+    std::printf("state %s\n", ISkyDeviceAction::toString(device.getState()));
+
+    unsigned char chunk[IMessage::MAX_DATA_SIZE];
+    const DebugData debugData;
+    debugData.serializeMessage(chunk);
+    const size_t length = debugData.getMessageSize();
+
+    std::vector<double> receive;
+    std::vector<double> update;
+    SkyMetrics metrics;
+    for (unsigned run = 0; run < runs; run++)
+    {
+        skybench::Stopwatch stopwatch;
+        for (unsigned i = 0; i < frames; i++)
+        {
+            board.feed(chunk, length);
+            if (0 == i % 256)
+            {
+                monitor.drain();
+            }
+        }
+        receive.push_back(stopwatch.seconds() * 1e9 / frames);
+
+        stopwatch.restart();
+        for (unsigned i = 0; i < frames; i++)
+        {
+            metrics.onChunk(length);
+            metrics.onFrame(SkyMetrics::RECEIVED, IMessage::DEBUG_DATA, length);
+        }
+        update.push_back(stopwatch.seconds() * 1e9 / frames);
+    }
+    monitor.drain();
+    skybench::keep(metrics.getSnapshot().receivedBytes);
+
+    const double receiveTime = median(receive);
+    const double updateTime = median(update);
+    std::printf("receive path: median %.1f ns/frame, metrics update %.2f ns/frame (%.2f%%), errors %lu\n",
+                receiveTime, updateTime, 100.0 * updateTime / receiveTime, (unsigned long)monitor.errors);
+
+    SkyMetricsExporter exporter;
+    exporter.add("uav", &device.getMetrics());
+    size_t size = 0;
+    skybench::Stopwatch stopwatch;
+    const unsigned exports = skybench::quick(argc, argv) ? 10 : 1000;
+    for (unsigned i = 0; i < exports; i++)
+    {
+        size = exporter.format().size();
+    }
+    std::printf("export of flight metrics: %zu B, %.1f us\n", size, stopwatch.seconds() * 1e6 / exports);
+    return 0;
+}
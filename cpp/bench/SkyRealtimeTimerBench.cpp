@@ -0,0 +1,101 @@
+// SkyRealtimeTimer at 100 Hz with optional busy threads competing for CPU,
+// wake-up lateness and tick-to-send percentiles for default policy and SCHED_FIFO 80.
+// usage: SkyRealtimeTimerBench [--quick] [busy threads]
+// SCHED_FIFO and mlockall need CAP_SYS_NICE / CAP_IPC_LOCK, run is skipped otherwise.
+
+#include "endpoint/SkyRealtimeTimer.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void report(const int priority, const double rate, const SkyRealtimeTimer& timer)
+{
+    const SkyLatencyHistogram& lateness = timer.getLateness();
+    const SkyLatencyHistogram& send = timer.getSendLatency();
+    std::printf("priority %2d (%.2f Hz): ticks %lu lateness p50 %.1f p99 %.1f p999 %.1f max %.1f us"
+                " | send p50 %.1f p99 %.1f us | overruns %lu\n",
+                priority, rate, (unsigned long)lateness.getCount(),
+                lateness.getPercentile(0.5) / 1e3, lateness.getPercentile(0.99) / 1e3,
+                lateness.getPercentile(0.999) / 1e3, lateness.getMax() / 1e3,
+                send.getPercentile(0.5) / 1e3, send.getPercentile(0.99) / 1e3,
+                (unsigned long)timer.getOverrunsCount());
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    int load = 0;
+    for (int i = 1; i < argc; i++)
+    {
+        if ('-' != argv[i][0])
+        {
+            load = std::atoi(argv[i]);
+        }
+    }
+    const std::chrono::milliseconds duration(quick ? 300 : 5000);
+
+    std::atomic<bool> busy(true);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < load; i++)
+    {
+        threads.push_back(std::thread([&]()
+        {
+            volatile double x = 0.0;
+            while (busy)
+            {
+                x += 1.0;
+            }
+        }));
+    }
+
+    std::printf("busy threads %d\n", load);
+    const int priorities[2] = {0, 80};
+    for (const int priority : priorities)
+    {
+        SkyRealtimeTimer* timer = nullptr;
+        unsigned long ticks = 0;
+        try
+        {
+            // callback does some work and reports its ControlData as sent
+            timer = new SkyRealtimeTimer([&]()
+            {
+                ticks++;
+                volatile int work = 0;
+                for (int i = 0; i < 2000; i++)
+                {
+                    work += i;
+                }
+                timer->notifySent();
+            }, SkyRealtimeTimer::Settings(priority, -1, priority > 0));
+        }
+        catch (const std::runtime_error& e)
+        {
+            std::printf("priority %2d: skipped, %s\n", priority, e.what());
+            continue;
+        }
+        skybench::Stopwatch stopwatch;
+        timer->start(100.0);
+        std::this_thread::sleep_for(duration);
+        timer->stop();
+        report(priority, ticks / stopwatch.seconds(), *timer);
+        delete timer;
+    }
+
+    busy = false;
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return 0;
+}
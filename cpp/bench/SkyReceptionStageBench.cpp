@@ -0,0 +1,168 @@
+// Burst replay: one chunk of 300 stale DebugData followed by TARGET_ACK and FLIGHT_LOOP
+// BREAK, 20 us of monitor work per handled message. Time to handle protocol messages
+// when chunk is handled in arrival order and through SkyReceptionStage, and sensors
+// logger burst of 300 SensorsData which has to pass whole.
+
+#include "endpoint/device/SkyReceptionStage.hpp"
+#include "endpoint/device/SkyTelemetryStore.hpp"
+
+#include "communication/AutopilotData.hpp"
+#include "communication/CommDispatcher.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/SensorsData.hpp"
+#include "communication/SignalData.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+typedef std::chrono::steady_clock Clock;
+
+const unsigned BURST = 300;
+
+SkyTelemetryStore store;
+
+void append(std::vector<unsigned char>& stream, const IMessage& message)
+{
+    // messages serialize from memory layout, which can be longer than frame
+    unsigned char buffer[IMessage::PREAMBLE_SIZE + sizeof(SensorsData) + IMessage::MAX_DATA_SIZE];
+    message.serializeMessage(buffer);
+    stream.insert(stream.end(), buffer, buffer + message.getMessageSize());
+}
+
+void handle(const IMessage& message)
+{
+    store.update(message);
+    const DeviceEventRecord record(DeviceEvent::DATA_RECEIVED, message);
+    skybench::keep(record.getType());
+    const Clock::time_point start = Clock::now();
+    while (Clock::now() - start < std::chrono::microseconds(20))
+    {
+    }
+}
+
+struct Result
+{
+    double ack, brk, total; // [us]
+    unsigned handled;
+};
+
+Result replay(const std::vector<unsigned char>& stream,
+              const IMessage::MessageType controlType,
+              const bool staged,
+              SkyReceptionStage& stage)
+{
+    Result result = {0.0, 0.0, 0.0, 0};
+    CommDispatcher dispatcher;
+    const Clock::time_point start = Clock::now();
+    auto deliver = [&](const IMessage& message)
+    {
+        handle(message);
+        result.handled++;
+        const double at = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+        if (IMessage::AUTOPILOT_DATA == message.getMessageType())
+        {
+            result.ack = at;
+        }
+        else if (IMessage::SIGNAL_DATA == message.getMessageType())
+        {
+            result.brk = at;
+        }
+    };
+    for (const unsigned char byte : stream)
+    {
+        const IMessage::PreambleType preamble = dispatcher.putChar(byte);
+        if (IMessage::CONTROL == preamble)
+        {
+            if (IMessage::DEBUG_DATA == controlType)
+            {
+                const DebugData debugData = dispatcher.getDebugData();
+                staged ? stage.push(debugData) : deliver(debugData);
+            }
+            else
+            {
+                const SensorsData sensorsData = dispatcher.getSensorsData();
+                staged ? stage.push(sensorsData) : deliver(sensorsData);
+            }
+        }
+        else if (IMessage::AUTOPILOT == preamble)
+        {
+            const AutopilotData autopilotData = dispatcher.getAutopilotData();
+            staged ? stage.push(autopilotData) : deliver(autopilotData);
+        }
+        else if (IMessage::SIGNAL == preamble)
+        {
+            const SignalData signalData = dispatcher.getSignalData();
+            staged ? stage.push(signalData) : deliver(signalData);
+        }
+    }
+    DeviceEventRecord record;
+    while (stage.pop(record))
+    {
+        deliver(record.getMessage());
+    }
+    result.total = std::chrono::duration<double, std::micro>(Clock::now() - start).count();
+    return result;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned repetitions = skybench::quick(argc, argv) ? 2 : 20;
+
+    std::vector<unsigned char> flight;
+    for (unsigned i = 0; i < BURST; i++)
+    {
+        DebugData debugData;
+        debugData.euler.x = (float)i;
+        append(flight, debugData);
+    }
+    AutopilotData autopilotData;
+    autopilotData.setType(AutopilotData::TARGET_ACK);
+    append(flight, autopilotData);
+    append(flight, SignalData(SignalData::FLIGHT_LOOP, SignalData::BREAK));
+
+    std::vector<unsigned char> logger;
+    for (unsigned i = 0; i < BURST; i++)
+    {
+        SensorsData sensorsData;
+        sensorsData.pressure = (float)i;
+        append(logger, sensorsData);
+    }
+    append(logger, SignalData(SignalData::SENSORS_LOGGER, SignalData::BREAK_ACK));
+
+    std::printf("flight burst %zu B: %u DebugData, TARGET_ACK, FLIGHT_LOOP BREAK\n", flight.size(), BURST);
+    for (int staged = 0; staged < 2; staged++)
+    {
+        SkyReceptionStage stage;
+        Result best = {1e9, 1e9, 1e9, 0};
+        for (unsigned r = 0; r < repetitions; r++)
+        {
+            const Result result = replay(flight, IMessage::DEBUG_DATA, staged, stage);
+            best.ack = std::min(best.ack, result.ack);
+            best.brk = std::min(best.brk, result.brk);
+            best.total = std::min(best.total, result.total);
+            best.handled = result.handled;
+        }
+        std::printf("    %-15s: TARGET_ACK after %7.1f us, BREAK after %7.1f us, chunk %7.1f us, handled %u, coalesced %lu\n",
+                    staged ? "reception stage" : "arrival order", best.ack, best.brk, best.total, best.handled,
+                    (unsigned long)stage.getCoalescedCount() / repetitions);
+    }
+    DebugData latest;
+    store.read(latest);
+    std::printf("    telemetry store latest euler.x %.0f\n", latest.euler.x);
+
+    std::printf("logger burst %zu B: %u SensorsData, SENSORS_LOGGER BREAK_ACK\n", logger.size(), BURST);
+    SkyReceptionStage stage;
+    const Result result = replay(logger, IMessage::SENSORS_DATA, true, stage);
+    std::printf("    reception stage: handled %u, coalesced %lu, chunk %7.1f us\n",
+                result.handled, (unsigned long)stage.getCoalescedCount(), result.total);
+    return 0;
+}
@@ -0,0 +1,168 @@
+// Replay of generated direct flight capture (50 Hz DebugData, pong 5 ms after each
+// 1 Hz ping) into device on virtual clock with FAST timing: frames decoded per second,
+// speed against real time, and same sent bytes and frames in every run.
+// ORIGINAL timing of short capture is compared with wall time.
+
+#include "endpoint/device/SkyDevice.hpp"
+#include "endpoint/SkyCapture.hpp"
+#include "endpoint/SkyReplayCommInterface.hpp"
+#include "endpoint/SkyVirtualClock.hpp"
+
+#include "SkyBench.hpp"
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+class ClockMonitor : public ISkyDeviceMonitor
+{
+public:
+    unsigned long errors;
+
+    ClockMonitor(SkyVirtualClock* const _clock):
+        errors(0),
+        clock(_clock)
+    {
+        enableEventRing(8192);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return clock->createTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        size_t count;
+        while ((count = drainDeviceEvents(events, EVENTS_BATCH)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                errors += DeviceEvent::MESSAGE == events[i].getType() ? 1 : 0;
+            }
+        }
+    }
+
+private:
+    static constexpr size_t EVENTS_BATCH = 512;
+
+    SkyVirtualClock* const clock;
+    DeviceEventRecord events[EVENTS_BATCH];
+};
+
+constexpr size_t ClockMonitor::EVENTS_BATCH;
+
+void generate(const std::string& path, const unsigned seconds)
+{
+    SkyCaptureWriter writer;
+    writer.open(path);
+    writer.write(SkyCapture::CONNECTED, SkyCapture::Duration(0), nullptr, 0);
+    unsigned char buffer[IMessage::MAX_DATA_SIZE];
+    for (unsigned time = 20; time <= seconds * 1000; time += 20)
+    {
+        DebugData debugData;
+        debugData.euler.x = (float)time;
+        debugData.serializeMessage(buffer);
+        writer.write(SkyCapture::RECEIVED, std::chrono::milliseconds(time), buffer, debugData.getMessageSize());
+        if (0 == time % 1000)
+        {
+            const SignalData pong(SignalData::PING_VALUE, (int)(time / 1000));
+            pong.serializeMessage(buffer);
+            writer.write(SkyCapture::RECEIVED, std::chrono::milliseconds(time + 5), buffer, pong.getMessageSize());
+        }
+    }
+}
+
+uint64_t getReceivedFrames(const SkyDevice& device)
+{
+    const SkyMetrics::Snapshot snapshot = device.getMetrics().getSnapshot();
+    uint64_t frames = 0;
+    for (unsigned type = 0; type < SkyMetrics::MESSAGE_TYPES_COUNT; type++)
+    {
+        frames += snapshot.frames[SkyMetrics::RECEIVED][type];
+    }
+    return frames;
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned seconds = skybench::quick(argc, argv) ? 60 : 3600;
+    const std::string path = "/tmp/SkyReplayBench." + std::to_string(getpid()) + ".skycap";
+
+    generate(path, seconds);
+    SkyCaptureReader reader;
+    if (!reader.open(path))
+    {
+        std::printf("can not read capture %s\n", path.c_str());
+        return 1;
+    }
+    std::printf("capture of %u s flight\n", seconds);
+
+    int result = 0;
+    uint64_t lastSent = 0;
+    uint64_t lastFrames = 0;
+    for (unsigned run = 0; run < 3; run++)
+    {
+        reader.rewind();
+        SkyVirtualClock clock;
+        ClockMonitor monitor(&clock);
+        SkyReplayCommInterface replay(&reader, &clock, SkyReplayCommInterface::FAST);
+        SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+        device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::DIRECT_FLIGHT, &replay));
+
+        skybench::Stopwatch stopwatch;
+        for (uint64_t records = 1; replay.step(); records++)
+        {
+            if (0 == records % 1024)
+            {
+                monitor.drain();
+            }
+        }
+        const double wall = stopwatch.seconds();
+        monitor.drain();
+
+        const uint64_t frames = getReceivedFrames(device);
+        std::printf("run %u: state %s, %lu frames in %.3f s: %.0f frames/s, %.0fx real time, sent %lu B, errors %lu\n",
+                    run, ISkyDeviceAction::toString(device.getState()), (unsigned long)frames, wall, frames / wall,
+                    std::chrono::duration<double>(reader.getDuration()).count() / wall,
+                    (unsigned long)replay.getSentBytes(), monitor.errors);
+        if (run > 0 && (lastSent != replay.getSentBytes() || lastFrames != frames))
+        {
+            std::printf("replay is not deterministic\n");
+            result = 1;
+        }
+        lastSent = replay.getSentBytes();
+        lastFrames = frames;
+    }
+
+    generate(path, skybench::quick(argc, argv) ? 1 : 2);
+    reader.open(path);
+    SkyVirtualClock clock;
+    ClockMonitor monitor(&clock);
+    SkyReplayCommInterface replay(&reader, &clock, SkyReplayCommInterface::ORIGINAL);
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+    device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::DIRECT_FLIGHT, &replay));
+    skybench::Stopwatch stopwatch;
+    replay.replay();
+    std::printf("original timing: %.3f s wall for %.3f s capture\n",
+                stopwatch.seconds(), std::chrono::duration<double>(reader.getDuration()).count());
+
+    std::remove(path.c_str());
+    return result;
+}
@@ -0,0 +1,346 @@
+// Per message dispatch cost of table driven actions: FlightAction and AppAction handling
+// DebugData and flight loop mix of DebugData and pong, fake listener, no device thread.
+// Reference is flight loop reception of FlightAction as it was written with switches
+// before transition tables, measured by the same harness. Median of 7 runs of 5M messages.
+
+#include "endpoint/device/actions/AppAction.hpp"
+#include "endpoint/device/actions/FlightAction.hpp"
+
+#include "communication/DebugData.hpp"
+
+#include "endpoint/device/PilotEvent.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+class IdleTimer : public ISkyTimer
+{
+public:
+    IdleTimer(std::function<void(void)> _exec):
+        ISkyTimer(_exec)
+    {
+    }
+
+    void start(const double) override
+    {
+    }
+
+    void stop(void) override
+    {
+    }
+};
+
+class CountingMonitor : public ISkyDeviceMonitor
+{
+public:
+    unsigned long events;
+
+    CountingMonitor(void):
+        events(0)
+    {
+    }
+
+    void notifyDeviceEvent(const DeviceEventRecord&) override
+    {
+        events++;
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+};
+
+class FakeListener : public ISkyDeviceAction::Listener
+{
+public:
+    CountingMonitor monitor;
+    unsigned long pongs;
+    unsigned long errors;
+
+    FakeListener(void):
+        pongs(0),
+        errors(0)
+    {
+    }
+
+    ISkyDeviceMonitor* getMonitor(void) override
+    {
+        return &monitor;
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void releaseTimer(ISkyTimer* timer) override
+    {
+        delete timer;
+    }
+
+    bool setupProtocolVersion(const unsigned) override
+    {
+        return true;
+    }
+
+    SkyActionPool& getActionPool(void) override
+    {
+        return actionPool;
+    }
+
+    void startAction(ISkyDeviceAction*, bool) override
+    {
+    }
+
+    void onPongReception(const SignalData&) override
+    {
+        pongs++;
+    }
+
+    void onSignalResponse(const SignalData::Command, const std::chrono::steady_clock::duration) override
+    {
+    }
+
+    const SkyLinkQuality& getLinkQuality(void) const override
+    {
+        return linkQuality;
+    }
+
+    const SkyRateController* getRateController(void) const override
+    {
+        return nullptr;
+    }
+
+    void onError(const std::string&) override
+    {
+        errors++;
+    }
+
+    void onError(const SkyError&) override
+    {
+        errors++;
+    }
+
+    void send(const IMessage&) override
+    {
+    }
+
+    void send(const ISignalPayloadMessage&) override
+    {
+    }
+
+    void enablePingTask(bool) override
+    {
+    }
+
+    void enableConnectionTimeoutTask(bool) override
+    {
+    }
+
+    void connectInterface(ISkyCommInterface*) override
+    {
+    }
+
+    void disconnectInterface(void) override
+    {
+    }
+
+private:
+    SkyActionPool actionPool;
+    SkyLinkQuality linkQuality;
+};
+
+// reception of FlightAction with nested switches, control timer and autopilot left out
+class SwitchFlightAction : public ISkyDeviceAction
+{
+public:
+    SwitchFlightAction(Listener* const _listener):
+        ISkyDeviceAction(_listener)
+    {
+        state = IDLE;
+    }
+
+    void start(void) override
+    {
+        state = FLING;
+        monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_STARTED));
+        listener->send(SignalData(SignalData::FLIGHT_LOOP, SignalData::READY));
+        listener->enablePingTask(true);
+    }
+
+    bool isActionDone(void) const override
+    {
+        return IDLE == state;
+    }
+
+    Type getType(void) const override
+    {
+        return FLIGHT;
+    }
+
+    const char* getStateName(void) const override
+    {
+        switch (state)
+        {
+        case IDLE: return "IDLE";
+        case FLING: return "FLING";
+        case BREAKING: return "BREAKING";
+        default: return "UNKNOWN";
+        }
+    }
+
+private:
+    enum State
+    {
+        IDLE,
+        FLING,
+        BREAKING,
+    };
+
+    std::atomic<State> state;
+
+    void handleReception(const IMessage& message) override
+    {
+        switch (state)
+        {
+        case IDLE:
+            handleIdleReception(message);
+            break;
+
+        case FLING:
+        case BREAKING:
+            handleRunningReception(message);
+            break;
+
+        default:
+            fail(SkyError::UNEXPECTED_MESSAGE, message);
+        }
+    }
+
+    void handleUserEvent(const PilotEvent& event) override
+    {
+        if (FLING == state && PilotEvent::BREAK_FLIGHT_LOOP == event.getType())
+        {
+            listener->enablePingTask(false);
+            listener->enableConnectionTimeoutTask(false);
+            state = BREAKING;
+        }
+        else
+        {
+            fail(SkyError::UNEXPECTED_PILOT_EVENT, event.getType());
+        }
+    }
+
+    void handleRunningReception(const IMessage& message)
+    {
+        switch (message.getMessageType())
+        {
+        case IMessage::DEBUG_DATA:
+            notifyReceived(message);
+            break;
+
+        case IMessage::SIGNAL_DATA:
+        {
+            const SignalData& signal = static_cast<const SignalData&>(message);
+            switch (signal.getCommand())
+            {
+            case SignalData::PING_VALUE:
+                listener->onPongReception(signal);
+                break;
+
+            case SignalData::FLIGHT_LOOP:
+                if ((SignalData::BREAK_ACK == signal.getParameter() && BREAKING == state)
+                    || SignalData::BREAK == signal.getParameter())
+                {
+                    listener->enablePingTask(false);
+                    state = IDLE;
+                }
+                else
+                {
+                    fail(SkyError::UNEXPECTED_MESSAGE, message);
+                }
+                break;
+
+            default:
+                fail(SkyError::UNEXPECTED_MESSAGE, message);
+            }
+            break;
+        }
+
+        default:
+            fail(SkyError::UNEXPECTED_MESSAGE, message);
+        }
+    }
+};
+
+// [ns] per message, median of runs
+template <typename _Fn>
+double measure(_Fn handle, const unsigned messages, const unsigned runs)
+{
+    std::vector<double> results;
+    for (unsigned run = 0; run < runs; run++)
+    {
+        skybench::Stopwatch stopwatch;
+        for (unsigned i = 0; i < messages; i++)
+        {
+            handle(i);
+        }
+        results.push_back(stopwatch.seconds() * 1e9 / messages);
+    }
+    std::sort(results.begin(), results.end());
+    return results[results.size() / 2];
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned messages = quick ? 100000 : 5000000;
+    const unsigned runs = quick ? 1 : 7;
+
+    FakeListener listener;
+    FlightAction flight(&listener, 50.0);
+    flight.start();
+    AppAction app(&listener);
+    app.start();
+    SwitchFlightAction reference(&listener);
+    reference.start();
+
+    const DebugData debugData;
+    const SignalData pong(SignalData::PING_VALUE, 7);
+    const IMessage* const mix[8] = {&debugData, &debugData, &debugData, &debugData,
+                                    &debugData, &debugData, &debugData, &pong};
+
+    const double flightDebug = measure([&](const unsigned) { flight.baseHandleReception(debugData); }, messages, runs);
+    const double flightMix = measure([&](const unsigned i) { flight.baseHandleReception(*mix[i & 7]); }, messages, runs);
+    const double appDebug = measure([&](const unsigned) { app.baseHandleReception(debugData); }, messages, runs);
+    const double switchDebug = measure([&](const unsigned) { reference.baseHandleReception(debugData); }, messages, runs);
+    const double switchMix = measure([&](const unsigned i) { reference.baseHandleReception(*mix[i & 7]); }, messages, runs);
+
+    std::printf("table FlightAction DebugData %.1f ns/msg, DebugData and pong mix %.1f ns/msg, "
+                "AppAction DebugData %.1f ns/msg\n", flightDebug, flightMix, appDebug);
+    std::printf("switch FlightAction DebugData %.1f ns/msg, DebugData and pong mix %.1f ns/msg\n",
+                switchDebug, switchMix);
+    std::printf("flight state %s, switch flight state %s, events %lu, pongs %lu, errors %lu\n",
+                flight.getStateName(), reference.getStateName(), listener.monitor.events,
+                listener.pongs, listener.errors);
+    return 0;
+}
@@ -0,0 +1,74 @@
+// SkyTelemetryStore update cost on receive path with three polling readers,
+// and SkyFleetTelemetry snapshot of 1000 devices into reused vector.
+
+#include "endpoint/device/SkyTelemetryStore.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <thread>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned updates = quick ? 50000 : 2000000;
+
+    SkyTelemetryStore store;
+    std::atomic<bool> done(false);
+    std::atomic<unsigned long> reads(0);
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < 3; r++)
+    {
+        readers.push_back(std::thread([&]()
+        {
+            DebugData debugData;
+            while (false == done)
+            {
+                store.read(debugData);
+                reads++;
+            }
+        }));
+    }
+    DebugData debugData;
+    skybench::Stopwatch stopwatch;
+    for (unsigned i = 0; i < updates; i++)
+    {
+        const float value = (float)i;
+        debugData.setEuler(Vect3Df(value, value, value));
+        store.update(debugData);
+    }
+    const double updateTime = stopwatch.seconds();
+    done = true;
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    std::printf("%u updates with 3 readers: %.0f ns per update, %lu reads\n",
+                updates, updateTime * 1e9 / updates, reads.load());
+
+    const unsigned devices = 1000;
+    const unsigned snapshots = quick ? 10 : 1000;
+    std::vector<std::unique_ptr<SkyTelemetryStore>> stores;
+    SkyFleetTelemetry fleet;
+    for (unsigned i = 0; i < devices; i++)
+    {
+        stores.push_back(std::unique_ptr<SkyTelemetryStore>(new SkyTelemetryStore()));
+        SensorsData sensorsData;
+        sensorsData.lat = (float)i;
+        stores.back()->update(sensorsData);
+        fleet.add(i, stores.back().get());
+    }
+    std::vector<SkyFleetTelemetry::Entry> entries;
+    fleet.snapshot(entries);
+    stopwatch.restart();
+    for (unsigned k = 0; k < snapshots; k++)
+    {
+        fleet.snapshot(entries);
+    }
+    std::printf("fleet snapshot of %u devices: %.1f us, %zu bytes per entry\n",
+                devices, stopwatch.seconds() * 1e6 / snapshots, sizeof(SkyFleetTelemetry::Entry));
+    return 0;
+}
@@ -0,0 +1,47 @@
+// SkyTimerWheel with 100k concurrent periodic timers and random rearms on virtual time,
+// cost of single rearm or fire.
+
+#include "endpoint/SkyTimerWheel.hpp"
+
+#include "SkyBench.hpp"
+
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <vector>
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    const unsigned timersCount = 100000;
+    const unsigned milliseconds = quick ? 100 : 2000;
+    const unsigned rearmsPerMillisecond = 500;
+
+    std::mt19937 generator(1);
+    SkyTimerWheel wheel(std::chrono::milliseconds(1));
+    std::vector<std::unique_ptr<ISkyTimer>> timers(timersCount);
+    unsigned long fires = 0;
+    for (unsigned i = 0; i < timersCount; i++)
+    {
+        timers[i].reset(wheel.createTimer([&]() { fires++; }));
+        timers[i]->start(1 + i % 50);
+    }
+
+    const SkyTimerWheel::Clock::time_point base = SkyTimerWheel::Clock::now();
+    unsigned long rearms = 0;
+    skybench::Stopwatch stopwatch;
+    for (unsigned ms = 1; ms <= milliseconds; ms++)
+    {
+        for (unsigned k = 0; k < rearmsPerMillisecond; k++)
+        {
+            timers[generator() % timersCount]->start(1 + generator() % 100);
+            rearms++;
+        }
+        wheel.advance(base + std::chrono::milliseconds(ms));
+    }
+    const double seconds = stopwatch.seconds();
+
+    std::printf("%u timers, %u ms virtual: %lu rearms, %lu fires in %.3f s, %.0f ns per operation\n",
+                timersCount, milliseconds, rearms, fires, seconds, seconds * 1e9 / (rearms + fires));
+    return 0;
+}
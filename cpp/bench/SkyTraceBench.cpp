@@ -0,0 +1,87 @@
+// Cost of trace point: filtered by runtime level, written to ring drained every
+// 1000 records, written with reader draining concurrently, compared to string
+// built for each point as monitor traces were before SkyTrace.
+
+#include "endpoint/device/SkyTrace.hpp"
+
+#include "communication/SignalData.hpp"
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+#include "SkyBench.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <string>
+#include <thread>
+
+namespace
+{
+
+constexpr size_t BATCH = 1000;
+
+SkyTrace::Record records[1024];
+
+}
+
+int main(int argc, char** argv)
+{
+    const unsigned points = skybench::quick(argc, argv) ? 100000 : 10000000;
+    volatile int parameter = SignalData::READY;
+
+    SkyTrace::setLevel(SkyTrace::INFO);
+    skybench::Stopwatch stopwatch;
+    for (unsigned i = 0; i < points; i++)
+    {
+        SkyTrace::debug(SkyTrace::SIGNAL_RECEIVED, ISkyDeviceAction::FLIGHT, "FLING", (int)parameter);
+    }
+    std::printf("disabled point: %.2f ns\n", stopwatch.seconds() * 1e9 / points);
+
+    // reader drains between batches, so ring never drops
+    SkyTrace::setLevel(SkyTrace::DEBUG);
+    double seconds = 0.0;
+    for (unsigned done = 0; done < points; done += BATCH)
+    {
+        stopwatch.restart();
+        for (size_t i = 0; i < BATCH; i++)
+        {
+            SkyTrace::debug(SkyTrace::SIGNAL_RECEIVED, ISkyDeviceAction::FLIGHT, "FLING", (int)parameter);
+        }
+        seconds += stopwatch.seconds();
+        SkyTrace::drain(records, BATCH);
+    }
+    std::printf("enabled point: %.2f ns\n", seconds * 1e9 / points);
+
+    const uint64_t droppedBefore = SkyTrace::getDroppedCount();
+    std::atomic<bool> running(true);
+    uint64_t read = 0;
+    std::thread reader([&running, &read](void)
+    {
+        while (running.load())
+        {
+            read += SkyTrace::drain(records, 1024);
+        }
+        read += SkyTrace::drain(records, 1024);
+    });
+    stopwatch.restart();
+    for (unsigned i = 0; i < points; i++)
+    {
+        SkyTrace::debug(SkyTrace::SIGNAL_RECEIVED, ISkyDeviceAction::FLIGHT, "FLING", (int)parameter);
+    }
+    seconds = stopwatch.seconds();
+    running.store(false);
+    reader.join();
+    std::printf("enabled point, concurrent reader: %.2f ns, read %llu, dropped %llu\n",
+                seconds * 1e9 / points, (unsigned long long)read,
+                (unsigned long long)(SkyTrace::getDroppedCount() - droppedBefore));
+
+    std::string text;
+    stopwatch.restart();
+    for (unsigned i = 0; i < points / 10; i++)
+    {
+        text = "HandleSignalReception with " + std::string("FLIGHT") + " @ FLING param: " +
+                SignalData::toString((SignalData::Parameter)parameter);
+        skybench::keep(text.size());
+    }
+    std::printf("string built: %.2f ns\n", stopwatch.seconds() * 1e9 / (points / 10));
+    return 0;
+}
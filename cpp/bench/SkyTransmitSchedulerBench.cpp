@@ -0,0 +1,145 @@
+// Worst ControlData send latency during 4 kB signal payload transfer (82 frames) queued
+// at once, 50 Hz controls, serial link drained at its bitrate in virtual time.
+// Frames written directly to interface are compared with SkyTransmitScheduler pacing
+// link bitrate and sending controls first.
+
+#include "endpoint/device/SkyTransmitScheduler.hpp"
+
+#include "communication/ControlData.hpp"
+
+#include "SkyBench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+const unsigned char BULK_MARK = 0xFF;
+
+// FIFO drained at bitrate, records when control frame left the wire
+class SerialLink : public ISkyCommInterface
+{
+public:
+    double now; // [s]
+    double busyUntil; // [s]
+    double controlQueued; // [s] time of newest control
+    std::vector<double> latencies; // [s]
+
+    SerialLink(const double _bitrate):
+        now(0.0),
+        busyUntil(0.0),
+        controlQueued(0.0),
+        bitrate(_bitrate)
+    {
+    }
+
+    void connect(void) override
+    {
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char* data, const size_t length) override
+    {
+        busyUntil = std::max(now, busyUntil) + length / bitrate;
+        if (BULK_MARK != data[0])
+        {
+            latencies.push_back(busyUntil - controlQueued);
+        }
+    }
+
+    size_t getSendQueueSize(void) const override
+    {
+        return (size_t)(std::max(0.0, busyUntil - now) * bitrate);
+    }
+
+private:
+    const double bitrate;
+};
+
+void simulate(const double bitrate, const bool scheduled)
+{
+    const unsigned controlSize = ControlData().getMessageSize();
+    const unsigned frameSize = IMessage::SIGNAL_DATA_MESSAGE_SIZE;
+    const unsigned payloadSize = 4096;
+    const unsigned framesCount = (payloadSize + IMessage::SIGNAL_DATA_PAYLOAD_SIZE - 1) / IMessage::SIGNAL_DATA_PAYLOAD_SIZE;
+    const double step = 0.0001;
+    const double controlPeriod = 0.02;
+
+    SerialLink link(bitrate);
+    SkyTransmitScheduler scheduler(SkyTransmitScheduler::Settings((unsigned)bitrate));
+    scheduler.setInterface(&link);
+
+    unsigned char control[IMessage::MAX_DATA_SIZE] = {0};
+    unsigned char bulk[IMessage::MAX_DATA_SIZE];
+    std::fill(bulk, bulk + sizeof(bulk), BULK_MARK);
+
+    const SkyTransmitScheduler::Clock::time_point start = SkyTransmitScheduler::Clock::now();
+    const long steps = (long)((payloadSize / bitrate * 1.5 + 1.0) / step);
+    for (long i = 0; i < steps; i++)
+    {
+        link.now = i * step;
+        const SkyTransmitScheduler::Clock::time_point now = start + std::chrono::microseconds((long)(link.now * 1e6));
+        if (1000 == i)
+        {
+            for (unsigned frame = 0; frame < framesCount; frame++)
+            {
+                if (scheduled)
+                {
+                    scheduler.send(SkyTransmitScheduler::BULK, IMessage::CONTROL_SETTINGS, bulk, frameSize, now);
+                }
+                else
+                {
+                    link.send(bulk, frameSize);
+                }
+            }
+        }
+        if (0 == i % (long)(controlPeriod / step + 0.5))
+        {
+            link.controlQueued = link.now;
+            if (scheduled)
+            {
+                scheduler.send(SkyTransmitScheduler::CONTROL, IMessage::CONTROL_DATA, control, controlSize, now);
+            }
+            else
+            {
+                link.send(control, controlSize);
+            }
+        }
+        if (scheduled)
+        {
+            SkyTransmitScheduler::Clock::duration wait;
+            scheduler.pump(wait, now);
+        }
+    }
+
+    std::vector<double>& latencies = link.latencies;
+    std::sort(latencies.begin(), latencies.end());
+    std::printf("link %6.0f B/s %-9s: %4zu controls, latency p50 %7.1f ms, worst %8.1f ms, "
+                "replaced %lu, wire busy until %.2f s\n",
+                bitrate, scheduled ? "scheduler" : "direct", latencies.size(),
+                latencies[latencies.size() / 2] * 1e3, latencies.back() * 1e3,
+                (unsigned long)scheduler.getReplacedCount(), link.busyUntil);
+}
+
+}
+
+int main(int argc, char** argv)
+{
+    const bool quick = skybench::quick(argc, argv);
+    for (const double bitrate : {11520.0, 5760.0, 960.0})
+    {
+        if (quick && bitrate < 1000.0)
+        {
+            continue;
+        }
+        simulate(bitrate, false);
+        simulate(bitrate, true);
+    }
+    return 0;
+}
@@ -0,0 +1,142 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef __ACCEL_CALIBRATION_SOLVER__
+#define __ACCEL_CALIBRATION_SOLVER__
+
+#include "MathCore.hpp"
+#include "LeastSquares.hpp"
+#include "ImuData.hpp"
+
+#ifdef __SKYDIVE_USE_STL__
+
+#include <istream>
+#include <string>
+#include <vector>
+
+#endif //__SKYDIVE_USE_STL__
+
+/**
+ * =============================================================================================
+ * AccelCalibrationSolver
+ * Ground side least squares solver for accelerometer calibration:
+ *     accelCalibrated = scale * accelRaw + bias
+ * where scale is 3x3 scale/misalignment matrix and bias is offset vector.
+ * Samples are streamed one by one, static segments are detected with running variance
+ * over sliding window, each segment is reduced to its mean and classified to one of six
+ * orientations (gravity along +/-X, +/-Y, +/-Z). Segment means are folded into QR factor
+ * of the fit, so memory usage does not depend on number of processed samples.
+ * =============================================================================================
+ */
+class AccelCalibrationSolver
+{
+public:
+    static constexpr unsigned MAX_WINDOW_SIZE = 256;
+
+    enum Orientation
+    {
+        X_UP,
+        X_DOWN,
+        Y_UP,
+        Y_DOWN,
+        Z_UP,
+        Z_DOWN,
+        ORIENTATIONS_COUNT
+    };
+
+    /**
+     * _windowSize - samples in variance window (clamped to MAX_WINDOW_SIZE)
+     * _varianceThreshold - max variance of every axis for sample to be static [raw unit ^ 2]
+     * _minSegmentLength - min static samples to accept segment
+     * _gravity - expected norm of calibrated gravity vector
+     */
+    AccelCalibrationSolver(const unsigned _windowSize = 50,
+                           const float _varianceThreshold = 0.01f,
+                           const unsigned _minSegmentLength = 200,
+                           const float _gravity = (float)roboLib::gravity);
+
+    // drops all samples, segments and result
+    void reset(void);
+
+    // online interface, samples are processed in order of arrival
+    void putSample(const Vect3Df& accel);
+    void putSample(const ImuData& imuData);
+
+    // closes ongoing static segment (if long enough), called at the end of stream
+    void flush(void);
+
+    bool isStatic(void) const;
+
+    unsigned getSamplesCount(void) const;
+    unsigned getSegmentsCount(void) const;
+    unsigned getRejectedSegmentsCount(void) const;
+    unsigned getOrientationSegmentsCount(const Orientation orientation) const;
+    unsigned getCoveredOrientationsCount(void) const;
+
+    // solves accumulated fit, returns false when data is not sufficient
+    bool solve(void);
+
+    bool isSolved(void) const;
+
+    const Mat3Df& getScale(void) const;
+    const Vect3Df& getBias(void) const;
+
+    // root mean square error of fit over accepted segments
+    float getResidual(void) const;
+
+    Vect3Df apply(const Vect3Df& accelRaw) const;
+
+#ifdef __SKYDIVE_USE_STL__
+
+    // offline interface, stream of ImuData lines (time, omega, accel, magnet, pressure)
+    // returns number of parsed samples, lines that can not be parsed are skipped
+    unsigned processLog(std::istream& stream);
+    unsigned processLogFile(const std::string& path);
+
+    // solves every log file separately (one board per file), files are processed in parallel
+    static std::vector<AccelCalibrationSolver> calibrateLogFiles(const std::vector<std::string>& paths,
+                                                                 const AccelCalibrationSolver& prototype = AccelCalibrationSolver());
+
+    static std::string toString(const Orientation orientation);
+
+#endif //__SKYDIVE_USE_STL__
+
+private:
+    static constexpr unsigned MIN_ORIENTATIONS = 4;
+    static constexpr double MIN_ALIGNMENT = 0.866; // cos(30 deg)
+
+    unsigned windowSize;
+    float varianceThreshold;
+    unsigned minSegmentLength;
+    float gravity;
+
+    // sliding window with running sums
+    Vect3Df window[MAX_WINDOW_SIZE];
+    unsigned windowCounter;
+    unsigned windowFill;
+    Vect3Dd windowSum;
+    Vect3Dd windowSqSum;
+
+    // ongoing static segment
+    bool staticState;
+    Vect3Dd segmentSum;
+    unsigned segmentLength;
+
+    // regressor [ax ay az 1], one output for each calibrated axis
+    HouseholderLeastSquares<double, 4, 3> fit;
+
+    unsigned samplesCount;
+    unsigned segmentsCount;
+    unsigned rejectedSegmentsCount;
+    unsigned orientationSegments[ORIENTATIONS_COUNT];
+
+    bool solved;
+    Mat3Df scale;
+    Vect3Df bias;
+    float residual;
+
+    void closeSegment(void);
+    bool classify(const Vect3Dd& mean, Vect3Dd& target, Orientation& orientation) const;
+};
+
+#endif // __ACCEL_CALIBRATION_SOLVER__
@@ -0,0 +1,75 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef __GEO_KERNELS__
+#define __GEO_KERNELS__
+
+#include "MathCore.hpp"
+
+/**
+ * =============================================================================================
+ * GeoKernels
+ * Batch geodesic computations (spherical Earth, roboLib::rEarth) over contiguous arrays
+ * of latitudes and longitudes [deg]. Points are converted in chunks to unit vectors
+ * on sphere, distance is taken from chord length, so per pair only one atan2 is evaluated.
+ * Trigonometry is done with branchless polynomial approximations, inner loops are
+ * vectorized (SSE2 where available). Big batches are split between workers of persistent
+ * pool (STL builds), pool threads are started with first such batch and live until exit.
+ * Max error of approximations: MAX_ANGLE_ERROR [rad], MAX_DISTANCE_ERROR [m].
+ * =============================================================================================
+ */
+class GeoKernels
+{
+public:
+    static constexpr unsigned CHUNK_SIZE = 256;
+    static constexpr unsigned PARALLEL_THRESHOLD = 1u << 15; // pairs processed in single thread
+
+    static constexpr double MAX_ANGLE_ERROR = 1e-12;
+    static constexpr double MAX_DISTANCE_ERROR = 1e-4;
+
+    static constexpr unsigned NO_POINT = ~0u; // nearest() of empty input
+
+    // one to many distance [m], result has count elements
+    static void distances(const double lat0, const double lon0,
+                          const double* lat, const double* lon, const unsigned count,
+                          double* result);
+    static void distances(const Vect2Dd& origin, const Vect2Dd* points, const unsigned count,
+                          double* result);
+
+    // one to many initial bearing [deg] in range [0, 360), 0 is north, 90 is east
+    static void bearings(const double lat0, const double lon0,
+                         const double* lat, const double* lon, const unsigned count,
+                         double* result);
+    static void bearings(const Vect2Dd& origin, const Vect2Dd* points, const unsigned count,
+                         double* result);
+
+    // count x count distance matrix [m], row major
+    static void distanceMatrix(const double* lat, const double* lon, const unsigned count,
+                               double* result);
+
+    // index of nearest point, distance [m] is optionally returned,
+    // for empty input NO_POINT is returned and distance is not written
+    static unsigned nearest(const double lat0, const double lon0,
+                            const double* lat, const double* lon, const unsigned count,
+                            double* distance = nullptr);
+
+    // sum of distances between consecutive points [m]
+    static double pathLength(const double* lat, const double* lon, const unsigned count);
+
+    // polynomial approximations used by kernels
+    static void fastSinCos(const double x, double& sinX, double& cosX);
+    static double fastAtan2(const double y, const double x);
+
+private:
+    static void toUnit(const double* lat, const double* lon, const unsigned stride, const unsigned count,
+                       double* ux, double* uy, double* uz);
+
+    static void distancesSerial(const double lat0, const double lon0,
+                                const double* lat, const double* lon, const unsigned stride,
+                                const unsigned count, double* result);
+    static void bearingsSerial(const double lat0, const double lon0,
+                               const double* lat, const double* lon, const unsigned stride,
+                               const unsigned count, double* result);
+};
+
+#endif // __GEO_KERNELS__
@@ -0,0 +1,576 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef __LEAST_SQUARES__
+#define __LEAST_SQUARES__
+
+#include "MathCore.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#endif
+
+/**
+ * =============================================================================================
+ * Streaming least squares engine
+ * RecursiveLeastSquares - sample by sample estimation with exponential forgetting
+ * HouseholderLeastSquares - batch solution, samples are gathered in blocks and folded
+ * into triangular factor R with Householder reflections, so only N x N factor is stored
+ * Model size N (and number of outputs M) are compile time parameters, all storage is static
+ * and inner loops work on contiguous arrays (explicit SSE2/NEON where available).
+ * =============================================================================================
+ */
+namespace roboLib
+{
+namespace simd
+{
+template <typename _Tp> inline _Tp dot(const _Tp* a, const _Tp* b, const unsigned n); // iloczyn skalarny
+template <typename _Tp> inline void axpy(const _Tp alpha, const _Tp* x, _Tp* y, const unsigned n); // y += alpha * x
+}
+}
+
+template <class _Tp, unsigned N>
+class RecursiveLeastSquares
+{
+public:
+    RecursiveLeastSquares(const _Tp _forgettingFactor = _Tp(1), const _Tp _initialCovariance = _Tp(1e6));
+
+    void reset(void);
+
+    // single sample update, returns a priori prediction error
+    _Tp update(const _Tp* regressor, const _Tp measurement);
+    _Tp predict(const _Tp* regressor) const;
+
+    void setForgettingFactor(const _Tp _forgettingFactor);
+    _Tp getForgettingFactor(void) const;
+
+    const _Tp* getParameters(void) const;
+    _Tp getParameter(const unsigned row) const; // (UWAGA! elementy numerowane w stylu Matlaba - od 1!)
+    Vector<_Tp> getParametersVector(void) const;
+
+    const _Tp* getCovariance(void) const; // N x N, row major
+
+    unsigned long getSamplesCount(void) const;
+
+    static constexpr unsigned size(void);
+
+private:
+    _Tp forgettingFactor;
+    _Tp initialCovariance;
+
+    _Tp theta[N];
+    _Tp P[N * N];
+    _Tp Px[N];
+
+    unsigned long samplesCount;
+};
+
+template <class _Tp, unsigned N, unsigned M = 1, unsigned BLOCK = 32>
+class HouseholderLeastSquares
+{
+public:
+    HouseholderLeastSquares(void);
+
+    void reset(void);
+
+    // sample with M measurements (one for each output), folded when block is full
+    void add(const _Tp* regressor, const _Tp* measurements);
+    void add(const _Tp* regressor, const _Tp measurement);
+
+    // folds pending block rows into triangular factor
+    void flush(void);
+
+    // merges factor of another solver (e.g. computed in another thread)
+    void merge(const HouseholderLeastSquares& other);
+
+    // solves R * theta = Q^T * y for every output, theta is N x M (column of each output)
+    bool solve(_Tp* theta);
+    bool solve(_Tp* theta, const unsigned output);
+
+    _Tp getResidualSumOfSquares(const unsigned output = 0);
+
+    const _Tp* getR(void); // N x N upper triangular, row major
+
+    unsigned long getSamplesCount(void) const;
+
+    static constexpr unsigned size(void);
+
+private:
+    _Tp R[N * N];
+    _Tp z[N * M];
+    _Tp rss[M];
+
+    // pending block, stored column by column for contiguous inner loops
+    _Tp blockA[N * BLOCK];
+    _Tp blockB[M * BLOCK];
+    unsigned blockRows;
+
+    unsigned long samplesCount;
+
+    void fold(void);
+};
+
+// ==================================== simd ====================================
+template <typename _Tp>
+inline _Tp roboLib::simd::dot(const _Tp* a, const _Tp* b, const unsigned n)
+{
+    _Tp sum = 0;
+    for (unsigned i = 0; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <typename _Tp>
+inline void roboLib::simd::axpy(const _Tp alpha, const _Tp* x, _Tp* y, const unsigned n)
+{
+    for (unsigned i = 0; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+#if defined(__SSE2__)
+
+namespace roboLib
+{
+namespace simd
+{
+template <>
+inline double dot<double>(const double* a, const double* b, const unsigned n)
+{
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc0 = _mm_add_pd(acc0, _mm_mul_pd(_mm_loadu_pd(a + i), _mm_loadu_pd(b + i)));
+        acc1 = _mm_add_pd(acc1, _mm_mul_pd(_mm_loadu_pd(a + i + 2), _mm_loadu_pd(b + i + 2)));
+    }
+    acc0 = _mm_add_pd(acc0, acc1);
+    double partial[2];
+    _mm_storeu_pd(partial, acc0);
+    double sum = partial[0] + partial[1];
+    for (; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <>
+inline void axpy<double>(const double alpha, const double* x, double* y, const unsigned n)
+{
+    const __m128d a = _mm_set1_pd(alpha);
+    unsigned i = 0;
+    for (; i + 2 <= n; i += 2)
+    {
+        _mm_storeu_pd(y + i, _mm_add_pd(_mm_loadu_pd(y + i), _mm_mul_pd(a, _mm_loadu_pd(x + i))));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+
+template <>
+inline float dot<float>(const float* a, const float* b, const unsigned n)
+{
+    __m128 acc = _mm_setzero_ps();
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = _mm_add_ps(acc, _mm_mul_ps(_mm_loadu_ps(a + i), _mm_loadu_ps(b + i)));
+    }
+    float partial[4];
+    _mm_storeu_ps(partial, acc);
+    float sum = partial[0] + partial[1] + partial[2] + partial[3];
+    for (; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <>
+inline void axpy<float>(const float alpha, const float* x, float* y, const unsigned n)
+{
+    const __m128 a = _mm_set1_ps(alpha);
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        _mm_storeu_ps(y + i, _mm_add_ps(_mm_loadu_ps(y + i), _mm_mul_ps(a, _mm_loadu_ps(x + i))));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+}
+}
+
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+
+namespace roboLib
+{
+namespace simd
+{
+template <>
+inline float dot<float>(const float* a, const float* b, const unsigned n)
+{
+    float32x4_t acc = vdupq_n_f32(0.0f);
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        acc = vmlaq_f32(acc, vld1q_f32(a + i), vld1q_f32(b + i));
+    }
+    float partial[4];
+    vst1q_f32(partial, acc);
+    float sum = partial[0] + partial[1] + partial[2] + partial[3];
+    for (; i < n; i++)
+    {
+        sum += a[i] * b[i];
+    }
+    return sum;
+}
+
+template <>
+inline void axpy<float>(const float alpha, const float* x, float* y, const unsigned n)
+{
+    const float32x4_t a = vdupq_n_f32(alpha);
+    unsigned i = 0;
+    for (; i + 4 <= n; i += 4)
+    {
+        vst1q_f32(y + i, vmlaq_f32(vld1q_f32(y + i), a, vld1q_f32(x + i)));
+    }
+    for (; i < n; i++)
+    {
+        y[i] += alpha * x[i];
+    }
+}
+}
+}
+
+#endif
+
+
+// =========================== RecursiveLeastSquares ============================
+template <class _Tp, unsigned N>
+RecursiveLeastSquares <_Tp, N>::RecursiveLeastSquares(const _Tp _forgettingFactor, const _Tp _initialCovariance):
+    forgettingFactor(_forgettingFactor),
+    initialCovariance(_initialCovariance)
+{
+    reset();
+}
+
+template <class _Tp, unsigned N>
+void RecursiveLeastSquares <_Tp, N>::reset(void)
+{
+    for (unsigned i = 0; i < N; i++)
+    {
+        theta[i] = 0;
+        for (unsigned j = 0; j < N; j++)
+        {
+            P[i * N + j] = (i == j) ? initialCovariance : _Tp(0);
+        }
+    }
+    samplesCount = 0;
+}
+
+template <class _Tp, unsigned N>
+_Tp RecursiveLeastSquares <_Tp, N>::update(const _Tp* regressor, const _Tp measurement)
+{
+    // Px = P * x, P is symmetric so every row is a contiguous dot product
+    for (unsigned i = 0; i < N; i++)
+    {
+        Px[i] = roboLib::simd::dot(P + i * N, regressor, N);
+    }
+    const _Tp denominator = forgettingFactor + roboLib::simd::dot(regressor, Px, N);
+    const _Tp error = measurement - roboLib::simd::dot(regressor, theta, N);
+
+    // theta += k * e, k = Px / denominator
+    roboLib::simd::axpy(error / denominator, Px, theta, N);
+
+    // P = (P - k * Px^T) / lambda, upper triangle is updated and mirrored, rounding
+    // would otherwise make P asymmetric and 1 / lambda amplifies that until P diverges
+    const _Tp invLambda = _Tp(1) / forgettingFactor;
+    for (unsigned i = 0; i < N; i++)
+    {
+        _Tp* row = P + i * N;
+        roboLib::simd::axpy(-Px[i] / denominator, Px + i, row + i, N - i);
+        for (unsigned j = i; j < N; j++)
+        {
+            row[j] *= invLambda;
+            P[j * N + i] = row[j];
+        }
+    }
+
+    samplesCount++;
+    return error;
+}
+
+template <class _Tp, unsigned N>
+_Tp RecursiveLeastSquares <_Tp, N>::predict(const _Tp* regressor) const
+{
+    return roboLib::simd::dot(regressor, theta, N);
+}
+
+template <class _Tp, unsigned N>
+void RecursiveLeastSquares <_Tp, N>::setForgettingFactor(const _Tp _forgettingFactor)
+{
+    forgettingFactor = _forgettingFactor;
+}
+
+template <class _Tp, unsigned N>
+_Tp RecursiveLeastSquares <_Tp, N>::getForgettingFactor(void) const
+{
+    return forgettingFactor;
+}
+
+template <class _Tp, unsigned N>
+const _Tp* RecursiveLeastSquares <_Tp, N>::getParameters(void) const
+{
+    return theta;
+}
+
+template <class _Tp, unsigned N>
+_Tp RecursiveLeastSquares <_Tp, N>::getParameter(const unsigned row) const
+{
+    return (row >= 1 && row <= N) ? theta[row - 1] : theta[0];
+}
+
+template <class _Tp, unsigned N>
+Vector<_Tp> RecursiveLeastSquares <_Tp, N>::getParametersVector(void) const
+{
+    Vector<_Tp> result(N);
+    for (unsigned i = 0; i < N; i++)
+    {
+        result(i + 1) = theta[i];
+    }
+    return result;
+}
+
+template <class _Tp, unsigned N>
+const _Tp* RecursiveLeastSquares <_Tp, N>::getCovariance(void) const
+{
+    return P;
+}
+
+template <class _Tp, unsigned N>
+unsigned long RecursiveLeastSquares <_Tp, N>::getSamplesCount(void) const
+{
+    return samplesCount;
+}
+
+template <class _Tp, unsigned N>
+constexpr unsigned RecursiveLeastSquares <_Tp, N>::size(void)
+{
+    return N;
+}
+
+
+// ========================== HouseholderLeastSquares ===========================
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+HouseholderLeastSquares <_Tp, N, M, BLOCK>::HouseholderLeastSquares(void)
+{
+    reset();
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::reset(void)
+{
+    for (unsigned i = 0; i < N * N; i++)
+    {
+        R[i] = 0;
+    }
+    for (unsigned i = 0; i < N * M; i++)
+    {
+        z[i] = 0;
+    }
+    for (unsigned i = 0; i < M; i++)
+    {
+        rss[i] = 0;
+    }
+    blockRows = 0;
+    samplesCount = 0;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::add(const _Tp* regressor, const _Tp* measurements)
+{
+    for (unsigned j = 0; j < N; j++)
+    {
+        blockA[j * BLOCK + blockRows] = regressor[j];
+    }
+    for (unsigned k = 0; k < M; k++)
+    {
+        blockB[k * BLOCK + blockRows] = measurements[k];
+    }
+    blockRows++;
+    samplesCount++;
+    if (BLOCK == blockRows)
+    {
+        fold();
+    }
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::add(const _Tp* regressor, const _Tp measurement)
+{
+    add(regressor, &measurement);
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::flush(void)
+{
+    if (blockRows > 0)
+    {
+        fold();
+    }
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::merge(const HouseholderLeastSquares& other)
+{
+    HouseholderLeastSquares copy(other);
+    copy.flush();
+    flush();
+    // rows of other factor are folded as regular samples
+    for (unsigned i = 0; i < N; i++)
+    {
+        for (unsigned j = 0; j < N; j++)
+        {
+            blockA[j * BLOCK + blockRows] = copy.R[i * N + j];
+        }
+        for (unsigned k = 0; k < M; k++)
+        {
+            blockB[k * BLOCK + blockRows] = copy.z[k * N + i];
+        }
+        blockRows++;
+        if (BLOCK == blockRows)
+        {
+            fold();
+        }
+    }
+    flush();
+    for (unsigned k = 0; k < M; k++)
+    {
+        rss[k] += copy.rss[k];
+    }
+    samplesCount += copy.samplesCount;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+bool HouseholderLeastSquares <_Tp, N, M, BLOCK>::solve(_Tp* theta)
+{
+    for (unsigned k = 0; k < M; k++)
+    {
+        if (!solve(theta + k * N, k))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+bool HouseholderLeastSquares <_Tp, N, M, BLOCK>::solve(_Tp* theta, const unsigned output)
+{
+    flush();
+    // back substitution on R * theta = z
+    for (int i = N - 1; i >= 0; i--)
+    {
+        const _Tp diag = R[i * N + i];
+        if (!(std::fabs(diag) > _Tp(0)))
+        {
+            return false;
+        }
+        _Tp sum = z[output * N + i];
+        for (unsigned j = i + 1; j < N; j++)
+        {
+            sum -= R[i * N + j] * theta[j];
+        }
+        theta[i] = sum / diag;
+    }
+    return true;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+_Tp HouseholderLeastSquares <_Tp, N, M, BLOCK>::getResidualSumOfSquares(const unsigned output)
+{
+    flush();
+    return output < M ? rss[output] : _Tp(0);
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+const _Tp* HouseholderLeastSquares <_Tp, N, M, BLOCK>::getR(void)
+{
+    flush();
+    return R;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+unsigned long HouseholderLeastSquares <_Tp, N, M, BLOCK>::getSamplesCount(void) const
+{
+    return samplesCount;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+constexpr unsigned HouseholderLeastSquares <_Tp, N, M, BLOCK>::size(void)
+{
+    return N;
+}
+
+template <class _Tp, unsigned N, unsigned M, unsigned BLOCK>
+void HouseholderLeastSquares <_Tp, N, M, BLOCK>::fold(void)
+{
+    // stacked matrix [R; A] is reduced column by column, R part is already upper
+    // triangular so reflection vector has only diagonal element and block rows
+    const unsigned rows = blockRows;
+    for (unsigned j = 0; j < N; j++)
+    {
+        _Tp* v = blockA + j * BLOCK;
+        const _Tp rjj = R[j * N + j];
+        const _Tp blockNorm2 = roboLib::simd::dot(v, v, rows);
+        if (!(blockNorm2 > _Tp(0)))
+        {
+            continue;
+        }
+        const _Tp norm = std::sqrt(rjj * rjj + blockNorm2);
+        const _Tp alpha = rjj > 0 ? -norm : norm;
+        const _Tp v0 = rjj - alpha;
+        const _Tp beta = _Tp(2) / (v0 * v0 + blockNorm2);
+
+        for (unsigned c = j + 1; c < N; c++)
+        {
+            _Tp* column = blockA + c * BLOCK;
+            const _Tp s = beta * (v0 * R[j * N + c] + roboLib::simd::dot(v, column, rows));
+            R[j * N + c] -= s * v0;
+            roboLib::simd::axpy(-s, v, column, rows);
+        }
+        for (unsigned k = 0; k < M; k++)
+        {
+            _Tp* rhs = blockB + k * BLOCK;
+            const _Tp s = beta * (v0 * z[k * N + j] + roboLib::simd::dot(v, rhs, rows));
+            z[k * N + j] -= s * v0;
+            roboLib::simd::axpy(-s, v, rhs, rows);
+        }
+        // diagonal takes sign opposite to previous one (no cancellation in v0),
+        // so R diagonal can have either sign, solution does not depend on it
+        R[j * N + j] = alpha;
+    }
+    // what is left in block right hand side is orthogonal to column space
+    for (unsigned k = 0; k < M; k++)
+    {
+        const _Tp* rhs = blockB + k * BLOCK;
+        rss[k] += roboLib::simd::dot(rhs, rhs, rows);
+    }
+    blockRows = 0;
+}
+
+#endif // __LEAST_SQUARES__
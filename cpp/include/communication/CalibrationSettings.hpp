@@ -100,6 +100,9 @@ public:
 
 private:
     unsigned crcValue;
+
+    // crc of fields preceding crc field
+    unsigned computeCrc(void) const;
 };
 
 #endif // __CALIBRATION_SETTINGS__
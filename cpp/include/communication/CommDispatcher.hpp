@@ -48,6 +48,11 @@ public:
     unsigned getSucessfullReceptions(void) const;
     unsigned getFailedReceptions(void) const;
 
+    // causes of failed receptions
+    unsigned getCrcFailures(void) const;
+    unsigned getPreambleCollisions(void) const; // new preamble before previous frame was complete
+    unsigned getIncompletePayloads(void) const; // signal payload broken by other message
+
     void clearCounters(void);
 
     IMessage::PreambleType putChar(unsigned char data);
@@ -67,6 +72,10 @@ private:
     unsigned failedReceptionCounter;
     unsigned sucessfullReceptionCounter;
 
+    unsigned crcFailureCounter;
+    unsigned preambleCollisionCounter;
+    unsigned incompletePayloadCounter;
+
     IMessage::PreambleType updatePreamble(unsigned char data);
     void activatePreamble(IMessage::PreambleType preambleType);
 
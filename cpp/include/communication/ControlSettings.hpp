@@ -232,6 +232,9 @@ public:
 
 private:
     unsigned crcValue;
+
+    // crc of fields preceding crc field
+    unsigned computeCrc(void) const;
 };
 
 #endif // __CONTROL_SETTINGS__
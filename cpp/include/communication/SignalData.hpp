@@ -58,7 +58,9 @@ public:
         // TODO sort these values in new lib release
         WHO_AM_I_VALUE, // board type (CalibrationSettings::BoardType)
         PROTOCOL_VERSION_VALUE,
-        PROTOCOL_VERSION
+        PROTOCOL_VERSION,
+
+        TELEMETRY_RATE // requested telemetry (DebugData) rate [Hz], sent only when rate control enabled
     };
 
     enum Parameter
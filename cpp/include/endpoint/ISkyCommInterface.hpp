@@ -31,6 +31,9 @@ public:
 
     virtual void send(const unsigned char* data, const size_t length) = 0;
 
+    // number of bytes accepted by send and not yet written to link, 0 when not known
+    virtual size_t getSendQueueSize(void) const;
+
     void setListener(Listener* _listener);
 
     void onConnected(void);
@@ -0,0 +1,24 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef ISKYEXECUTOR_HPP
+#define ISKYEXECUTOR_HPP
+
+#include <functional>
+
+/**
+ * Thread that runs tasks in order of execute calls (e.g. event loop).
+ * When SkyDevice is given executor, its mailbox is drained only by executor thread.
+ */
+class ISkyExecutor
+{
+public:
+    virtual ~ISkyExecutor(void);
+
+    // can be called from any thread
+    virtual void execute(std::function<void(void)> task) = 0;
+
+    virtual bool isCurrentThread(void) const = 0;
+};
+
+#endif // ISKYEXECUTOR_HPP
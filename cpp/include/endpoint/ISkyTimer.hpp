@@ -19,6 +19,9 @@ public:
 protected:
     void onTimeout(void) const;
 
+    // timer reused for other task
+    void setTimeoutHandler(std::function<void(void)> _exec);
+
 private:
     std::function<void(void)> exec;
 };
@@ -0,0 +1,40 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYALLOCATIONGUARD_HPP
+#define SKYALLOCATIONGUARD_HPP
+
+#include <cstdint>
+
+/**
+ * =============================================================================================
+ * SkyAllocationGuard
+ * Test mode check that code path does not touch heap. When library is built with
+ * __SKYDIVE_ALLOCATION_GUARD__ defined, global operator new is replaced and counts
+ * allocations of whole process while any guard exists, fatal guard aborts on first one.
+ * Meant for single threaded simulations, e.g. flight loop driven by manual timers:
+ *     SkyAllocationGuard guard(true);
+ *     ... simulated flight ...
+ * Without the define guard counts nothing and isEnabled returns false.
+ * =============================================================================================
+ */
+class SkyAllocationGuard
+{
+public:
+    SkyAllocationGuard(const bool _fatal = false);
+    ~SkyAllocationGuard(void);
+
+    // allocations since guard was created
+    uint64_t getAllocationsCount(void) const;
+
+    static bool isEnabled(void);
+
+private:
+    const bool fatal;
+    const uint64_t initialCount;
+
+    SkyAllocationGuard(const SkyAllocationGuard&) = delete;
+    SkyAllocationGuard& operator=(const SkyAllocationGuard&) = delete;
+};
+
+#endif // SKYALLOCATIONGUARD_HPP
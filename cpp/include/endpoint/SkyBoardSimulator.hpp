@@ -0,0 +1,187 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYBOARDSIMULATOR_HPP
+#define SKYBOARDSIMULATOR_HPP
+
+#include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/ISkyTimer.hpp"
+
+#include "communication/CommDispatcher.hpp"
+#include "communication/CalibrationSettings.hpp"
+#include "communication/ControlSettings.hpp"
+#include "communication/RouteContainer.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/ControlData.hpp"
+#include "communication/SensorsData.hpp"
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+
+/**
+ * =============================================================================================
+ * SkyBoardSimulator
+ * Board side of SkyComm protocol as loopback interface of device, for load tests
+ * of ground stack without hardware. Bytes sent by device are parsed by own dispatcher
+ * and answered in place: connection with protocol version and calibration download,
+ * application and flight loops, signal payload upload and download (also retransmitted
+ * when device reports invalid or lost payload), accelerometer, magnetometer, radio
+ * and ESC calibrations, radio check, sensors logger, reset and who am I.
+ * Telemetry (DebugData in loops, SensorsData of logger, ControlData of radio check)
+ * is streamed by single periodic timer with configured rates, flight rate follows
+ * TELEMETRY_RATE requested by device. Flight telemetry echoes received controls.
+ * Timers are created by factory, so thousands of boards share one clock
+ * (SkyVirtualClock, SkyTimerWheel or SkyEventLoop) and board costs about one timer,
+ * dispatcher and settings copy, streaming does not allocate.
+ * Board is not thread safe, its timers have to run in thread handling device input
+ * (thread of device executor, or thread advancing clock for device without executor).
+ * Timer factory has to outlive board.
+ * =============================================================================================
+ */
+class SkyBoardSimulator : public ISkyCommInterface
+{
+public:
+    typedef std::function<ISkyTimer*(std::function<void(void)>)> TimerFactory;
+
+    enum Stage
+    {
+        DISCONNECTED,
+        CONNECTING,
+        APP_LOOP,
+        FLIGHT_INITIALIZATION,
+        FLIGHT_LOOP,
+        UPLOAD,
+        DOWNLOAD,
+        ACCEL_CALIBRATION,
+        MAGNET_CALIBRATION,
+        RADIO_CALIBRATION,
+        RADIO_CALIBRATION_CHECK,
+        RADIO_CHECK,
+        ESC_CALIBRATION,
+        SENSORS_LOGGER
+    };
+
+    struct Settings
+    {
+        double appTelemetryRate; // [Hz] DebugData in application loop, 0 disables
+        double flightTelemetryRate; // [Hz] DebugData in flight loop until device requests rate
+        double sensorsRate; // [Hz] SensorsData of sensors logger
+        double radioRate; // [Hz] ControlData of radio check and calibration
+        CalibrationSettings::BoardType boardType;
+        unsigned protocolVersion; // other than IMessage::PROTOCOL_VERSION is rejected by device
+        bool pingAnswers;
+
+        Settings(void);
+    };
+
+    // single writer (board thread), summed by load test over all boards
+    struct Statistics
+    {
+        uint64_t receivedBytes;
+        uint64_t receivedFrames; // parsed frames sent by device
+        uint64_t failedReceptions;
+        uint64_t sentBytes;
+        uint64_t sentFrames; // signal payload counted per frame
+        uint64_t telemetryFrames;
+        uint64_t controlFrames; // ControlData received in flight loop
+        uint64_t pings;
+        uint64_t payloadsSent; // retransmissions included
+        uint64_t payloadRetransmissions;
+        uint64_t payloadsReceived;
+        uint64_t invalidPayloads;
+        uint64_t unexpectedSignals;
+        uint64_t connections;
+    };
+
+    SkyBoardSimulator(TimerFactory _timerFactory, const Settings& _settings = Settings());
+    ~SkyBoardSimulator(void);
+
+    SkyBoardSimulator(const SkyBoardSimulator&) = delete;
+    SkyBoardSimulator& operator=(const SkyBoardSimulator&) = delete;
+
+    void connect(void) override;
+    void disconnect(void) override;
+    void send(const unsigned char* data, const size_t length) override;
+
+    Stage getStage(void) const;
+    const Statistics& getStatistics(void) const;
+
+    // current telemetry rate [Hz], 0 when nothing is streamed
+    double getTelemetryRate(void) const;
+
+    // settings kept by board, sent on connection, flight and download, replaced by upload
+    CalibrationSettings& getCalibrationSettings(void);
+    ControlSettings& getControlSettings(void);
+    const RouteContainer& getRoute(void) const;
+
+    static const char* toString(const Stage stage);
+
+private:
+    // radio calibration channels acknowledged before check
+    static constexpr unsigned RADIO_CHANNELS = 8;
+
+    // messages are serialized from memory layout, which can be longer than frame
+    // (SensorsData in 64-bit builds), frame is then cut by crc
+    static constexpr size_t TRANSMIT_BUFFER_SIZE =
+            IMessage::PREAMBLE_SIZE + sizeof(SensorsData) > IMessage::MAX_DATA_SIZE
+            ? IMessage::PREAMBLE_SIZE + sizeof(SensorsData) : IMessage::MAX_DATA_SIZE;
+
+    TimerFactory timerFactory;
+    const Settings settings;
+
+    Stage stage;
+    bool connected;
+
+    CommDispatcher dispatcher;
+    std::unique_ptr<ISkyTimer> streamTimer;
+    double telemetryRate;
+    double flightTelemetryRate; // requested by device
+
+    CalibrationSettings calibrationSettings;
+    ControlSettings controlSettings;
+    RouteContainer route;
+
+    // payload sent and not acknowledged by device
+    const ISignalPayloadMessage* pendingPayload;
+
+    unsigned radioChannel;
+    unsigned escStep;
+
+    DebugData debugData;
+    ControlData controlData; // last received in flight, streamed in radio check
+    SensorsData sensorsData;
+
+    Statistics statistics;
+
+    void handleSignal(const SignalData& signal);
+    void handlePayload(const ISignalPayloadMessage& payload);
+    void handleControl(const ControlData& control);
+    void handleAutopilot(const AutopilotData& autopilot);
+
+    // acknowledges start of procedure from application loop
+    bool startCommand(const SignalData& signal, const Stage next);
+    void handleConnection(const SignalData& signal);
+    void handleFlight(const SignalData& signal);
+    void handleMagnetCalibration(const SignalData& signal);
+    void handleRadioCalibration(const SignalData& signal);
+    void handleEscCalibration(const SignalData& signal);
+    void handleBreak(const SignalData& signal, const Stage expected);
+    void handlePayloadResponse(const SignalData& signal);
+
+    // next step after payload was acknowledged by device
+    void onPayloadAck(const ISignalPayloadMessage* const payload);
+
+    void enterStage(const Stage next);
+    void restartStream(void);
+    void streamHandler(void);
+    void updateTelemetry(void);
+
+    void reply(const SignalData::Command command, const SignalData::Parameter parameter);
+    void reply(const SignalData::Command command, const int value);
+    void transmit(const IMessage& message);
+    void transmitPayload(const ISignalPayloadMessage& payload);
+    void unexpected(void);
+};
+
+#endif // SKYBOARDSIMULATOR_HPP
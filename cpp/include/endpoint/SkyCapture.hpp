@@ -0,0 +1,143 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYCAPTURE_HPP
+#define SKYCAPTURE_HPP
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyCapture
+ * Binary capture of link: raw chunks received and sent by interface and its connection
+ * events, with time since start of capture.
+ * File starts with 8 byte header "SKYCAP" + version + 0, each record is:
+ * type (1 byte), time since previous record [ns] (varint), data length (varint), data.
+ * Varints are LEB128, so usual telemetry chunk costs 3-5 bytes of record header.
+ * Data of ERROR record is error text.
+ * =============================================================================================
+ */
+class SkyCapture
+{
+public:
+    typedef std::chrono::nanoseconds Duration;
+
+    enum Type
+    {
+        RECEIVED,
+        SENT,
+        CONNECTED,
+        DISCONNECTED,
+        ERROR,
+        TYPES_COUNT
+    };
+
+    struct Record
+    {
+        Type type;
+        Duration time; // since start of capture
+        const unsigned char* data; // valid until reader is closed
+        size_t length;
+    };
+
+    static constexpr unsigned char VERSION = 1;
+    static constexpr size_t HEADER_SIZE = 8;
+
+    static const char* toString(const Type type);
+};
+
+/**
+ * =============================================================================================
+ * SkyCaptureWriter
+ * Writes capture file, records can be written from many threads (interface
+ * and device threads), time is taken when record is written.
+ * =============================================================================================
+ */
+class SkyCaptureWriter
+{
+public:
+    SkyCaptureWriter(void);
+    ~SkyCaptureWriter(void);
+
+    // existing file is replaced, returns false when file can not be created
+    bool open(const std::string& path);
+    void close(void);
+
+    bool isOpen(void) const;
+
+    void write(const SkyCapture::Type type, const unsigned char* data, const size_t length);
+
+    // record of given time since start (e.g. converted or simulated link),
+    // time earlier than previous record is moved to it
+    void write(const SkyCapture::Type type,
+               const SkyCapture::Duration time,
+               const unsigned char* data,
+               const size_t length);
+
+    // writes buffered records to file
+    void flush(void);
+
+    uint64_t getRecordsCount(void) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    mutable std::mutex mutex;
+    FILE* file;
+
+    Clock::time_point startTime;
+    SkyCapture::Duration lastTime;
+
+    uint64_t recordsCount;
+
+    void writeRecord(const SkyCapture::Type type,
+                     SkyCapture::Duration time,
+                     const unsigned char* data,
+                     const size_t length);
+
+    static size_t putVarint(unsigned char* buffer, uint64_t value);
+};
+
+/**
+ * =============================================================================================
+ * SkyCaptureReader
+ * Reads whole capture file into memory, records point to its buffer, so reading
+ * does not copy data. Used by one thread.
+ * =============================================================================================
+ */
+class SkyCaptureReader
+{
+public:
+    SkyCaptureReader(void);
+
+    // returns false when file can not be read or is not capture
+    bool open(const std::string& path);
+    void close(void);
+
+    // returns false at end of capture or at broken record
+    bool next(SkyCapture::Record& record);
+
+    // starts reading again from first record
+    void rewind(void);
+
+    bool isBroken(void) const;
+
+    // time of last whole record
+    SkyCapture::Duration getDuration(void) const;
+
+private:
+    std::vector<unsigned char> buffer;
+    size_t offset;
+    SkyCapture::Duration time;
+    SkyCapture::Duration duration;
+    bool broken;
+
+    bool getVarint(uint64_t& value);
+};
+
+#endif // SKYCAPTURE_HPP
@@ -0,0 +1,143 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYEVENTLOOP_HPP
+#define SKYEVENTLOOP_HPP
+
+#ifdef __linux__
+
+#include "endpoint/ISkyExecutor.hpp"
+#include "endpoint/ISkyTimer.hpp"
+#include "endpoint/SkyMailbox.hpp"
+#include "endpoint/SkyTimerWheel.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyEventLoop
+ * Single threaded epoll loop multiplexing file descriptors (transports), timers
+ * and tasks posted from other threads. Many SkyDevice instances can be hosted on one loop:
+ * device is created with loop as its executor, its monitor creates timers with
+ * SkyEventLoop::createTimer and its interface is SkyFdCommInterface bound to the same loop.
+ * Timers and fd watches can be used only from loop thread, execute from any thread.
+ * Watches and timers created from other thread while loop runs throw std::logic_error.
+ * SkyDevice constructor creates its timers, so device with running loop as executor
+ * has to be created (and destroyed) on loop thread, e.g. in task passed to execute.
+ * Loop thread blocks SIGPIPE, writes to closed pipes fail with EPIPE instead.
+ * =============================================================================================
+ */
+class SkyEventLoop : public ISkyExecutor
+{
+public:
+    typedef SkyTimerWheel::Clock Clock;
+    typedef std::function<void(const unsigned events)> FdHandler;
+
+    SkyEventLoop(const Clock::duration timerTick = std::chrono::milliseconds(1));
+    ~SkyEventLoop(void);
+
+    // runs loop in calling thread until stop
+    void run(void);
+
+    // can be called from any thread
+    void stop(void);
+
+    bool isRunning(void) const;
+
+    // registers fd with epoll events mask (EPOLLIN, EPOLLOUT...), handler gets ready events
+    void watch(const int fd, const unsigned events, FdHandler handler);
+    void modify(const int fd, const unsigned events);
+    void unwatch(const int fd);
+
+    // timer driven by this loop (shared timing wheel), ticks are called on loop thread
+    ISkyTimer* createTimer(std::function<void(void)> exec);
+
+    // ISkyExecutor overrides
+    void execute(std::function<void(void)> task) override;
+    bool isCurrentThread(void) const override;
+
+    unsigned long getIterationsCount(void) const;
+
+private:
+    struct Watch
+    {
+        int fd;
+        FdHandler handler;
+        bool active;
+    };
+
+    struct Task : public SkyMailbox::Node
+    {
+        std::function<void(void)> task;
+    };
+
+    static constexpr unsigned MAX_EVENTS = 256;
+
+    const int epollFd;
+    const int wakeFd;
+
+    std::atomic<bool> running;
+    std::atomic<bool> stopRequest;
+    std::thread::id loopThread;
+
+    std::unordered_map<int, std::unique_ptr<Watch>> watches;
+    std::vector<std::unique_ptr<Watch>> retiredWatches;
+
+    // tasks posted from other threads, eventfd is signaled when mailbox was empty
+    SkyMailbox tasks;
+
+    SkyTimerWheel timerWheel;
+
+    unsigned long iterationsCount;
+
+    // throws when called from other thread while loop is running
+    void checkThread(const char* operation) const;
+
+    int getTimeout(void) const;
+    void runTasks(void);
+    void runTimers(void);
+    void wake(void);
+};
+
+/**
+ * =============================================================================================
+ * SkyEventLoopGroup
+ * N loops running in own threads, optionally pinned to consecutive CPU cores.
+ * Devices are distributed between loops, every device stays on one loop for its lifetime.
+ * =============================================================================================
+ */
+class SkyEventLoopGroup
+{
+public:
+    // loopsCount 0 means one loop per hardware thread
+    SkyEventLoopGroup(const unsigned loopsCount = 0, const bool _pinThreads = true);
+    ~SkyEventLoopGroup(void);
+
+    void start(void);
+    void stop(void);
+
+    unsigned size(void) const;
+
+    SkyEventLoop& getLoop(const unsigned index);
+
+    // round robin selection of loop for new device
+    SkyEventLoop& nextLoop(void);
+
+private:
+    const bool pinThreads;
+
+    std::vector<std::unique_ptr<SkyEventLoop>> loops;
+    std::vector<std::thread> threads;
+
+    std::atomic<unsigned> counter;
+};
+
+#endif // __linux__
+
+#endif // SKYEVENTLOOP_HPP
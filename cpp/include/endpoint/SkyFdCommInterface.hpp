@@ -0,0 +1,82 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYFDCOMMINTERFACE_HPP
+#define SKYFDCOMMINTERFACE_HPP
+
+#ifdef __linux__
+
+#include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/SkyEventLoop.hpp"
+
+#include <sys/types.h>
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyFdCommInterface
+ * Communication over already opened file descriptor (socket, pipe, serial port)
+ * served by SkyEventLoop. Descriptor is switched to non blocking mode, data that can not
+ * be written immediately is buffered and flushed when descriptor becomes writable.
+ * Listener callbacks are called on loop thread. Writes never raise SIGPIPE (sockets are
+ * written with MSG_NOSIGNAL, loop thread blocks SIGPIPE for pipes), closed peer is reported
+ * by onError. Tasks posted to loop by connect, disconnect and send are cancelled
+ * on destruction; interface destroyed outside of running loop thread waits until loop
+ * detaches it.
+ * =============================================================================================
+ */
+class SkyFdCommInterface : public ISkyCommInterface
+{
+public:
+    SkyFdCommInterface(SkyEventLoop* const _loop, const int _fd, const bool _ownsFd = true);
+    ~SkyFdCommInterface(void);
+
+    void connect(void) override;
+
+    void disconnect(void) override;
+
+    // can be called from any thread, data is copied when called outside of loop thread
+    void send(const unsigned char* data, const size_t length) override;
+
+    // bytes buffered because descriptor was not writable
+    size_t getSendQueueSize(void) const override;
+
+    int getFd(void) const;
+
+private:
+    static constexpr size_t READ_BUFFER_SIZE = 4096;
+
+    SkyEventLoop* const loop;
+    const int fd;
+    const bool ownsFd;
+    const bool fdIsSocket;
+
+    // shared with tasks posted to loop, cleared on loop thread when interface is destroyed
+    std::shared_ptr<SkyFdCommInterface*> self;
+
+    bool connected;
+
+    std::vector<unsigned char> pendingOutput;
+    std::atomic<size_t> pendingOutputSize;
+
+    void handleEvents(const unsigned events);
+    void handleRead(void);
+    void handleWrite(void);
+
+    void connectFromLoop(void);
+    void sendFromLoop(const unsigned char* data, const size_t length);
+
+    // write without SIGPIPE, errors are left in errno
+    ssize_t writeFd(const unsigned char* data, const size_t length);
+    void handleWriteError(void);
+
+    void close(void);
+    void detach(void);
+};
+
+#endif // __linux__
+
+#endif // SKYFDCOMMINTERFACE_HPP
@@ -0,0 +1,53 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYFREELIST_HPP
+#define SKYFREELIST_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * =============================================================================================
+ * SkyFreeList
+ * Lock-free stack of free slot indices of preallocated pool (R. K. Treiber).
+ * Head is index of top slot tagged with counter of changes in single 64 bit word,
+ * so slot taken and returned by other thread between read and CAS (ABA) fails
+ * the CAS, portable without double width CAS. Both push and pop can be called from
+ * any thread, list never allocates after construction. All slots are free initially.
+ * =============================================================================================
+ */
+class SkyFreeList
+{
+public:
+    SkyFreeList(const size_t _capacity);
+
+    SkyFreeList(const SkyFreeList&) = delete;
+    SkyFreeList& operator=(const SkyFreeList&) = delete;
+
+    // returns false when every slot is taken
+    bool pop(size_t& index);
+
+    // slot has to be taken by pop before
+    void push(const size_t index);
+
+    size_t getCapacity(void) const;
+
+private:
+    static constexpr uint32_t EMPTY = ~0u;
+
+    const size_t capacity;
+
+    // tag in upper half, index of top slot in lower half
+    std::atomic<uint64_t> head;
+
+    // index of next free slot, read by concurrent pop of slot that is taken meanwhile,
+    // so it is atomic, stale value is rejected by tag
+    std::unique_ptr<std::atomic<uint32_t>[]> next;
+
+    static uint64_t pack(const uint64_t tag, const uint32_t index);
+};
+
+#endif // SKYFREELIST_HPP
@@ -0,0 +1,49 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYLATENCYHISTOGRAM_HPP
+#define SKYLATENCYHISTOGRAM_HPP
+
+#include <atomic>
+#include <cstdint>
+
+/**
+ * =============================================================================================
+ * SkyLatencyHistogram
+ * Lock free log-linear histogram of durations in nanoseconds. Every power of two range
+ * is divided into 16 buckets, so reported percentiles have at most ~6% relative error.
+ * record can be called from any thread concurrently with readers (values are relaxed
+ * counters, readers get consistent enough snapshot for monitoring).
+ * =============================================================================================
+ */
+class SkyLatencyHistogram
+{
+public:
+    SkyLatencyHistogram(void);
+
+    void record(const uint64_t nanoseconds);
+
+    uint64_t getCount(void) const;
+    uint64_t getMax(void) const; // [ns]
+    double getMean(void) const; // [ns]
+
+    // quantile 0.0 - 1.0, returns upper bound of bucket [ns], 0 when empty
+    uint64_t getPercentile(const double quantile) const;
+
+    void reset(void);
+
+private:
+    static constexpr unsigned SUB_BITS = 4;
+    static constexpr unsigned SUB_BUCKETS = 1 << SUB_BITS;
+    static constexpr unsigned BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+    std::atomic<uint64_t> buckets[BUCKETS];
+    std::atomic<uint64_t> count;
+    std::atomic<uint64_t> sum;
+    std::atomic<uint64_t> max;
+
+    static unsigned bucketIndex(const uint64_t value);
+    static uint64_t bucketUpperBound(const unsigned index);
+};
+
+#endif // SKYLATENCYHISTOGRAM_HPP
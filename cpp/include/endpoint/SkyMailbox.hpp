@@ -0,0 +1,48 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYMAILBOX_HPP
+#define SKYMAILBOX_HPP
+
+#include <atomic>
+
+/**
+ * =============================================================================================
+ * SkyMailbox
+ * Intrusive lock-free multiple producers single consumer queue (D. Vyukov).
+ * Items derive from SkyMailbox::Node, queue never allocates. push is wait-free and can be
+ * called from any thread, pop can be called only from one consumer at a time.
+ * =============================================================================================
+ */
+class SkyMailbox
+{
+public:
+    class Node
+    {
+    public:
+        Node(void);
+        virtual ~Node(void);
+
+    private:
+        friend class SkyMailbox;
+        std::atomic<Node*> next;
+    };
+
+    SkyMailbox(void);
+
+    // returns true if queue was empty before push
+    bool push(Node* node);
+
+    // returns oldest node or nullptr if queue is empty, when producer is in the middle
+    // of push, waits until node is linked, so FIFO order is always preserved
+    Node* pop(void);
+
+    bool isEmpty(void) const;
+
+private:
+    std::atomic<Node*> head;
+    Node* tail;
+    Node stub;
+};
+
+#endif // SKYMAILBOX_HPP
@@ -0,0 +1,97 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYREALTIMETIMER_HPP
+#define SKYREALTIMETIMER_HPP
+
+#ifdef __linux__
+
+#include "endpoint/ISkyTimer.hpp"
+#include "endpoint/SkyLatencyHistogram.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+/**
+ * =============================================================================================
+ * SkyRealtimeTimer
+ * Timer for control loop (FlightAction controlFreq) running in own thread on timerfd
+ * armed with absolute CLOCK_MONOTONIC deadlines, expirations stay on fixed grid
+ * started at start() call, so there is no cumulative drift. Thread can optionally run
+ * with SCHED_FIFO priority, be pinned to CPU and whole process memory can be locked.
+ * Wake-up lateness (wake time - deadline) is recorded on every tick, tick-to-send latency
+ * is recorded when notifySent is called, monitor should do it when DeviceEventSent
+ * with ControlData is notified. Timer can be destroyed from its own callback.
+ * =============================================================================================
+ */
+class SkyRealtimeTimer : public ISkyTimer
+{
+public:
+    struct Settings
+    {
+        int priority; // SCHED_FIFO priority 1 - 99, 0 keeps default policy
+        int cpu; // CPU index to pin timer thread, -1 disables pinning
+        bool lockMemory; // mlockall(MCL_CURRENT | MCL_FUTURE) for whole process
+
+        Settings(const int _priority = 0, const int _cpu = -1, const bool _lockMemory = false);
+    };
+
+    SkyRealtimeTimer(std::function<void(void)> _exec, const Settings& settings = Settings());
+    ~SkyRealtimeTimer(void);
+
+    void start(const double freqency) override;
+    void stop(void) override;
+
+    // call after data produced by last tick was sent, records tick-to-send latency
+    void notifySent(void);
+
+    const SkyLatencyHistogram& getLateness(void) const;
+    const SkyLatencyHistogram& getSendLatency(void) const;
+
+    // ticks missed because previous callback did not return on time
+    uint64_t getOverrunsCount(void) const;
+
+    void resetStatistics(void);
+
+private:
+    // state used by timer thread, outlives timer when it is destroyed from callback
+    struct Shared
+    {
+        int timerFd;
+        int wakeFd;
+
+        std::atomic<bool> quit;
+
+        std::mutex mutex;
+        bool armed;
+        int64_t deadline; // [ns] next expected expiry
+        int64_t period; // [ns]
+
+        std::atomic<int64_t> lastTick; // [ns]
+        std::atomic<uint64_t> overruns;
+
+        SkyLatencyHistogram lateness;
+        SkyLatencyHistogram sendLatency;
+
+        Shared(void);
+        ~Shared(void);
+    };
+
+    std::shared_ptr<Shared> shared;
+    std::thread thread;
+
+    static void run(std::shared_ptr<Shared> shared, SkyRealtimeTimer* const timer);
+
+    static int64_t now(void);
+
+    void applySettings(const Settings& settings);
+    void shutdown(void);
+};
+
+#endif // __linux__
+
+#endif // SKYREALTIMETIMER_HPP
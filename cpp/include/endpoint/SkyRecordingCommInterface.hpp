@@ -0,0 +1,44 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYRECORDINGCOMMINTERFACE_HPP
+#define SKYRECORDINGCOMMINTERFACE_HPP
+
+#include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/SkyCapture.hpp"
+
+/**
+ * =============================================================================================
+ * SkyRecordingCommInterface
+ * Decorator of interface writing link capture: every received and sent chunk
+ * and connection event is written to capture before it is passed on.
+ * Device uses decorator instead of wrapped interface, wrapped interface reports to decorator.
+ * Capture can be replayed by SkyReplayCommInterface.
+ * =============================================================================================
+ */
+class SkyRecordingCommInterface :
+        public ISkyCommInterface,
+        private ISkyCommInterface::Listener
+{
+public:
+    // interface and writer have to outlive decorator
+    SkyRecordingCommInterface(ISkyCommInterface* const _interface, SkyCaptureWriter* const _writer);
+    ~SkyRecordingCommInterface(void);
+
+    void connect(void) override;
+    void disconnect(void) override;
+    void send(const unsigned char* data, const size_t length) override;
+    size_t getSendQueueSize(void) const override;
+
+private:
+    ISkyCommInterface* const interface;
+    SkyCaptureWriter* const writer;
+
+    // ISkyCommInterface::Listener overrides
+    void onConnected(void) override;
+    void onDisconnected(void) override;
+    void onError(const std::string& message) override;
+    void onReceived(const unsigned char* data, const size_t length) override;
+};
+
+#endif // SKYRECORDINGCOMMINTERFACE_HPP
@@ -0,0 +1,74 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYREPLAYCOMMINTERFACE_HPP
+#define SKYREPLAYCOMMINTERFACE_HPP
+
+#include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/SkyCapture.hpp"
+#include "endpoint/SkyVirtualClock.hpp"
+
+#include <cstdint>
+
+/**
+ * =============================================================================================
+ * SkyReplayCommInterface
+ * Interface feeding link capture back to listener (device): received chunks
+ * and connection events are passed in captured order, sent data is only counted.
+ * When virtual clock is given, it is advanced to time of each record before record
+ * is passed, so timers of device fire between chunks as they did during capture.
+ * With FAST timing records are replayed as fast as possible, with ORIGINAL timing
+ * replay waits for captured time. Replay with virtual clock and FAST timing is
+ * deterministic, so field link problem can be reproduced many times faster than real time.
+ * Data received after disconnect requested by listener is dropped.
+ * =============================================================================================
+ */
+class SkyReplayCommInterface : public ISkyCommInterface
+{
+public:
+    enum Timing
+    {
+        FAST,
+        ORIGINAL
+    };
+
+    // reader has to outlive interface, clock can be nullptr
+    SkyReplayCommInterface(SkyCaptureReader* const _reader,
+                           SkyVirtualClock* const _clock = nullptr,
+                           const Timing _timing = FAST);
+    ~SkyReplayCommInterface(void);
+
+    void connect(void) override;
+    void disconnect(void) override;
+    void send(const unsigned char* data, const size_t length) override;
+
+    // passes next record, returns false at end of capture
+    bool step(void);
+
+    // passes all remaining records, returns their number
+    uint64_t replay(void);
+
+    uint64_t getReceivedBytes(void) const;
+    uint64_t getDroppedBytes(void) const;
+    uint64_t getSentBytes(void) const;
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    SkyCaptureReader* const reader;
+    SkyVirtualClock* const clock;
+    const Timing timing;
+
+    bool connected;
+    bool started;
+
+    // capture time 0 at replay start
+    SkyVirtualClock::Duration clockStart;
+    Clock::time_point wallStart;
+
+    uint64_t receivedBytes;
+    uint64_t droppedBytes;
+    uint64_t sentBytes;
+};
+
+#endif // SKYREPLAYCOMMINTERFACE_HPP
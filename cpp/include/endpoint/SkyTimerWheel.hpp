@@ -0,0 +1,107 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYTIMERWHEEL_HPP
+#define SKYTIMERWHEEL_HPP
+
+#include "endpoint/ISkyTimer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+
+/**
+ * =============================================================================================
+ * SkyTimerWheel
+ * Hierarchical timing wheel (4 levels x 256 slots) shared by many timers,
+ * start, stop and destruction of timer are O(1). Timers are intrusive list nodes,
+ * wheel never allocates. Time is quantized to ticks, periodic timers are rescheduled
+ * from previous expiry, so there is no cumulative drift. Wheel is not thread safe,
+ * advance and all timer operations have to be called by one thread (event loop).
+ * =============================================================================================
+ */
+class SkyTimerWheel
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    // intrusive list node
+    struct Node
+    {
+        Node* prev;
+        Node* next;
+    };
+
+    class Timer : public ISkyTimer, private Node
+    {
+    public:
+        Timer(SkyTimerWheel* const _wheel, std::function<void(void)> _exec);
+        ~Timer(void);
+
+        void start(const double freqency) override;
+        void stop(void) override;
+
+        bool isActive(void) const;
+
+    private:
+        friend class SkyTimerWheel;
+
+        SkyTimerWheel* const wheel;
+
+        bool linked;
+        unsigned level;
+        unsigned slot;
+
+        uint64_t expiry; // [tick]
+        uint64_t period; // [tick]
+    };
+
+    SkyTimerWheel(const Clock::duration _tickDuration = std::chrono::milliseconds(1));
+    ~SkyTimerWheel(void);
+
+    ISkyTimer* createTimer(std::function<void(void)> exec);
+
+    // fires all timers expired until now
+    void advance(void);
+    void advance(const Clock::time_point now);
+
+    // time left to next possible expiry (upper levels are reported as next cascade),
+    // negative when there are no active timers
+    Clock::duration getTimeToNextExpiry(void) const;
+
+    uint64_t getCurrentTick(void) const;
+    unsigned getActiveTimersCount(void) const;
+    Clock::duration getTickDuration(void) const;
+
+private:
+    static constexpr unsigned LEVELS = 4;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned SLOTS = 1 << SLOT_BITS;
+    static constexpr unsigned SLOT_MASK = SLOTS - 1;
+    static constexpr unsigned BITMAP_WORDS = SLOTS / 64;
+
+    const Clock::duration tickDuration;
+    const Clock::time_point startTime;
+
+    uint64_t currentTick;
+    unsigned activeTimersCount;
+
+    // slot sentinels and bitmaps of non empty slots
+    Node slots[LEVELS][SLOTS];
+    uint64_t occupied[LEVELS][BITMAP_WORDS];
+
+    // timers of processed slot, callbacks can stop or destroy them safely
+    Node pending;
+
+    uint64_t toTick(const Clock::time_point time) const;
+
+    void schedule(Timer* timer);
+    void link(Node* head, Timer* timer);
+    void unlink(Timer* timer);
+    void moveSlot(const unsigned level, const unsigned slot);
+    void processTick(void);
+
+    int findOccupied(const unsigned level, const unsigned from) const;
+};
+
+#endif // SKYTIMERWHEEL_HPP
@@ -0,0 +1,95 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYVIRTUALCLOCK_HPP
+#define SKYVIRTUALCLOCK_HPP
+
+#include "endpoint/ISkyTimer.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyVirtualClock
+ * Simulated time for timers of devices under replay or test. Time moves only when
+ * advanced, timers expired in advanced period are fired in order of expiry
+ * (timers of the same expiry in order of start), with clock set to expiry of fired timer.
+ * So run does not depend on speed of machine and repeats exactly.
+ * With advanceToNext time jumps straight to next deadline, so multi second timeouts
+ * of actions expire instantly (see SkyScenario).
+ * Monitor creates timers with SkyVirtualClock::createTimer, device should run without
+ * executor, then every input is handled synchronously in thread advancing the clock.
+ * Timers are kept in binary heap, start, stop and expiry are O(log n).
+ * Clock is not thread safe, it has to outlive its timers.
+ * =============================================================================================
+ */
+class SkyVirtualClock
+{
+public:
+    typedef std::chrono::nanoseconds Duration;
+
+    class Timer : public ISkyTimer
+    {
+    public:
+        Timer(SkyVirtualClock* const _clock, std::function<void(void)> _exec);
+        ~Timer(void);
+
+        void start(const double freqency) override;
+        void stop(void) override;
+
+        bool isActive(void) const;
+
+    private:
+        friend class SkyVirtualClock;
+
+        static constexpr size_t NOT_SCHEDULED = (size_t)-1;
+
+        SkyVirtualClock* const clock;
+
+        size_t heapIndex;
+        Duration expiry;
+        Duration period;
+        uint64_t sequence; // order of start, for timers of the same expiry
+    };
+
+    SkyVirtualClock(void);
+    ~SkyVirtualClock(void);
+
+    ISkyTimer* createTimer(std::function<void(void)> exec);
+
+    // time since clock was created
+    Duration now(void) const;
+
+    // fires all timers expired until time, returns number of fired timers
+    size_t advanceTo(const Duration time);
+    size_t advanceBy(const Duration duration);
+
+    // jumps to earliest expiry and fires all timers expired at it,
+    // returns number of fired timers, 0 when no timer is active
+    size_t advanceToNext(void);
+
+    // earliest expiry of active timers, false when no timer is active
+    bool getNextExpiry(Duration& expiry) const;
+
+    unsigned getActiveTimersCount(void) const;
+
+private:
+    Duration time;
+    uint64_t sequence;
+
+    // active timers, earliest expiry first
+    std::vector<Timer*> heap;
+
+    void schedule(Timer* timer);
+    void unschedule(Timer* timer);
+
+    bool isEarlier(const Timer* first, const Timer* second) const;
+    void place(Timer* timer, const size_t index);
+    void siftUp(size_t index);
+    void siftDown(size_t index);
+};
+
+#endif // SKYVIRTUALCLOCK_HPP
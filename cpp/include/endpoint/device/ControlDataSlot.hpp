@@ -0,0 +1,51 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef CONTROLDATASLOT_HPP
+#define CONTROLDATASLOT_HPP
+
+#include "communication/ControlData.hpp"
+
+#include <atomic>
+
+/**
+ * =============================================================================================
+ * ControlDataSlot
+ * Latest value triple buffer between joystick (input) thread and control loop.
+ * write and read are wait free and never block each other, reader always gets last
+ * complete ControlData, intermediate values are overwritten. One writer and one reader
+ * at a time (different threads can take the role if calls are externally serialized).
+ * =============================================================================================
+ */
+class ControlDataSlot
+{
+public:
+    ControlDataSlot(void);
+
+    // input thread
+    void write(const ControlData& data);
+
+    // control loop, returns default ControlData until first write
+    const ControlData& read(void);
+
+    // true when value was written since last read
+    bool hasUpdate(void) const;
+
+private:
+    static constexpr unsigned INDEX_MASK = 0x3;
+    static constexpr unsigned FRESH = 0x4;
+
+    ControlData buffers[3];
+
+    // index of buffer exchanged between sides with FRESH flag, kept away from
+    // private indexes to avoid false sharing between writer and reader
+    char paddingBefore[64];
+    std::atomic<unsigned> middle;
+    char paddingAfter[64];
+
+    unsigned back; // writer
+    char paddingBack[64];
+    unsigned front; // reader
+};
+
+#endif // CONTROLDATASLOT_HPP
@@ -9,6 +9,8 @@
 
 #include "communication/CalibrationSettings.hpp"
 
+#include "SkyLinkQuality.hpp"
+
 #include <string>
 
 /**
@@ -130,15 +132,19 @@ private:
     const unsigned ping;
     const unsigned received;
     const unsigned fails;
+    const SkyLinkQuality::Figures linkQuality;
 
 public:
     DeviceEventConnectionStatus(const unsigned _ping,
                                 const unsigned _received,
-                                const unsigned _fails);
+                                const unsigned _fails,
+                                const SkyLinkQuality::Figures& _linkQuality = SkyLinkQuality::Figures());
 
+    // half of last round trip time [ms]
     unsigned getPing(void) const;
     unsigned getReceived(void) const;
     unsigned getFails(void) const;
+    const SkyLinkQuality::Figures& getLinkQuality(void) const;
 
     std::string toString(void) const;
 };
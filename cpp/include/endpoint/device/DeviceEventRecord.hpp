@@ -0,0 +1,149 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef DEVICEEVENTRECORD_HPP
+#define DEVICEEVENTRECORD_HPP
+
+#include "DeviceEvent.hpp"
+#include "SkyError.hpp"
+
+#include "communication/IMessage.hpp"
+#include "communication/ControlData.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/SensorsData.hpp"
+#include "communication/AutopilotData.hpp"
+#include "communication/SignalData.hpp"
+#include "communication/CalibrationSettings.hpp"
+
+#include <memory>
+#include <string>
+
+class SkyDevice;
+
+// size of largest of given types
+template <typename... Types>
+struct MaxSizeOf
+{
+    static constexpr size_t value = 0;
+};
+
+template <typename Type, typename... Types>
+struct MaxSizeOf<Type, Types...>
+{
+    static constexpr size_t value = sizeof(Type) > MaxSizeOf<Types...>::value ?
+                sizeof(Type) : MaxSizeOf<Types...>::value;
+};
+
+/**
+ * =============================================================================================
+ * DeviceEventRecord
+ * Value type equivalent of DeviceEvent class hierarchy, tagged by DeviceEvent::Type.
+ * Received and sent messages are copied into record: control, telemetry and signal
+ * messages are kept inline, so records of flight loop traffic never allocate,
+ * signal payload messages (settings, routes) are cloned on heap and shared between copies.
+ * Record carries device which emitted it, taken from OriginScope of creating thread.
+ * =============================================================================================
+ */
+class DeviceEventRecord
+{
+public:
+    // records created by thread while scope exists are emitted by origin,
+    // SkyDevice opens it while processing its mailbox, scopes can be nested
+    class OriginScope
+    {
+    public:
+        OriginScope(const SkyDevice* const origin);
+        ~OriginScope(void);
+
+        OriginScope(const OriginScope&) = delete;
+        OriginScope& operator=(const OriginScope&) = delete;
+
+    private:
+        const SkyDevice* const previous;
+    };
+
+    DeviceEventRecord(void);
+    DeviceEventRecord(const DeviceEvent::Type _type);
+
+    // DATA_RECEIVED or DATA_SENT
+    DeviceEventRecord(const DeviceEvent::Type _type, const IMessage& _message);
+
+    // MESSAGE
+    DeviceEventRecord(const DeviceEventMessage::MessageType _textType, const std::string& _text);
+
+    // MESSAGE of ERROR type, text is formatted when it is read
+    DeviceEventRecord(const SkyError& _error);
+
+    // CONNECTION_STATUS
+    DeviceEventRecord(const unsigned _ping, const unsigned _received, const unsigned _fails,
+                      const SkyLinkQuality::Figures& _linkQuality = SkyLinkQuality::Figures());
+
+    // WHO_AM_I or UPGRADE_STARTED
+    DeviceEventRecord(const DeviceEvent::Type _type, const CalibrationSettings::BoardType _boardType);
+
+    DeviceEventRecord(const DeviceEventRecord& other);
+    DeviceEventRecord& operator=(const DeviceEventRecord& other);
+
+    ~DeviceEventRecord(void);
+
+    DeviceEvent::Type getType(void) const;
+
+    bool hasMessage(void) const;
+    const IMessage& getMessage(void) const;
+
+    DeviceEventMessage::MessageType getTextType(void) const;
+    const std::string& getText(void) const;
+
+    // NONE when event was not created from SkyError
+    const SkyError& getError(void) const;
+
+    unsigned getPing(void) const;
+    unsigned getReceived(void) const;
+    unsigned getFails(void) const;
+    const SkyLinkQuality::Figures& getLinkQuality(void) const;
+
+    CalibrationSettings::BoardType getBoardType(void) const;
+
+    // device which emitted event, nullptr when record was created outside of OriginScope
+    const SkyDevice* getOrigin(void) const;
+
+    // heap allocated DeviceEvent for legacy ISkyDeviceMonitor::notifyDeviceEvent consumers
+    std::unique_ptr<const DeviceEvent> toDeviceEvent(void) const;
+
+    std::string toString(void) const;
+
+private:
+    static constexpr size_t INLINE_CAPACITY =
+            MaxSizeOf<ControlData, DebugData, SensorsData, AutopilotData, SignalData>::value;
+
+    static thread_local const SkyDevice* currentOrigin;
+
+    DeviceEvent::Type type;
+    const SkyDevice* origin;
+
+    // message is placed in storage or held by heapMessage, nullptr when absent
+    const IMessage* message;
+    union
+    {
+        unsigned char storage[INLINE_CAPACITY];
+        double storageAlignment;
+    };
+    std::shared_ptr<const IMessage> heapMessage;
+
+    DeviceEventMessage::MessageType textType;
+    mutable std::string text;
+    SkyError error;
+
+    unsigned ping;
+    unsigned received;
+    unsigned fails;
+    SkyLinkQuality::Figures linkQuality;
+
+    CalibrationSettings::BoardType boardType;
+
+    void setMessage(const IMessage& source);
+    void setMessage(const DeviceEventRecord& source);
+    void resetMessage(void);
+};
+
+#endif // DEVICEEVENTRECORD_HPP
@@ -0,0 +1,67 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef DEVICEEVENTRING_HPP
+#define DEVICEEVENTRING_HPP
+
+#include "DeviceEventRecord.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/**
+ * =============================================================================================
+ * DeviceEventRing
+ * Bounded lock-free queue of DeviceEventRecord for many producers (devices) and
+ * single consumer (monitor thread). Records live in preallocated cells and are copied
+ * in and out, so publishing flight loop events does not allocate. Full ring rejects
+ * new records, number of rejected records is counted.
+ * =============================================================================================
+ */
+class DeviceEventRing
+{
+public:
+    // capacity is rounded up to power of two
+    DeviceEventRing(const size_t _capacity);
+    ~DeviceEventRing(void);
+
+    // any thread, returns false when ring is full
+    bool push(const DeviceEventRecord& record);
+
+    // consumer thread
+    bool pop(DeviceEventRecord& record);
+
+    // consumer thread, copies up to maxCount oldest records, returns their number
+    size_t drain(DeviceEventRecord* records, const size_t maxCount);
+
+    // approximate number of queued records
+    size_t size(void) const;
+
+    size_t getCapacity(void) const;
+    uint64_t getRejectedCount(void) const;
+
+private:
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        DeviceEventRecord record;
+    };
+
+    const size_t mask;
+    std::unique_ptr<Cell[]> cells;
+
+    // producers and consumer positions on separate cache lines
+    char paddingBefore[64];
+    std::atomic<size_t> enqueuePosition;
+    char paddingMiddle[64];
+    std::atomic<size_t> dequeuePosition;
+    char paddingAfter[64];
+
+    std::atomic<uint64_t> rejectedCount;
+
+    static size_t roundUpCapacity(const size_t capacity);
+};
+
+#endif // DEVICEEVENTRING_HPP
@@ -9,6 +9,11 @@
 #include "communication/IMessage.hpp"
 
 #include "DeviceEvent.hpp"
+#include "DeviceEventRecord.hpp"
+#include "DeviceEventRing.hpp"
+#include "SkyEventDelivery.hpp"
+#include "ControlDataSlot.hpp"
+#include "SkyTrace.hpp"
 #include "communication/ControlData.hpp"
 
 #include <string>
@@ -30,8 +35,80 @@ public:
 
     /**
      * notifyUavEvent
+     * Legacy heap event consumer, called by default record handler when event ring is disabled.
+     * Has to be overridden unless events are drained from event ring, default aborts
+     * when it is reached without event ring (events would be lost silently).
      */
-    virtual void notifyDeviceEvent(std::unique_ptr<const DeviceEvent> event) = 0;
+    virtual void notifyDeviceEvent(std::unique_ptr<const DeviceEvent> event);
+
+    /**
+     * notifyDeviceEvent
+     * Every device event is emitted as value record. By default record is published
+     * to batch delivery or event ring (when enabled) or converted to heap DeviceEvent.
+     */
+    virtual void notifyDeviceEvent(const DeviceEventRecord& event);
+
+    /**
+     * notifyDeviceEvents
+     * Batch of events handed by batch delivery, by default every event
+     * is converted to heap DeviceEvent.
+     */
+    virtual void notifyDeviceEvents(const DeviceEventRecord* events, const size_t count);
+
+    /**
+     * enableBatchDelivery
+     * Events are delivered in batches to notifyDeviceEvents, telemetry is coalesced
+     * when consumer is slow (see SkyEventDelivery). Batches are delivered in calls
+     * of deliverDeviceEvents or by dedicated thread (startBatchDelivery),
+     * has to be called before device is started.
+     */
+    void enableBatchDelivery(const size_t capacity = 1024, const size_t maxBatch = 64);
+
+    /**
+     * startBatchDelivery
+     * Starts dedicated thread calling notifyDeviceEvents as soon as events are published,
+     * instead of deliverDeviceEvents. Requires enableBatchDelivery.
+     */
+    void startBatchDelivery(void);
+
+    /**
+     * stopBatchDelivery
+     * Delivers pending events and joins delivery thread. Thread calls virtual
+     * notifyDeviceEvents, so derived monitor has to call it in its destructor,
+     * monitor destroyed with running delivery thread aborts.
+     */
+    void stopBatchDelivery(void);
+
+    /**
+     * deliverDeviceEvents
+     * Called by monitor thread, delivers all pending events, returns their number.
+     */
+    size_t deliverDeviceEvents(void);
+
+    /**
+     * getEventDelivery
+     * Batch delivery with its counters, nullptr when disabled.
+     */
+    const SkyEventDelivery* getEventDelivery(void) const;
+
+    /**
+     * enableEventRing
+     * Events are queued in bounded ring and drained by monitor thread in batches,
+     * has to be called before device is started.
+     */
+    void enableEventRing(const size_t capacity);
+
+    /**
+     * drainDeviceEvents
+     * Copies up to maxCount oldest queued events, returns their number.
+     */
+    size_t drainDeviceEvents(DeviceEventRecord* events, const size_t maxCount);
+
+    /**
+     * getRejectedEventsCount
+     * Events lost because event ring was full.
+     */
+    uint64_t getRejectedEventsCount(void) const;
 
     /**
      * getControlDataSendingFreq
@@ -40,9 +117,17 @@ public:
 
     /**
      * getControlDataToSend
+     * Called by control loop, push style monitors return getPushedControlData.
      */
     virtual ControlData getControlDataToSend(void) = 0;
 
+    /**
+     * pushControlData
+     * Push style source of control data, wait free, called by single input (joystick)
+     * thread. Values reach control loop when getControlDataToSend returns getPushedControlData.
+     */
+    void pushControlData(const ControlData& controlData);
+
     /**
      * createTimer
      */
@@ -50,8 +135,29 @@ public:
 
     /**
      * trace
+     * Receives formatted records of SkyTrace in calls of deliverTraces.
      */
     virtual void trace(const std::string& trace) = 0;
+
+    /**
+     * deliverTraces
+     * Called by monitor thread, formats pending SkyTrace records of all devices
+     * in process and passes them to trace, returns their number.
+     */
+    size_t deliverTraces(void);
+
+protected:
+    /**
+     * getPushedControlData
+     * Last value passed to pushControlData, default ControlData until first push.
+     */
+    ControlData getPushedControlData(void);
+
+private:
+    ControlDataSlot controlDataSlot;
+
+    std::unique_ptr<DeviceEventRing> eventRing;
+    std::unique_ptr<SkyEventDelivery> eventDelivery;
 };
 
 #endif // ISKYDIVEMONITOR_HPP
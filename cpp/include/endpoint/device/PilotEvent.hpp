@@ -50,6 +50,8 @@ public:
     Type getType(void) const;
 
     virtual std::string toString(void) const;
+
+    static std::string toString(const Type type);
 };
 
 class PilotEventConnect : public PilotEvent
@@ -0,0 +1,87 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYACTIONPOOL_HPP
+#define SKYACTIONPOOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <utility>
+#include <vector>
+
+class ISkyDeviceAction;
+
+/**
+ * =============================================================================================
+ * SkyActionPool
+ * Storage of device actions reused between transitions. Action is constructed in place
+ * in slot of its type, slot storage is allocated with first action of that type and kept,
+ * so after every action was performed once transitions do not allocate. Type gets more
+ * slots only when more its actions are alive at once (finishing one starts next one).
+ * Used only by device thread.
+ * =============================================================================================
+ */
+class SkyActionPool
+{
+public:
+    SkyActionPool(void);
+    ~SkyActionPool(void);
+
+    template <typename Action, typename... Args>
+    Action* create(Args&&... args)
+    {
+        const size_t index = acquire(getTypeKey<Action>(), sizeof(Action));
+#ifdef __SKYDIVE_NO_EXCEPTIONS__
+        Action* action = new (slots[index].storage) Action(std::forward<Args>(args)...);
+        slots[index].action = action;
+        return action;
+#else
+        try
+        {
+            Action* action = new (slots[index].storage) Action(std::forward<Args>(args)...);
+            slots[index].action = action;
+            return action;
+        }
+        catch (...)
+        {
+            slots[index].used = false;
+            throw;
+        }
+#endif // __SKYDIVE_NO_EXCEPTIONS__
+    }
+
+    // destroys action and frees its slot, action not created by pool is deleted
+    void release(ISkyDeviceAction* const action);
+
+    size_t getSlotsCount(void) const;
+    uint64_t getReusedCount(void) const;
+
+private:
+    // storage for any action of given type
+    struct Slot
+    {
+        const void* type;
+        void* storage;
+        ISkyDeviceAction* action;
+        bool used;
+    };
+
+    // enough for all action types, slot storage is never moved
+    static constexpr size_t SLOTS_CAPACITY = 32;
+
+    std::vector<Slot> slots;
+    uint64_t reusedCount;
+
+    // unique address for each action type
+    template <typename Action>
+    static const void* getTypeKey(void)
+    {
+        static const char key = 0;
+        return &key;
+    }
+
+    size_t acquire(const void* type, const size_t size);
+};
+
+#endif // SKYACTIONPOOL_HPP
@@ -8,17 +8,41 @@
 #include "PilotEvent.hpp"
 
 #include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/ISkyExecutor.hpp"
+#include "endpoint/SkyMailbox.hpp"
+#include "endpoint/SkyFreeList.hpp"
 #include "ISkyDeviceMonitor.hpp"
+#include "SkyTelemetryStore.hpp"
+#include "SkyLinkQuality.hpp"
+#include "SkyRateController.hpp"
+#include "SkyTransmitScheduler.hpp"
+#include "SkyReceptionStage.hpp"
+#include "SkyMetrics.hpp"
+#include "SkyActionPool.hpp"
 
 #include "actions/ISkyDeviceAction.hpp"
 
 #include "communication/CommDispatcher.hpp"
 
-#include <ctime>
 #include <memory>
-#include <mutex>
 #include <atomic>
+#include <vector>
+#include <unordered_map>
 
+/**
+ * =============================================================================================
+ * SkyDevice
+ * Device is an actor, every input (received bytes, pilot events, interface callbacks
+ * and timer ticks) is posted to lock-free mailbox. Mailbox is drained by thread that
+ * posted into empty mailbox, so action code never runs concurrently and needs no locks.
+ * When executor is given (e.g. SkyEventLoop), mailbox is drained only on executor thread.
+ * Constructor creates timers with monitor createTimer, so with SkyEventLoop timers device
+ * has to be created and destroyed on loop thread (or before loop runs), loop throws otherwise.
+ * Steady state flight loop (control, telemetry, ping) does not touch heap: mailbox items
+ * come from preallocated pool, flight messages are framed by value and frames wait
+ * in preallocated scheduler queues. Actions and their timers are reused between transitions.
+ * =============================================================================================
+ */
 class SkyDevice :
         public ISkyCommInterface::Listener,
         public ISkyDeviceAction::Listener
@@ -27,7 +51,9 @@ public:
     SkyDevice(ISkyDeviceMonitor* const _monitor,
                   const double _pingFreq,
                   const double _controlFreq,
-                  const double _connectionTimeout);
+                  const double _connectionTimeout,
+                  ISkyExecutor* const _executor = nullptr);
+    ~SkyDevice(void);
 
     /**
      * Sends event to ongoing UAV action. This is the main communication pipeline,
@@ -35,7 +61,8 @@ public:
      * If unexpected event will be pushed, communication will be broken
      * and UavEvent::ERROR_MESSAGE will be emmited by ISkyDiveUav interface.
      * Event should be dynamicaly allocated and will be deleted after processing.
-     * Calling this method is thread safe.
+     * Calling this method is thread safe, event is handled in order of posting
+     * (possibly by other thread, after this method returns).
      */
     void pushPilotEvent(const PilotEvent* const pilotEvent);
 
@@ -51,23 +78,161 @@ public:
      */
     ISkyDeviceAction::Type getState(void) const;
 
+    /**
+     * Latest telemetry received from UAV, can be polled from any thread
+     * without blocking reception (e.g. by UI or SkyFleetTelemetry).
+     */
+    const SkyTelemetryStore& getTelemetry(void) const;
+
+    /**
+     * Round trip time, its variance and ping loss rate measured by ping task.
+     * Figures can be read from any thread.
+     */
+    const SkyLinkQuality& getLinkQuality(void) const override;
+
+    /**
+     * Throughput of used link [B/s], signal timeouts include time of payload transmission
+     * and sent frames are paced to it. Has to be called before interface is connected.
+     */
+    void setLinkThroughput(const unsigned bytesPerSecond);
+
+    /**
+     * Enables adaptation of control send rate to link congestion during flight,
+     * telemetry rate changes are requested from UAV with SignalData::TELEMETRY_RATE,
+     * so board software has to support it. Has to be called before flight loop starts.
+     */
+    void enableRateControl(const SkyRateController::Settings& settings = SkyRateController::Settings());
+
+    const SkyRateController* getRateController(void) const override;
+
+    /**
+     * Counters of received messages: framed, coalesced stale telemetry and telemetry
+     * dropped because action changed. Can be read from any thread.
+     */
+    const SkyReceptionStage& getReceptionStage(void) const;
+
+    /**
+     * Frames and bytes per message type, reception failures, signal round trip times,
+     * action state dwell times and send queue depth, can be read from any thread
+     * (e.g. by SkyMetricsExporter).
+     */
+    const SkyMetrics& getMetrics(void) const;
+
 private:
+    // single input of device actor
+    struct MailboxItem : public SkyMailbox::Node
+    {
+        enum Type
+        {
+            RECEPTION,
+            PILOT_EVENT,
+            TIMER_TICK,
+            CONNECTED,
+            DISCONNECTED,
+            ERROR
+        };
+
+        static constexpr size_t CHUNK_CAPACITY = 256;
+
+        MailboxItem(const Type _type = RECEPTION);
+
+        Type type;
+
+        unsigned char data[CHUNK_CAPACITY];
+        size_t length;
+        bool endOfChunk; // last part of data received by interface at once
+
+        std::unique_ptr<const PilotEvent> pilotEvent;
+
+        unsigned timerId;
+        unsigned timerGeneration;
+
+        std::string message;
+    };
+
+    // timer created for actions, ticks are posted to mailbox and handled by executor,
+    // ticks posted before stop or restart are dropped by generation check
+    class MailboxTimer : public ISkyTimer
+    {
+    public:
+        MailboxTimer(SkyDevice* const _device, std::function<void(void)> _exec);
+        ~MailboxTimer(void);
+
+        void start(const double freqency) override;
+        void stop(void) override;
+
+        void fire(const unsigned _generation) const;
+
+        // released timer is reused by next action
+        void reset(std::function<void(void)> _exec);
+
+    private:
+        SkyDevice* const device;
+        const unsigned id;
+        std::unique_ptr<ISkyTimer> timer;
+        std::atomic<unsigned> generation;
+        bool running;
+    };
+
     // listener for events emitted from UAV
     ISkyDeviceMonitor* const monitor;
 
+    // optional thread owning device
+    ISkyExecutor* const executor;
+
     // used communication buffer
     ISkyCommInterface* interface;
 
-    // preformed UAV action, device state
-    // this is shared because when new action is starting
-    // we need to prevent it from beeing destructed if
-    // antoher thread is still working on this state
-    std::shared_ptr<ISkyDeviceAction> action;
-    std::mutex actionLock;
+    // inputs of actor and flag of thread that is draining them
+    SkyMailbox mailbox;
+    std::atomic<bool> draining;
+
+    // preallocated mailbox items, taken by posting threads and returned by draining thread
+    // through lock-free list of free indices, so posting never blocks on other poster,
+    // items are allocated on heap only when whole pool is in mailbox
+    static constexpr size_t ITEM_POOL_SIZE = 64;
+    std::unique_ptr<MailboxItem[]> itemPool;
+    SkyFreeList freeItems;
+
+    // timers alive, accessed only by executor
+    std::unordered_map<unsigned, MailboxTimer*> timers;
+    unsigned timersCounter;
+
+    // timers released by finished actions
+    std::vector<MailboxTimer*> idleTimers;
+
+    // preformed UAV action, device state, modified only by executor
+    SkyActionPool actionPool;
+    ISkyDeviceAction* action;
+
+    // action that is finishing is still on stack when it starts new action,
+    // replaced actions are released to pool after handling of mailbox item
+    std::vector<ISkyDeviceAction*> retiredActions;
+
+    // first error reported by actions while mailbox item is handled,
+    // handled after the item, when failed action is not on stack anymore
+    SkyError pendingError;
+
+    // action type cached for getState calls from other threads
+    std::atomic<ISkyDeviceAction::Type> state;
 
     // dispatcher for SkyDive Comm Protocol
     CommDispatcher dispatcher;
 
+    // messages framed from received chunk, waiting for handling
+    SkyReceptionStage receptionStage;
+
+    // latest telemetry messages, written only by executor
+    SkyTelemetryStore telemetry;
+
+    // written only by executor
+    SkyMetrics metrics;
+
+    // action state measured for dwell time, checked after each mailbox item
+    const char* dwellAction;
+    const char* dwellState;
+    SkyMetrics::Clock::time_point dwellStart;
+
     // timeing settings
     const double pingFreq, controlFreq;
     const double connectionTimeoutFreq;
@@ -76,32 +241,61 @@ private:
     std::unique_ptr<ISkyTimer> pingTimer;
     std::unique_ptr<ISkyTimer> connetionTimer;
 
-    // ping feature variables
-    int sentPingValue;
-    clock_t sentPingTime;
+    // ping feature variables, pings are numbered and matched by link quality estimator
+    int pingSequence;
+    SkyLinkQuality linkQuality;
+
+    // optional congestion control, updated with each ping result
+    std::unique_ptr<SkyRateController> rateController;
 
     // connection timeout variables
-    std::atomic<bool> receptionFeed;
-    std::atomic<bool> connectionLost;
+    bool receptionFeed;
+    bool connectionLost;
+
+    // frames waiting for link, pumped by transmit timer when they can not be sent at once
+    SkyTransmitScheduler transmitScheduler;
+    std::unique_ptr<ISkyTimer> transmitTimer;
+    bool transmitPending;
 
     // static buffer for building messages with ISignalPaylodData objects
     // allocated for memory menagment optimization
     unsigned char messageBuildingBuffer[IMessage::MAX_DATA_SIZE];
 
-    // notify methods, can be called from another thread so action
-    // has to be locked under shared pointer
-    void notifyPilotEvent(std::shared_ptr<ISkyDeviceAction> guard,
-                             const PilotEvent* const operatorEvent);
-    void notifyReception(std::shared_ptr<ISkyDeviceAction> guard,
-                         const IMessage* const message);
+    MailboxItem* acquireItem(const MailboxItem::Type type);
+    void releaseItem(MailboxItem* item);
+
+    // posts item to mailbox and drains it if no other thread is doing it
+    void post(MailboxItem* item);
+    void drain(void);
+    void process(const MailboxItem& item);
+    void handleItem(const MailboxItem& item);
+
+    void retireAction(void);
+    void releaseRetiredActions(void);
+
+    void notifyPilotEvent(const PilotEvent* const operatorEvent);
+    void notifyReception(const unsigned char* data, const size_t length, const bool endOfChunk);
+    void frameMessage(const IMessage::PreambleType preamble);
+    void stageMessage(const IMessage& message);
+    void handleReceptionStage(void);
+    void notifyReception(const IMessage& message);
 
     void handleError(const std::string& message);
+    void handleError(const SkyError& error);
+    void handleError(const DeviceEventRecord& errorEvent);
 
     void pingTimerHandler(void);
-    void handlePong(const SignalData& signalData) const;
+    void handlePong(const SignalData& signalData);
+    void updateRateController(void);
 
     void connectionTimerHandler(void);
 
+    void transmit(const SkyTransmitScheduler::Priority priority, const IMessage::MessageType type, const size_t length);
+    void pumpTransmission(void);
+    void updateSendQueueMetrics(void);
+
+    void updateStateDwell(void);
+
     // ISkyCommInterface::Listener overrides
     void onConnected(void) override;
     void onDisconnected(void) override;
@@ -110,9 +304,15 @@ private:
 
     // ISkyDeviceAction::Listener overrides
     ISkyDeviceMonitor* getMonitor(void) override;
+    ISkyTimer* createTimer(std::function<void(void)> exec) override;
+    void releaseTimer(ISkyTimer* timer) override;
     bool setupProtocolVersion(const unsigned version) override;
+    SkyActionPool& getActionPool(void) override;
     void startAction(ISkyDeviceAction* action, bool immediateStart = true) override;
     void onPongReception(const SignalData& pong) override;
+    void onSignalResponse(const SignalData::Command command,
+                          const std::chrono::steady_clock::duration roundTrip) override;
+    void onError(const SkyError& error) override;
     void send(const IMessage& message) override;
     void send(const ISignalPayloadMessage& message) override;
     void enablePingTask(bool enabled) override;
@@ -0,0 +1,147 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYERROR_HPP
+#define SKYERROR_HPP
+
+#include "communication/IMessage.hpp"
+
+#include <string>
+
+#ifndef __SKYDIVE_NO_EXCEPTIONS__
+#include <stdexcept>
+#endif // __SKYDIVE_NO_EXCEPTIONS__
+
+/**
+ * =============================================================================================
+ * SkyError
+ * Error of reception and action pipeline, passed by value instead of thrown exception.
+ * Error is code with static descriptor, names of action and state (static strings)
+ * and few numbers of detail, whose meaning is given by descriptor. Raising error
+ * does not build any string, text is formatted only when error is reported.
+ * Action reports error to its listener and returns, device handles it after ongoing
+ * mailbox item, same as exceptions were handled before.
+ * Build flags:
+ * __SKYDIVE_ERROR_EXCEPTIONS__ actions throw SkyError::Exception (std::runtime_error),
+ *                              so handlers are unwound at error as with exceptions,
+ * __SKYDIVE_NO_EXCEPTIONS__ for builds with -fno-exceptions, nothing is caught and
+ *                           broken invariants (raise) abort.
+ * =============================================================================================
+ */
+class SkyError
+{
+public:
+    enum Code
+    {
+        NONE,
+
+        // protocol errors, action is finished and link disconnected
+        UNEXPECTED_MESSAGE,
+        UNEXPECTED_SIGNAL_PARAMETER,
+        UNEXPECTED_PILOT_EVENT,
+        UNEXPECTED_TIMEOUT,
+        UNEXPECTED_ACTION,
+        UNSUPPORTED_PROTOCOL,
+        SIGNAL_TIMEOUT,
+        SIGNAL_PAYLOAD_RECEPTION,
+        SIGNAL_PAYLOAD_UPLOAD,
+        UNEXPECTED_PAYLOAD_TYPE,
+        ACTION_NOT_DONE,
+
+        // broken invariants, raised
+        INVALID_TRANSITION,
+        INVALID_EVENT_ACCESS,
+        NO_MESSAGE,
+        MESSAGE_NOT_COPIED,
+        FRAME_TOO_LONG,
+
+        CODES_COUNT
+    };
+
+    // meaning of detail numbers
+    enum Detail
+    {
+        NO_DETAIL,
+        MESSAGE, // value is message type, command and parameter of signal message
+        SIGNAL, // value is expected command, command and parameter of sent signal
+        COMMAND, // value is signal command
+        PARAMETER, // value is signal parameter
+        PILOT_EVENT, // value is pilot event type
+        ACTION, // value is action type
+        VALUE
+    };
+
+    struct Descriptor
+    {
+        Code code;
+        const char* name;
+        const char* text;
+        Detail detail;
+    };
+
+    class Exception;
+
+    SkyError(void);
+    SkyError(const Code _code, const int _value = 0, const int _command = 0, const int _parameter = 0);
+
+    // detail of received message
+    SkyError(const Code _code, const IMessage& message);
+
+    // action and state names have to be static strings
+    SkyError& at(const char* const _action, const char* const _state);
+
+    bool isError(void) const;
+
+    Code getCode(void) const;
+    const Descriptor& getDescriptor(void) const;
+
+    int getValue(void) const;
+    int getCommand(void) const;
+    int getParameter(void) const;
+
+    const char* getAction(void) const;
+    const char* getState(void) const;
+
+    // formats whole text, not for hot path
+    std::string toString(void) const;
+
+    // exception adapter, throws Exception, aborts when built without exceptions
+    [[noreturn]] void raise(void) const;
+
+    static const Descriptor& getDescriptor(const Code code);
+
+private:
+    static const Descriptor DESCRIPTORS[CODES_COUNT];
+
+    Code code;
+
+    const char* action;
+    const char* state;
+
+    int value;
+    int command;
+    int parameter;
+};
+
+#ifndef __SKYDIVE_NO_EXCEPTIONS__
+
+/**
+ * =============================================================================================
+ * SkyError::Exception
+ * SkyError thrown by raise, what() is formatted error text.
+ * =============================================================================================
+ */
+class SkyError::Exception : public std::runtime_error
+{
+public:
+    Exception(const SkyError& _error);
+
+    const SkyError& getError(void) const;
+
+private:
+    SkyError error;
+};
+
+#endif // __SKYDIVE_NO_EXCEPTIONS__
+
+#endif // SKYERROR_HPP
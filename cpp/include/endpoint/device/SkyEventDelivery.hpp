@@ -0,0 +1,117 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYEVENTDELIVERY_HPP
+#define SKYEVENTDELIVERY_HPP
+
+#include "DeviceEventRecord.hpp"
+#include "DeviceEventRing.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+class ISkyDeviceMonitor;
+
+/**
+ * =============================================================================================
+ * SkyEventDelivery
+ * Delivers device events to ISkyDeviceMonitor::notifyDeviceEvents in batches, publishing
+ * never blocks device thread for longer than short copy. Events are delivered in publish
+ * order of every device. Under backpressure (event ring filled above high watermark
+ * or overflowed) events wait in unbounded overflow list and telemetry is coalesced per
+ * device (DeviceEventRecord::getOrigin): queued DebugData, SensorsData and connection
+ * status are replaced in place by newer value of the same device, unless other event
+ * of that device was queued after them. Sent ControlData is dropped when ring is full.
+ * Any other event (state machine events, messages, settings) is never lost.
+ * Batches are delivered by deliver (monitor thread) or by own thread after start.
+ * =============================================================================================
+ */
+class SkyEventDelivery
+{
+public:
+    SkyEventDelivery(ISkyDeviceMonitor* const _monitor,
+                     const size_t capacity = 1024,
+                     const size_t _maxBatch = 64);
+    ~SkyEventDelivery(void);
+
+    // device side, any thread
+    void publish(const DeviceEventRecord& event);
+
+    // delivers all pending events in batches, returns their number
+    size_t deliver(void);
+
+    // dedicated delivery thread, controlled by monitor (ISkyDeviceMonitor::startBatchDelivery)
+    // and stopped by destructor of derived monitor
+    void start(void);
+    void stop(void);
+    bool isRunning(void) const;
+
+    uint64_t getPublishedCount(void) const;
+    uint64_t getDeliveredCount(void) const;
+    uint64_t getBatchesCount(void) const;
+    uint64_t getCoalescedCount(void) const;
+    uint64_t getDroppedCount(void) const;
+    uint64_t getOverflowCount(void) const;
+
+private:
+    enum Policy
+    {
+        KEEP,
+        DROPPABLE,
+        COALESCE_DEBUG_DATA,
+        COALESCE_SENSORS_DATA,
+        COALESCE_CONNECTION_STATUS
+    };
+
+    // queued telemetry kind of device
+    typedef std::pair<const SkyDevice*, Policy> CoalescingKey;
+
+    ISkyDeviceMonitor* const monitor;
+    const size_t maxBatch;
+    const size_t highWatermark;
+
+    DeviceEventRing ring;
+
+    // events that did not fit into ring, while not empty every event goes here,
+    // positions are counted from first event ever queued
+    std::mutex overflowMutex;
+    std::deque<DeviceEventRecord> overflow;
+    uint64_t overflowPopped;
+    std::atomic<bool> overflowing;
+    // position of latest queued telemetry of device and kind
+    std::map<CoalescingKey, uint64_t> coalescingPositions;
+    // position of latest queued event of device which is not coalesced
+    std::map<const SkyDevice*, uint64_t> keptPositions;
+
+    std::vector<DeviceEventRecord> batch;
+
+    std::thread thread;
+    std::mutex wakeMutex;
+    std::condition_variable wakeCondition;
+    std::atomic<bool> waiting;
+    std::atomic<bool> running;
+
+    std::atomic<uint64_t> publishedCount;
+    std::atomic<uint64_t> deliveredCount;
+    std::atomic<uint64_t> batchesCount;
+    std::atomic<uint64_t> coalescedCount;
+    std::atomic<uint64_t> droppedCount;
+    std::atomic<uint64_t> overflowCount;
+
+    static Policy getPolicy(const DeviceEventRecord& event);
+
+    void pushOverflow(const DeviceEventRecord& event, const Policy policy);
+
+    bool hasPending(void) const;
+    void wake(void);
+    void run(void);
+};
+
+#endif // SKYEVENTDELIVERY_HPP
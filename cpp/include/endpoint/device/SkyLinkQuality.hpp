@@ -0,0 +1,117 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYLINKQUALITY_HPP
+#define SKYLINKQUALITY_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyLinkQuality
+ * Round trip time estimator fed by ping / pong exchange, based on steady clock.
+ * Several pings can be outstanding, pong is matched by echoed value. Smoothed RTT,
+ * RTT variance and retransmission timeout follow RFC 6298 (SRTT, RTTVAR, RTO).
+ * Ping not answered within loss timeout is lost, loss rate is computed over
+ * sliding window of last resolved pings.
+ * Updated by device thread, figures can be read from any thread.
+ * =============================================================================================
+ */
+class SkyLinkQuality
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Settings
+    {
+        unsigned throughput; // link throughput [B/s], used to estimate transmission time
+        unsigned maxOutstanding; // pings waiting for pong, oldest is lost when exceeded
+        unsigned lossWindow; // number of last resolved pings used for loss rate, up to 64
+        Clock::duration lossTimeout; // ping without pong for that long is lost
+        Clock::duration minRto, maxRto, initialRto;
+
+        Settings(const unsigned _throughput = 11520,
+                 const unsigned _maxOutstanding = 16,
+                 const unsigned _lossWindow = 32,
+                 const Clock::duration _lossTimeout = std::chrono::seconds(2),
+                 const Clock::duration _minRto = std::chrono::milliseconds(50),
+                 const Clock::duration _maxRto = std::chrono::seconds(10),
+                 const Clock::duration _initialRto = std::chrono::seconds(1));
+    };
+
+    // consistent set of estimator outputs, times in microseconds
+    struct Figures
+    {
+        bool valid; // false until first RTT sample
+        uint32_t lastRtt;
+        uint32_t minRtt;
+        uint32_t smoothedRtt;
+        uint32_t rttVariance;
+        uint32_t rto;
+        float lossRate; // 0 - 1 over loss window
+        uint32_t outstanding;
+        uint32_t sent;
+        uint32_t answered;
+        uint32_t lost;
+
+        Figures(void);
+    };
+
+    SkyLinkQuality(const Settings& _settings = Settings());
+
+    // device thread
+    void onPingSent(const int value, const Clock::time_point time = Clock::now());
+    // returns false for unknown or already lost ping
+    bool onPongReceived(const int value, const Clock::time_point time = Clock::now());
+    // marks pings older than loss timeout as lost, returns their number
+    unsigned expire(const Clock::time_point time = Clock::now());
+    void reset(void);
+
+    // any thread
+    Figures getFigures(void) const;
+    Clock::duration getSmoothedRtt(void) const;
+    Clock::duration getRto(void) const;
+    float getLossRate(void) const;
+
+    // time needed to push given number of bytes through link, not included in RTT of ping
+    Clock::duration getTransmitTime(const unsigned bytes) const;
+    void setThroughput(const unsigned bytesPerSecond);
+
+private:
+    struct Ping
+    {
+        int value;
+        Clock::time_point time;
+        bool pending;
+    };
+
+    const Settings settings;
+    std::atomic<unsigned> throughput;
+
+    // circular buffer of pings in sending order
+    std::vector<Ping> pings;
+    size_t pingsHead;
+
+    // outcomes of last resolved pings, bit set when lost
+    uint64_t lossBits;
+    unsigned lossSamples;
+
+    // estimator state in seconds
+    bool hasSample;
+    double srtt, rttvar, rto;
+
+    // figures being updated by device thread and their copy for readers
+    Figures current;
+    mutable std::mutex figuresMutex;
+    Figures figures;
+
+    void resolve(const bool lost);
+    void sample(const Clock::duration rtt);
+    void publish(void);
+};
+
+#endif // SKYLINKQUALITY_HPP
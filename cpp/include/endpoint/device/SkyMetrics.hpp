@@ -0,0 +1,127 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYMETRICS_HPP
+#define SKYMETRICS_HPP
+
+#include "communication/IMessage.hpp"
+#include "communication/SignalData.hpp"
+
+#include "endpoint/SkyLatencyHistogram.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+/**
+ * =============================================================================================
+ * SkyMetrics
+ * Link and protocol metrics of single device: frames and bytes per message type
+ * and direction, reception failures by cause, round trip time of signals per command,
+ * dwell time of action states and depth of send queue.
+ * Metrics are written only by device thread, counters have single writer so they are
+ * updated with plain relaxed store, without locked instructions. Histograms are created
+ * at first sample of command or state, so steady flight loop does not allocate.
+ * Snapshot and histograms can be read from any thread (see SkyMetricsExporter).
+ * =============================================================================================
+ */
+class SkyMetrics
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum Direction
+    {
+        RECEIVED,
+        SENT,
+        DIRECTIONS_COUNT
+    };
+
+    static constexpr unsigned MESSAGE_TYPES_COUNT = IMessage::WIFI_CONFIGURATION + 1;
+    static constexpr unsigned COMMANDS_COUNT = SignalData::TELEMETRY_RATE - SignalData::START_CMD + 1;
+
+    // action states with dwell histogram, states above are not measured
+    static constexpr unsigned MAX_STATES = 128;
+
+    struct Snapshot
+    {
+        // signal payload is counted per frame when sent, once assembled when received
+        uint64_t frames[DIRECTIONS_COUNT][MESSAGE_TYPES_COUNT];
+        uint64_t bytes[DIRECTIONS_COUNT][MESSAGE_TYPES_COUNT];
+
+        uint64_t receivedBytes; // all bytes read from link, including not framed ones
+        uint64_t crcFailures;
+        uint64_t preambleCollisions;
+        uint64_t incompletePayloads;
+
+        uint64_t sendQueueFrames; // waiting in transmit scheduler
+        uint64_t sendQueueFramesMax;
+        uint64_t sendQueueBytes; // buffered by interface
+    };
+
+    struct StateDwell
+    {
+        const char* action;
+        const char* state;
+        const SkyLatencyHistogram* histogram;
+    };
+
+    SkyMetrics(void);
+    ~SkyMetrics(void);
+
+    SkyMetrics(const SkyMetrics&) = delete;
+    SkyMetrics& operator=(const SkyMetrics&) = delete;
+
+    // device thread
+    void onFrame(const Direction direction, const IMessage::MessageType type, const size_t length);
+    void onChunk(const size_t length);
+    void setReceptionFailures(const unsigned crc, const unsigned preamble, const unsigned payload);
+    void setSendQueue(const size_t frames, const size_t bytes);
+    void recordSignalRoundTrip(const SignalData::Command command, const Clock::duration duration);
+
+    // action and state names have to be static strings
+    void recordStateDwell(const char* const action, const char* const state, const Clock::duration duration);
+
+    // any thread
+    Snapshot getSnapshot(void) const;
+
+    // nullptr when signal was not measured
+    const SkyLatencyHistogram* getSignalRoundTrip(const SignalData::Command command) const;
+
+    unsigned getStatesCount(void) const;
+
+    // index below getStatesCount
+    StateDwell getStateDwell(const unsigned index) const;
+
+private:
+    struct StateSlot
+    {
+        const char* action;
+        const char* state;
+        SkyLatencyHistogram* histogram;
+    };
+
+    std::atomic<uint64_t> frames[DIRECTIONS_COUNT][MESSAGE_TYPES_COUNT];
+    std::atomic<uint64_t> bytes[DIRECTIONS_COUNT][MESSAGE_TYPES_COUNT];
+
+    std::atomic<uint64_t> receivedBytes;
+    std::atomic<uint64_t> crcFailures;
+    std::atomic<uint64_t> preambleCollisions;
+    std::atomic<uint64_t> incompletePayloads;
+
+    std::atomic<uint64_t> sendQueueFrames;
+    std::atomic<uint64_t> sendQueueFramesMax;
+    std::atomic<uint64_t> sendQueueBytes;
+
+    std::atomic<SkyLatencyHistogram*> signalRoundTrip[COMMANDS_COUNT];
+
+    // slots are filled by device thread and published by count
+    StateSlot states[MAX_STATES];
+    std::atomic<unsigned> statesCount;
+
+    static void add(std::atomic<uint64_t>& counter, const uint64_t value);
+    static void set(std::atomic<uint64_t>& counter, const uint64_t value);
+    static uint64_t toNanoseconds(const Clock::duration duration);
+};
+
+#endif // SKYMETRICS_HPP
@@ -0,0 +1,76 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYMETRICSEXPORTER_HPP
+#define SKYMETRICSEXPORTER_HPP
+
+#include "SkyMetrics.hpp"
+
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyMetricsExporter
+ * Formats metrics of devices in Prometheus text exposition format, every device is
+ * labeled with its name. Histograms are exported as summaries (quantiles in seconds).
+ * Text can be written to file (e.g. for node exporter textfile collector) or served
+ * on unix socket: every accepted connection gets whole text and is closed
+ * (socat - UNIX-CONNECT:path). Socket is non blocking and can be watched by SkyEventLoop:
+ * loop.watch(exporter.getFd(), EPOLLIN, [&](unsigned) { exporter.serve(); }).
+ * Formatting only reads metrics, so it never stalls device threads.
+ * =============================================================================================
+ */
+class SkyMetricsExporter
+{
+public:
+    SkyMetricsExporter(void);
+    ~SkyMetricsExporter(void);
+
+    // metrics have to outlive exporter or be removed
+    void add(const std::string& device, const SkyMetrics* const metrics);
+    void remove(const SkyMetrics* const metrics);
+
+    std::string format(void) const;
+
+    // text is written to temporary file and renamed, readers never see partial file
+    bool writeFile(const std::string& path) const;
+
+#ifdef __linux__
+
+    // creates listening unix socket, existing socket file is replaced
+    bool listen(const std::string& path);
+
+    // -1 when not listening
+    int getFd(void) const;
+
+    // serves all pending connections, returns their number
+    size_t serve(void);
+
+    void close(void);
+
+#endif // __linux__
+
+private:
+    struct Source
+    {
+        std::string device;
+        const SkyMetrics* metrics;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Source> sources;
+
+    int fd;
+    std::string socketPath;
+
+    static void formatSummary(std::string& text,
+                              const char* const name,
+                              const std::string& labels,
+                              const SkyLatencyHistogram& histogram);
+
+    static std::string escape(const std::string& value);
+};
+
+#endif // SKYMETRICSEXPORTER_HPP
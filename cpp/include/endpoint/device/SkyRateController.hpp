@@ -0,0 +1,81 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYRATECONTROLLER_HPP
+#define SKYRATECONTROLLER_HPP
+
+#include "SkyLinkQuality.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+
+/**
+ * =============================================================================================
+ * SkyRateController
+ * Additive increase / multiplicative decrease of control send rate and requested
+ * telemetry rate. Link is congested when RTT grows above minimal RTT (data waits in
+ * queues), ping is lost, reception CRC failures appear or send queue of interface grows.
+ * Rate is decreased at most once per smoothed RTT, so one congestion episode is
+ * reacted to once. Telemetry rate follows control rate proportionally.
+ * Updated by device thread, rates can be read from any thread.
+ * =============================================================================================
+ */
+class SkyRateController
+{
+public:
+    typedef SkyLinkQuality::Clock Clock;
+
+    struct Settings
+    {
+        double minControlRate, maxControlRate; // [Hz]
+        double minTelemetryRate, maxTelemetryRate; // [Hz]
+        double increaseStep; // [Hz] added to control rate on each update without congestion
+        double decreaseFactor; // control rate multiplier on congestion
+        double rttInflation; // RTT above minimal RTT times inflation means queueing
+        Clock::duration rttMargin; // RTT growth always tolerated (jitter)
+        double maxFailureRate; // part of failed receptions since last update
+        size_t maxQueueSize; // [B] waiting in interface send queue
+
+        Settings(const double _minControlRate = 5.0,
+                 const double _maxControlRate = 50.0,
+                 const double _minTelemetryRate = 2.0,
+                 const double _maxTelemetryRate = 50.0,
+                 const double _increaseStep = 1.0,
+                 const double _decreaseFactor = 0.7,
+                 const double _rttInflation = 2.0,
+                 const Clock::duration _rttMargin = std::chrono::milliseconds(20),
+                 const double _maxFailureRate = 0.05,
+                 const size_t _maxQueueSize = 512);
+    };
+
+    SkyRateController(const Settings& _settings, const double initialControlRate);
+
+    // device thread, received and failed are reception counters of dispatcher
+    void update(const SkyLinkQuality::Figures& linkQuality,
+                const unsigned received,
+                const unsigned failed,
+                const size_t queueSize,
+                const Clock::time_point time = Clock::now());
+
+    // any thread, [Hz]
+    double getControlRate(void) const;
+    double getTelemetryRate(void) const;
+
+    bool isCongested(void) const;
+    unsigned getDecreasesCount(void) const;
+
+private:
+    const Settings settings;
+
+    std::atomic<double> controlRate;
+    std::atomic<double> telemetryRate;
+    std::atomic<bool> congested;
+    std::atomic<unsigned> decreasesCount;
+
+    // counters at previous update
+    unsigned lastReceived, lastFailed, lastLost;
+    Clock::time_point lastDecrease;
+};
+
+#endif // SKYRATECONTROLLER_HPP
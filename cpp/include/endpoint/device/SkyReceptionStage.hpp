@@ -0,0 +1,75 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYRECEPTIONSTAGE_HPP
+#define SKYRECEPTIONSTAGE_HPP
+
+#include "DeviceEventRecord.hpp"
+
+#include "communication/IMessage.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyReceptionStage
+ * Messages framed from whole received chunk, before any of them is handled.
+ * Protocol messages (signals, autopilot, signal payloads) keep arrival order and
+ * are handled first. Latest-wins telemetry (DebugData of application and flight loops)
+ * is coalesced, only newest message is kept and handled after protocol messages,
+ * so burst of stale telemetry after link stall does not delay acknowledges or break
+ * commands. Every other message is kept in arrival order with protocol messages,
+ * SensorsData of sensors logger is recorded sample by sample and never coalesced.
+ * Messages are copied into DATA_RECEIVED records, flight loop messages are kept
+ * inline and storage is reused, so staging them never allocates.
+ * Used by device thread, counters can be read from any thread.
+ * =============================================================================================
+ */
+class SkyReceptionStage
+{
+public:
+    SkyReceptionStage(void);
+    ~SkyReceptionStage(void);
+
+    // message is copied
+    void push(const IMessage& message);
+
+    // next message to handle, protocol messages first, false when stage is empty
+    bool pop(DeviceEventRecord& record);
+
+    // telemetry and other control frames framed for action that is not performed anymore
+    void dropTelemetry(void);
+    void clear(void);
+
+    uint64_t getFramedCount(void) const;
+    uint64_t getCoalescedCount(void) const;
+    uint64_t getDroppedCount(void) const;
+
+private:
+    // latest-wins telemetry
+    enum Telemetry
+    {
+        DEBUG,
+        TELEMETRY_COUNT
+    };
+
+    // ordered messages framed from single chunk, usually only few,
+    // storage grows for sensors logger burst and is kept
+    static constexpr size_t ORDERED_CAPACITY = 16;
+
+    std::vector<DeviceEventRecord> ordered;
+    size_t orderedHead;
+
+    DeviceEventRecord latest[TELEMETRY_COUNT];
+    bool hasLatest[TELEMETRY_COUNT];
+
+    std::atomic<uint64_t> framedCount;
+    std::atomic<uint64_t> coalescedCount;
+    std::atomic<uint64_t> droppedCount;
+
+    static int getTelemetry(const IMessage& message);
+};
+
+#endif // SKYRECEPTIONSTAGE_HPP
@@ -0,0 +1,177 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYSCENARIO_HPP
+#define SKYSCENARIO_HPP
+
+#include "SkyDevice.hpp"
+#include "PilotEvent.hpp"
+#include "ISkyDeviceMonitor.hpp"
+#include "SkyError.hpp"
+
+#include "endpoint/ISkyCommInterface.hpp"
+#include "endpoint/SkyVirtualClock.hpp"
+
+#include "communication/CommDispatcher.hpp"
+#include "communication/IMessage.hpp"
+#include "communication/SignalData.hpp"
+
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyScenario
+ * Scripted run of device against simulated board, for action flows and their failure paths.
+ * Scenario is interface and monitor of its own device, timers run on SkyVirtualClock
+ * and device has no executor, so every step is handled synchronously. Script is list
+ * of steps: pilot events, messages received from board, expectations of sent frames,
+ * device events, errors and state. Expectation waits by jumping clock to next timer
+ * deadline until it is met, so signal timeouts and retransmissions of many seconds
+ * take microseconds. Expectation not met within wait limit (virtual time) fails scenario.
+ * Pings sent by device are answered by board, other sent frames are skipped
+ * by expectations, except signals which have to match expected one.
+ * Script is run once, scenario is not thread safe.
+ * =============================================================================================
+ */
+class SkyScenario :
+        private ISkyCommInterface,
+        private ISkyDeviceMonitor
+{
+public:
+    typedef SkyVirtualClock::Duration Duration;
+
+    SkyScenario(const double _pingFreq = 1.0,
+                const double _controlFreq = 25.0,
+                const double _connectionTimeout = 1.0);
+    ~SkyScenario(void);
+
+    // device connects to simulated board
+    SkyScenario& connectDevice(const ISkyDeviceAction::Type connectionType = ISkyDeviceAction::APP);
+
+    // event is pushed to device at its step
+    SkyScenario& pilot(const PilotEvent* const pilotEvent);
+    SkyScenario& pilot(const PilotEvent::Type type);
+
+    // board sends message, signal payload message is split into signal frames
+    SkyScenario& receive(const IMessage& message);
+
+    // board sends raw bytes (e.g. broken frame)
+    SkyScenario& receive(const unsigned char* data, const size_t length);
+
+    SkyScenario& advance(const Duration duration);
+
+    // next signal sent by device (pings excluded)
+    SkyScenario& expectSignal(const SignalData::Command command, const SignalData::Parameter parameter);
+
+    // next sent frame of message type, e.g. uploaded signal payload or control data
+    SkyScenario& expectSent(const IMessage::MessageType type);
+
+    SkyScenario& expectEvent(const DeviceEvent::Type type);
+    SkyScenario& expectError(const SkyError::Code code);
+    SkyScenario& expectState(const ISkyDeviceAction::Type state);
+
+    // maximal virtual time of waiting for expectation, 60 s by default
+    void setWaitLimit(const Duration limit);
+
+    // board answers pings by default, silent board lets connection timeout expire
+    void setPingAnswers(const bool enabled);
+
+    // runs script, false at first failed expectation
+    bool run(void);
+
+    // description of failed step, empty when scenario passed
+    const std::string& getFailure(void) const;
+
+    SkyDevice& getDevice(void);
+    SkyVirtualClock& getClock(void);
+
+    // every event emitted by device during run
+    const std::vector<DeviceEventRecord>& getEvents(void) const;
+
+private:
+    struct Step
+    {
+        enum Type
+        {
+            PILOT_EVENT,
+            RECEIVE,
+            ADVANCE,
+            EXPECT_SIGNAL,
+            EXPECT_SENT,
+            EXPECT_EVENT,
+            EXPECT_ERROR,
+            EXPECT_STATE
+        };
+
+        Type type;
+        std::unique_ptr<const PilotEvent> pilotEvent;
+        std::vector<unsigned char> data;
+        int value; // message type, event type, error code or state
+        SignalData::Command command;
+        SignalData::Parameter parameter;
+        Duration duration;
+
+        Step(const Type _type);
+    };
+
+    // frame sent by device, as parsed by board
+    struct Frame
+    {
+        IMessage::MessageType type;
+        SignalData::Command command; // also of signal payload message
+        SignalData::Parameter parameter;
+    };
+
+    SkyVirtualClock clock;
+    SkyDevice device;
+
+    std::vector<Step> steps;
+    Duration waitLimit;
+    bool pingAnswers;
+
+    bool connected;
+    CommDispatcher dispatcher;
+    std::vector<unsigned char> sentBytes;
+    std::deque<Frame> sentFrames;
+
+    std::vector<DeviceEventRecord> events;
+    size_t eventsHead; // events before head were consumed by expectations
+
+    size_t stepIndex;
+    std::string failure;
+
+    Step& addStep(const Step::Type type);
+
+    bool runStep(Step& step);
+
+    // advances clock to next deadlines until predicate is met or limit is reached
+    template <typename Predicate>
+    bool waitFor(Predicate predicate);
+
+    // pop sent frames until expected one, false when there is none yet
+    bool takeSignal(Frame& frame);
+    bool takeSent(const IMessage::MessageType type);
+    bool takeEvent(const Step& step);
+
+    // board frames bytes sent by device and answers pings
+    void parseSent(void);
+    void reply(const SignalData& signal);
+
+    bool fail(const std::string& text);
+
+    // ISkyCommInterface overrides
+    void connect(void) override;
+    void disconnect(void) override;
+    void send(const unsigned char* data, const size_t length) override;
+
+    // ISkyDeviceMonitor overrides
+    void notifyDeviceEvent(const DeviceEventRecord& event) override;
+    ControlData getControlDataToSend(void) override;
+    ISkyTimer* createTimer(std::function<void(void)> exec) override;
+    void trace(const std::string& trace) override;
+};
+
+#endif // SKYSCENARIO_HPP
@@ -0,0 +1,125 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYTELEMETRYSTORE_HPP
+#define SKYTELEMETRYSTORE_HPP
+
+#include "communication/IMessage.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/SensorsData.hpp"
+#include "communication/AutopilotData.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyTelemetryStore
+ * Latest DebugData, SensorsData and AutopilotData received from one device.
+ * Updated by device receive path (single writer), every slot is protected by seqlock,
+ * so any number of readers can poll it without blocking or slowing down the link thread.
+ * Payload is kept in serialized form in atomic words, readers rebuild messages from it.
+ * =============================================================================================
+ */
+class SkyTelemetryStore
+{
+public:
+    struct Snapshot
+    {
+        DebugData debugData;
+        SensorsData sensorsData;
+        AutopilotData autopilotData;
+
+        // reception time of each message [ns, steady clock], 0 if not received yet
+        int64_t debugDataTime;
+        int64_t sensorsDataTime;
+        int64_t autopilotDataTime;
+
+        Snapshot(void);
+    };
+
+    SkyTelemetryStore(void);
+
+    // receive path, messages of other types are ignored
+    void update(const IMessage& message);
+
+    // readers, return false if message was not received yet
+    bool read(DebugData& debugData) const;
+    bool read(SensorsData& sensorsData) const;
+    bool read(AutopilotData& autopilotData) const;
+
+    void read(Snapshot& snapshot) const;
+
+    // number of stored messages of all types, cheap change detection for pollers
+    uint64_t getUpdatesCount(void) const;
+
+private:
+    class Slot
+    {
+    public:
+        // messages are serialized from memory layout, which can be longer than frame
+        // (SensorsData in 64-bit builds)
+        static constexpr unsigned SIZE = ((sizeof(SensorsData) > IMessage::MAX_DATA_SIZE
+                                           ? sizeof(SensorsData) : IMessage::MAX_DATA_SIZE) + 7) & ~7u;
+
+        Slot(void);
+
+        void write(const IMessage& message, const int64_t time);
+
+        // data has to hold SIZE bytes
+        int64_t read(unsigned char* data) const;
+
+    private:
+        static constexpr unsigned WORDS = SIZE / 8;
+
+        std::atomic<unsigned> sequence;
+        std::atomic<int64_t> time;
+        std::atomic<uint64_t> words[WORDS];
+    };
+
+    Slot debugDataSlot;
+    Slot sensorsDataSlot;
+    Slot autopilotDataSlot;
+
+    std::atomic<uint64_t> updatesCount;
+};
+
+/**
+ * =============================================================================================
+ * SkyFleetTelemetry
+ * Registry of telemetry stores of many devices, fleet snapshot is written into one
+ * contiguous array of entries that can be reused between calls without allocation.
+ * Registration is guarded by mutex, device receive paths are never blocked by it.
+ * =============================================================================================
+ */
+class SkyFleetTelemetry
+{
+public:
+    struct Entry
+    {
+        unsigned deviceId;
+        SkyTelemetryStore::Snapshot snapshot;
+    };
+
+    void add(const unsigned deviceId, const SkyTelemetryStore* const store);
+    void remove(const unsigned deviceId);
+
+    // resizes entries to number of devices and fills them in order of registration
+    void snapshot(std::vector<Entry>& entries) const;
+
+    unsigned size(void) const;
+
+private:
+    struct Record
+    {
+        unsigned deviceId;
+        const SkyTelemetryStore* store;
+    };
+
+    mutable std::mutex mutex;
+    std::vector<Record> records;
+};
+
+#endif // SKYTELEMETRYSTORE_HPP
@@ -0,0 +1,195 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYTRACE_HPP
+#define SKYTRACE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <type_traits>
+
+// trace points below this level are not compiled in
+#ifndef __SKYDIVE_TRACE_LEVEL__
+#define __SKYDIVE_TRACE_LEVEL__ 0
+#endif // __SKYDIVE_TRACE_LEVEL__
+
+/**
+ * =============================================================================================
+ * SkyTrace
+ * Binary trace of device and actions. Trace point writes its id, level, timestamp and
+ * raw arguments (numbers, enum values, static strings) into ring of calling thread,
+ * text is formatted only by reader (see ISkyDeviceMonitor::deliverTraces).
+ * Each thread has own single producer ring, created at its first trace, after that
+ * writing takes no lock and does not allocate. Full ring drops new records, they are counted.
+ * Points below __SKYDIVE_TRACE_LEVEL__ are removed by compiler, points below level
+ * set in runtime cost one relaxed load, arguments are still evaluated.
+ * Strings passed as arguments have to outlive trace (literals, static names).
+ * =============================================================================================
+ */
+class SkyTrace
+{
+public:
+    enum Level
+    {
+        DEBUG,
+        INFO,
+        WARNING,
+        ERROR,
+        OFF
+    };
+
+    enum Point
+    {
+        // static text
+        TEXT,
+
+        // device
+        DEVICE_CONNECTED,
+        DEVICE_DISCONNECTED,
+        PILOT_EVENT,
+        INTERFACE_ERROR,
+        ACTION_ERROR,
+        PROTOCOL_VERSION,
+        ACTION_STARTED,
+        PING_TASK_STARTED,
+        PING_TASK_ENDED,
+        CONNECTION_TIMEOUT_TASK_STARTED,
+        CONNECTION_TIMEOUT_TASK_ENDED,
+
+        // actions
+        SIGNAL_RECEIVED,
+        SIGNAL_TIMEOUT_STARTED,
+        SIGNAL_PAYLOAD_RECEPTION,
+        SIGNAL_PAYLOAD_TIMEOUT,
+        SIGNAL_PAYLOAD_INVALID,
+        SIGNAL_PAYLOAD_REJECTED,
+        BREAK_COMMAND,
+        BREAK_STATE,
+        CONTROL_RATE,
+        TELEMETRY_RATE,
+        RADIO_CALIBRATION_ACK,
+
+        POINTS_COUNT
+    };
+
+    static constexpr size_t MAX_ARGUMENTS = 5;
+
+    union Argument
+    {
+        int64_t integer;
+        double real;
+        const char* text;
+    };
+
+    struct Record
+    {
+        uint64_t time; // [ns] since trace was started, raw clock ticks in ring
+        uint32_t thread; // number of thread in order of first trace
+        uint16_t point;
+        uint8_t level;
+        uint8_t count;
+        Argument arguments[MAX_ARGUMENTS];
+    };
+
+    // format of point text: %d integer, %f real, %s string,
+    // %C signal command, %P signal parameter, %E pilot event, %A action type, %M message type
+    struct Descriptor
+    {
+        Point point;
+        const char* name;
+        const char* format;
+    };
+
+    template <typename... Args>
+    static void debug(const Point point, const Args... args)
+    {
+        trace(DEBUG, point, args...);
+    }
+
+    template <typename... Args>
+    static void info(const Point point, const Args... args)
+    {
+        trace(INFO, point, args...);
+    }
+
+    template <typename... Args>
+    static void warning(const Point point, const Args... args)
+    {
+        trace(WARNING, point, args...);
+    }
+
+    template <typename... Args>
+    static void error(const Point point, const Args... args)
+    {
+        trace(ERROR, point, args...);
+    }
+
+    template <typename... Args>
+    static void trace(const Level level, const Point point, const Args... args)
+    {
+        static_assert(sizeof...(Args) <= MAX_ARGUMENTS, "SkyTrace: too many arguments");
+        if (level >= __SKYDIVE_TRACE_LEVEL__ && isEnabled(level))
+        {
+            // first element only makes array valid for points without arguments
+            const Argument arguments[] = {toArgument(0), toArgument(args)...};
+            write(level, point, arguments + 1, sizeof...(Args));
+        }
+    }
+
+    static bool isEnabled(const Level level)
+    {
+        return level >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    // runtime filter, INFO by default
+    static void setLevel(const Level level);
+    static Level getLevel(void);
+
+    // reader, copies up to maxCount oldest records of all threads (ordered per thread),
+    // single reader at a time
+    static size_t drain(Record* records, const size_t maxCount);
+
+    // records lost because ring of writing thread was full
+    static uint64_t getDroppedCount(void);
+
+    static std::string format(const Record& record);
+
+    static const Descriptor& getDescriptor(const Point point);
+    static const char* toString(const Level level);
+
+private:
+    static const Descriptor DESCRIPTORS[POINTS_COUNT];
+
+    static std::atomic<int> runtimeLevel;
+
+    template <typename Type>
+    static typename std::enable_if<std::is_integral<Type>::value || std::is_enum<Type>::value, Argument>::type
+    toArgument(const Type value)
+    {
+        Argument argument;
+        argument.integer = static_cast<int64_t>(value);
+        return argument;
+    }
+
+    template <typename Type>
+    static typename std::enable_if<std::is_floating_point<Type>::value, Argument>::type
+    toArgument(const Type value)
+    {
+        Argument argument;
+        argument.real = value;
+        return argument;
+    }
+
+    static Argument toArgument(const char* const value)
+    {
+        Argument argument;
+        argument.text = value;
+        return argument;
+    }
+
+    static void write(const Level level, const Point point, const Argument* arguments, const size_t count);
+};
+
+#endif // SKYTRACE_HPP
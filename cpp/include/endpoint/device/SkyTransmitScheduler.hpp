@@ -0,0 +1,125 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYTRANSMITSCHEDULER_HPP
+#define SKYTRANSMITSCHEDULER_HPP
+
+#include "communication/IMessage.hpp"
+
+#include "endpoint/ISkyCommInterface.hpp"
+
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyTransmitScheduler
+ * Frames waiting for link are kept in queue per priority class, highest class
+ * is always sent first, so control data and pings never wait behind signal payload
+ * transfer longer than transmission of single frame. Newer ControlData replaces
+ * queued one, only latest control is worth sending.
+ * Link bitrate is respected with token bucket, when bitrate is not set frames
+ * are passed while send queue of interface is short. Frames that can not be sent
+ * now are sent by pump, device calls it again after returned wait time.
+ * Queues are preallocated rings, they grow only when more frames wait than ever before.
+ * Used only by device thread.
+ * =============================================================================================
+ */
+class SkyTransmitScheduler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    enum Priority
+    {
+        CONTROL, // ControlData and ping
+        AUTOPILOT,
+        SIGNAL,
+        BULK, // frames of signal payload messages
+        PRIORITIES_COUNT
+    };
+
+    struct Settings
+    {
+        unsigned bitrate; // [B/s], 0 when not limited
+        unsigned burst; // [B] sent at once after idle time
+        size_t maxInterfaceQueue; // [B] buffered by interface, frames wait in scheduler above that
+
+        Settings(const unsigned _bitrate = 0,
+                 const unsigned _burst = IMessage::MAX_DATA_SIZE,
+                 const size_t _maxInterfaceQueue = IMessage::MAX_DATA_SIZE);
+    };
+
+    SkyTransmitScheduler(const Settings& _settings = Settings());
+
+    void setInterface(ISkyCommInterface* const _interface);
+    void setBitrate(const unsigned bitrate);
+
+    static Priority getPriority(const IMessage& message);
+
+    // frame is copied, returns true when frames wait for pump
+    bool send(const Priority priority,
+              const IMessage::MessageType type,
+              const unsigned char* data,
+              const size_t length,
+              const Clock::time_point time = Clock::now());
+
+    // sends as much as allowed, returns true when frames still wait, wait is time to next call
+    bool pump(Clock::duration& wait, const Clock::time_point time = Clock::now());
+
+    // drops all waiting frames (link disconnected)
+    void clear(void);
+
+    size_t getQueuedCount(const Priority priority) const;
+    uint64_t getSentCount(const Priority priority) const;
+    uint64_t getReplacedCount(void) const;
+
+private:
+    struct Frame
+    {
+        IMessage::MessageType type;
+        size_t length;
+        unsigned char data[IMessage::MAX_DATA_SIZE];
+    };
+
+    // ring of frames, storage is kept when frames are sent
+    class FrameQueue
+    {
+    public:
+        FrameQueue(const size_t capacity);
+
+        bool empty(void) const;
+        size_t size(void) const;
+
+        Frame& at(const size_t index);
+        Frame& front(void);
+
+        Frame& emplaceBack(void);
+        void popFront(void);
+        void clear(void);
+
+    private:
+        std::vector<Frame> frames;
+        size_t head;
+        size_t count;
+    };
+
+    Settings settings;
+
+    ISkyCommInterface* interface;
+
+    FrameQueue queues[PRIORITIES_COUNT];
+
+    // token bucket [B], may go below zero for frame bigger than available tokens
+    double tokens;
+    Clock::time_point lastRefill;
+
+    uint64_t sentCount[PRIORITIES_COUNT];
+    uint64_t replacedCount;
+
+    void refill(const Clock::time_point time);
+    bool hasQueued(void) const;
+};
+
+#endif // SKYTRANSMITSCHEDULER_HPP
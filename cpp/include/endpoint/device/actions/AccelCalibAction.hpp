@@ -4,11 +4,11 @@
 #ifndef ACCELCALIBACTION_HPP
 #define ACCELCALIBACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class AccelCalibAction : public ISkyDeviceAction
+class AccelCalibAction : public ISkyTableAction
 {
 public:
     AccelCalibAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -30,10 +31,21 @@ private:
         CALIBRATION_RECEPTION
     };
 
+    typedef SkyStateMachine<AccelCalibAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onCalibrationDone(const SkyActionEvent& event);
+    void onNonStatic(const SkyActionEvent& event);
+    void onCalibrationReceived(const SkyActionEvent& event);
 };
 
 #endif // ACCELCALIBACTION_HPP
@@ -4,15 +4,11 @@
 #ifndef APPACTION_HPP
 #define APPACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class PilotEventAction;
-class PilotEventUpload;
-class PilotEventDownload;
-
-class AppAction : public ISkyDeviceAction
+class AppAction : public ISkyTableAction
 {
 public:
     AppAction(Listener* const _listener);
@@ -25,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -34,14 +31,20 @@ private:
         APP_LOOP
     };
 
+    typedef SkyStateMachine<AppAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
 
-    void handleUserUavEventAction(const PilotEventAction& event);
-    void handleUserUavEventUpload(const PilotEventUpload& event);
-    void handleUserUavEventDownload(const PilotEventDownload& event);
+    void onUserEventAction(const SkyActionEvent& event);
+    void onUserEventUpload(const SkyActionEvent& event);
+    void onUserEventDownload(const SkyActionEvent& event);
 };
 
 #endif // APPACTION_HPP
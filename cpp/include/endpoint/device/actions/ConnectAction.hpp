@@ -4,13 +4,13 @@
 #ifndef CONNECTACTION_HPP
 #define CONNECTACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include "endpoint/ISkyCommInterface.hpp"
 
 #include <atomic>
 
-class ConnectAction : public ISkyDeviceAction
+class ConnectAction : public ISkyTableAction
 {
 public:
     ConnectAction(Listener* const _listener);
@@ -21,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -34,12 +35,28 @@ private:
         FINAL_COMMAND,
     };
 
+    typedef SkyStateMachine<ConnectAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
     bool wasNonStatic;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    bool isProtocolSupported(const SkyActionEvent& event);
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onProtocolVersion(const SkyActionEvent& event);
+    void onProtocolNotSupported(const SkyActionEvent& event);
+    void onCalibrationReady(const SkyActionEvent& event);
+    void onCalibrationNonStatic(const SkyActionEvent& event);
+    void onCalibrationReceived(const SkyActionEvent& event);
+    void onFinalAck(const SkyActionEvent& event);
 };
 
 #endif // CONNECTACTION_HPP
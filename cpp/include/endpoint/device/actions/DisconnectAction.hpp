@@ -4,11 +4,11 @@
 #ifndef DISCONNECTACTION_HPP
 #define DISCONNECTACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class DisconnectAction : public ISkyDeviceAction
+class DisconnectAction : public ISkyTableAction
 {
 public:
     DisconnectAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -28,10 +29,18 @@ private:
         DISCONNECTING
     };
 
+    typedef SkyStateMachine<DisconnectAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onBreakAck(const SkyActionEvent& event);
 };
 
 #endif // DISCONNECTACTION_HPP
@@ -4,11 +4,11 @@
 #ifndef DOWNLOADSIGNALPAYLOD_HPP
 #define DOWNLOADSIGNALPAYLOD_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class DownloadSignalPaylod : public ISkyDeviceAction
+class DownloadSignalPaylod : public ISkyTableAction
 {
 public:
     DownloadSignalPaylod(Listener* const _listener, const SignalData::Command _type);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     const SignalData::Command type;
@@ -32,13 +33,25 @@ private:
         DATA_RECEPTION
     };
 
+    typedef SkyStateMachine<DownloadSignalPaylod, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onFail(const SkyActionEvent& event);
+    void onDataReceived(const SkyActionEvent& event);
 
+    // DUMMY for unexpected payload type
     SignalData::Command getDownloadCommand(void) const;
     DeviceEvent::Type getMonitorFailEvent(void) const;
+    unsigned getExpectedPayloadSize(void) const;
 };
 
 #endif // DOWNLOADSIGNALPAYLOD_HPP
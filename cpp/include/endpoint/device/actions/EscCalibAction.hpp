@@ -4,11 +4,11 @@
 #ifndef ESCCALIB_HPP
 #define ESCCALIB_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class EscCalibAction : public ISkyDeviceAction
+class EscCalibAction : public ISkyTableAction
 {
 public:
     EscCalibAction(Listener* const _listener);
@@ -19,10 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
-
-protected:
-    void proceed(const Parameter userCommand);
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -38,13 +36,29 @@ private:
         FINAL_ESC_DISCONNECT_ACK
     };
 
+    typedef SkyStateMachine<EscCalibAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
     std::atomic<bool> breaking;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    bool isBreaking(const SkyActionEvent& event);
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onNotAllowed(const SkyActionEvent& event);
+    void onProceed(const SkyActionEvent& event);
+    void onFinalProceed(const SkyActionEvent& event);
+    void onStepDone(const SkyActionEvent& event);
+    void onConnectAck(const SkyActionEvent& event);
+    void onBreakAck(const SkyActionEvent& event);
+    void onFinalAck(const SkyActionEvent& event);
 };
 
 #endif // ESCCALIB_HPP
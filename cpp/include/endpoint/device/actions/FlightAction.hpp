@@ -4,7 +4,7 @@
 #ifndef FLIGHTACTION_HPP
 #define FLIGHTACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include "communication/AutopilotData.hpp"
 
@@ -12,7 +12,7 @@
 
 class PilotEventAutopilot;
 
-class FlightAction : public ISkyDeviceAction
+class FlightAction : public ISkyTableAction
 {
 public:
     FlightAction(Listener* const _listener, const double _controlFreq);
@@ -24,7 +24,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -34,19 +35,41 @@ private:
         BREAKING,
     };
 
+    typedef SkyStateMachine<FlightAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
+    // control rate change smaller than that does not restart control timer [Hz]
+    static constexpr double CONTROL_RATE_HYSTERESIS = 0.5;
+
     const double controlFreq;
 
+    // rates in use when rate control is enabled, 0 telemetry rate when not requested yet
+    double currentControlFreq;
+    int requestedTelemetryRate;
+
     std::atomic<State> state;
 
     ISkyTimer* controlTimer;
 
-    void handleReception(const IMessage& message) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    bool isBreak(const SkyActionEvent& event);
+    bool isBreakAck(const SkyActionEvent& event);
+
+    void onAutopilotReceived(const SkyActionEvent& event);
+    void onBreakRequested(const SkyActionEvent& event);
+    void onBrokenByBoard(const SkyActionEvent& event);
+    void onBreakAck(const SkyActionEvent& event);
+    void onAutopilotTarget(const SkyActionEvent& event);
 
-    void handleRunningReception(const IMessage& message);
     void handleAutopilotReception(const AutopilotData& message);
 
     void controlTaskHandler(void);
+    void adaptRates(void);
 
     void flightEnded(const bool byBoard);
 
@@ -4,11 +4,11 @@
 #ifndef FLIGHTINITIALIZATIONACTION_HPP
 #define FLIGHTINITIALIZATIONACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class FlightInitializationAction : public ISkyDeviceAction
+class FlightInitializationAction : public ISkyTableAction
 {
 public:
     FlightInitializationAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -31,10 +32,23 @@ private:
         ROUTE_RECEPTION
     };
 
+    typedef SkyStateMachine<FlightInitializationAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onNotAllowed(const SkyActionEvent& event);
+    void onControlsReceived(const SkyActionEvent& event);
+    void onRouteAllowed(const SkyActionEvent& event);
+    void onRouteNotAllowed(const SkyActionEvent& event);
+    void onRouteReceived(const SkyActionEvent& event);
 
     void flightReady(void);
 };
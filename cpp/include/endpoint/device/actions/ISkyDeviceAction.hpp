@@ -7,10 +7,16 @@
 #include "communication/IMessage.hpp"
 
 #include "endpoint/device/ISkyDeviceMonitor.hpp"
+#include "endpoint/device/SkyError.hpp"
+#include "endpoint/device/SkyActionPool.hpp"
+#include "endpoint/device/SkyLinkQuality.hpp"
+#include "endpoint/device/SkyRateController.hpp"
+#include "endpoint/device/SkyTrace.hpp"
 
 #include "endpoint/ISkyCommInterface.hpp"
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 
 class PilotEvent;
@@ -47,14 +53,36 @@ public:
 
         virtual ISkyDeviceMonitor* getMonitor(void) = 0;
 
+        // timers of actions have to be created by listener, so timeouts are
+        // serialized with other action inputs
+        virtual ISkyTimer* createTimer(std::function<void(void)> exec) = 0;
+
+        // timer is stopped and can be reused by next action
+        virtual void releaseTimer(ISkyTimer* timer) = 0;
+
         virtual bool setupProtocolVersion(const unsigned version) = 0;
 
+        // actions should be created in pool, finished action is released to it
+        virtual SkyActionPool& getActionPool(void) = 0;
         virtual void startAction(ISkyDeviceAction* action, bool immediateStart = true) = 0;
 
         virtual void onPongReception(const SignalData& pong) = 0;
 
+        // response to signal sent by sendSignal, for link metrics
+        virtual void onSignalResponse(const SignalData::Command command,
+                                      const std::chrono::steady_clock::duration roundTrip) = 0;
+
+        // RTT estimate used to compute signal timeouts
+        virtual const SkyLinkQuality& getLinkQuality(void) const = 0;
+
+        // adaptive flight loop rates, nullptr when rate control is disabled
+        virtual const SkyRateController* getRateController(void) const = 0;
+
         virtual void onError(const std::string& message) = 0;
 
+        // error of action, handled after ongoing input of device
+        virtual void onError(const SkyError& error) = 0;
+
         virtual void send(const IMessage& message) = 0;
         virtual void send(const ISignalPayloadMessage& message) = 0;
 
@@ -71,7 +99,7 @@ public:
     virtual void start(void) = 0;
     virtual void end(void);
 
-    void baseHandleReception(std::unique_ptr<const IMessage> message);
+    void baseHandleReception(const IMessage& message);
 
     virtual void handleReception(const IMessage& message) = 0;
     virtual void handleUserEvent(const PilotEvent& event);
@@ -82,14 +110,21 @@ public:
 
     virtual Type getType(void) const = 0;
 
-    virtual std::string getStateName(void) const = 0;
+    // static name, never fails
+    virtual const char* getStateName(void) const = 0;
 
     std::string getName(void) const;
 
-    static std::string toString(const Type type);
+    // static name, "UNKNOWN" for unexpected type
+    static const char* toString(const Type type);
 
 protected:
-    static constexpr unsigned DEFAULT_SIGNAL_TIMEOUT = 3000; // [ms]
+    // signal timeout is RTO of link plus payload transmission time, doubled on each retry,
+    // timeout given explicitly is lower bound (time that UAV needs to process command)
+    static constexpr unsigned ADAPTIVE_SIGNAL_TIMEOUT = 0; // [ms]
+    static constexpr unsigned DEFAULT_SIGNAL_TIMEOUT = 3000; // [ms] used until RTT is measured
+    static constexpr unsigned MIN_SIGNAL_TIMEOUT = 250; // [ms]
+    static constexpr unsigned MAX_SIGNAL_TIMEOUT = 30000; // [ms]
     static constexpr unsigned MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS = 3; // [ms]
 
     typedef SignalData::Command Command;
@@ -104,30 +139,51 @@ protected:
     std::atomic<bool> wasSignalPayloadReceptionProcedure;
 
     SignalData sentSignal;
+    std::chrono::steady_clock::time_point sentSignalTime;
     Command expectedSignalCommand;
 
     Command receivedSignalPayload;
+    unsigned receivedSignalPayloadSize;
     unsigned receptionErrors;
 
     ISkyTimer* signalTimer;
 
     void baseHandleTimeout(void);
 
+    // next action constructed in pool of listener, passed to listener->startAction
+    template <typename Action, typename... Args>
+    Action* createAction(Args&&... args) const
+    {
+        return listener->getActionPool().create<Action>(listener, std::forward<Args>(args)...);
+    }
+
     virtual void handleReception(const SignalData& message);
     virtual void handleSignalReception(const Parameter parameter);
     virtual void handleTimeout(void);
 
     void sendSignal(const Command command, const Parameter parameter,
-                    const unsigned timeout = DEFAULT_SIGNAL_TIMEOUT);
+                    const unsigned timeout = ADAPTIVE_SIGNAL_TIMEOUT);
     void startSignalTimeout(const Command expectedCommand,
-                            const unsigned timeout = DEFAULT_SIGNAL_TIMEOUT);
-    void startSignalTimeoutTimer(const unsigned timeout = DEFAULT_SIGNAL_TIMEOUT);
+                            const unsigned timeout = ADAPTIVE_SIGNAL_TIMEOUT);
+    void startSignalTimeoutTimer(const unsigned timeout);
+
+    // [ms], payloadSize is data size of signal payload message transfered before response,
+    // attempt is number of retries already done
+    unsigned getSignalTimeout(const unsigned timeout,
+                              const unsigned payloadSize = 0,
+                              const unsigned attempt = 0) const;
 
     void endSignalTimeout(void);
 
-    void initializeSignalPayloadReception(const SignalData::Command& command);
+    // payloadSize of expected data, 0 when not known
+    void initializeSignalPayloadReception(const SignalData::Command& command,
+                                          const unsigned payloadSize = 0);
     bool handleSignalPayloadReception(const IMessage& message);
 
+    // message is copied into event, caller keeps ownership
+    void notifyReceived(const IMessage& message) const;
+    void notifySent(const IMessage& message) const;
+
     void handleIdleReception(const IMessage& message) const;
 
     bool isPingMessage(const IMessage& received, int& value) const;
@@ -138,10 +194,11 @@ protected:
                          const SignalData::Parameter parameter,
                          const IMessage& received) const;
 
-    void except(const std::string& message) const;
-    void except(const std::string& message, const IMessage& received) const;
-    void except(const std::string& message, const PilotEvent& event) const;
-    void except(const std::string& message, const SignalData::Parameter parameter) const;
+    // error is reported to listener (or thrown with __SKYDIVE_ERROR_EXCEPTIONS__),
+    // handler should return after it, action is finished by device
+    void fail(SkyError error) const;
+    void fail(const SkyError::Code code, const int value = 0) const;
+    void fail(const SkyError::Code code, const IMessage& received) const;
 };
 
 #endif // ISKYDEVICEACTION_HPP
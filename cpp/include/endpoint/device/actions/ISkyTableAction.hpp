@@ -0,0 +1,47 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef ISKYTABLEACTION_HPP
+#define ISKYTABLEACTION_HPP
+
+#include "ISkyDeviceAction.hpp"
+#include "SkyActionEvent.hpp"
+#include "SkyStateMachine.hpp"
+
+/**
+ * =============================================================================================
+ * ISkyTableAction
+ * Action driven by SkyStateMachine transition table. Signal parameters, pilot events
+ * and received messages are dispatched to table of current state, input that does not
+ * match any transition is reported as unexpected. Effects and guards common for most
+ * of actions are provided here, so tables can refer them directly.
+ * =============================================================================================
+ */
+class ISkyTableAction : public ISkyDeviceAction
+{
+public:
+    ISkyTableAction(Listener* const _listener);
+
+    // Graphviz digraph of transition table
+    virtual std::string getStateGraph(void) const = 0;
+
+protected:
+    // returns false when event is not expected in current state
+    virtual bool dispatch(const SkyActionEvent& event) = 0;
+
+    void handleReception(const IMessage& message) override;
+    void handleSignalReception(const Parameter parameter) override;
+    void handleUserEvent(const PilotEvent& event) override;
+
+    // common effects
+    void onIdleReception(const SkyActionEvent& event);
+    void onReceived(const SkyActionEvent& event);
+    void onPong(const SkyActionEvent& event);
+
+    // common guards, signal payload reception is handled by guard, it fails until
+    // whole valid payload is received
+    bool isSignalPayloadReceived(const SkyActionEvent& event);
+    bool isPong(const SkyActionEvent& event);
+};
+
+#endif // ISKYTABLEACTION_HPP
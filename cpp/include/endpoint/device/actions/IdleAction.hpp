@@ -4,11 +4,11 @@
 #ifndef IDLEACTION_HPP
 #define IDLEACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 class PilotEventConnect;
 
-class IdleAction : public ISkyDeviceAction
+class IdleAction : public ISkyTableAction
 {
 public:
     IdleAction(Listener* const _listener);
@@ -19,13 +19,37 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
-    void handleReception(const IMessage& message) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    enum State
+    {
+        IDLE
+    };
 
-    void handleDirectFlightCommand(const PilotEventConnect& ev);
+    typedef SkyStateMachine<IdleAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
+    State state;
+
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    static const PilotEventConnect& getConnectEvent(const SkyActionEvent& event);
+
+    bool isAppConnection(const SkyActionEvent& event);
+    bool isUpgradeConnection(const SkyActionEvent& event);
+    bool isWhoAmIConnection(const SkyActionEvent& event);
+    bool isDirectFlightConnection(const SkyActionEvent& event);
+
+    void onAppConnect(const SkyActionEvent& event);
+    void onUpgradeConnect(const SkyActionEvent& event);
+    void onWhoAmIConnect(const SkyActionEvent& event);
+    void onDirectFlightConnect(const SkyActionEvent& event);
 };
 
 #endif // IDLEACTION_HPP
@@ -4,11 +4,11 @@
 #ifndef MAGNETCALIBACTION_HPP
 #define MAGNETCALIBACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class MagnetCalibAction : public ISkyDeviceAction
+class MagnetCalibAction : public ISkyTableAction
 {
 public:
     MagnetCalibAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -32,11 +33,24 @@ private:
         CALIBRATION_RECEPTION
     };
 
+    typedef SkyStateMachine<MagnetCalibAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onUserDone(const SkyActionEvent& event);
+    void onUserAbort(const SkyActionEvent& event);
+    void onCalibrationDone(const SkyActionEvent& event);
+    void onCalibrationFail(const SkyActionEvent& event);
+    void onSkipAck(const SkyActionEvent& event);
+    void onCalibrationReceived(const SkyActionEvent& event);
 };
 
 #endif // MAGNETCALIBACTION_HPP
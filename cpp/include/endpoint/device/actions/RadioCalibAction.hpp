@@ -4,11 +4,11 @@
 #ifndef RADIOCALIBACTION_HPP
 #define RADIOCALIBACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class RadioCalibAction : public ISkyDeviceAction
+class RadioCalibAction : public ISkyTableAction
 {
 public:
     RadioCalibAction(Listener* const _listener);
@@ -21,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -36,13 +37,35 @@ private:
         CALIBRATION_RECEPTION
     };
 
-    std::atomic<State> state;
+    typedef SkyStateMachine<RadioCalibAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    std::atomic<State> state;
 
     int current;
+
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    bool isLastChannel(const SkyActionEvent& event);
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onNotAllowed(const SkyActionEvent& event);
+    void onChannelDone(const SkyActionEvent& event);
+    void onChannelSkip(const SkyActionEvent& event);
+    void onBreak(const SkyActionEvent& event);
+    void onChannelAck(const SkyActionEvent& event);
+    void onChannelFail(const SkyActionEvent& event);
+    void onBreakAck(const SkyActionEvent& event);
+    void onCheckDone(const SkyActionEvent& event);
+    void onCheckSkip(const SkyActionEvent& event);
+    void onFinalAck(const SkyActionEvent& event);
+    void onFinalBreakFail(const SkyActionEvent& event);
+    void onFinalBreakAck(const SkyActionEvent& event);
+    void onCalibrationReceived(const SkyActionEvent& event);
 };
 
 #endif // RADIOCALIBACTION_HPP
@@ -4,11 +4,11 @@
 #ifndef RADIOCHECKACTION_HPP
 #define RADIOCHECKACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class RadioCheckAction : public ISkyDeviceAction
+class RadioCheckAction : public ISkyTableAction
 {
 public:
     RadioCheckAction(Listener* const _listener);
@@ -21,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -33,11 +34,22 @@ private:
         BREAKING
     };
 
+    typedef SkyStateMachine<RadioCheckAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onNotAllowed(const SkyActionEvent& event);
+    void onControlsReceived(const SkyActionEvent& event);
+    void onUserDone(const SkyActionEvent& event);
+    void onBreakAck(const SkyActionEvent& event);
 };
 
 #endif // RADIOCHECKACTION_HPP
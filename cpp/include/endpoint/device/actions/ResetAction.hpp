@@ -4,11 +4,11 @@
 #ifndef RESETACTION_HPP
 #define RESETACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class ResetAction : public ISkyDeviceAction
+class ResetAction : public ISkyTableAction
 {
 public:
     ResetAction(Listener* const _listener);
@@ -19,21 +19,28 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
     {
         IDLE,
-        INITIAL_COMMAND,
-        CALIBRATION,
-        CALIBRATION_RECEPTION
+        INITIAL_COMMAND
     };
 
+    typedef SkyStateMachine<ResetAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
 };
 
 #endif // RESETACTION_HPP
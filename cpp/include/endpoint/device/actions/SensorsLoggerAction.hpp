@@ -4,11 +4,11 @@
 #ifndef SENSORSLOGGERACTION_HPP
 #define SENSORSLOGGERACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class SensorsLoggerAction : public ISkyDeviceAction
+class SensorsLoggerAction : public ISkyTableAction
 {
 public:
     SensorsLoggerAction(Listener* const _listener);
@@ -21,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -32,11 +33,20 @@ private:
         BREAKING
     };
 
+    typedef SkyStateMachine<SensorsLoggerAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
-    void handleUserEvent(const PilotEvent& event) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onBreakRequested(const SkyActionEvent& event);
+    void onBreakAck(const SkyActionEvent& event);
 };
 
 #endif // SENSORSLOGGERACTION_HPP
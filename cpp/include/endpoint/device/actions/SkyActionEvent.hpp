@@ -0,0 +1,83 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYACTIONEVENT_HPP
+#define SKYACTIONEVENT_HPP
+
+#include "communication/IMessage.hpp"
+#include "communication/SignalData.hpp"
+
+#include "endpoint/device/PilotEvent.hpp"
+
+#include <string>
+
+/**
+ * =============================================================================================
+ * SkyActionEvent
+ * Input of action state machine: signal parameter, pilot event or received message.
+ * Each event has dense id used to index transition tables, ids of table rows are constant
+ * expressions. Signal parameters that are plain values (board type, protocol version)
+ * share one id, every kind has wildcard id matching any event of that kind.
+ * =============================================================================================
+ */
+class SkyActionEvent
+{
+public:
+    enum Kind
+    {
+        SIGNAL,
+        PILOT_EVENT,
+        MESSAGE
+    };
+
+    // ids are ordered by kind, last enumerators of SignalData::Parameter (from START),
+    // PilotEvent::Type and IMessage::MessageType bound ranges
+    static constexpr unsigned SIGNAL_VALUE = 0;
+    static constexpr unsigned ANY_SIGNAL =
+            SIGNAL_VALUE + 1 + SignalData::VIA_ROUTE_NOT_ALLOWED - SignalData::START + 1;
+    static constexpr unsigned ANY_PILOT_EVENT = ANY_SIGNAL + 1 + PilotEvent::RADIO_CALIBRATION_SKIP + 1;
+    static constexpr unsigned ANY_MESSAGE = ANY_PILOT_EVENT + 1 + IMessage::WIFI_CONFIGURATION + 1;
+    static constexpr unsigned EVENTS_COUNT = ANY_MESSAGE + 1;
+
+    static constexpr unsigned onSignal(const SignalData::Parameter parameter)
+    {
+        return SignalData::START <= parameter && SignalData::VIA_ROUTE_NOT_ALLOWED >= parameter ?
+                    SIGNAL_VALUE + 1 + parameter - SignalData::START : SIGNAL_VALUE;
+    }
+
+    static constexpr unsigned onPilotEvent(const PilotEvent::Type type)
+    {
+        return ANY_SIGNAL + 1 + type;
+    }
+
+    static constexpr unsigned onMessage(const IMessage::MessageType type)
+    {
+        return ANY_PILOT_EVENT + 1 + type;
+    }
+
+    explicit SkyActionEvent(const SignalData::Parameter _parameter);
+    explicit SkyActionEvent(const PilotEvent& _pilotEvent);
+    explicit SkyActionEvent(const IMessage& _message);
+
+    Kind getKind(void) const;
+    unsigned getId(void) const;
+
+    SignalData::Parameter getParameter(void) const;
+    const PilotEvent& getPilotEvent(void) const;
+    const IMessage& getMessage(void) const;
+
+    // wildcard of the same kind as event with given id
+    static unsigned getWildcard(const unsigned id);
+
+    static std::string getName(const unsigned id);
+
+private:
+    const Kind kind;
+    const unsigned id;
+
+    const SignalData::Parameter parameter;
+    const PilotEvent* const pilotEvent;
+    const IMessage* const message;
+};
+
+#endif // SKYACTIONEVENT_HPP
@@ -0,0 +1,152 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYSTATEMACHINE_HPP
+#define SKYSTATEMACHINE_HPP
+
+#include "SkyActionEvent.hpp"
+
+#include "endpoint/device/SkyError.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * =============================================================================================
+ * SkyStateMachine
+ * Transition table of action. Rows (state, event, guard, effect, next state) are declared
+ * once as constant array, state names are array indexed by state. Rows are linked into
+ * flat index [state][event] when table is created, so dispatch does not search rows.
+ * Rows of the same state and event are tried in declaration order, first one with guard
+ * passed is taken, rows of wildcard event are tried after exact ones. State is changed
+ * before effect is called, so effect may start next action or leave state by its own.
+ * =============================================================================================
+ */
+template <typename Action, typename State>
+class SkyStateMachine
+{
+public:
+    typedef bool (Action::*Guard)(const SkyActionEvent& event);
+    typedef void (Action::*Effect)(const SkyActionEvent& event);
+
+    // guard and effect can be nullptr
+    struct Transition
+    {
+        State state;
+        unsigned event;
+        Guard guard;
+        Effect effect;
+        State next;
+    };
+
+    template <size_t STATES_COUNT, size_t TRANSITIONS_COUNT>
+    SkyStateMachine(const char* const (&_stateNames)[STATES_COUNT],
+                    const Transition (&_transitions)[TRANSITIONS_COUNT]):
+        stateNames(_stateNames),
+        statesCount(STATES_COUNT),
+        transitions(_transitions),
+        transitionsCount(TRANSITIONS_COUNT),
+        first(STATES_COUNT * SkyActionEvent::EVENTS_COUNT, NONE),
+        following(TRANSITIONS_COUNT, NONE)
+    {
+        static_assert(TRANSITIONS_COUNT < NONE, "SkyStateMachine: too many transitions");
+        // linked from last row, so chains keep declaration order
+        for (size_t i = TRANSITIONS_COUNT; i-- > 0;)
+        {
+            const Transition& transition = transitions[i];
+            if ((size_t)transition.state >= statesCount || (size_t)transition.next >= statesCount
+                    || transition.event >= SkyActionEvent::EVENTS_COUNT)
+            {
+                SkyError(SkyError::INVALID_TRANSITION, (int)i).raise();
+            }
+            uint16_t& head = first[getIndex(transition.state, transition.event)];
+            following[i] = head;
+            head = (uint16_t)i;
+        }
+    }
+
+    // returns false when no transition matches event in current state
+    template <typename StateStorage>
+    bool dispatch(Action& action, StateStorage& state, const SkyActionEvent& event) const
+    {
+        const State current = state;
+        return fire(action, state, current, event.getId(), event)
+                || fire(action, state, current, SkyActionEvent::getWildcard(event.getId()), event);
+    }
+
+    // "UNKNOWN" for unexpected state
+    const char* getStateName(const State state) const
+    {
+        return (size_t)state < statesCount ? stateNames[state] : "UNKNOWN";
+    }
+
+    // Graphviz digraph of table, guarded transitions are dashed
+    std::string toDot(const std::string& name) const
+    {
+        std::string dot = "digraph " + name + " {\n";
+        for (size_t i = 0; i < statesCount; i++)
+        {
+            dot += "    \"" + std::string(stateNames[i]) + "\";\n";
+        }
+        for (size_t i = 0; i < transitionsCount; i++)
+        {
+            const Transition& transition = transitions[i];
+            dot += "    \"" + std::string(stateNames[transition.state]) + "\" -> \"" +
+                    std::string(stateNames[transition.next]) + "\" [label=\"" +
+                    SkyActionEvent::getName(transition.event) + "\"" +
+                    (nullptr != transition.guard ? ", style=dashed" : "") + "];\n";
+        }
+        return dot + "}\n";
+    }
+
+private:
+    static constexpr uint16_t NONE = 0xFFFF;
+
+    const char* const* const stateNames;
+    const size_t statesCount;
+
+    const Transition* const transitions;
+    const size_t transitionsCount;
+
+    // first row of [state][event] and next row of the same state and event
+    std::vector<uint16_t> first;
+    std::vector<uint16_t> following;
+
+    size_t getIndex(const State state, const unsigned event) const
+    {
+        return (size_t)state * SkyActionEvent::EVENTS_COUNT + event;
+    }
+
+    template <typename StateStorage>
+    bool fire(Action& action,
+              StateStorage& state,
+              const State current,
+              const unsigned event,
+              const SkyActionEvent& source) const
+    {
+        for (uint16_t i = first[getIndex(current, event)]; NONE != i; i = following[i])
+        {
+            const Transition& transition = transitions[i];
+            if (nullptr == transition.guard || (action.*transition.guard)(source))
+            {
+                // self transitions of flight loop do not touch (atomic) state
+                if (transition.next != current)
+                {
+                    state = transition.next;
+                }
+                if (nullptr != transition.effect)
+                {
+                    (action.*transition.effect)(source);
+                }
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+template <typename Action, typename State>
+constexpr uint16_t SkyStateMachine<Action, State>::NONE;
+
+#endif // SKYSTATEMACHINE_HPP
@@ -4,11 +4,11 @@
 #ifndef UPGRADEACTION_HPP
 #define UPGRADEACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class UpgradeAction : public ISkyDeviceAction
+class UpgradeAction : public ISkyTableAction
 {
 public:
     UpgradeAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -29,10 +30,20 @@ private:
         BOARD_VERSION,
     };
 
+    typedef SkyStateMachine<UpgradeAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onNotAllowed(const SkyActionEvent& event);
+    void onBoardVersion(const SkyActionEvent& event);
 };
 
 #endif // UPGRADEACTION_HPP
@@ -4,14 +4,16 @@
 #ifndef UPLOADSIGNALPAYLOAD_HPP
 #define UPLOADSIGNALPAYLOAD_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class UploadSignalPayload : public ISkyDeviceAction
+class UploadSignalPayload : public ISkyTableAction
 {
 public:
+    // takes ownership of data
     UploadSignalPayload(Listener* const _listener, const ISignalPayloadMessage& _data);
+    ~UploadSignalPayload(void);
 
     void start(void) override;
 
@@ -19,7 +21,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     const ISignalPayloadMessage& data;
@@ -32,13 +35,24 @@ private:
         UPLOAD
     };
 
+    typedef SkyStateMachine<UploadSignalPayload, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
     unsigned retransmissionCounter;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onInitialAck(const SkyActionEvent& event);
+    void onUploadAck(const SkyActionEvent& event);
+    void onUploadError(const SkyActionEvent& event);
 
+    // DUMMY for unexpected payload type
     SignalData::Command getUploadCommand(const IMessage::MessageType type) const;
 };
 
@@ -4,11 +4,11 @@
 #ifndef WHOAMIACTION_HPP
 #define WHOAMIACTION_HPP
 
-#include "ISkyDeviceAction.hpp"
+#include "ISkyTableAction.hpp"
 
 #include <atomic>
 
-class WhoAmIAction : public ISkyDeviceAction
+class WhoAmIAction : public ISkyTableAction
 {
 public:
     WhoAmIAction(Listener* const _listener);
@@ -19,7 +19,8 @@ public:
 
     Type getType(void) const override;
 
-    std::string getStateName(void) const override;
+    const char* getStateName(void) const override;
+    std::string getStateGraph(void) const override;
 
 private:
     enum State
@@ -28,10 +29,18 @@ private:
         INITIAL_COMMAND
     };
 
+    typedef SkyStateMachine<WhoAmIAction, State> StateMachine;
+
+    static const char* const STATE_NAMES[];
+    static const StateMachine::Transition TRANSITIONS[];
+
     std::atomic<State> state;
 
-    void handleReception(const IMessage& message) override;
-    void handleSignalReception(const Parameter parameter) override;
+    static const StateMachine& getStateMachine(void);
+
+    bool dispatch(const SkyActionEvent& event) override;
+
+    void onBoardType(const SkyActionEvent& event);
 };
 
 #endif // WHOAMIACTION_HPP
@@ -0,0 +1,349 @@
+#include "common/AccelCalibrationSolver.hpp"
+
+#ifdef __SKYDIVE_USE_STL__
+
+#include <fstream>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <stdlib.h>
+
+#endif //__SKYDIVE_USE_STL__
+
+AccelCalibrationSolver::AccelCalibrationSolver(const unsigned _windowSize,
+                                               const float _varianceThreshold,
+                                               const unsigned _minSegmentLength,
+                                               const float _gravity):
+    windowSize(_windowSize < 2 ? 2 : (_windowSize > MAX_WINDOW_SIZE ? MAX_WINDOW_SIZE : _windowSize)),
+    varianceThreshold(_varianceThreshold),
+    minSegmentLength(_minSegmentLength < windowSize ? windowSize : _minSegmentLength),
+    gravity(_gravity)
+{
+    reset();
+}
+
+void AccelCalibrationSolver::reset(void)
+{
+    windowCounter = 0;
+    windowFill = 0;
+    windowSum = Vect3Dd::zeros();
+    windowSqSum = Vect3Dd::zeros();
+
+    staticState = false;
+    segmentSum = Vect3Dd::zeros();
+    segmentLength = 0;
+
+    fit.reset();
+
+    samplesCount = 0;
+    segmentsCount = 0;
+    rejectedSegmentsCount = 0;
+    for (unsigned i = 0; i < ORIENTATIONS_COUNT; i++)
+    {
+        orientationSegments[i] = 0;
+    }
+
+    solved = false;
+    scale = Mat3Df::eye();
+    bias = Vect3Df::zeros();
+    residual = 0.0f;
+}
+
+void AccelCalibrationSolver::putSample(const Vect3Df& accel)
+{
+    samplesCount++;
+
+    // update sliding window running sums
+    if (windowFill == windowSize)
+    {
+        const Vect3Dd outgoing(window[windowCounter]);
+        windowSum = windowSum - outgoing;
+        windowSqSum = windowSqSum - outgoing * outgoing;
+    }
+    else
+    {
+        windowFill++;
+    }
+    const Vect3Dd incoming(accel);
+    window[windowCounter] = accel;
+    windowSum = windowSum + incoming;
+    windowSqSum = windowSqSum + incoming * incoming;
+    windowCounter++;
+    if (windowCounter >= windowSize)
+    {
+        windowCounter = 0;
+    }
+
+    bool nowStatic = false;
+    if (windowFill == windowSize)
+    {
+        const Vect3Dd mean = windowSum / (double)windowFill;
+        const Vect3Dd variance = windowSqSum / (double)windowFill - mean * mean;
+        nowStatic = variance.x < varianceThreshold
+                && variance.y < varianceThreshold
+                && variance.z < varianceThreshold;
+    }
+
+    if (nowStatic)
+    {
+        if (!staticState)
+        {
+            // whole window belongs to new segment
+            segmentSum = windowSum;
+            segmentLength = windowFill;
+        }
+        else
+        {
+            segmentSum = segmentSum + incoming;
+            segmentLength++;
+        }
+    }
+    else if (staticState)
+    {
+        closeSegment();
+    }
+    staticState = nowStatic;
+}
+
+void AccelCalibrationSolver::putSample(const ImuData& imuData)
+{
+    putSample(imuData.accel);
+}
+
+void AccelCalibrationSolver::flush(void)
+{
+    if (staticState)
+    {
+        closeSegment();
+        staticState = false;
+    }
+    windowCounter = 0;
+    windowFill = 0;
+    windowSum = Vect3Dd::zeros();
+    windowSqSum = Vect3Dd::zeros();
+}
+
+bool AccelCalibrationSolver::isStatic(void) const
+{
+    return staticState;
+}
+
+unsigned AccelCalibrationSolver::getSamplesCount(void) const
+{
+    return samplesCount;
+}
+
+unsigned AccelCalibrationSolver::getSegmentsCount(void) const
+{
+    return segmentsCount;
+}
+
+unsigned AccelCalibrationSolver::getRejectedSegmentsCount(void) const
+{
+    return rejectedSegmentsCount;
+}
+
+unsigned AccelCalibrationSolver::getOrientationSegmentsCount(const Orientation orientation) const
+{
+    return orientation < ORIENTATIONS_COUNT ? orientationSegments[orientation] : 0;
+}
+
+unsigned AccelCalibrationSolver::getCoveredOrientationsCount(void) const
+{
+    unsigned result = 0;
+    for (unsigned i = 0; i < ORIENTATIONS_COUNT; i++)
+    {
+        if (orientationSegments[i] > 0)
+        {
+            result++;
+        }
+    }
+    return result;
+}
+
+bool AccelCalibrationSolver::solve(void)
+{
+    solved = false;
+    if (getCoveredOrientationsCount() < MIN_ORIENTATIONS)
+    {
+        return false;
+    }
+
+    // each calibrated axis shares the same regressor, so single factorization solves all three
+    double p[4 * 3];
+    if (!fit.solve(p))
+    {
+        return false;
+    }
+    double sse = 0.0;
+    for (unsigned i = 0; i < 3; i++)
+    {
+        scale.mat[i * 3 + 0] = (float)p[i * 4 + 0];
+        scale.mat[i * 3 + 1] = (float)p[i * 4 + 1];
+        scale.mat[i * 3 + 2] = (float)p[i * 4 + 2];
+        bias(i + 1) = (float)p[i * 4 + 3];
+        sse += fit.getResidualSumOfSquares(i);
+    }
+    residual = (float)std::sqrt(sse / (3.0 * segmentsCount));
+    solved = scale.isNormal() && bias.isNormal();
+    return solved;
+}
+
+bool AccelCalibrationSolver::isSolved(void) const
+{
+    return solved;
+}
+
+const Mat3Df& AccelCalibrationSolver::getScale(void) const
+{
+    return scale;
+}
+
+const Vect3Df& AccelCalibrationSolver::getBias(void) const
+{
+    return bias;
+}
+
+float AccelCalibrationSolver::getResidual(void) const
+{
+    return residual;
+}
+
+Vect3Df AccelCalibrationSolver::apply(const Vect3Df& accelRaw) const
+{
+    return scale * accelRaw + bias;
+}
+
+void AccelCalibrationSolver::closeSegment(void)
+{
+    if (segmentLength >= minSegmentLength)
+    {
+        const Vect3Dd mean = segmentSum / (double)segmentLength;
+        Vect3Dd target;
+        Orientation orientation;
+        if (classify(mean, target, orientation))
+        {
+            const double x[4] = {mean.x, mean.y, mean.z, 1.0};
+            const double t[3] = {target.x, target.y, target.z};
+            fit.add(x, t);
+            orientationSegments[orientation]++;
+            segmentsCount++;
+        }
+        else
+        {
+            rejectedSegmentsCount++;
+        }
+    }
+    segmentSum = Vect3Dd::zeros();
+    segmentLength = 0;
+}
+
+bool AccelCalibrationSolver::classify(const Vect3Dd& mean, Vect3Dd& target, Orientation& orientation) const
+{
+    const double norm = mean.getNorm();
+    if (!(norm > 0.0))
+    {
+        return false;
+    }
+    unsigned axis;
+    const Vect3Dd absMean(std::fabs(mean.x), std::fabs(mean.y), std::fabs(mean.z));
+    const double dominant = absMean.max(axis);
+    if (dominant / norm < MIN_ALIGNMENT)
+    {
+        // tilted segment, target direction is not known
+        return false;
+    }
+    const bool up = mean(axis) > 0.0;
+    target = Vect3Dd::zeros();
+    target(axis) = up ? gravity : -gravity;
+    orientation = (Orientation)(2 * (axis - 1) + (up ? 0 : 1));
+    return true;
+}
+
+#ifdef __SKYDIVE_USE_STL__
+
+unsigned AccelCalibrationSolver::processLog(std::istream& stream)
+{
+    unsigned parsed = 0;
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        // time, omega (3), accel (3), magnet (3), pressure
+        const char* ptr = line.c_str();
+        char* end;
+        float values[7];
+        unsigned i = 0;
+        for (; i < 7; i++)
+        {
+            values[i] = strtof(ptr, &end);
+            if (end == ptr)
+            {
+                break;
+            }
+            ptr = end;
+        }
+        if (7 == i)
+        {
+            putSample(Vect3Df(values[4], values[5], values[6]));
+            parsed++;
+        }
+    }
+    flush();
+    return parsed;
+}
+
+unsigned AccelCalibrationSolver::processLogFile(const std::string& path)
+{
+    std::ifstream file(path);
+    if (!file.is_open())
+    {
+        return 0;
+    }
+    return processLog(file);
+}
+
+std::vector<AccelCalibrationSolver> AccelCalibrationSolver::calibrateLogFiles(const std::vector<std::string>& paths,
+                                                                              const AccelCalibrationSolver& prototype)
+{
+    std::vector<AccelCalibrationSolver> results(paths.size(), prototype);
+    std::atomic<unsigned> next(0);
+    auto worker = [&]()
+    {
+        for (unsigned i = next++; i < paths.size(); i = next++)
+        {
+            results[i].reset();
+            results[i].processLogFile(paths[i]);
+            results[i].solve();
+        }
+    };
+
+    const unsigned hardware = std::thread::hardware_concurrency();
+    const unsigned threadsCount = (unsigned)std::min<size_t>(paths.size(), hardware > 0 ? hardware : 1);
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < threadsCount; i++)
+    {
+        threads.push_back(std::thread(worker));
+    }
+    worker();
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    return results;
+}
+
+std::string AccelCalibrationSolver::toString(const Orientation orientation)
+{
+    switch (orientation)
+    {
+    case X_UP: return "X_UP";
+    case X_DOWN: return "X_DOWN";
+    case Y_UP: return "Y_UP";
+    case Y_DOWN: return "Y_DOWN";
+    case Z_UP: return "Z_UP";
+    case Z_DOWN: return "Z_DOWN";
+    default: return "UNKNOWN";
+    }
+}
+
+#endif //__SKYDIVE_USE_STL__
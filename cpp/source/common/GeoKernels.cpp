@@ -0,0 +1,535 @@
+#include "common/GeoKernels.hpp"
+
+#ifdef __SKYDIVE_USE_STL__
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#endif //__SKYDIVE_USE_STL__
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+static_assert(sizeof(Vect2Dd) == 2 * sizeof(double), "Vect2Dd has to be packed pair of doubles");
+
+namespace
+{
+constexpr double TWO_OVER_PI = 0.63661977236758134308;
+constexpr double PI_2_HI = 1.57079632673412561417; // pi/2 split for exact range reduction
+constexpr double PI_2_LO = 6.07710050650619224932e-11;
+constexpr double PI_2 = 1.57079632679489661923;
+constexpr double PI_4 = 0.78539816339744830962;
+constexpr double TAN_PI_8 = 0.41421356237309504880;
+constexpr double ROUND_MAGIC = 6755399441055744.0; // 1.5 * 2^52, rounds to nearest integer
+constexpr double DEG_TO_RAD = roboLib::pi / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / roboLib::pi;
+
+// sin and cos on |r| <= pi/4, Taylor series truncated below 2e-14
+inline double sinPoly(const double r, const double r2)
+{
+    return r * (1.0 + r2 * (-1.0 / 6.0 + r2 * (1.0 / 120.0 + r2 * (-1.0 / 5040.0 + r2 * (1.0 / 362880.0
+            + r2 * (-1.0 / 39916800.0 + r2 * (1.0 / 6227020800.0)))))));
+}
+
+inline double cosPoly(const double r2)
+{
+    return 1.0 + r2 * (-0.5 + r2 * (1.0 / 24.0 + r2 * (-1.0 / 720.0 + r2 * (1.0 / 40320.0
+            + r2 * (-1.0 / 3628800.0 + r2 * (1.0 / 479001600.0 + r2 * (-1.0 / 87178291200.0)))))));
+}
+
+inline void sinCos(const double x, double& s, double& c)
+{
+    const double k = (x * TWO_OVER_PI + ROUND_MAGIC) - ROUND_MAGIC;
+    const double r = (x - k * PI_2_HI) - k * PI_2_LO;
+    const double r2 = r * r;
+    const double sr = sinPoly(r, r2);
+    const double cr = cosPoly(r2);
+    const int q = (int)k;
+    const double ss = (q & 1) ? cr : sr;
+    const double cc = (q & 1) ? sr : cr;
+    s = (q & 2) ? -ss : ss;
+    c = ((q + 1) & 2) ? -cc : cc;
+}
+
+// atan series coefficients, on |u| <= tan(pi/8) truncated below 3e-13
+constexpr unsigned ATAN_ORDER = 14;
+constexpr double ATAN_COEFFS[ATAN_ORDER] = {
+    1.0, -1.0 / 3.0, 1.0 / 5.0, -1.0 / 7.0, 1.0 / 9.0, -1.0 / 11.0, 1.0 / 13.0,
+    -1.0 / 15.0, 1.0 / 17.0, -1.0 / 19.0, 1.0 / 21.0, -1.0 / 23.0, 1.0 / 25.0, -1.0 / 27.0
+};
+
+// atan on [0, 1]
+inline double atanUnit(const double t)
+{
+    const bool reduce = t > TAN_PI_8;
+    const double u = reduce ? (t - 1.0) / (t + 1.0) : t;
+    const double u2 = u * u;
+    double p = ATAN_COEFFS[ATAN_ORDER - 1];
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+    {
+        p = p * u2 + ATAN_COEFFS[k];
+    }
+    p *= u;
+    return reduce ? PI_4 + p : p;
+}
+
+inline double atan2Poly(const double y, const double x)
+{
+    const double ax = std::fabs(x);
+    const double ay = std::fabs(y);
+    const double mn = ax < ay ? ax : ay;
+    const double mx = ax < ay ? ay : ax;
+    double a = atanUnit(mn / (mx > 0.0 ? mx : 1.0));
+    a = ay > ax ? PI_2 - a : a;
+    a = x < 0.0 ? roboLib::pi - a : a;
+    return y < 0.0 ? -a : a;
+}
+
+// great circle distance from squared chord between unit vectors
+inline double chordToDistance(const double chord2)
+{
+    const double h2 = 0.25 * chord2;
+    const double h = std::sqrt(h2);
+    const double s = std::sqrt(h2 < 1.0 ? 1.0 - h2 : 0.0);
+    // h^2 + s^2 = 1, so max(h, s) is never below 1/sqrt(2)
+    const double a = atanUnit((h < s ? h : s) / (h < s ? s : h));
+    return 2.0 * roboLib::rEarth * (h > s ? PI_2 - a : a);
+}
+
+#if defined(__SSE2__)
+
+// two lane versions of kernels above, division and sqrt keep compiler from vectorizing scalar code
+inline __m128d select(const __m128d mask, const __m128d a, const __m128d b)
+{
+    return _mm_or_pd(_mm_and_pd(mask, a), _mm_andnot_pd(mask, b));
+}
+
+inline __m128d atanUnit(const __m128d t)
+{
+    const __m128d one = _mm_set1_pd(1.0);
+    const __m128d reduce = _mm_cmpgt_pd(t, _mm_set1_pd(TAN_PI_8));
+    const __m128d u = select(reduce, _mm_div_pd(_mm_sub_pd(t, one), _mm_add_pd(t, one)), t);
+    const __m128d u2 = _mm_mul_pd(u, u);
+    __m128d p = _mm_set1_pd(ATAN_COEFFS[ATAN_ORDER - 1]);
+    for (int k = ATAN_ORDER - 2; k >= 0; k--)
+    {
+        p = _mm_add_pd(_mm_mul_pd(p, u2), _mm_set1_pd(ATAN_COEFFS[k]));
+    }
+    p = _mm_mul_pd(p, u);
+    return _mm_add_pd(p, _mm_and_pd(reduce, _mm_set1_pd(PI_4)));
+}
+
+inline __m128d atan2Poly(const __m128d y, const __m128d x)
+{
+    const __m128d signMask = _mm_set1_pd(-0.0);
+    const __m128d zero = _mm_setzero_pd();
+    const __m128d ax = _mm_andnot_pd(signMask, x);
+    const __m128d ay = _mm_andnot_pd(signMask, y);
+    const __m128d mn = _mm_min_pd(ax, ay);
+    const __m128d mx = _mm_max_pd(ax, ay);
+    const __m128d safeMx = select(_mm_cmpgt_pd(mx, zero), mx, _mm_set1_pd(1.0));
+    __m128d a = atanUnit(_mm_div_pd(mn, safeMx));
+    a = select(_mm_cmpgt_pd(ay, ax), _mm_sub_pd(_mm_set1_pd(PI_2), a), a);
+    a = select(_mm_cmplt_pd(x, zero), _mm_sub_pd(_mm_set1_pd(roboLib::pi), a), a);
+    return select(_mm_cmplt_pd(y, zero), _mm_xor_pd(a, signMask), a);
+}
+
+inline __m128d chordToDistance(const __m128d chord2)
+{
+    const __m128d h2 = _mm_mul_pd(_mm_set1_pd(0.25), chord2);
+    const __m128d h = _mm_sqrt_pd(h2);
+    const __m128d s = _mm_sqrt_pd(_mm_max_pd(_mm_sub_pd(_mm_set1_pd(1.0), h2), _mm_setzero_pd()));
+    const __m128d a = atanUnit(_mm_div_pd(_mm_min_pd(h, s), _mm_max_pd(h, s)));
+    const __m128d angle = select(_mm_cmpgt_pd(h, s), _mm_sub_pd(_mm_set1_pd(PI_2), a), a);
+    return _mm_mul_pd(_mm_set1_pd(2.0 * roboLib::rEarth), angle);
+}
+
+#endif
+
+inline void unitDistances(const double px, const double py, const double pz,
+                          const double* ux, const double* uy, const double* uz, const unsigned count,
+                          double* result)
+{
+    unsigned i = 0;
+#if defined(__SSE2__)
+    const __m128d vpx = _mm_set1_pd(px), vpy = _mm_set1_pd(py), vpz = _mm_set1_pd(pz);
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d dx = _mm_sub_pd(_mm_loadu_pd(ux + i), vpx);
+        const __m128d dy = _mm_sub_pd(_mm_loadu_pd(uy + i), vpy);
+        const __m128d dz = _mm_sub_pd(_mm_loadu_pd(uz + i), vpz);
+        const __m128d chord2 = _mm_add_pd(_mm_add_pd(_mm_mul_pd(dx, dx), _mm_mul_pd(dy, dy)), _mm_mul_pd(dz, dz));
+        _mm_storeu_pd(result + i, chordToDistance(chord2));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const double dx = ux[i] - px;
+        const double dy = uy[i] - py;
+        const double dz = uz[i] - pz;
+        result[i] = chordToDistance(dx * dx + dy * dy + dz * dz);
+    }
+}
+
+inline void unitBearings(const double ex, const double ey, const double nx, const double ny, const double nz,
+                         const double* ux, const double* uy, const double* uz, const unsigned count,
+                         double* result)
+{
+    unsigned i = 0;
+#if defined(__SSE2__)
+    const __m128d vex = _mm_set1_pd(ex), vey = _mm_set1_pd(ey);
+    const __m128d vnx = _mm_set1_pd(nx), vny = _mm_set1_pd(ny), vnz = _mm_set1_pd(nz);
+    const __m128d zero = _mm_setzero_pd();
+    for (; i + 2 <= count; i += 2)
+    {
+        const __m128d x = _mm_loadu_pd(ux + i);
+        const __m128d y = _mm_loadu_pd(uy + i);
+        const __m128d z = _mm_loadu_pd(uz + i);
+        const __m128d east = _mm_add_pd(_mm_mul_pd(x, vex), _mm_mul_pd(y, vey));
+        const __m128d north = _mm_add_pd(_mm_add_pd(_mm_mul_pd(x, vnx), _mm_mul_pd(y, vny)), _mm_mul_pd(z, vnz));
+        const __m128d bearing = _mm_mul_pd(atan2Poly(east, north), _mm_set1_pd(RAD_TO_DEG));
+        _mm_storeu_pd(result + i, _mm_add_pd(bearing, _mm_and_pd(_mm_cmplt_pd(bearing, zero), _mm_set1_pd(360.0))));
+    }
+#endif
+    for (; i < count; i++)
+    {
+        const double east = ux[i] * ex + uy[i] * ey;
+        const double north = ux[i] * nx + uy[i] * ny + uz[i] * nz;
+        const double bearing = atan2Poly(east, north) * RAD_TO_DEG;
+        result[i] = bearing < 0.0 ? bearing + 360.0 : bearing;
+    }
+}
+
+#ifdef __SKYDIVE_USE_STL__
+
+// workers are started with first big batch and live until exit, batch is split into ranges
+// taken by workers and calling thread, one batch runs at a time
+class WorkerPool
+{
+public:
+    typedef void (*RangeFunction)(void* context, const unsigned begin, const unsigned end);
+
+    static WorkerPool& instance(void)
+    {
+        static WorkerPool pool;
+        return pool;
+    }
+
+    // returns false when there are no workers or another batch is running,
+    // then caller has to compute its batch serially
+    bool run(const unsigned count, const unsigned long work, RangeFunction function, void* context)
+    {
+        std::unique_lock<std::mutex> batchLock(batchMutex, std::try_to_lock);
+        if (workers.empty() || false == batchLock.owns_lock())
+        {
+            return false;
+        }
+        const unsigned participants = (unsigned)std::min<unsigned long>(
+                    std::min<unsigned long>(work / GeoKernels::PARALLEL_THRESHOLD + 1, workers.size() + 1),
+                    count > 0 ? count : 1);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            rangeFunction = function;
+            rangeContext = context;
+            rangeCount = count;
+            rangeStep = (count + participants - 1) / participants;
+            nextBegin.store(0, std::memory_order_relaxed);
+            pendingWorkers = (unsigned)workers.size();
+            generation++;
+        }
+        wake.notify_all();
+        process();
+        std::unique_lock<std::mutex> lock(mutex);
+        done.wait(lock, [this]() { return 0 == pendingWorkers; });
+        return true;
+    }
+
+private:
+    std::mutex batchMutex;
+    std::mutex mutex;
+    std::condition_variable wake;
+    std::condition_variable done;
+    std::vector<std::thread> workers;
+    bool stopping;
+
+    unsigned generation;
+    unsigned pendingWorkers;
+    RangeFunction rangeFunction;
+    void* rangeContext;
+    unsigned rangeCount;
+    unsigned rangeStep;
+    std::atomic<unsigned> nextBegin;
+
+    WorkerPool(void):
+        stopping(false),
+        generation(0),
+        pendingWorkers(0),
+        rangeFunction(nullptr),
+        rangeContext(nullptr),
+        rangeCount(0),
+        rangeStep(1),
+        nextBegin(0)
+    {
+        const unsigned hardware = std::thread::hardware_concurrency();
+        for (unsigned i = 1; i < hardware; i++)
+        {
+            workers.push_back(std::thread(&WorkerPool::worker, this));
+        }
+    }
+
+    ~WorkerPool(void)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& thread : workers)
+        {
+            thread.join();
+        }
+    }
+
+    void worker(void)
+    {
+        unsigned seen = 0;
+        std::unique_lock<std::mutex> lock(mutex);
+        while (true)
+        {
+            wake.wait(lock, [&]() { return stopping || seen != generation; });
+            if (stopping)
+            {
+                return;
+            }
+            seen = generation;
+            lock.unlock();
+            process();
+            lock.lock();
+            if (0 == --pendingWorkers)
+            {
+                done.notify_one();
+            }
+        }
+    }
+
+    void process(void)
+    {
+        while (true)
+        {
+            const unsigned begin = nextBegin.fetch_add(rangeStep, std::memory_order_relaxed);
+            if (begin >= rangeCount)
+            {
+                return;
+            }
+            rangeFunction(rangeContext, begin, std::min(rangeCount, begin + rangeStep));
+        }
+    }
+};
+
+template <class _Fn>
+void invokeRange(void* context, const unsigned begin, const unsigned end)
+{
+    (*static_cast<_Fn*>(context))(begin, end);
+}
+
+template <class _Fn>
+void parallelRange(const unsigned count, const unsigned long work, _Fn fn)
+{
+    if (work < GeoKernels::PARALLEL_THRESHOLD
+            || false == WorkerPool::instance().run(count, work, &invokeRange<_Fn>, &fn))
+    {
+        fn(0, count);
+    }
+}
+
+#else
+
+template <class _Fn>
+void parallelRange(const unsigned count, const unsigned long, _Fn fn)
+{
+    fn(0, count);
+}
+
+#endif //__SKYDIVE_USE_STL__
+}
+
+void GeoKernels::distances(const double lat0, const double lon0,
+                           const double* lat, const double* lon, const unsigned count,
+                           double* result)
+{
+    parallelRange(count, count, [&](const unsigned begin, const unsigned end)
+    {
+        distancesSerial(lat0, lon0, lat + begin, lon + begin, 1, end - begin, result + begin);
+    });
+}
+
+void GeoKernels::distances(const Vect2Dd& origin, const Vect2Dd* points, const unsigned count,
+                           double* result)
+{
+    parallelRange(count, count, [&](const unsigned begin, const unsigned end)
+    {
+        distancesSerial(origin.x, origin.y, &points[begin].x, &points[begin].y, 2, end - begin, result + begin);
+    });
+}
+
+void GeoKernels::bearings(const double lat0, const double lon0,
+                          const double* lat, const double* lon, const unsigned count,
+                          double* result)
+{
+    parallelRange(count, count, [&](const unsigned begin, const unsigned end)
+    {
+        bearingsSerial(lat0, lon0, lat + begin, lon + begin, 1, end - begin, result + begin);
+    });
+}
+
+void GeoKernels::bearings(const Vect2Dd& origin, const Vect2Dd* points, const unsigned count,
+                          double* result)
+{
+    parallelRange(count, count, [&](const unsigned begin, const unsigned end)
+    {
+        bearingsSerial(origin.x, origin.y, &points[begin].x, &points[begin].y, 2, end - begin, result + begin);
+    });
+}
+
+void GeoKernels::distanceMatrix(const double* lat, const double* lon, const unsigned count,
+                                double* result)
+{
+#ifdef __SKYDIVE_USE_STL__
+    // unit vectors are computed once and shared by all rows
+    std::vector<double> units(3 * (size_t)count);
+    double* ux = units.data();
+    double* uy = ux + count;
+    double* uz = uy + count;
+    toUnit(lat, lon, 1, count, ux, uy, uz);
+    parallelRange(count, (unsigned long)count * count, [&](const unsigned begin, const unsigned end)
+    {
+        for (unsigned i = begin; i < end; i++)
+        {
+            unitDistances(ux[i], uy[i], uz[i], ux, uy, uz, count, result + (size_t)i * count);
+        }
+    });
+#else
+    for (unsigned i = 0; i < count; i++)
+    {
+        distancesSerial(lat[i], lon[i], lat, lon, 1, count, result + i * count);
+    }
+#endif //__SKYDIVE_USE_STL__
+}
+
+unsigned GeoKernels::nearest(const double lat0, const double lon0,
+                             const double* lat, const double* lon, const unsigned count,
+                             double* distance)
+{
+    double ux[CHUNK_SIZE], uy[CHUNK_SIZE], uz[CHUNK_SIZE];
+    double px, py, pz;
+    toUnit(&lat0, &lon0, 1, 1, &px, &py, &pz);
+
+    // chord length is monotonic with distance, so only the winner is converted
+    unsigned best = NO_POINT;
+    double bestChord2 = 5.0;
+    for (unsigned offset = 0; offset < count; offset += CHUNK_SIZE)
+    {
+        const unsigned size = count - offset < CHUNK_SIZE ? count - offset : CHUNK_SIZE;
+        toUnit(lat + offset, lon + offset, 1, size, ux, uy, uz);
+        for (unsigned i = 0; i < size; i++)
+        {
+            const double dx = ux[i] - px;
+            const double dy = uy[i] - py;
+            const double dz = uz[i] - pz;
+            const double chord2 = dx * dx + dy * dy + dz * dz;
+            if (chord2 < bestChord2)
+            {
+                bestChord2 = chord2;
+                best = offset + i;
+            }
+        }
+    }
+    if (nullptr != distance && NO_POINT != best)
+    {
+        *distance = chordToDistance(bestChord2);
+    }
+    return best;
+}
+
+double GeoKernels::pathLength(const double* lat, const double* lon, const unsigned count)
+{
+    double ux[CHUNK_SIZE], uy[CHUNK_SIZE], uz[CHUNK_SIZE];
+    double result = 0.0;
+    // consecutive chunks overlap by one point
+    for (unsigned offset = 0; offset + 1 < count; offset += CHUNK_SIZE - 1)
+    {
+        const unsigned size = count - offset < CHUNK_SIZE ? count - offset : CHUNK_SIZE;
+        toUnit(lat + offset, lon + offset, 1, size, ux, uy, uz);
+        for (unsigned i = 1; i < size; i++)
+        {
+            const double dx = ux[i] - ux[i - 1];
+            const double dy = uy[i] - uy[i - 1];
+            const double dz = uz[i] - uz[i - 1];
+            result += chordToDistance(dx * dx + dy * dy + dz * dz);
+        }
+    }
+    return result;
+}
+
+void GeoKernels::fastSinCos(const double x, double& sinX, double& cosX)
+{
+    sinCos(x, sinX, cosX);
+}
+
+double GeoKernels::fastAtan2(const double y, const double x)
+{
+    return atan2Poly(y, x);
+}
+
+void GeoKernels::toUnit(const double* lat, const double* lon, const unsigned stride, const unsigned count,
+                        double* ux, double* uy, double* uz)
+{
+    for (unsigned i = 0; i < count; i++)
+    {
+        double sinLat, cosLat, sinLon, cosLon;
+        sinCos(lat[i * stride] * DEG_TO_RAD, sinLat, cosLat);
+        sinCos(lon[i * stride] * DEG_TO_RAD, sinLon, cosLon);
+        ux[i] = cosLat * cosLon;
+        uy[i] = cosLat * sinLon;
+        uz[i] = sinLat;
+    }
+}
+
+void GeoKernels::distancesSerial(const double lat0, const double lon0,
+                                 const double* lat, const double* lon, const unsigned stride,
+                                 const unsigned count, double* result)
+{
+    double ux[CHUNK_SIZE], uy[CHUNK_SIZE], uz[CHUNK_SIZE];
+    double px, py, pz;
+    toUnit(&lat0, &lon0, 1, 1, &px, &py, &pz);
+    for (unsigned offset = 0; offset < count; offset += CHUNK_SIZE)
+    {
+        const unsigned size = count - offset < CHUNK_SIZE ? count - offset : CHUNK_SIZE;
+        toUnit(lat + offset * stride, lon + offset * stride, stride, size, ux, uy, uz);
+        unitDistances(px, py, pz, ux, uy, uz, size, result + offset);
+    }
+}
+
+void GeoKernels::bearingsSerial(const double lat0, const double lon0,
+                                const double* lat, const double* lon, const unsigned stride,
+                                const unsigned count, double* result)
+{
+    double ux[CHUNK_SIZE], uy[CHUNK_SIZE], uz[CHUNK_SIZE];
+    double sinLat0, cosLat0, sinLon0, cosLon0;
+    sinCos(lat0 * DEG_TO_RAD, sinLat0, cosLat0);
+    sinCos(lon0 * DEG_TO_RAD, sinLon0, cosLon0);
+    // local east and north directions at origin
+    const double ex = -sinLon0, ey = cosLon0;
+    const double nx = -sinLat0 * cosLon0, ny = -sinLat0 * sinLon0, nz = cosLat0;
+    for (unsigned offset = 0; offset < count; offset += CHUNK_SIZE)
+    {
+        const unsigned size = count - offset < CHUNK_SIZE ? count - offset : CHUNK_SIZE;
+        toUnit(lat + offset * stride, lon + offset * stride, stride, size, ux, uy, uz);
+        unitBearings(ex, ey, nx, ny, nz, ux, uy, uz, size, result + offset);
+    }
+}
@@ -82,9 +82,7 @@ bool CalibrationSettings::isValid(void) const
         return false;
     }
 
-    unsigned char dataTab[sizeof(CalibrationSettings)];
-    serialize(dataTab);
-    return IMessage::computeCrc32(dataTab, getDataSize() - 4) == crcValue
+    return computeCrc() == crcValue
             && magnetSoft.getDet() != 0.0f
             && accelCalib.getDet() != 0.0f;
 }
@@ -96,9 +94,15 @@ unsigned CalibrationSettings::getCrc(void) const
 
 void CalibrationSettings::setCrc(void)
 {
-    unsigned char dataTab[sizeof(CalibrationSettings)];
-    serialize(dataTab);
-    crcValue = IMessage::computeCrc32(dataTab, getDataSize() - 4);
+    crcValue = computeCrc();
+}
+
+unsigned CalibrationSettings::computeCrc(void) const
+{
+    // fields start after vtable pointer, serialize() copies from this + 4 which on
+    // 64-bit builds would put upper half of vtable pointer under crc
+    const unsigned char* const begin = (const unsigned char*)this + sizeof(void*);
+    return IMessage::computeCrc32(begin, (unsigned)((const unsigned char*)&crcValue - begin));
 }
 
 ISignalPayloadMessage* CalibrationSettings::clone(void) const
@@ -30,6 +30,10 @@ void CommDispatcher::reset(void)
     failedReceptionCounter = 0;
     sucessfullReceptionCounter = 0;
 
+    crcFailureCounter = 0;
+    preambleCollisionCounter = 0;
+    incompletePayloadCounter = 0;
+
     receivingSignalData = false;
     receivedSignalData = SignalData::DUMMY;
     signalDataBuffer = NULL;
@@ -179,10 +183,28 @@ unsigned CommDispatcher::getFailedReceptions(void) const
     return failedReceptionCounter;
 }
 
+unsigned CommDispatcher::getCrcFailures(void) const
+{
+    return crcFailureCounter;
+}
+
+unsigned CommDispatcher::getPreambleCollisions(void) const
+{
+    return preambleCollisionCounter;
+}
+
+unsigned CommDispatcher::getIncompletePayloads(void) const
+{
+    return incompletePayloadCounter;
+}
+
 void CommDispatcher::clearCounters(void)
 {
     sucessfullReceptionCounter = 0;
     failedReceptionCounter = 0;
+    crcFailureCounter = 0;
+    preambleCollisionCounter = 0;
+    incompletePayloadCounter = 0;
 }
 
 IMessage::PreambleType CommDispatcher::putChar(unsigned char data)
@@ -199,6 +221,7 @@ IMessage::PreambleType CommDispatcher::putChar(unsigned char data)
             Tracer::Trace("New preamble received when previous reception not ready");
 #endif // TRACER_H_
             failedReceptionCounter++;
+            preambleCollisionCounter++;
         }
         activatePreamble(newPreamble);
         return IMessage::EMPTY;
@@ -248,6 +271,7 @@ IMessage::PreambleType CommDispatcher::putChar(unsigned char data)
                     {
                         //std::cout << "\nFAIL: receiving SignalData not ready\n\n";
                         failedReceptionCounter++;
+                        incompletePayloadCounter++;
 #ifdef TRACER_H_
                         Tracer::Trace("Receiving SignalData not ready");
 #endif // TRACER_H_
@@ -262,6 +286,7 @@ IMessage::PreambleType CommDispatcher::putChar(unsigned char data)
                 // something gone wrong, reset processor
                 //std::cout << "\nFAIL: wrong CRC\n\n";
                 failedReceptionCounter++;
+                crcFailureCounter++;
 #ifdef TRACER_H_
                 Tracer::Trace("Wrong CRC");
 #endif // TRACER_H_
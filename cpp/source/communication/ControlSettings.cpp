@@ -126,9 +126,7 @@ bool ControlSettings::isValid(void) const
         return false;
     }
 
-    unsigned char dataTab[sizeof(ControlSettings)];
-    serialize(dataTab);
-    return IMessage::computeCrc32(dataTab, getDataSize() - 4) == crcValue;
+    return computeCrc() == crcValue;
 }
 
 unsigned ControlSettings::getCrc(void) const
@@ -138,9 +136,15 @@ unsigned ControlSettings::getCrc(void) const
 
 void ControlSettings::setCrc(void)
 {
-    unsigned char dataTab[sizeof(ControlSettings)];
-    serialize(dataTab);
-    crcValue = IMessage::computeCrc32(dataTab, getDataSize() - 4);
+    crcValue = computeCrc();
+}
+
+unsigned ControlSettings::computeCrc(void) const
+{
+    // fields start after vtable pointer, serialize() copies from this + 4 which on
+    // 64-bit builds would put upper half of vtable pointer under crc
+    const unsigned char* const begin = (const unsigned char*)this + sizeof(void*);
+    return IMessage::computeCrc32(begin, (unsigned)((const unsigned char*)&crcValue - begin));
 }
 
 ISignalPayloadMessage* ControlSettings::clone(void) const
@@ -130,6 +130,11 @@ std::string SignalData::toString(const SignalData& command)
         return "SINGAL_DATA(WHO_AM_I_VALUE: "
                 + std::to_string(command.getParameter()) + ")";
     }
+    else if (TELEMETRY_RATE == command.getCommand())
+    {
+        return "SIGNAL_DATA(TELEMETRY_RATE: "
+                + std::to_string(command.getParameter()) + ")";
+    }
     else
     {
         return "SIGNAL_DATA(" + toString(command.getCommand())
@@ -198,6 +203,8 @@ std::string SignalData::toString(const SignalData::Command& command)
         return std::string("PROTOCOL_VERSION_VALUE");
     case SignalData::PROTOCOL_VERSION:
         return std::string("PROTOCOL_VERSION");
+    case SignalData::TELEMETRY_RATE:
+        return std::string("TELEMETRY_RATE");
     default:
         return std::string("Bad command type");
     }
@@ -8,6 +8,11 @@ ISkyCommInterface::~ISkyCommInterface(void)
 {
 }
 
+size_t ISkyCommInterface::getSendQueueSize(void) const
+{
+    return 0;
+}
+
 void ISkyCommInterface::setListener(Listener* _listener)
 {
     listener = _listener;
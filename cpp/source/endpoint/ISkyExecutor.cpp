@@ -0,0 +1,5 @@
+#include "endpoint/ISkyExecutor.hpp"
+
+ISkyExecutor::~ISkyExecutor(void)
+{
+}
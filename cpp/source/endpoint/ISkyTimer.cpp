@@ -13,3 +13,8 @@ void ISkyTimer::onTimeout(void) const
 {
     exec();
 }
+
+void ISkyTimer::setTimeoutHandler(std::function<void(void)> _exec)
+{
+    exec = _exec;
+}
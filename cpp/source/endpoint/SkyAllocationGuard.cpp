@@ -0,0 +1,118 @@
+#include "endpoint/SkyAllocationGuard.hpp"
+
+#include <atomic>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace
+{
+
+std::atomic<unsigned> armedGuards(0);
+std::atomic<unsigned> fatalGuards(0);
+std::atomic<uint64_t> allocationsCount(0);
+
+}
+
+#ifdef __SKYDIVE_ALLOCATION_GUARD__
+
+namespace
+{
+
+void* allocate(const std::size_t size)
+{
+    if (armedGuards.load(std::memory_order_relaxed) > 0)
+    {
+        allocationsCount.fetch_add(1, std::memory_order_relaxed);
+        if (fatalGuards.load(std::memory_order_relaxed) > 0)
+        {
+            // no allocation is allowed here, including the one for exception message
+            std::fputs("SkyAllocationGuard: heap allocation in guarded scope\n", stderr);
+            std::abort();
+        }
+    }
+    return std::malloc(0 == size ? 1 : size);
+}
+
+}
+
+void* operator new(std::size_t size)
+{
+    void* result = allocate(size);
+    if (nullptr == result)
+    {
+        throw std::bad_alloc();
+    }
+    return result;
+}
+
+void* operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept
+{
+    return allocate(size);
+}
+
+void operator delete(void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete[](void* pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+#endif // __SKYDIVE_ALLOCATION_GUARD__
+
+SkyAllocationGuard::SkyAllocationGuard(const bool _fatal):
+    fatal(_fatal),
+    initialCount(allocationsCount.load())
+{
+    armedGuards++;
+    if (fatal)
+    {
+        fatalGuards++;
+    }
+}
+
+SkyAllocationGuard::~SkyAllocationGuard(void)
+{
+    if (fatal)
+    {
+        fatalGuards--;
+    }
+    armedGuards--;
+}
+
+uint64_t SkyAllocationGuard::getAllocationsCount(void) const
+{
+    return allocationsCount.load() - initialCount;
+}
+
+bool SkyAllocationGuard::isEnabled(void)
+{
+#ifdef __SKYDIVE_ALLOCATION_GUARD__
+    return true;
+#else
+    return false;
+#endif // __SKYDIVE_ALLOCATION_GUARD__
+}
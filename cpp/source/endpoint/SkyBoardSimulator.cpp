@@ -0,0 +1,769 @@
+#include "endpoint/SkyBoardSimulator.hpp"
+
+#include "communication/AutopilotData.hpp"
+#include "communication/IMessage.hpp"
+
+constexpr unsigned SkyBoardSimulator::RADIO_CHANNELS;
+constexpr size_t SkyBoardSimulator::TRANSMIT_BUFFER_SIZE;
+
+SkyBoardSimulator::Settings::Settings(void):
+    appTelemetryRate(5.0),
+    flightTelemetryRate(25.0),
+    sensorsRate(50.0),
+    radioRate(25.0),
+    boardType(CalibrationSettings::TYPE_BASIC_V3),
+    protocolVersion(IMessage::PROTOCOL_VERSION),
+    pingAnswers(true)
+{
+}
+
+SkyBoardSimulator::SkyBoardSimulator(TimerFactory _timerFactory, const Settings& _settings):
+    timerFactory(_timerFactory),
+    settings(_settings),
+    stage(DISCONNECTED),
+    connected(false),
+    telemetryRate(0.0),
+    flightTelemetryRate(_settings.flightTelemetryRate),
+    calibrationSettings(CalibrationSettings::createDefault()),
+    controlSettings(ControlSettings::createDefault()),
+    pendingPayload(nullptr),
+    radioChannel(0),
+    escStep(0),
+    statistics()
+{
+    listener = nullptr;
+    streamTimer.reset(timerFactory([this]() { streamHandler(); }));
+
+    calibrationSettings.boardType = settings.boardType;
+    calibrationSettings.setCrc();
+
+    // not set by defaults, same as in direct flight connection
+    controlSettings.uavType = ControlSettings::QUADROCOPTER_X;
+    controlSettings.initialSolverMode = ControlData::ANGLE;
+    controlSettings.manualThrottleMode = ControlSettings::STATIC;
+    controlSettings.setCrc();
+
+    debugData.setBatteryVoltage(12.6f);
+    controlData.setControllerCommand(ControlData::MANUAL);
+}
+
+SkyBoardSimulator::~SkyBoardSimulator(void)
+{
+    streamTimer->stop();
+}
+
+void SkyBoardSimulator::connect(void)
+{
+    connected = true;
+    statistics.connections++;
+    dispatcher.reset();
+    pendingPayload = nullptr;
+    flightTelemetryRate = settings.flightTelemetryRate;
+    enterStage(CONNECTING);
+    onConnected();
+}
+
+void SkyBoardSimulator::disconnect(void)
+{
+    if (connected)
+    {
+        connected = false;
+        enterStage(DISCONNECTED);
+        onDisconnected();
+    }
+}
+
+void SkyBoardSimulator::send(const unsigned char* data, const size_t length)
+{
+    if (false == connected)
+    {
+        return;
+    }
+    statistics.receivedBytes += length;
+    for (size_t i = 0; i < length; i++)
+    {
+        switch (dispatcher.putChar(data[i]))
+        {
+        case IMessage::CONTROL:
+            statistics.receivedFrames++;
+            handleControl(dispatcher.getControlData());
+            break;
+
+        case IMessage::AUTOPILOT:
+            statistics.receivedFrames++;
+            handleAutopilot(dispatcher.getAutopilotData());
+            break;
+
+        case IMessage::SIGNAL:
+            statistics.receivedFrames++;
+            if (SignalData::hasPayload(dispatcher.getCommand()))
+            {
+                std::unique_ptr<IMessage> message(dispatcher.retriveSignalMessage());
+                if (nullptr != message)
+                {
+                    handlePayload(static_cast<const ISignalPayloadMessage&>(*message));
+                }
+            }
+            else
+            {
+                handleSignal(dispatcher.getSignalData());
+            }
+            break;
+
+        default:
+            break;
+        }
+        if (false == connected)
+        {
+            // reply made device close link, rest of data is dropped
+            break;
+        }
+    }
+    statistics.failedReceptions = dispatcher.getFailedReceptions();
+}
+
+SkyBoardSimulator::Stage SkyBoardSimulator::getStage(void) const
+{
+    return stage;
+}
+
+const SkyBoardSimulator::Statistics& SkyBoardSimulator::getStatistics(void) const
+{
+    return statistics;
+}
+
+double SkyBoardSimulator::getTelemetryRate(void) const
+{
+    return telemetryRate;
+}
+
+CalibrationSettings& SkyBoardSimulator::getCalibrationSettings(void)
+{
+    return calibrationSettings;
+}
+
+ControlSettings& SkyBoardSimulator::getControlSettings(void)
+{
+    return controlSettings;
+}
+
+const RouteContainer& SkyBoardSimulator::getRoute(void) const
+{
+    return route;
+}
+
+const char* SkyBoardSimulator::toString(const Stage stage)
+{
+    switch (stage)
+    {
+    case DISCONNECTED: return "DISCONNECTED";
+    case CONNECTING: return "CONNECTING";
+    case APP_LOOP: return "APP_LOOP";
+    case FLIGHT_INITIALIZATION: return "FLIGHT_INITIALIZATION";
+    case FLIGHT_LOOP: return "FLIGHT_LOOP";
+    case UPLOAD: return "UPLOAD";
+    case DOWNLOAD: return "DOWNLOAD";
+    case ACCEL_CALIBRATION: return "ACCEL_CALIBRATION";
+    case MAGNET_CALIBRATION: return "MAGNET_CALIBRATION";
+    case RADIO_CALIBRATION: return "RADIO_CALIBRATION";
+    case RADIO_CALIBRATION_CHECK: return "RADIO_CALIBRATION_CHECK";
+    case RADIO_CHECK: return "RADIO_CHECK";
+    case ESC_CALIBRATION: return "ESC_CALIBRATION";
+    case SENSORS_LOGGER: return "SENSORS_LOGGER";
+    default: return "UNKNOWN";
+    }
+}
+
+void SkyBoardSimulator::handleSignal(const SignalData& signal)
+{
+    switch (signal.getCommand())
+    {
+    case SignalData::PING_VALUE:
+        statistics.pings++;
+        if (settings.pingAnswers)
+        {
+            transmit(signal);
+        }
+        break;
+
+    case SignalData::START_CMD:
+    case SignalData::PROTOCOL_VERSION:
+    case SignalData::APP_LOOP:
+        handleConnection(signal);
+        break;
+
+    case SignalData::WHO_AM_I_VALUE:
+        if (CONNECTING == stage && SignalData::START == signal.getParameter())
+        {
+            // device closes link after board type
+            reply(SignalData::WHO_AM_I_VALUE, (int)settings.boardType);
+        }
+        else
+        {
+            unexpected();
+        }
+        break;
+
+    case SignalData::SOFTWARE_UPGRADE:
+        // upgrade is not possible over simulated link
+        reply(SignalData::SOFTWARE_UPGRADE, SignalData::NOT_ALLOWED);
+        break;
+
+    case SignalData::SYSTEM_RESET:
+        // device closes link after acknowledge
+        startCommand(signal, CONNECTING);
+        break;
+
+    case SignalData::FLIGHT_LOOP:
+        handleFlight(signal);
+        break;
+
+    case SignalData::TELEMETRY_RATE:
+        if (signal.getParameterValue() > 0)
+        {
+            flightTelemetryRate = signal.getParameterValue();
+            restartStream();
+        }
+        break;
+
+    case SignalData::CALIBRATE_ACCEL:
+        if (startCommand(signal, ACCEL_CALIBRATION))
+        {
+            reply(SignalData::CALIBRATE_ACCEL, SignalData::DONE);
+            transmitPayload(calibrationSettings);
+        }
+        break;
+
+    case SignalData::CALIBRATE_MAGNET:
+        handleMagnetCalibration(signal);
+        break;
+
+    case SignalData::CALIBRATE_RADIO:
+        handleRadioCalibration(signal);
+        break;
+
+    case SignalData::CHECK_RADIO:
+        if (SignalData::BREAK == signal.getParameter())
+        {
+            handleBreak(signal, RADIO_CHECK);
+        }
+        else if (startCommand(signal, RADIO_CHECK))
+        {
+            // controls are streamed when settings are acknowledged
+            transmitPayload(controlSettings);
+        }
+        break;
+
+    case SignalData::CALIBRATE_ESC:
+        handleEscCalibration(signal);
+        break;
+
+    case SignalData::SENSORS_LOGGER:
+        if (SignalData::BREAK == signal.getParameter())
+        {
+            handleBreak(signal, SENSORS_LOGGER);
+        }
+        else
+        {
+            startCommand(signal, SENSORS_LOGGER);
+        }
+        break;
+
+    case SignalData::UPLOAD_SETTINGS:
+    case SignalData::UPLOAD_ROUTE:
+    case SignalData::WIFI_CONFIGURATION:
+        startCommand(signal, UPLOAD);
+        break;
+
+    case SignalData::DOWNLOAD_SETTINGS:
+        if (startCommand(signal, DOWNLOAD))
+        {
+            transmitPayload(controlSettings);
+        }
+        break;
+
+    case SignalData::DOWNLOAD_ROUTE:
+        if (APP_LOOP == stage && false == route.isContainerFilled())
+        {
+            reply(SignalData::DOWNLOAD_ROUTE, SignalData::FAIL);
+        }
+        else if (startCommand(signal, DOWNLOAD))
+        {
+            transmitPayload(route);
+        }
+        break;
+
+    case SignalData::CALIBRATION_SETTINGS:
+    case SignalData::CONTROL_SETTINGS:
+    case SignalData::ROUTE_CONTAINER:
+        handlePayloadResponse(signal);
+        break;
+
+    default:
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handlePayload(const ISignalPayloadMessage& payload)
+{
+    statistics.payloadsReceived++;
+    if (UPLOAD != stage)
+    {
+        statistics.unexpectedSignals++;
+        return;
+    }
+    if (false == payload.isValid())
+    {
+        // device retransmits
+        statistics.invalidPayloads++;
+        reply(payload.getSignalDataCommand(), SignalData::DATA_INVALID);
+        return;
+    }
+    switch (payload.getMessageType())
+    {
+    case IMessage::CONTROL_SETTINGS:
+        controlSettings = static_cast<const ControlSettings&>(payload);
+        break;
+
+    case IMessage::ROUTE_CONTAINER:
+        route = static_cast<const RouteContainer&>(payload);
+        break;
+
+    default:
+        // wifi configuration is only acknowledged
+        break;
+    }
+    reply(payload.getSignalDataCommand(), SignalData::ACK);
+    enterStage(APP_LOOP);
+}
+
+void SkyBoardSimulator::handleControl(const ControlData& control)
+{
+    if (FLIGHT_LOOP != stage)
+    {
+        return;
+    }
+    statistics.controlFrames++;
+    controlData = control;
+    if (ControlData::STOP == control.getControllerCommand())
+    {
+        reply(SignalData::FLIGHT_LOOP, SignalData::BREAK_ACK);
+        enterStage(APP_LOOP);
+    }
+}
+
+void SkyBoardSimulator::handleAutopilot(const AutopilotData& autopilot)
+{
+    if (FLIGHT_LOOP == stage && AutopilotData::TARGET == autopilot.getType())
+    {
+        AutopilotData response(autopilot);
+        response.setType(AutopilotData::TARGET_ACK);
+        transmit(response);
+    }
+}
+
+bool SkyBoardSimulator::startCommand(const SignalData& signal, const Stage next)
+{
+    if (APP_LOOP != stage || SignalData::START != signal.getParameter())
+    {
+        unexpected();
+        return false;
+    }
+    reply(signal.getCommand(), SignalData::ACK);
+    enterStage(next);
+    return true;
+}
+
+void SkyBoardSimulator::handleConnection(const SignalData& signal)
+{
+    if (CONNECTING == stage && SignalData::START_CMD == signal.getCommand()
+            && SignalData::START == signal.getParameter())
+    {
+        reply(SignalData::START_CMD, SignalData::ACK);
+        // version is sent as plain value
+        reply(SignalData::PROTOCOL_VERSION_VALUE, (int)settings.protocolVersion);
+    }
+    else if (CONNECTING == stage && SignalData::PROTOCOL_VERSION == signal.getCommand())
+    {
+        if (SignalData::ACK == signal.getParameter())
+        {
+            reply(SignalData::CALIBRATION_SETTINGS, SignalData::READY);
+            transmitPayload(calibrationSettings);
+        }
+        // version rejected, device closes link
+    }
+    else if (CONNECTING == stage && SignalData::APP_LOOP == signal.getCommand()
+             && SignalData::START == signal.getParameter())
+    {
+        reply(SignalData::APP_LOOP, SignalData::ACK);
+        enterStage(APP_LOOP);
+    }
+    else if (APP_LOOP == stage && SignalData::APP_LOOP == signal.getCommand()
+             && SignalData::BREAK == signal.getParameter())
+    {
+        // device closes link after acknowledge
+        reply(SignalData::APP_LOOP, SignalData::BREAK_ACK);
+        enterStage(CONNECTING);
+    }
+    else
+    {
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handleFlight(const SignalData& signal)
+{
+    switch (signal.getParameter())
+    {
+    case SignalData::START:
+        if (startCommand(signal, FLIGHT_INITIALIZATION))
+        {
+            transmitPayload(controlSettings);
+        }
+        break;
+
+    case SignalData::READY:
+        // after initialization or at once in direct flight connection
+        if (FLIGHT_INITIALIZATION == stage || CONNECTING == stage)
+        {
+            flightTelemetryRate = settings.flightTelemetryRate;
+            enterStage(FLIGHT_LOOP);
+        }
+        else
+        {
+            unexpected();
+        }
+        break;
+
+    default:
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handleMagnetCalibration(const SignalData& signal)
+{
+    if (SignalData::START == signal.getParameter())
+    {
+        startCommand(signal, MAGNET_CALIBRATION);
+    }
+    else if (MAGNET_CALIBRATION == stage && SignalData::DONE == signal.getParameter())
+    {
+        reply(SignalData::CALIBRATE_MAGNET, SignalData::DONE);
+        transmitPayload(calibrationSettings);
+    }
+    else if (MAGNET_CALIBRATION == stage && SignalData::SKIP == signal.getParameter())
+    {
+        reply(SignalData::CALIBRATE_MAGNET, SignalData::ACK);
+        enterStage(APP_LOOP);
+    }
+    else
+    {
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handleRadioCalibration(const SignalData& signal)
+{
+    switch (signal.getParameter())
+    {
+    case SignalData::START:
+        if (startCommand(signal, RADIO_CALIBRATION))
+        {
+            radioChannel = 0;
+        }
+        break;
+
+    case SignalData::DONE:
+    case SignalData::SKIP:
+        if (RADIO_CALIBRATION == stage)
+        {
+            reply(SignalData::CALIBRATE_RADIO, SignalData::ACK);
+            radioChannel++;
+            if (radioChannel >= RADIO_CHANNELS)
+            {
+                enterStage(RADIO_CALIBRATION_CHECK);
+            }
+        }
+        else
+        {
+            unexpected();
+        }
+        break;
+
+    case SignalData::BREAK:
+        if (RADIO_CALIBRATION_CHECK == stage)
+        {
+            // results accepted by operator, application loop follows calibration acknowledge
+            reply(SignalData::CALIBRATE_RADIO, SignalData::ACK);
+            transmitPayload(calibrationSettings);
+        }
+        else
+        {
+            handleBreak(signal, RADIO_CALIBRATION);
+        }
+        break;
+
+    case SignalData::BREAK_FAIL:
+        handleBreak(signal, RADIO_CALIBRATION_CHECK);
+        break;
+
+    default:
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handleEscCalibration(const SignalData& signal)
+{
+    switch (signal.getParameter())
+    {
+    case SignalData::START:
+        if (startCommand(signal, ESC_CALIBRATION))
+        {
+            escStep = 0;
+        }
+        break;
+
+    case SignalData::DONE:
+        if (ESC_CALIBRATION == stage)
+        {
+            // ESC disconnected, then connected and calibrated at once
+            reply(SignalData::CALIBRATE_ESC, SignalData::ACK);
+            escStep++;
+            if (2 == escStep)
+            {
+                reply(SignalData::CALIBRATE_ESC, SignalData::DONE);
+            }
+        }
+        else
+        {
+            unexpected();
+        }
+        break;
+
+    case SignalData::READY:
+        if (ESC_CALIBRATION == stage)
+        {
+            reply(SignalData::CALIBRATE_ESC, SignalData::ACK);
+            enterStage(APP_LOOP);
+        }
+        else
+        {
+            unexpected();
+        }
+        break;
+
+    case SignalData::BREAK_FAIL:
+        handleBreak(signal, ESC_CALIBRATION);
+        break;
+
+    default:
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handleBreak(const SignalData& signal, const Stage expected)
+{
+    if (expected == stage)
+    {
+        reply(signal.getCommand(), SignalData::BREAK_ACK);
+        enterStage(APP_LOOP);
+    }
+    else
+    {
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::handlePayloadResponse(const SignalData& signal)
+{
+    if (nullptr == pendingPayload || pendingPayload->getSignalDataCommand() != signal.getCommand())
+    {
+        unexpected();
+        return;
+    }
+    switch (signal.getParameter())
+    {
+    case SignalData::ACK:
+    {
+        const ISignalPayloadMessage* const payload = pendingPayload;
+        pendingPayload = nullptr;
+        onPayloadAck(payload);
+        break;
+    }
+
+    case SignalData::DATA_INVALID:
+    case SignalData::TIMEOUT:
+        // device counts retransmissions and fails when limit is exceeded
+        statistics.payloadRetransmissions++;
+        transmitPayload(*pendingPayload);
+        break;
+
+    default:
+        unexpected();
+    }
+}
+
+void SkyBoardSimulator::onPayloadAck(const ISignalPayloadMessage* const payload)
+{
+    switch (stage)
+    {
+    case CONNECTING:
+        // device starts application loop
+        break;
+
+    case FLIGHT_INITIALIZATION:
+        if (&controlSettings == payload)
+        {
+            if (route.isContainerFilled())
+            {
+                reply(SignalData::FLIGHT_LOOP, SignalData::VIA_ROUTE_ALLOWED);
+                transmitPayload(route);
+            }
+            else
+            {
+                reply(SignalData::FLIGHT_LOOP, SignalData::VIA_ROUTE_NOT_ALLOWED);
+            }
+        }
+        // device starts flight loop
+        break;
+
+    case RADIO_CHECK:
+        restartStream();
+        break;
+
+    default:
+        enterStage(APP_LOOP);
+    }
+}
+
+void SkyBoardSimulator::enterStage(const Stage next)
+{
+    stage = next;
+    restartStream();
+}
+
+void SkyBoardSimulator::restartStream(void)
+{
+    double rate = 0.0;
+    if (nullptr == pendingPayload)
+    {
+        switch (stage)
+        {
+        case APP_LOOP:
+            rate = settings.appTelemetryRate;
+            break;
+
+        case FLIGHT_LOOP:
+            rate = flightTelemetryRate;
+            break;
+
+        case SENSORS_LOGGER:
+            rate = settings.sensorsRate;
+            break;
+
+        case RADIO_CHECK:
+        case RADIO_CALIBRATION_CHECK:
+            rate = settings.radioRate;
+            break;
+
+        default:
+            break;
+        }
+    }
+    // first frame is sent after period, never during handling of device input
+    if (rate != telemetryRate)
+    {
+        telemetryRate = rate;
+        if (rate > 0.0)
+        {
+            streamTimer->start(rate);
+        }
+        else
+        {
+            streamTimer->stop();
+        }
+    }
+}
+
+void SkyBoardSimulator::streamHandler(void)
+{
+    switch (stage)
+    {
+    case APP_LOOP:
+    case FLIGHT_LOOP:
+        updateTelemetry();
+        transmit(debugData);
+        break;
+
+    case SENSORS_LOGGER:
+        transmit(sensorsData);
+        break;
+
+    case RADIO_CHECK:
+    case RADIO_CALIBRATION_CHECK:
+        transmit(controlData);
+        break;
+
+    default:
+        return;
+    }
+    statistics.telemetryFrames++;
+}
+
+void SkyBoardSimulator::updateTelemetry(void)
+{
+    if (FLIGHT_LOOP == stage)
+    {
+        // vehicle follows controls at once
+        debugData.setEuler(controlData.getEuler());
+        debugData.setUsedThrottle(controlData.getThrottle());
+        debugData.setControllerState(static_cast<DebugData::ControllerState>(controlData.getControllerCommand()));
+    }
+    else
+    {
+        debugData.setControllerState(DebugData::APPLICATION_LOOP);
+    }
+}
+
+void SkyBoardSimulator::reply(const SignalData::Command command, const SignalData::Parameter parameter)
+{
+    transmit(SignalData(command, parameter));
+}
+
+void SkyBoardSimulator::reply(const SignalData::Command command, const int value)
+{
+    transmit(SignalData(command, value));
+}
+
+void SkyBoardSimulator::transmit(const IMessage& message)
+{
+    if (connected && nullptr != listener)
+    {
+        unsigned char buffer[TRANSMIT_BUFFER_SIZE];
+        message.serializeMessage(buffer);
+        statistics.sentFrames++;
+        statistics.sentBytes += message.getMessageSize();
+        onReceived(buffer, message.getMessageSize());
+    }
+}
+
+void SkyBoardSimulator::transmitPayload(const ISignalPayloadMessage& payload)
+{
+    pendingPayload = &payload;
+    statistics.payloadsSent++;
+    restartStream();
+    unsigned char buffer[IMessage::SIGNAL_DATA_MESSAGE_SIZE];
+    ISignalPayloadMessage::MessagesBuilder builder(&payload);
+    while (builder.hasNext() && connected && nullptr != listener)
+    {
+        builder.getNext(buffer);
+        statistics.sentFrames++;
+        statistics.sentBytes += IMessage::SIGNAL_DATA_MESSAGE_SIZE;
+        onReceived(buffer, IMessage::SIGNAL_DATA_MESSAGE_SIZE);
+    }
+}
+
+void SkyBoardSimulator::unexpected(void)
+{
+    statistics.unexpectedSignals++;
+}
@@ -0,0 +1,257 @@
+#include "endpoint/SkyCapture.hpp"
+
+#include <cstring>
+
+namespace
+{
+
+const char MAGIC[] = "SKYCAP";
+
+// type, time and length
+constexpr size_t MAX_RECORD_HEADER_SIZE = 1 + 10 + 10;
+
+}
+
+constexpr unsigned char SkyCapture::VERSION;
+constexpr size_t SkyCapture::HEADER_SIZE;
+
+const char* SkyCapture::toString(const Type type)
+{
+    switch (type)
+    {
+    case RECEIVED: return "RECEIVED";
+    case SENT: return "SENT";
+    case CONNECTED: return "CONNECTED";
+    case DISCONNECTED: return "DISCONNECTED";
+    case ERROR: return "ERROR";
+    default: return "UNKNOWN";
+    }
+}
+
+SkyCaptureWriter::SkyCaptureWriter(void):
+    file(nullptr),
+    lastTime(0),
+    recordsCount(0)
+{
+}
+
+SkyCaptureWriter::~SkyCaptureWriter(void)
+{
+    close();
+}
+
+bool SkyCaptureWriter::open(const std::string& path)
+{
+    close();
+    std::lock_guard<std::mutex> lock(mutex);
+    file = std::fopen(path.c_str(), "wb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+    unsigned char header[SkyCapture::HEADER_SIZE] = {0};
+    std::memcpy(header, MAGIC, sizeof(MAGIC) - 1);
+    header[sizeof(MAGIC) - 1] = SkyCapture::VERSION;
+    if (sizeof(header) != std::fwrite(header, 1, sizeof(header), file))
+    {
+        std::fclose(file);
+        file = nullptr;
+        return false;
+    }
+    startTime = Clock::now();
+    lastTime = SkyCapture::Duration(0);
+    recordsCount = 0;
+    return true;
+}
+
+void SkyCaptureWriter::close(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (nullptr != file)
+    {
+        std::fclose(file);
+        file = nullptr;
+    }
+}
+
+bool SkyCaptureWriter::isOpen(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return nullptr != file;
+}
+
+void SkyCaptureWriter::write(const SkyCapture::Type type, const unsigned char* data, const size_t length)
+{
+    const Clock::time_point now = Clock::now();
+    std::lock_guard<std::mutex> lock(mutex);
+    // time is taken before lock, records of other threads may be written in between
+    writeRecord(type, std::chrono::duration_cast<SkyCapture::Duration>(now - startTime), data, length);
+}
+
+void SkyCaptureWriter::write(const SkyCapture::Type type,
+                             const SkyCapture::Duration time,
+                             const unsigned char* data,
+                             const size_t length)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    writeRecord(type, time, data, length);
+}
+
+void SkyCaptureWriter::writeRecord(const SkyCapture::Type type,
+                                   SkyCapture::Duration time,
+                                   const unsigned char* data,
+                                   const size_t length)
+{
+    if (nullptr == file)
+    {
+        return;
+    }
+    if (time < lastTime)
+    {
+        time = lastTime;
+    }
+    unsigned char header[MAX_RECORD_HEADER_SIZE];
+    size_t size = 0;
+    header[size++] = (unsigned char)type;
+    size += putVarint(header + size, (uint64_t)(time - lastTime).count());
+    size += putVarint(header + size, length);
+    std::fwrite(header, 1, size, file);
+    if (length > 0)
+    {
+        std::fwrite(data, 1, length, file);
+    }
+    lastTime = time;
+    recordsCount++;
+}
+
+void SkyCaptureWriter::flush(void)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    if (nullptr != file)
+    {
+        std::fflush(file);
+    }
+}
+
+uint64_t SkyCaptureWriter::getRecordsCount(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return recordsCount;
+}
+
+size_t SkyCaptureWriter::putVarint(unsigned char* buffer, uint64_t value)
+{
+    size_t size = 0;
+    while (value >= 0x80)
+    {
+        buffer[size++] = (unsigned char)(value | 0x80);
+        value >>= 7;
+    }
+    buffer[size++] = (unsigned char)value;
+    return size;
+}
+
+SkyCaptureReader::SkyCaptureReader(void):
+    offset(0),
+    time(0),
+    duration(0),
+    broken(false)
+{
+}
+
+bool SkyCaptureReader::open(const std::string& path)
+{
+    close();
+    FILE* file = std::fopen(path.c_str(), "rb");
+    if (nullptr == file)
+    {
+        return false;
+    }
+    unsigned char chunk[65536];
+    size_t read;
+    while ((read = std::fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        buffer.insert(buffer.end(), chunk, chunk + read);
+    }
+    std::fclose(file);
+    if (buffer.size() < SkyCapture::HEADER_SIZE
+            || 0 != std::memcmp(buffer.data(), MAGIC, sizeof(MAGIC) - 1)
+            || SkyCapture::VERSION != buffer[sizeof(MAGIC) - 1])
+    {
+        close();
+        return false;
+    }
+    rewind();
+    SkyCapture::Record record;
+    while (next(record))
+    {
+        duration = record.time;
+    }
+    rewind();
+    return true;
+}
+
+void SkyCaptureReader::close(void)
+{
+    buffer.clear();
+    offset = 0;
+    time = SkyCapture::Duration(0);
+    duration = SkyCapture::Duration(0);
+    broken = false;
+}
+
+bool SkyCaptureReader::next(SkyCapture::Record& record)
+{
+    if (broken || offset >= buffer.size())
+    {
+        return false;
+    }
+    const unsigned type = buffer[offset++];
+    uint64_t delta, length;
+    if (type >= SkyCapture::TYPES_COUNT || false == getVarint(delta) || false == getVarint(length)
+            || length > buffer.size() - offset)
+    {
+        // truncated file (e.g. capture process killed) ends at last whole record
+        broken = true;
+        return false;
+    }
+    time += SkyCapture::Duration(delta);
+    record.type = static_cast<SkyCapture::Type>(type);
+    record.time = time;
+    record.data = buffer.data() + offset;
+    record.length = (size_t)length;
+    offset += (size_t)length;
+    return true;
+}
+
+void SkyCaptureReader::rewind(void)
+{
+    offset = buffer.empty() ? 0 : SkyCapture::HEADER_SIZE;
+    time = SkyCapture::Duration(0);
+    broken = false;
+}
+
+bool SkyCaptureReader::isBroken(void) const
+{
+    return broken;
+}
+
+SkyCapture::Duration SkyCaptureReader::getDuration(void) const
+{
+    return duration;
+}
+
+bool SkyCaptureReader::getVarint(uint64_t& value)
+{
+    value = 0;
+    for (unsigned shift = 0; shift < 64 && offset < buffer.size(); shift += 7)
+    {
+        const unsigned char byte = buffer[offset++];
+        value |= (uint64_t)(byte & 0x7F) << shift;
+        if (0 == (byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
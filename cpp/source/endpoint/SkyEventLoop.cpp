@@ -0,0 +1,280 @@
+#include "endpoint/SkyEventLoop.hpp"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+#include <stdexcept>
+#include <string>
+
+SkyEventLoop::SkyEventLoop(const Clock::duration timerTick):
+    epollFd(epoll_create1(EPOLL_CLOEXEC)),
+    wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    running(false),
+    stopRequest(false),
+    timerWheel(timerTick),
+    iterationsCount(0)
+{
+    if (epollFd < 0 || wakeFd < 0)
+    {
+        throw std::runtime_error(std::string("SkyEventLoop: can not create epoll: ") + strerror(errno));
+    }
+    epoll_event event;
+    event.events = EPOLLIN;
+    event.data.ptr = nullptr;
+    epoll_ctl(epollFd, EPOLL_CTL_ADD, wakeFd, &event);
+}
+
+SkyEventLoop::~SkyEventLoop(void)
+{
+    SkyMailbox::Node* node;
+    while (nullptr != (node = tasks.pop()))
+    {
+        delete node;
+    }
+    close(wakeFd);
+    close(epollFd);
+}
+
+void SkyEventLoop::run(void)
+{
+    // peer closing socket or pipe must not kill process, write returns EPIPE
+    sigset_t signals;
+    sigemptyset(&signals);
+    sigaddset(&signals, SIGPIPE);
+    pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+    loopThread = std::this_thread::get_id();
+    running = true;
+    epoll_event events[MAX_EVENTS];
+    while (false == stopRequest)
+    {
+        const int count = epoll_wait(epollFd, events, MAX_EVENTS, getTimeout());
+        if (count < 0 && EINTR != errno)
+        {
+            running = false;
+            throw std::runtime_error(std::string("SkyEventLoop: epoll_wait failed: ") + strerror(errno));
+        }
+        for (int i = 0; i < count; i++)
+        {
+            Watch* watch = static_cast<Watch*>(events[i].data.ptr);
+            if (nullptr == watch)
+            {
+                uint64_t value;
+                while (read(wakeFd, &value, sizeof(value)) > 0);
+            }
+            else if (watch->active)
+            {
+                watch->handler(events[i].events);
+            }
+        }
+        // handlers could unwatch descriptors still present in events array
+        retiredWatches.clear();
+
+        runTasks();
+        runTimers();
+        iterationsCount++;
+    }
+    runTasks();
+    stopRequest = false;
+    running = false;
+}
+
+void SkyEventLoop::stop(void)
+{
+    stopRequest = true;
+    wake();
+}
+
+bool SkyEventLoop::isRunning(void) const
+{
+    return running;
+}
+
+void SkyEventLoop::watch(const int fd, const unsigned events, FdHandler handler)
+{
+    checkThread("watch");
+    std::unique_ptr<Watch> watch(new Watch{fd, handler, true});
+    epoll_event event;
+    event.events = events;
+    event.data.ptr = watch.get();
+    if (epoll_ctl(epollFd, EPOLL_CTL_ADD, fd, &event) < 0)
+    {
+        throw std::runtime_error(std::string("SkyEventLoop: can not watch fd: ") + strerror(errno));
+    }
+    watches[fd] = std::move(watch);
+}
+
+void SkyEventLoop::modify(const int fd, const unsigned events)
+{
+    checkThread("modify");
+    auto it = watches.find(fd);
+    if (watches.end() != it)
+    {
+        epoll_event event;
+        event.events = events;
+        event.data.ptr = it->second.get();
+        epoll_ctl(epollFd, EPOLL_CTL_MOD, fd, &event);
+    }
+}
+
+void SkyEventLoop::unwatch(const int fd)
+{
+    checkThread("unwatch");
+    auto it = watches.find(fd);
+    if (watches.end() != it)
+    {
+        epoll_ctl(epollFd, EPOLL_CTL_DEL, fd, nullptr);
+        it->second->active = false;
+        retiredWatches.push_back(std::move(it->second));
+        watches.erase(it);
+    }
+}
+
+ISkyTimer* SkyEventLoop::createTimer(std::function<void(void)> exec)
+{
+    checkThread("createTimer");
+    return timerWheel.createTimer(exec);
+}
+
+void SkyEventLoop::execute(std::function<void(void)> task)
+{
+    Task* node = new Task();
+    node->task = task;
+    if (tasks.push(node))
+    {
+        wake();
+    }
+}
+
+bool SkyEventLoop::isCurrentThread(void) const
+{
+    return std::this_thread::get_id() == loopThread;
+}
+
+unsigned long SkyEventLoop::getIterationsCount(void) const
+{
+    return iterationsCount;
+}
+
+void SkyEventLoop::checkThread(const char* operation) const
+{
+    if (running && false == isCurrentThread())
+    {
+        throw std::logic_error(std::string("SkyEventLoop: ") + operation
+                               + " called outside of loop thread while loop is running");
+    }
+}
+
+int SkyEventLoop::getTimeout(void) const
+{
+    if (false == tasks.isEmpty())
+    {
+        return 0;
+    }
+    const Clock::duration left = timerWheel.getTimeToNextExpiry();
+    if (left < Clock::duration::zero())
+    {
+        return -1;
+    }
+    // rounded up, loop never wakes before next tick
+    return (int)std::chrono::duration_cast<std::chrono::milliseconds>(
+                left + std::chrono::milliseconds(1) - Clock::duration(1)).count();
+}
+
+void SkyEventLoop::runTasks(void)
+{
+    SkyMailbox::Node* node;
+    while (nullptr != (node = tasks.pop()))
+    {
+        std::unique_ptr<Task> task(static_cast<Task*>(node));
+        task->task();
+    }
+}
+
+void SkyEventLoop::runTimers(void)
+{
+    timerWheel.advance();
+}
+
+void SkyEventLoop::wake(void)
+{
+    const uint64_t value = 1;
+    while (write(wakeFd, &value, sizeof(value)) < 0 && EINTR == errno);
+}
+
+SkyEventLoopGroup::SkyEventLoopGroup(const unsigned loopsCount, const bool _pinThreads):
+    pinThreads(_pinThreads),
+    counter(0)
+{
+    const unsigned hardware = std::thread::hardware_concurrency();
+    const unsigned count = loopsCount > 0 ? loopsCount : (hardware > 0 ? hardware : 1);
+    for (unsigned i = 0; i < count; i++)
+    {
+        loops.push_back(std::unique_ptr<SkyEventLoop>(new SkyEventLoop()));
+    }
+}
+
+SkyEventLoopGroup::~SkyEventLoopGroup(void)
+{
+    stop();
+}
+
+void SkyEventLoopGroup::start(void)
+{
+    const unsigned hardware = std::thread::hardware_concurrency();
+    for (unsigned i = 0; i < loops.size(); i++)
+    {
+        SkyEventLoop* loop = loops[i].get();
+        threads.push_back(std::thread([loop]()
+        {
+            loop->run();
+        }));
+        if (pinThreads && hardware > 0)
+        {
+            cpu_set_t cpuSet;
+            CPU_ZERO(&cpuSet);
+            CPU_SET(i % hardware, &cpuSet);
+            pthread_setaffinity_np(threads.back().native_handle(), sizeof(cpuSet), &cpuSet);
+        }
+    }
+}
+
+void SkyEventLoopGroup::stop(void)
+{
+    for (std::unique_ptr<SkyEventLoop>& loop : loops)
+    {
+        loop->stop();
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    threads.clear();
+}
+
+unsigned SkyEventLoopGroup::size(void) const
+{
+    return loops.size();
+}
+
+SkyEventLoop& SkyEventLoopGroup::getLoop(const unsigned index)
+{
+    return *loops[index % loops.size()];
+}
+
+SkyEventLoop& SkyEventLoopGroup::nextLoop(void)
+{
+    return getLoop(counter++);
+}
+
+#endif // __linux__
@@ -0,0 +1,284 @@
+#include "endpoint/SkyFdCommInterface.hpp"
+
+#ifdef __linux__
+
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <memory>
+#include <string>
+
+namespace
+{
+
+bool isSocket(const int fd)
+{
+    struct stat status;
+    return 0 == fstat(fd, &status) && S_ISSOCK(status.st_mode);
+}
+
+}
+
+SkyFdCommInterface::SkyFdCommInterface(SkyEventLoop* const _loop, const int _fd, const bool _ownsFd):
+    loop(_loop),
+    fd(_fd),
+    ownsFd(_ownsFd),
+    fdIsSocket(isSocket(_fd)),
+    self(new SkyFdCommInterface*(this)),
+    connected(false),
+    pendingOutputSize(0)
+{
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL, 0) | O_NONBLOCK);
+}
+
+SkyFdCommInterface::~SkyFdCommInterface(void)
+{
+    if (loop->isCurrentThread() || false == loop->isRunning())
+    {
+        detach();
+    }
+    else
+    {
+        // tasks posted before are run first (mailbox is FIFO), then interface is detached on loop thread
+        std::shared_ptr<SkyFdCommInterface*> detached(self);
+        std::shared_ptr<std::promise<void>> done(new std::promise<void>());
+        std::future<void> doneFuture = done->get_future();
+        loop->execute([detached, done]()
+        {
+            if (nullptr != *detached)
+            {
+                (*detached)->detach();
+            }
+            done->set_value();
+        });
+        while (std::future_status::ready != doneFuture.wait_for(std::chrono::milliseconds(10)))
+        {
+            if (false == loop->isRunning())
+            {
+                // loop stopped before task was run, nothing runs concurrently now
+                detach();
+                break;
+            }
+        }
+    }
+    if (ownsFd)
+    {
+        ::close(fd);
+    }
+}
+
+void SkyFdCommInterface::connect(void)
+{
+    std::shared_ptr<SkyFdCommInterface*> target(self);
+    loop->execute([target]()
+    {
+        if (nullptr != *target)
+        {
+            (*target)->connectFromLoop();
+        }
+    });
+}
+
+void SkyFdCommInterface::disconnect(void)
+{
+    std::shared_ptr<SkyFdCommInterface*> target(self);
+    loop->execute([target]()
+    {
+        if (nullptr != *target && (*target)->connected)
+        {
+            (*target)->close();
+        }
+    });
+}
+
+void SkyFdCommInterface::send(const unsigned char* data, const size_t length)
+{
+    if (loop->isCurrentThread())
+    {
+        sendFromLoop(data, length);
+    }
+    else
+    {
+        std::shared_ptr<SkyFdCommInterface*> target(self);
+        std::shared_ptr<std::vector<unsigned char>> copy(new std::vector<unsigned char>(data, data + length));
+        loop->execute([target, copy]()
+        {
+            if (nullptr != *target)
+            {
+                (*target)->sendFromLoop(copy->data(), copy->size());
+            }
+        });
+    }
+}
+
+size_t SkyFdCommInterface::getSendQueueSize(void) const
+{
+    return pendingOutputSize.load(std::memory_order_relaxed);
+}
+
+int SkyFdCommInterface::getFd(void) const
+{
+    return fd;
+}
+
+void SkyFdCommInterface::handleEvents(const unsigned events)
+{
+    if (events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR))
+    {
+        handleRead();
+    }
+    if (connected && (events & EPOLLOUT))
+    {
+        handleWrite();
+    }
+}
+
+void SkyFdCommInterface::handleRead(void)
+{
+    unsigned char buffer[READ_BUFFER_SIZE];
+    while (connected)
+    {
+        const ssize_t result = read(fd, buffer, sizeof(buffer));
+        if (result > 0)
+        {
+            onReceived(buffer, (size_t)result);
+        }
+        else if (0 == result)
+        {
+            close();
+        }
+        else if (EINTR != errno)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                const std::string message = std::string("SkyFdCommInterface read failed: ") + strerror(errno);
+                close();
+                onError(message);
+            }
+            break;
+        }
+    }
+}
+
+void SkyFdCommInterface::handleWrite(void)
+{
+    size_t offset = 0;
+    while (offset < pendingOutput.size())
+    {
+        const ssize_t result = writeFd(pendingOutput.data() + offset, pendingOutput.size() - offset);
+        if (result > 0)
+        {
+            offset += result;
+        }
+        else if (result < 0 && EINTR != errno)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                handleWriteError();
+                return;
+            }
+            break;
+        }
+    }
+    pendingOutput.erase(pendingOutput.begin(), pendingOutput.begin() + offset);
+    pendingOutputSize.store(pendingOutput.size(), std::memory_order_relaxed);
+    if (pendingOutput.empty())
+    {
+        loop->modify(fd, EPOLLIN | EPOLLRDHUP);
+    }
+}
+
+void SkyFdCommInterface::sendFromLoop(const unsigned char* data, const size_t length)
+{
+    if (false == connected)
+    {
+        return;
+    }
+    size_t offset = 0;
+    // keep order, when something is already buffered new data goes after it
+    while (pendingOutput.empty() && offset < length)
+    {
+        const ssize_t result = writeFd(data + offset, length - offset);
+        if (result > 0)
+        {
+            offset += result;
+        }
+        else if (result < 0 && EINTR != errno)
+        {
+            if (EAGAIN != errno && EWOULDBLOCK != errno)
+            {
+                handleWriteError();
+                return;
+            }
+            break;
+        }
+    }
+    if (offset < length)
+    {
+        const bool wasEmpty = pendingOutput.empty();
+        pendingOutput.insert(pendingOutput.end(), data + offset, data + length);
+        pendingOutputSize.store(pendingOutput.size(), std::memory_order_relaxed);
+        if (wasEmpty)
+        {
+            loop->modify(fd, EPOLLIN | EPOLLRDHUP | EPOLLOUT);
+        }
+    }
+}
+
+void SkyFdCommInterface::connectFromLoop(void)
+{
+    if (false == connected)
+    {
+        loop->watch(fd, EPOLLIN | EPOLLRDHUP, std::bind(&SkyFdCommInterface::handleEvents, this, std::placeholders::_1));
+        connected = true;
+        onConnected();
+    }
+}
+
+ssize_t SkyFdCommInterface::writeFd(const unsigned char* data, const size_t length)
+{
+    if (fdIsSocket)
+    {
+        return ::send(fd, data, length, MSG_NOSIGNAL);
+    }
+    // SIGPIPE is blocked in loop thread, so closed pipe ends with EPIPE
+    return write(fd, data, length);
+}
+
+void SkyFdCommInterface::handleWriteError(void)
+{
+    const std::string message = EPIPE == errno || ECONNRESET == errno
+            ? std::string("SkyFdCommInterface peer closed connection: ") + strerror(errno)
+            : std::string("SkyFdCommInterface write failed: ") + strerror(errno);
+    close();
+    onError(message);
+}
+
+void SkyFdCommInterface::close(void)
+{
+    loop->unwatch(fd);
+    connected = false;
+    pendingOutput.clear();
+    pendingOutputSize.store(0, std::memory_order_relaxed);
+    onDisconnected();
+}
+
+void SkyFdCommInterface::detach(void)
+{
+    // listener is not notified, interface is being destroyed
+    *self = nullptr;
+    if (connected)
+    {
+        loop->unwatch(fd);
+        connected = false;
+    }
+}
+
+#endif // __linux__
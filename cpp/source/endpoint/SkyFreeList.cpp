@@ -0,0 +1,62 @@
+#include "endpoint/SkyFreeList.hpp"
+
+#include <stdexcept>
+
+constexpr uint32_t SkyFreeList::EMPTY;
+
+SkyFreeList::SkyFreeList(const size_t _capacity):
+    capacity(_capacity),
+    head(pack(0, 0 == _capacity ? EMPTY : 0)),
+    next(new std::atomic<uint32_t>[_capacity])
+{
+    if (capacity >= EMPTY)
+    {
+        throw std::invalid_argument("SkyFreeList: capacity too big");
+    }
+    for (size_t i = 0; i < capacity; i++)
+    {
+        next[i].store(i + 1 < capacity ? (uint32_t)(i + 1) : EMPTY, std::memory_order_relaxed);
+    }
+}
+
+bool SkyFreeList::pop(size_t& index)
+{
+    uint64_t current = head.load(std::memory_order_acquire);
+    for (;;)
+    {
+        const uint32_t top = (uint32_t)current;
+        if (EMPTY == top)
+        {
+            return false;
+        }
+        const uint32_t below = next[top].load(std::memory_order_relaxed);
+        // acquire pairs with release of push, slot contents written before return are visible
+        if (head.compare_exchange_weak(current, pack((current >> 32) + 1, below),
+                                       std::memory_order_acquire, std::memory_order_acquire))
+        {
+            index = top;
+            return true;
+        }
+    }
+}
+
+void SkyFreeList::push(const size_t index)
+{
+    uint64_t current = head.load(std::memory_order_relaxed);
+    do
+    {
+        next[index].store((uint32_t)current, std::memory_order_relaxed);
+    }
+    while (false == head.compare_exchange_weak(current, pack((current >> 32) + 1, (uint32_t)index),
+                                               std::memory_order_release, std::memory_order_relaxed));
+}
+
+size_t SkyFreeList::getCapacity(void) const
+{
+    return capacity;
+}
+
+uint64_t SkyFreeList::pack(const uint64_t tag, const uint32_t index)
+{
+    return (tag << 32) | index;
+}
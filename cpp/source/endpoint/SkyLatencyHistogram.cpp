@@ -0,0 +1,103 @@
+#include "endpoint/SkyLatencyHistogram.hpp"
+
+SkyLatencyHistogram::SkyLatencyHistogram(void)
+{
+    reset();
+}
+
+void SkyLatencyHistogram::record(const uint64_t nanoseconds)
+{
+    buckets[bucketIndex(nanoseconds)].fetch_add(1, std::memory_order_relaxed);
+    count.fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(nanoseconds, std::memory_order_relaxed);
+    uint64_t current = max.load(std::memory_order_relaxed);
+    while (nanoseconds > current
+           && false == max.compare_exchange_weak(current, nanoseconds, std::memory_order_relaxed));
+}
+
+uint64_t SkyLatencyHistogram::getCount(void) const
+{
+    return count.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyLatencyHistogram::getMax(void) const
+{
+    return max.load(std::memory_order_relaxed);
+}
+
+double SkyLatencyHistogram::getMean(void) const
+{
+    const uint64_t samples = getCount();
+    return samples > 0 ? (double)sum.load(std::memory_order_relaxed) / samples : 0.0;
+}
+
+uint64_t SkyLatencyHistogram::getPercentile(const double quantile) const
+{
+    uint64_t total = 0;
+    for (unsigned i = 0; i < BUCKETS; i++)
+    {
+        total += buckets[i].load(std::memory_order_relaxed);
+    }
+    if (0 == total)
+    {
+        return 0;
+    }
+    const double q = quantile < 0.0 ? 0.0 : (quantile > 1.0 ? 1.0 : quantile);
+    uint64_t rank = (uint64_t)(q * total + 0.5);
+    rank = rank < 1 ? 1 : rank;
+    uint64_t seen = 0;
+    for (unsigned i = 0; i < BUCKETS; i++)
+    {
+        seen += buckets[i].load(std::memory_order_relaxed);
+        if (seen >= rank)
+        {
+            const uint64_t bound = bucketUpperBound(i);
+            const uint64_t maxValue = getMax();
+            return bound < maxValue ? bound : maxValue;
+        }
+    }
+    return getMax();
+}
+
+void SkyLatencyHistogram::reset(void)
+{
+    for (unsigned i = 0; i < BUCKETS; i++)
+    {
+        buckets[i].store(0, std::memory_order_relaxed);
+    }
+    count.store(0, std::memory_order_relaxed);
+    sum.store(0, std::memory_order_relaxed);
+    max.store(0, std::memory_order_relaxed);
+}
+
+unsigned SkyLatencyHistogram::bucketIndex(const uint64_t value)
+{
+    if (value < SUB_BUCKETS)
+    {
+        return (unsigned)value;
+    }
+    unsigned exponent = 63;
+#if defined(__GNUC__)
+    exponent = 63 - __builtin_clzll(value);
+#else
+    while (0 == (value & (1ULL << exponent)))
+    {
+        exponent--;
+    }
+#endif
+    // exponent >= SUB_BITS, top SUB_BITS bits below leading one select sub bucket
+    const unsigned sub = (unsigned)(value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1);
+    return (exponent - SUB_BITS + 1) * SUB_BUCKETS + sub;
+}
+
+uint64_t SkyLatencyHistogram::bucketUpperBound(const unsigned index)
+{
+    if (index < SUB_BUCKETS)
+    {
+        return index;
+    }
+    const unsigned exponent = index / SUB_BUCKETS + SUB_BITS - 1;
+    const uint64_t sub = index % SUB_BUCKETS;
+    const uint64_t lower = (1ULL << exponent) + (sub << (exponent - SUB_BITS));
+    return lower + (1ULL << (exponent - SUB_BITS)) - 1;
+}
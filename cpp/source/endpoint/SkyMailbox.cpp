@@ -0,0 +1,77 @@
+#include "endpoint/SkyMailbox.hpp"
+
+#include <thread>
+
+SkyMailbox::Node::Node(void):
+    next(nullptr)
+{
+}
+
+SkyMailbox::Node::~Node(void)
+{
+}
+
+SkyMailbox::SkyMailbox(void):
+    head(&stub),
+    tail(&stub)
+{
+}
+
+bool SkyMailbox::push(Node* node)
+{
+    node->next.store(nullptr, std::memory_order_relaxed);
+    Node* prev = head.exchange(node, std::memory_order_seq_cst);
+    // between exchange and this store queue is not consistent, consumer waits for link
+    prev->next.store(node, std::memory_order_release);
+    return prev == &stub;
+}
+
+SkyMailbox::Node* SkyMailbox::pop(void)
+{
+    for (;;)
+    {
+        Node* current = tail;
+        Node* next = current->next.load(std::memory_order_acquire);
+        if (&stub == current)
+        {
+            if (nullptr == next)
+            {
+                if (head.load(std::memory_order_acquire) == &stub)
+                {
+                    return nullptr;
+                }
+                // producer is linking node after stub
+                std::this_thread::yield();
+                continue;
+            }
+            tail = next;
+            current = next;
+            next = next->next.load(std::memory_order_acquire);
+        }
+        if (nullptr != next)
+        {
+            tail = next;
+            return current;
+        }
+        if (head.load(std::memory_order_acquire) == current)
+        {
+            // last node, stub is pushed back so current can be released
+            push(&stub);
+            next = current->next.load(std::memory_order_acquire);
+            if (nullptr != next)
+            {
+                tail = next;
+                return current;
+            }
+        }
+        // producer is linking node after current
+        std::this_thread::yield();
+    }
+}
+
+bool SkyMailbox::isEmpty(void) const
+{
+    // stub is pushed back only when last node is taken, so head points to it
+    // only when queue is empty, safe to call from any thread
+    return head.load(std::memory_order_seq_cst) == &stub;
+}
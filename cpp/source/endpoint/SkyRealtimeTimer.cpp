@@ -0,0 +1,229 @@
+#include "endpoint/SkyRealtimeTimer.hpp"
+
+#ifdef __linux__
+
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <poll.h>
+#include <pthread.h>
+#include <sched.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+SkyRealtimeTimer::Settings::Settings(const int _priority, const int _cpu, const bool _lockMemory):
+    priority(_priority),
+    cpu(_cpu),
+    lockMemory(_lockMemory)
+{
+}
+
+SkyRealtimeTimer::Shared::Shared(void):
+    timerFd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC)),
+    wakeFd(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)),
+    quit(false),
+    armed(false),
+    deadline(0),
+    period(0),
+    lastTick(0),
+    overruns(0)
+{
+}
+
+SkyRealtimeTimer::Shared::~Shared(void)
+{
+    if (timerFd >= 0)
+    {
+        close(timerFd);
+    }
+    if (wakeFd >= 0)
+    {
+        close(wakeFd);
+    }
+}
+
+SkyRealtimeTimer::SkyRealtimeTimer(std::function<void(void)> _exec, const Settings& settings):
+    ISkyTimer(_exec),
+    shared(new Shared())
+{
+    if (shared->timerFd < 0 || shared->wakeFd < 0)
+    {
+        throw std::runtime_error(std::string("SkyRealtimeTimer: can not create timerfd: ") + strerror(errno));
+    }
+    if (settings.lockMemory && mlockall(MCL_CURRENT | MCL_FUTURE) < 0)
+    {
+        throw std::runtime_error(std::string("SkyRealtimeTimer: mlockall failed: ") + strerror(errno));
+    }
+    thread = std::thread(&SkyRealtimeTimer::run, shared, this);
+    try
+    {
+        applySettings(settings);
+    }
+    catch (...)
+    {
+        shutdown();
+        throw;
+    }
+}
+
+SkyRealtimeTimer::~SkyRealtimeTimer(void)
+{
+    shutdown();
+}
+
+void SkyRealtimeTimer::start(const double freqency)
+{
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    shared->period = (int64_t)(1.0e9 / freqency);
+    shared->period = shared->period > 0 ? shared->period : 1;
+    shared->deadline = now() + shared->period;
+    shared->armed = true;
+
+    itimerspec spec;
+    spec.it_value.tv_sec = shared->deadline / 1000000000;
+    spec.it_value.tv_nsec = shared->deadline % 1000000000;
+    spec.it_interval.tv_sec = shared->period / 1000000000;
+    spec.it_interval.tv_nsec = shared->period % 1000000000;
+    if (timerfd_settime(shared->timerFd, TFD_TIMER_ABSTIME, &spec, nullptr) < 0)
+    {
+        throw std::runtime_error(std::string("SkyRealtimeTimer: can not arm timerfd: ") + strerror(errno));
+    }
+}
+
+void SkyRealtimeTimer::stop(void)
+{
+    std::lock_guard<std::mutex> lock(shared->mutex);
+    shared->armed = false;
+    itimerspec spec = {};
+    timerfd_settime(shared->timerFd, 0, &spec, nullptr);
+}
+
+void SkyRealtimeTimer::notifySent(void)
+{
+    const int64_t tick = shared->lastTick.load(std::memory_order_acquire);
+    if (0 != tick)
+    {
+        const int64_t latency = now() - tick;
+        shared->sendLatency.record(latency > 0 ? latency : 0);
+    }
+}
+
+const SkyLatencyHistogram& SkyRealtimeTimer::getLateness(void) const
+{
+    return shared->lateness;
+}
+
+const SkyLatencyHistogram& SkyRealtimeTimer::getSendLatency(void) const
+{
+    return shared->sendLatency;
+}
+
+uint64_t SkyRealtimeTimer::getOverrunsCount(void) const
+{
+    return shared->overruns;
+}
+
+void SkyRealtimeTimer::resetStatistics(void)
+{
+    shared->lateness.reset();
+    shared->sendLatency.reset();
+    shared->overruns = 0;
+}
+
+void SkyRealtimeTimer::run(std::shared_ptr<Shared> shared, SkyRealtimeTimer* const timer)
+{
+    pollfd fds[2];
+    fds[0].fd = shared->timerFd;
+    fds[0].events = POLLIN;
+    fds[1].fd = shared->wakeFd;
+    fds[1].events = POLLIN;
+    while (false == shared->quit)
+    {
+        if (poll(fds, 2, -1) < 0 || 0 == (fds[0].revents & POLLIN))
+        {
+            continue;
+        }
+        uint64_t expirations = 0;
+        if (read(shared->timerFd, &expirations, sizeof(expirations)) != sizeof(expirations))
+        {
+            continue;
+        }
+        const int64_t wakeTime = now();
+        {
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            if (false == shared->armed || 0 == expirations)
+            {
+                continue;
+            }
+            // deadline of last expiration reported by kernel
+            const int64_t expected = shared->deadline + (int64_t)(expirations - 1) * shared->period;
+            shared->deadline = expected + shared->period;
+            shared->lateness.record(wakeTime > expected ? wakeTime - expected : 0);
+            shared->overruns += expirations - 1;
+        }
+        shared->lastTick.store(wakeTime, std::memory_order_release);
+        if (false == shared->quit)
+        {
+            timer->onTimeout();
+        }
+    }
+}
+
+int64_t SkyRealtimeTimer::now(void)
+{
+    timespec time;
+    clock_gettime(CLOCK_MONOTONIC, &time);
+    return (int64_t)time.tv_sec * 1000000000 + time.tv_nsec;
+}
+
+void SkyRealtimeTimer::applySettings(const Settings& settings)
+{
+    if (settings.cpu >= 0)
+    {
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(settings.cpu, &cpuSet);
+        const int result = pthread_setaffinity_np(thread.native_handle(), sizeof(cpuSet), &cpuSet);
+        if (0 != result)
+        {
+            throw std::runtime_error(std::string("SkyRealtimeTimer: can not set affinity: ") + strerror(result));
+        }
+    }
+    if (settings.priority > 0)
+    {
+        sched_param param;
+        param.sched_priority = settings.priority;
+        const int result = pthread_setschedparam(thread.native_handle(), SCHED_FIFO, &param);
+        if (0 != result)
+        {
+            throw std::runtime_error(std::string("SkyRealtimeTimer: can not set SCHED_FIFO: ") + strerror(result));
+        }
+    }
+}
+
+void SkyRealtimeTimer::shutdown(void)
+{
+    if (false == thread.joinable())
+    {
+        return;
+    }
+    shared->quit = true;
+    const uint64_t value = 1;
+    while (write(shared->wakeFd, &value, sizeof(value)) < 0 && EINTR == errno);
+    if (std::this_thread::get_id() == thread.get_id())
+    {
+        // destroyed from own callback, thread exits using only shared state
+        thread.detach();
+    }
+    else
+    {
+        thread.join();
+    }
+}
+
+#endif // __linux__
@@ -0,0 +1,59 @@
+#include "endpoint/SkyRecordingCommInterface.hpp"
+
+SkyRecordingCommInterface::SkyRecordingCommInterface(ISkyCommInterface* const _interface,
+                                                     SkyCaptureWriter* const _writer):
+    interface(_interface),
+    writer(_writer)
+{
+    listener = nullptr;
+    interface->setListener(this);
+}
+
+SkyRecordingCommInterface::~SkyRecordingCommInterface(void)
+{
+}
+
+void SkyRecordingCommInterface::connect(void)
+{
+    interface->connect();
+}
+
+void SkyRecordingCommInterface::disconnect(void)
+{
+    interface->disconnect();
+}
+
+void SkyRecordingCommInterface::send(const unsigned char* data, const size_t length)
+{
+    writer->write(SkyCapture::SENT, data, length);
+    interface->send(data, length);
+}
+
+size_t SkyRecordingCommInterface::getSendQueueSize(void) const
+{
+    return interface->getSendQueueSize();
+}
+
+void SkyRecordingCommInterface::onConnected(void)
+{
+    writer->write(SkyCapture::CONNECTED, nullptr, 0);
+    ISkyCommInterface::onConnected();
+}
+
+void SkyRecordingCommInterface::onDisconnected(void)
+{
+    writer->write(SkyCapture::DISCONNECTED, nullptr, 0);
+    ISkyCommInterface::onDisconnected();
+}
+
+void SkyRecordingCommInterface::onError(const std::string& message)
+{
+    writer->write(SkyCapture::ERROR, reinterpret_cast<const unsigned char*>(message.data()), message.size());
+    ISkyCommInterface::onError(message);
+}
+
+void SkyRecordingCommInterface::onReceived(const unsigned char* data, const size_t length)
+{
+    writer->write(SkyCapture::RECEIVED, data, length);
+    ISkyCommInterface::onReceived(data, length);
+}
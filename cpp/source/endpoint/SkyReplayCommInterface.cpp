@@ -0,0 +1,128 @@
+#include "endpoint/SkyReplayCommInterface.hpp"
+
+#include <string>
+#include <thread>
+
+SkyReplayCommInterface::SkyReplayCommInterface(SkyCaptureReader* const _reader,
+                                               SkyVirtualClock* const _clock,
+                                               const Timing _timing):
+    reader(_reader),
+    clock(_clock),
+    timing(_timing),
+    connected(false),
+    started(false),
+    clockStart(0),
+    receivedBytes(0),
+    droppedBytes(0),
+    sentBytes(0)
+{
+    listener = nullptr;
+}
+
+SkyReplayCommInterface::~SkyReplayCommInterface(void)
+{
+}
+
+void SkyReplayCommInterface::connect(void)
+{
+    // connection event is replayed from capture
+    connected = true;
+}
+
+void SkyReplayCommInterface::disconnect(void)
+{
+    connected = false;
+}
+
+void SkyReplayCommInterface::send(const unsigned char*, const size_t length)
+{
+    sentBytes += length;
+}
+
+bool SkyReplayCommInterface::step(void)
+{
+    SkyCapture::Record record;
+    if (false == reader->next(record))
+    {
+        return false;
+    }
+    if (false == started)
+    {
+        started = true;
+        clockStart = nullptr != clock ? clock->now() : SkyVirtualClock::Duration(0);
+        wallStart = Clock::now();
+    }
+    if (ORIGINAL == timing)
+    {
+        std::this_thread::sleep_until(wallStart + record.time);
+    }
+    if (nullptr != clock)
+    {
+        clock->advanceTo(clockStart + record.time);
+    }
+    switch (record.type)
+    {
+    case SkyCapture::RECEIVED:
+        if (connected && nullptr != listener)
+        {
+            receivedBytes += record.length;
+            onReceived(record.data, record.length);
+        }
+        else
+        {
+            droppedBytes += record.length;
+        }
+        break;
+
+    case SkyCapture::CONNECTED:
+        if (connected && nullptr != listener)
+        {
+            onConnected();
+        }
+        break;
+
+    case SkyCapture::DISCONNECTED:
+        if (nullptr != listener)
+        {
+            onDisconnected();
+        }
+        break;
+
+    case SkyCapture::ERROR:
+        if (nullptr != listener)
+        {
+            onError(std::string(reinterpret_cast<const char*>(record.data), record.length));
+        }
+        break;
+
+    default:
+        // sent data is produced by listener itself
+        break;
+    }
+    return true;
+}
+
+uint64_t SkyReplayCommInterface::replay(void)
+{
+    uint64_t count = 0;
+    while (step())
+    {
+        count++;
+    }
+    return count;
+}
+
+uint64_t SkyReplayCommInterface::getReceivedBytes(void) const
+{
+    return receivedBytes;
+}
+
+uint64_t SkyReplayCommInterface::getDroppedBytes(void) const
+{
+    return droppedBytes;
+}
+
+uint64_t SkyReplayCommInterface::getSentBytes(void) const
+{
+    return sentBytes;
+}
@@ -0,0 +1,272 @@
+#include "endpoint/SkyTimerWheel.hpp"
+
+#include <cmath>
+
+SkyTimerWheel::Timer::Timer(SkyTimerWheel* const _wheel, std::function<void(void)> _exec):
+    ISkyTimer(_exec),
+    wheel(_wheel),
+    linked(false),
+    level(0),
+    slot(0),
+    expiry(0),
+    period(1)
+{
+    prev = next = nullptr;
+}
+
+SkyTimerWheel::Timer::~Timer(void)
+{
+    stop();
+}
+
+void SkyTimerWheel::Timer::start(const double freqency)
+{
+    if (linked)
+    {
+        wheel->unlink(this);
+    }
+    else
+    {
+        wheel->activeTimersCount++;
+    }
+    const double ticks = 1.0 / (freqency * std::chrono::duration<double>(wheel->tickDuration).count());
+    period = ticks < 1.0 ? 1 : (ticks > 4294967295.0 ? 4294967295ULL : (uint64_t)std::llround(ticks));
+    const uint64_t nowTick = wheel->toTick(Clock::now());
+    expiry = (nowTick > wheel->currentTick ? nowTick : wheel->currentTick) + period;
+    wheel->schedule(this);
+}
+
+void SkyTimerWheel::Timer::stop(void)
+{
+    if (linked)
+    {
+        wheel->unlink(this);
+        wheel->activeTimersCount--;
+    }
+}
+
+bool SkyTimerWheel::Timer::isActive(void) const
+{
+    return linked;
+}
+
+SkyTimerWheel::SkyTimerWheel(const Clock::duration _tickDuration):
+    tickDuration(_tickDuration),
+    startTime(Clock::now()),
+    currentTick(0),
+    activeTimersCount(0)
+{
+    for (unsigned l = 0; l < LEVELS; l++)
+    {
+        for (unsigned s = 0; s < SLOTS; s++)
+        {
+            slots[l][s].prev = slots[l][s].next = &slots[l][s];
+        }
+        for (unsigned w = 0; w < BITMAP_WORDS; w++)
+        {
+            occupied[l][w] = 0;
+        }
+    }
+    pending.prev = pending.next = &pending;
+}
+
+SkyTimerWheel::~SkyTimerWheel(void)
+{
+}
+
+ISkyTimer* SkyTimerWheel::createTimer(std::function<void(void)> exec)
+{
+    return new Timer(this, exec);
+}
+
+void SkyTimerWheel::advance(void)
+{
+    advance(Clock::now());
+}
+
+void SkyTimerWheel::advance(const Clock::time_point now)
+{
+    const uint64_t target = toTick(now);
+    while (currentTick < target)
+    {
+        if (0 == activeTimersCount)
+        {
+            currentTick = target;
+            break;
+        }
+        // empty slots up to next occupied one or next cascade are skipped
+        const unsigned index = currentTick & SLOT_MASK;
+        const int found = index + 1 < SLOTS ? findOccupied(0, index + 1) : -1;
+        const uint64_t distance = found >= 0 ? found - index : SLOTS - index;
+        const uint64_t left = target - currentTick;
+        currentTick += (distance < left ? distance : left) - 1;
+        processTick();
+    }
+}
+
+SkyTimerWheel::Clock::duration SkyTimerWheel::getTimeToNextExpiry(void) const
+{
+    if (0 == activeTimersCount)
+    {
+        return Clock::duration(-1);
+    }
+    const unsigned index = currentTick & SLOT_MASK;
+    const int found = index + 1 < SLOTS ? findOccupied(0, index + 1) : -1;
+    const uint64_t distance = found >= 0 ? found - index : SLOTS - index;
+    const Clock::duration left = startTime + tickDuration * (currentTick + distance) - Clock::now();
+    return left > Clock::duration::zero() ? left : Clock::duration::zero();
+}
+
+uint64_t SkyTimerWheel::getCurrentTick(void) const
+{
+    return currentTick;
+}
+
+unsigned SkyTimerWheel::getActiveTimersCount(void) const
+{
+    return activeTimersCount;
+}
+
+SkyTimerWheel::Clock::duration SkyTimerWheel::getTickDuration(void) const
+{
+    return tickDuration;
+}
+
+uint64_t SkyTimerWheel::toTick(const Clock::time_point time) const
+{
+    return time > startTime ? (uint64_t)((time - startTime) / tickDuration) : 0;
+}
+
+void SkyTimerWheel::schedule(Timer* timer)
+{
+    const uint64_t delta = timer->expiry > currentTick ? timer->expiry - currentTick : 0;
+    unsigned level = 0;
+    while (level + 1 < LEVELS && delta >= (1ULL << (SLOT_BITS * (level + 1))))
+    {
+        level++;
+    }
+    const uint64_t expiry = delta > 0 ? timer->expiry : currentTick;
+    timer->level = level;
+    timer->slot = (expiry >> (SLOT_BITS * level)) & SLOT_MASK;
+    link(&slots[level][timer->slot], timer);
+    occupied[level][timer->slot / 64] |= 1ULL << (timer->slot % 64);
+}
+
+void SkyTimerWheel::link(Node* head, Timer* timer)
+{
+    timer->prev = head->prev;
+    timer->next = head;
+    head->prev->next = timer;
+    head->prev = timer;
+    timer->linked = true;
+}
+
+void SkyTimerWheel::unlink(Timer* timer)
+{
+    timer->prev->next = timer->next;
+    timer->next->prev = timer->prev;
+    timer->prev = timer->next = nullptr;
+    timer->linked = false;
+    if (timer->level < LEVELS)
+    {
+        const Node& head = slots[timer->level][timer->slot];
+        if (head.next == &head)
+        {
+            occupied[timer->level][timer->slot / 64] &= ~(1ULL << (timer->slot % 64));
+        }
+    }
+}
+
+void SkyTimerWheel::moveSlot(const unsigned level, const unsigned slot)
+{
+    Node& head = slots[level][slot];
+    if (head.next == &head)
+    {
+        return;
+    }
+    // splice whole slot to pending list
+    pending.next = head.next;
+    pending.prev = head.prev;
+    pending.next->prev = &pending;
+    pending.prev->next = &pending;
+    head.prev = head.next = &head;
+    occupied[level][slot / 64] &= ~(1ULL << (slot % 64));
+    for (Node* node = pending.next; node != &pending; node = node->next)
+    {
+        static_cast<Timer*>(node)->level = LEVELS;
+    }
+}
+
+void SkyTimerWheel::processTick(void)
+{
+    currentTick++;
+    const unsigned index = currentTick & SLOT_MASK;
+    if (0 == index)
+    {
+        // cascade timers from upper levels down to their exact slots
+        for (unsigned level = 1; level < LEVELS; level++)
+        {
+            const unsigned levelIndex = (currentTick >> (SLOT_BITS * level)) & SLOT_MASK;
+            moveSlot(level, levelIndex);
+            while (pending.next != &pending)
+            {
+                Timer* timer = static_cast<Timer*>(pending.next);
+                unlink(timer);
+                schedule(timer);
+            }
+            if (0 != levelIndex)
+            {
+                break;
+            }
+        }
+    }
+
+    moveSlot(0, index);
+    while (pending.next != &pending)
+    {
+        Timer* timer = static_cast<Timer*>(pending.next);
+        unlink(timer);
+        if (timer->expiry <= currentTick)
+        {
+            // rescheduled before callback, it can stop, restart or destroy timer
+            timer->expiry += timer->period;
+            if (timer->expiry <= currentTick)
+            {
+                timer->expiry = currentTick + timer->period;
+            }
+            schedule(timer);
+            timer->onTimeout();
+        }
+        else
+        {
+            schedule(timer);
+        }
+    }
+}
+
+int SkyTimerWheel::findOccupied(const unsigned level, const unsigned from) const
+{
+    unsigned word = from / 64;
+    uint64_t bits = occupied[level][word] & (~0ULL << (from % 64));
+    for (;;)
+    {
+        if (0 != bits)
+        {
+#if defined(__GNUC__)
+            return word * 64 + __builtin_ctzll(bits);
+#else
+            unsigned bit = 0;
+            while (0 == (bits & (1ULL << bit)))
+            {
+                bit++;
+            }
+            return word * 64 + bit;
+#endif
+        }
+        if (++word >= BITMAP_WORDS)
+        {
+            return -1;
+        }
+        bits = occupied[level][word];
+    }
+}
@@ -0,0 +1,195 @@
+#include "endpoint/SkyVirtualClock.hpp"
+
+#include <cmath>
+
+constexpr size_t SkyVirtualClock::Timer::NOT_SCHEDULED;
+
+SkyVirtualClock::Timer::Timer(SkyVirtualClock* const _clock, std::function<void(void)> _exec):
+    ISkyTimer(_exec),
+    clock(_clock),
+    heapIndex(NOT_SCHEDULED),
+    expiry(0),
+    period(1),
+    sequence(0)
+{
+}
+
+SkyVirtualClock::Timer::~Timer(void)
+{
+    stop();
+}
+
+void SkyVirtualClock::Timer::start(const double freqency)
+{
+    if (NOT_SCHEDULED != heapIndex)
+    {
+        clock->unschedule(this);
+    }
+    const double nanoseconds = 1e9 / freqency;
+    period = Duration(nanoseconds < 1.0 ? 1 : (nanoseconds > 9.2e18 ? INT64_MAX : std::llround(nanoseconds)));
+    expiry = clock->time + period;
+    clock->schedule(this);
+}
+
+void SkyVirtualClock::Timer::stop(void)
+{
+    if (NOT_SCHEDULED != heapIndex)
+    {
+        clock->unschedule(this);
+    }
+}
+
+bool SkyVirtualClock::Timer::isActive(void) const
+{
+    return NOT_SCHEDULED != heapIndex;
+}
+
+SkyVirtualClock::SkyVirtualClock(void):
+    time(0),
+    sequence(0)
+{
+}
+
+SkyVirtualClock::~SkyVirtualClock(void)
+{
+    // timers left alive are only detached
+    for (Timer* timer : heap)
+    {
+        timer->heapIndex = Timer::NOT_SCHEDULED;
+    }
+}
+
+ISkyTimer* SkyVirtualClock::createTimer(std::function<void(void)> exec)
+{
+    return new Timer(this, exec);
+}
+
+SkyVirtualClock::Duration SkyVirtualClock::now(void) const
+{
+    return time;
+}
+
+size_t SkyVirtualClock::advanceTo(const Duration _time)
+{
+    size_t fired = 0;
+    while (false == heap.empty() && heap.front()->expiry <= _time)
+    {
+        Timer* timer = heap.front();
+        time = timer->expiry;
+        // periodic timer is rescheduled before callback, so callback can stop or destroy it
+        unschedule(timer);
+        timer->expiry += timer->period;
+        schedule(timer);
+        fired++;
+        timer->onTimeout();
+    }
+    if (_time > time)
+    {
+        time = _time;
+    }
+    return fired;
+}
+
+size_t SkyVirtualClock::advanceBy(const Duration duration)
+{
+    return advanceTo(time + duration);
+}
+
+size_t SkyVirtualClock::advanceToNext(void)
+{
+    if (heap.empty())
+    {
+        return 0;
+    }
+    return advanceTo(heap.front()->expiry);
+}
+
+bool SkyVirtualClock::getNextExpiry(Duration& expiry) const
+{
+    if (heap.empty())
+    {
+        return false;
+    }
+    expiry = heap.front()->expiry;
+    return true;
+}
+
+unsigned SkyVirtualClock::getActiveTimersCount(void) const
+{
+    return (unsigned)heap.size();
+}
+
+void SkyVirtualClock::schedule(Timer* timer)
+{
+    timer->sequence = sequence++;
+    heap.push_back(timer);
+    timer->heapIndex = heap.size() - 1;
+    siftUp(timer->heapIndex);
+}
+
+void SkyVirtualClock::unschedule(Timer* timer)
+{
+    const size_t index = timer->heapIndex;
+    Timer* last = heap.back();
+    heap.pop_back();
+    timer->heapIndex = Timer::NOT_SCHEDULED;
+    if (last != timer)
+    {
+        place(last, index);
+        siftUp(index);
+        siftDown(last->heapIndex);
+    }
+}
+
+bool SkyVirtualClock::isEarlier(const Timer* first, const Timer* second) const
+{
+    return first->expiry < second->expiry
+            || (first->expiry == second->expiry && first->sequence < second->sequence);
+}
+
+void SkyVirtualClock::place(Timer* timer, const size_t index)
+{
+    heap[index] = timer;
+    timer->heapIndex = index;
+}
+
+void SkyVirtualClock::siftUp(size_t index)
+{
+    Timer* timer = heap[index];
+    while (index > 0)
+    {
+        const size_t parent = (index - 1) / 2;
+        if (false == isEarlier(timer, heap[parent]))
+        {
+            break;
+        }
+        place(heap[parent], index);
+        index = parent;
+    }
+    place(timer, index);
+}
+
+void SkyVirtualClock::siftDown(size_t index)
+{
+    Timer* timer = heap[index];
+    const size_t size = heap.size();
+    while (true)
+    {
+        size_t child = 2 * index + 1;
+        if (child >= size)
+        {
+            break;
+        }
+        if (child + 1 < size && isEarlier(heap[child + 1], heap[child]))
+        {
+            child++;
+        }
+        if (false == isEarlier(heap[child], timer))
+        {
+            break;
+        }
+        place(heap[child], index);
+        index = child;
+    }
+    place(timer, index);
+}
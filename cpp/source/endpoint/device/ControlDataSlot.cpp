@@ -0,0 +1,28 @@
+#include "endpoint/device/ControlDataSlot.hpp"
+
+ControlDataSlot::ControlDataSlot(void):
+    middle(1),
+    back(0),
+    front(2)
+{
+}
+
+void ControlDataSlot::write(const ControlData& data)
+{
+    buffers[back] = data;
+    back = middle.exchange(back | FRESH, std::memory_order_acq_rel) & INDEX_MASK;
+}
+
+const ControlData& ControlDataSlot::read(void)
+{
+    if (middle.load(std::memory_order_relaxed) & FRESH)
+    {
+        front = middle.exchange(front, std::memory_order_acq_rel) & INDEX_MASK;
+    }
+    return buffers[front];
+}
+
+bool ControlDataSlot::hasUpdate(void) const
+{
+    return 0 != (middle.load(std::memory_order_relaxed) & FRESH);
+}
@@ -57,7 +57,7 @@ std::string DeviceEvent::toString(void) const
     case CALIBRATE_ESC_DONE: return "CALIBRATE_ESC_DONE";
     case CALIBRATE_ESC_ENDED: return "CALIBRATE_ESC_ENDED";
     default:
-        throw std::runtime_error("UavEvent::toString:Unexpected event type");
+        return "UNKNOWN";
     }
 }
 
@@ -132,11 +132,13 @@ std::string DeviceEventSent::toString(void) const
 
 DeviceEventConnectionStatus::DeviceEventConnectionStatus(const unsigned _ping,
                                                          const unsigned _received,
-                                                         const unsigned _fails) :
+                                                         const unsigned _fails,
+                                                         const SkyLinkQuality::Figures& _linkQuality) :
     DeviceEvent(CONNECTION_STATUS),
     ping(_ping),
     received(_received),
-    fails(_fails)
+    fails(_fails),
+    linkQuality(_linkQuality)
 {
 }
 
@@ -155,9 +157,21 @@ unsigned DeviceEventConnectionStatus::getFails(void) const
     return fails;
 }
 
+const SkyLinkQuality::Figures& DeviceEventConnectionStatus::getLinkQuality(void) const
+{
+    return linkQuality;
+}
+
 std::string DeviceEventConnectionStatus::toString(void) const
 {
-    return DeviceEvent::toString() + ": " + std::to_string(ping) + " ms";
+    if (false == linkQuality.valid)
+    {
+        return DeviceEvent::toString() + ": " + std::to_string(ping) + " ms";
+    }
+    return DeviceEvent::toString() + ": " + std::to_string(ping) + " ms, srtt: "
+            + std::to_string(linkQuality.smoothedRtt / 1000.0f) + " ms, rttvar: "
+            + std::to_string(linkQuality.rttVariance / 1000.0f) + " ms, loss: "
+            + std::to_string((unsigned)(linkQuality.lossRate * 100.0f + 0.5f)) + "%";
 }
 
 DeviceEventUpgradeStarted::DeviceEventUpgradeStarted(const CalibrationSettings::BoardType _type) :
@@ -0,0 +1,323 @@
+#include "endpoint/device/DeviceEventRecord.hpp"
+
+#include "communication/ISignalPayloadMessage.hpp"
+
+#include <new>
+
+namespace
+{
+
+// heap copy of any message, used for signal payloads and legacy events
+IMessage* cloneMessage(const IMessage& message)
+{
+    switch (message.getMessageType())
+    {
+    case IMessage::CONTROL_DATA:
+        return new ControlData(static_cast<const ControlData&>(message));
+
+    case IMessage::DEBUG_DATA:
+        return new DebugData(static_cast<const DebugData&>(message));
+
+    case IMessage::SENSORS_DATA:
+        return new SensorsData(static_cast<const SensorsData&>(message));
+
+    case IMessage::AUTOPILOT_DATA:
+        return new AutopilotData(static_cast<const AutopilotData&>(message));
+
+    case IMessage::SIGNAL_DATA:
+        return new SignalData(static_cast<const SignalData&>(message));
+
+    default:
+        if (message.isSignalPayloadMessage())
+        {
+            return static_cast<const ISignalPayloadMessage&>(message).clone();
+        }
+        SkyError(SkyError::MESSAGE_NOT_COPIED, message).raise();
+    }
+}
+
+}
+
+thread_local const SkyDevice* DeviceEventRecord::currentOrigin = nullptr;
+
+DeviceEventRecord::OriginScope::OriginScope(const SkyDevice* const origin):
+    previous(currentOrigin)
+{
+    currentOrigin = origin;
+}
+
+DeviceEventRecord::OriginScope::~OriginScope(void)
+{
+    currentOrigin = previous;
+}
+
+DeviceEventRecord::DeviceEventRecord(void):
+    DeviceEventRecord(DeviceEvent::MESSAGE)
+{
+}
+
+DeviceEventRecord::DeviceEventRecord(const DeviceEvent::Type _type):
+    type(_type),
+    origin(currentOrigin),
+    message(nullptr),
+    textType(DeviceEventMessage::INFO),
+    ping(0),
+    received(0),
+    fails(0),
+    boardType(CalibrationSettings::TYPE_UNKNOWN)
+{
+}
+
+DeviceEventRecord::DeviceEventRecord(const DeviceEvent::Type _type, const IMessage& _message):
+    DeviceEventRecord(_type)
+{
+    setMessage(_message);
+}
+
+DeviceEventRecord::DeviceEventRecord(const DeviceEventMessage::MessageType _textType, const std::string& _text):
+    DeviceEventRecord(DeviceEvent::MESSAGE)
+{
+    textType = _textType;
+    text = _text;
+}
+
+DeviceEventRecord::DeviceEventRecord(const SkyError& _error):
+    DeviceEventRecord(DeviceEvent::MESSAGE)
+{
+    textType = DeviceEventMessage::ERROR;
+    error = _error;
+}
+
+DeviceEventRecord::DeviceEventRecord(const unsigned _ping, const unsigned _received, const unsigned _fails,
+                                     const SkyLinkQuality::Figures& _linkQuality):
+    DeviceEventRecord(DeviceEvent::CONNECTION_STATUS)
+{
+    ping = _ping;
+    received = _received;
+    fails = _fails;
+    linkQuality = _linkQuality;
+}
+
+DeviceEventRecord::DeviceEventRecord(const DeviceEvent::Type _type, const CalibrationSettings::BoardType _boardType):
+    DeviceEventRecord(_type)
+{
+    boardType = _boardType;
+}
+
+DeviceEventRecord::DeviceEventRecord(const DeviceEventRecord& other):
+    type(other.type),
+    origin(other.origin),
+    message(nullptr),
+    textType(other.textType),
+    text(other.text),
+    error(other.error),
+    ping(other.ping),
+    received(other.received),
+    fails(other.fails),
+    linkQuality(other.linkQuality),
+    boardType(other.boardType)
+{
+    setMessage(other);
+}
+
+DeviceEventRecord& DeviceEventRecord::operator=(const DeviceEventRecord& other)
+{
+    if (this != &other)
+    {
+        resetMessage();
+        type = other.type;
+        origin = other.origin;
+        textType = other.textType;
+        text = other.text;
+        error = other.error;
+        ping = other.ping;
+        received = other.received;
+        fails = other.fails;
+        linkQuality = other.linkQuality;
+        boardType = other.boardType;
+        setMessage(other);
+    }
+    return *this;
+}
+
+DeviceEventRecord::~DeviceEventRecord(void)
+{
+    resetMessage();
+}
+
+DeviceEvent::Type DeviceEventRecord::getType(void) const
+{
+    return type;
+}
+
+bool DeviceEventRecord::hasMessage(void) const
+{
+    return nullptr != message;
+}
+
+const IMessage& DeviceEventRecord::getMessage(void) const
+{
+    if (nullptr == message)
+    {
+        SkyError(SkyError::NO_MESSAGE).raise();
+    }
+    return *message;
+}
+
+DeviceEventMessage::MessageType DeviceEventRecord::getTextType(void) const
+{
+    return textType;
+}
+
+const std::string& DeviceEventRecord::getText(void) const
+{
+    if (error.isError() && text.empty())
+    {
+        text = error.toString();
+    }
+    return text;
+}
+
+const SkyError& DeviceEventRecord::getError(void) const
+{
+    return error;
+}
+
+unsigned DeviceEventRecord::getPing(void) const
+{
+    return ping;
+}
+
+unsigned DeviceEventRecord::getReceived(void) const
+{
+    return received;
+}
+
+unsigned DeviceEventRecord::getFails(void) const
+{
+    return fails;
+}
+
+const SkyLinkQuality::Figures& DeviceEventRecord::getLinkQuality(void) const
+{
+    return linkQuality;
+}
+
+CalibrationSettings::BoardType DeviceEventRecord::getBoardType(void) const
+{
+    return boardType;
+}
+
+const SkyDevice* DeviceEventRecord::getOrigin(void) const
+{
+    return origin;
+}
+
+std::unique_ptr<const DeviceEvent> DeviceEventRecord::toDeviceEvent(void) const
+{
+    switch (type)
+    {
+    case DeviceEvent::MESSAGE:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventMessage(textType, getText()));
+
+    case DeviceEvent::DATA_RECEIVED:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventReceived(*cloneMessage(getMessage())));
+
+    case DeviceEvent::DATA_SENT:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventSent(*cloneMessage(getMessage())));
+
+    case DeviceEvent::CONNECTION_STATUS:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventConnectionStatus(ping, received, fails, linkQuality));
+
+    case DeviceEvent::WHO_AM_I:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventWhoAmI(boardType));
+
+    case DeviceEvent::UPGRADE_STARTED:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEventUpgradeStarted(boardType));
+
+    default:
+        return std::unique_ptr<const DeviceEvent>(new DeviceEvent(type));
+    }
+}
+
+std::string DeviceEventRecord::toString(void) const
+{
+    const std::string name = DeviceEvent(type).toString();
+    switch (type)
+    {
+    case DeviceEvent::MESSAGE:
+        return name + " with:\n\"" + getText() + "\"";
+
+    case DeviceEvent::DATA_RECEIVED:
+    case DeviceEvent::DATA_SENT:
+        return name + " with: " + (nullptr != message ? message->getMessageName() : "none");
+
+    case DeviceEvent::CONNECTION_STATUS:
+        return DeviceEventConnectionStatus(ping, received, fails, linkQuality).toString();
+
+    case DeviceEvent::WHO_AM_I:
+    case DeviceEvent::UPGRADE_STARTED:
+        return name + ": " + CalibrationSettings::getBoardTypeString(boardType);
+
+    default:
+        return name;
+    }
+}
+
+void DeviceEventRecord::setMessage(const IMessage& source)
+{
+    switch (source.getMessageType())
+    {
+    case IMessage::CONTROL_DATA:
+        message = new (storage) ControlData(static_cast<const ControlData&>(source));
+        break;
+
+    case IMessage::DEBUG_DATA:
+        message = new (storage) DebugData(static_cast<const DebugData&>(source));
+        break;
+
+    case IMessage::SENSORS_DATA:
+        message = new (storage) SensorsData(static_cast<const SensorsData&>(source));
+        break;
+
+    case IMessage::AUTOPILOT_DATA:
+        message = new (storage) AutopilotData(static_cast<const AutopilotData&>(source));
+        break;
+
+    case IMessage::SIGNAL_DATA:
+        message = new (storage) SignalData(static_cast<const SignalData&>(source));
+        break;
+
+    default:
+        heapMessage.reset(cloneMessage(source));
+        message = heapMessage.get();
+    }
+}
+
+void DeviceEventRecord::setMessage(const DeviceEventRecord& source)
+{
+    if (nullptr == source.message)
+    {
+        return;
+    }
+    if (source.heapMessage)
+    {
+        // signal payloads are immutable, copies share them
+        heapMessage = source.heapMessage;
+        message = heapMessage.get();
+    }
+    else
+    {
+        setMessage(*source.message);
+    }
+}
+
+void DeviceEventRecord::resetMessage(void)
+{
+    if (nullptr != message && message != heapMessage.get())
+    {
+        message->~IMessage();
+    }
+    heapMessage.reset();
+    message = nullptr;
+}
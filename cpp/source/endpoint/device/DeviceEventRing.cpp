@@ -0,0 +1,99 @@
+#include "endpoint/device/DeviceEventRing.hpp"
+
+DeviceEventRing::DeviceEventRing(const size_t _capacity):
+    mask(roundUpCapacity(_capacity) - 1),
+    cells(new Cell[mask + 1]),
+    enqueuePosition(0),
+    dequeuePosition(0),
+    rejectedCount(0)
+{
+    for (size_t i = 0; i <= mask; i++)
+    {
+        cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+DeviceEventRing::~DeviceEventRing(void)
+{
+}
+
+bool DeviceEventRing::push(const DeviceEventRecord& record)
+{
+    size_t position = enqueuePosition.load(std::memory_order_relaxed);
+    for (;;)
+    {
+        Cell& cell = cells[position & mask];
+        const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+        const intptr_t difference = (intptr_t)sequence - (intptr_t)position;
+        if (0 == difference)
+        {
+            if (enqueuePosition.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+            {
+                cell.record = record;
+                cell.sequence.store(position + 1, std::memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0)
+        {
+            rejectedCount.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        else
+        {
+            position = enqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+}
+
+bool DeviceEventRing::pop(DeviceEventRecord& record)
+{
+    const size_t position = dequeuePosition.load(std::memory_order_relaxed);
+    Cell& cell = cells[position & mask];
+    if (cell.sequence.load(std::memory_order_acquire) != position + 1)
+    {
+        // empty or producer still copying record
+        return false;
+    }
+    record = cell.record;
+    dequeuePosition.store(position + 1, std::memory_order_relaxed);
+    cell.sequence.store(position + mask + 1, std::memory_order_release);
+    return true;
+}
+
+size_t DeviceEventRing::drain(DeviceEventRecord* records, const size_t maxCount)
+{
+    size_t count = 0;
+    while (count < maxCount && pop(records[count]))
+    {
+        count++;
+    }
+    return count;
+}
+
+size_t DeviceEventRing::size(void) const
+{
+    const size_t enqueued = enqueuePosition.load(std::memory_order_relaxed);
+    const size_t dequeued = dequeuePosition.load(std::memory_order_relaxed);
+    return enqueued > dequeued ? enqueued - dequeued : 0;
+}
+
+size_t DeviceEventRing::getCapacity(void) const
+{
+    return mask + 1;
+}
+
+uint64_t DeviceEventRing::getRejectedCount(void) const
+{
+    return rejectedCount.load(std::memory_order_relaxed);
+}
+
+size_t DeviceEventRing::roundUpCapacity(const size_t capacity)
+{
+    size_t result = 2;
+    while (result < capacity)
+    {
+        result <<= 1;
+    }
+    return result;
+}
@@ -1,7 +1,17 @@
 #include "endpoint/device/ISkyDeviceMonitor.hpp"
 
+#include <cstdio>
+#include <cstdlib>
+#include <stdexcept>
+
 ISkyDeviceMonitor::~ISkyDeviceMonitor()
 {
+    if (eventDelivery && eventDelivery->isRunning())
+    {
+        // derived part is gone, delivery thread would call its notifyDeviceEvents
+        std::fputs("ISkyDeviceMonitor: batch delivery not stopped by derived destructor\n", stderr);
+        std::abort();
+    }
 }
 
 void ISkyDeviceMonitor::notifyDeviceEvent(const DeviceEvent* const event)
@@ -9,8 +19,118 @@ void ISkyDeviceMonitor::notifyDeviceEvent(const DeviceEvent* const event)
     notifyDeviceEvent(std::unique_ptr<const DeviceEvent>(event));
 }
 
+void ISkyDeviceMonitor::notifyDeviceEvent(std::unique_ptr<const DeviceEvent>)
+{
+    // consumers of event ring do not need legacy events, for any other monitor
+    // reaching this default means events are lost
+    if (nullptr == eventRing)
+    {
+        std::fputs("ISkyDeviceMonitor: notifyDeviceEvent not overridden and event ring not enabled\n", stderr);
+        std::abort();
+    }
+}
+
+void ISkyDeviceMonitor::notifyDeviceEvent(const DeviceEventRecord& event)
+{
+    if (eventDelivery)
+    {
+        eventDelivery->publish(event);
+    }
+    else if (eventRing)
+    {
+        eventRing->push(event);
+    }
+    else
+    {
+        notifyDeviceEvent(event.toDeviceEvent());
+    }
+}
+
+void ISkyDeviceMonitor::notifyDeviceEvents(const DeviceEventRecord* events, const size_t count)
+{
+    for (size_t i = 0; i < count; i++)
+    {
+        notifyDeviceEvent(events[i].toDeviceEvent());
+    }
+}
+
+void ISkyDeviceMonitor::enableBatchDelivery(const size_t capacity, const size_t maxBatch)
+{
+    eventDelivery.reset(new SkyEventDelivery(this, capacity, maxBatch));
+}
+
+void ISkyDeviceMonitor::startBatchDelivery(void)
+{
+    if (nullptr == eventDelivery)
+    {
+        throw std::logic_error("ISkyDeviceMonitor: batch delivery not enabled");
+    }
+    eventDelivery->start();
+}
+
+void ISkyDeviceMonitor::stopBatchDelivery(void)
+{
+    if (eventDelivery)
+    {
+        eventDelivery->stop();
+    }
+}
+
+size_t ISkyDeviceMonitor::deliverDeviceEvents(void)
+{
+    return eventDelivery ? eventDelivery->deliver() : 0;
+}
+
+const SkyEventDelivery* ISkyDeviceMonitor::getEventDelivery(void) const
+{
+    return eventDelivery.get();
+}
+
+void ISkyDeviceMonitor::enableEventRing(const size_t capacity)
+{
+    eventRing.reset(new DeviceEventRing(capacity));
+}
+
+size_t ISkyDeviceMonitor::drainDeviceEvents(DeviceEventRecord* events, const size_t maxCount)
+{
+    return eventRing ? eventRing->drain(events, maxCount) : 0;
+}
+
+uint64_t ISkyDeviceMonitor::getRejectedEventsCount(void) const
+{
+    return eventRing ? eventRing->getRejectedCount() : 0;
+}
+
 double ISkyDeviceMonitor::getControlDataSendingFreq(void)
 {
     // by default return 25 Hz's
     return 25.0;
 }
+
+void ISkyDeviceMonitor::pushControlData(const ControlData& controlData)
+{
+    controlDataSlot.write(controlData);
+}
+
+ControlData ISkyDeviceMonitor::getPushedControlData(void)
+{
+    return controlDataSlot.read();
+}
+
+size_t ISkyDeviceMonitor::deliverTraces(void)
+{
+    SkyTrace::Record records[64];
+    size_t delivered = 0;
+    size_t count;
+    do
+    {
+        count = SkyTrace::drain(records, 64);
+        for (size_t i = 0; i < count; i++)
+        {
+            trace(SkyTrace::format(records[i]));
+        }
+        delivered += count;
+    }
+    while (64 == count);
+    return delivered;
+}
@@ -18,6 +18,11 @@ PilotEvent::Type PilotEvent::getType(void) const
 }
 
 std::string PilotEvent::toString(void) const
+{
+    return toString(type);
+}
+
+std::string PilotEvent::toString(const Type type)
 {
     switch (type)
     {
@@ -37,9 +42,9 @@ std::string PilotEvent::toString(void) const
     case RADIO_CHECK_DONE: return "RADIO_CHECK_DONE";
     case RADIO_CALIBRATION_BREAK: return "RADIO_CALIBRATION_BREAK";
     case RADIO_CALIBRATION_DONE: return "RADIO_CALIBRATION_DONE";
-    case RADIO_CALIBRATION_SKIP: return "RADIO_CHECK_DONE";
+    case RADIO_CALIBRATION_SKIP: return "RADIO_CALIBRATION_SKIP";
     default:
-        throw std::runtime_error("UserUavEvent::toString:Unexpected event type");
+        return "UNKNOWN";
     }
 }
 
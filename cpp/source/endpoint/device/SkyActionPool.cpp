@@ -0,0 +1,68 @@
+#include "endpoint/device/SkyActionPool.hpp"
+
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+constexpr size_t SkyActionPool::SLOTS_CAPACITY;
+
+SkyActionPool::SkyActionPool(void):
+    reusedCount(0)
+{
+    slots.reserve(SLOTS_CAPACITY);
+}
+
+SkyActionPool::~SkyActionPool(void)
+{
+    for (Slot& slot : slots)
+    {
+        if (slot.used)
+        {
+            slot.action->~ISkyDeviceAction();
+        }
+        ::operator delete(slot.storage);
+    }
+}
+
+void SkyActionPool::release(ISkyDeviceAction* const action)
+{
+    for (Slot& slot : slots)
+    {
+        if (slot.used && slot.action == action)
+        {
+            action->~ISkyDeviceAction();
+            slot.action = nullptr;
+            slot.used = false;
+            return;
+        }
+    }
+    delete action;
+}
+
+size_t SkyActionPool::getSlotsCount(void) const
+{
+    return slots.size();
+}
+
+uint64_t SkyActionPool::getReusedCount(void) const
+{
+    return reusedCount;
+}
+
+size_t SkyActionPool::acquire(const void* type, const size_t size)
+{
+    for (size_t i = 0; i < slots.size(); i++)
+    {
+        if (false == slots[i].used && type == slots[i].type)
+        {
+            slots[i].used = true;
+            reusedCount++;
+            return i;
+        }
+    }
+    Slot slot;
+    slot.type = type;
+    slot.storage = ::operator new(size);
+    slot.action = nullptr;
+    slot.used = true;
+    slots.push_back(slot);
+    return slots.size() - 1;
+}
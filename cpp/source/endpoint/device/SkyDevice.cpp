@@ -5,22 +5,124 @@
 #include "endpoint/device/actions/IdleAction.hpp"
 
 #include <stdlib.h>
+#include <cstring>
+#include <algorithm>
 #include <functional>
 
+constexpr size_t SkyDevice::MailboxItem::CHUNK_CAPACITY;
+constexpr size_t SkyDevice::ITEM_POOL_SIZE;
+
+SkyDevice::MailboxItem::MailboxItem(const Type _type):
+    type(_type),
+    length(0),
+    endOfChunk(true),
+    timerId(0),
+    timerGeneration(0)
+{
+}
+
+SkyDevice::MailboxTimer::MailboxTimer(SkyDevice* const _device, std::function<void(void)> _exec):
+    ISkyTimer(_exec),
+    device(_device),
+    id(++device->timersCounter),
+    generation(0),
+    running(false)
+{
+    device->timers[id] = this;
+    timer.reset(device->monitor->createTimer([this]()
+    {
+        // called by timer thread, only posts tick
+        MailboxItem* item = device->acquireItem(MailboxItem::TIMER_TICK);
+        item->timerId = id;
+        item->timerGeneration = generation;
+        device->post(item);
+    }));
+}
+
+SkyDevice::MailboxTimer::~MailboxTimer(void)
+{
+    timer.reset();
+    device->timers.erase(id);
+}
+
+void SkyDevice::MailboxTimer::start(const double freqency)
+{
+    generation++;
+    running = true;
+    timer->start(freqency);
+}
+
+void SkyDevice::MailboxTimer::stop(void)
+{
+    generation++;
+    running = false;
+    timer->stop();
+}
+
+void SkyDevice::MailboxTimer::fire(const unsigned _generation) const
+{
+    if (running && _generation == generation)
+    {
+        onTimeout();
+    }
+}
+
+void SkyDevice::MailboxTimer::reset(std::function<void(void)> _exec)
+{
+    stop();
+    setTimeoutHandler(_exec);
+}
+
 SkyDevice::SkyDevice(ISkyDeviceMonitor* const _monitor,
                      const double _pingFreq,
                      const double _controlFreq,
-                     const double _connectionTimeout) :
+                     const double _connectionTimeout,
+                     ISkyExecutor* const _executor) :
     monitor(_monitor),
+    executor(_executor),
+    interface(nullptr),
+    draining(false),
+    itemPool(new MailboxItem[ITEM_POOL_SIZE]),
+    freeItems(ITEM_POOL_SIZE),
+    timersCounter(0),
+    action(nullptr),
+    dwellAction(nullptr),
+    dwellState(nullptr),
     pingFreq(_pingFreq),
     controlFreq(_controlFreq),
     connectionTimeoutFreq(1 / _connectionTimeout),
-    pingTimer(monitor->createTimer(std::bind(&SkyDevice::pingTimerHandler, this))),
-    connetionTimer(monitor->createTimer(std::bind(&SkyDevice::connectionTimerHandler, this)))
+    pingSequence(0),
+    receptionFeed(false),
+    connectionLost(false),
+    transmitPending(false)
 {
-    action = std::make_shared<IdleAction>(this);
+    pingTimer.reset(createTimer(std::bind(&SkyDevice::pingTimerHandler, this)));
+    connetionTimer.reset(createTimer(std::bind(&SkyDevice::connectionTimerHandler, this)));
+    transmitTimer.reset(createTimer(std::bind(&SkyDevice::pumpTransmission, this)));
 
-    std::srand(std::time(0));
+    retiredActions.reserve(2);
+    action = actionPool.create<IdleAction>(this);
+    state = action->getType();
+}
+
+SkyDevice::~SkyDevice(void)
+{
+    // timers have to be released before registry
+    retireAction();
+    releaseRetiredActions();
+    for (MailboxTimer* timer : idleTimers)
+    {
+        delete timer;
+    }
+    pingTimer.reset();
+    connetionTimer.reset();
+    transmitTimer.reset();
+
+    SkyMailbox::Node* node;
+    while (nullptr != (node = mailbox.pop()))
+    {
+        releaseItem(static_cast<MailboxItem*>(node));
+    }
 }
 
 void SkyDevice::pushPilotEvent(const PilotEvent* const pilotEvent)
@@ -30,73 +132,387 @@ void SkyDevice::pushPilotEvent(const PilotEvent* const pilotEvent)
 
 void SkyDevice::pushPilotEvent(std::unique_ptr<const PilotEvent> pilotEvent)
 {
-    notifyPilotEvent(action, pilotEvent.get());
+    MailboxItem* item = acquireItem(MailboxItem::PILOT_EVENT);
+    item->pilotEvent = std::move(pilotEvent);
+    post(item);
 }
 
 ISkyDeviceAction::Type SkyDevice::getState(void) const
 {
-    return action->getType();
+    return state;
 }
 
-void SkyDevice::notifyPilotEvent(std::shared_ptr<ISkyDeviceAction> guard,
-                                    const PilotEvent* const operatorEvent)
+const SkyTelemetryStore& SkyDevice::getTelemetry(void) const
 {
-    monitor->trace("Handling pilot event: " + operatorEvent->toString() + " at: " + guard->getName());
-    std::unique_lock<std::mutex>(actionLock);
-    guard->handleUserEvent(*operatorEvent);
+    return telemetry;
 }
 
-void SkyDevice::notifyReception(std::shared_ptr<ISkyDeviceAction> guard,
-                                const IMessage* const message)
+const SkyLinkQuality& SkyDevice::getLinkQuality(void) const
 {
-    //monitor->trace("HandleReception reception: " + message->getMessageName() + " at: " + guard->getName());
+    return linkQuality;
+}
 
-    receptionFeed = true;
-    if (connectionLost)
+void SkyDevice::setLinkThroughput(const unsigned bytesPerSecond)
+{
+    linkQuality.setThroughput(bytesPerSecond);
+    transmitScheduler.setBitrate(bytesPerSecond);
+}
+
+void SkyDevice::enableRateControl(const SkyRateController::Settings& settings)
+{
+    rateController.reset(new SkyRateController(settings, controlFreq));
+}
+
+const SkyRateController* SkyDevice::getRateController(void) const
+{
+    return rateController.get();
+}
+
+const SkyReceptionStage& SkyDevice::getReceptionStage(void) const
+{
+    return receptionStage;
+}
+
+const SkyMetrics& SkyDevice::getMetrics(void) const
+{
+    return metrics;
+}
+
+SkyDevice::MailboxItem* SkyDevice::acquireItem(const MailboxItem::Type type)
+{
+    MailboxItem* item;
+    size_t index;
+    if (freeItems.pop(index))
     {
-        connectionLost = false;
-        monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CONNECTION_RECOVERED));
+        item = &itemPool[index];
+    }
+    else
+    {
+        // pool exhausted by burst of inputs
+        item = new MailboxItem();
     }
+    item->type = type;
+    return item;
+}
 
+void SkyDevice::releaseItem(MailboxItem* item)
+{
+    if (item < itemPool.get() || item >= itemPool.get() + ITEM_POOL_SIZE)
+    {
+        delete item;
+        return;
+    }
+    item->length = 0;
+    item->endOfChunk = true;
+    item->pilotEvent.reset();
+    item->message.clear();
+    freeItems.push(item - itemPool.get());
+}
+
+void SkyDevice::post(MailboxItem* item)
+{
+    const bool wasEmpty = mailbox.push(item);
+    if (nullptr == executor || executor->isCurrentThread())
+    {
+        drain();
+    }
+    else if (wasEmpty)
+    {
+        // one drain task is enough for all items posted until mailbox is empty again
+        // lambda fits into std::function without allocation
+        executor->execute([this]() { drain(); });
+    }
+}
+
+void SkyDevice::drain(void)
+{
+    // thread that wins the flag processes all items, including posted by other threads
+    // in the meantime, after release mailbox is checked again so no item is left behind
+    while (false == draining.exchange(true))
+    {
+        const DeviceEventRecord::OriginScope originScope(this);
+        SkyMailbox::Node* node;
+        while (nullptr != (node = mailbox.pop()))
+        {
+            MailboxItem* item = static_cast<MailboxItem*>(node);
+            process(*item);
+            releaseItem(item);
+        }
+        draining = false;
+        if (mailbox.isEmpty())
+        {
+            break;
+        }
+    }
+}
+
+void SkyDevice::process(const MailboxItem& item)
+{
+#ifdef __SKYDIVE_NO_EXCEPTIONS__
+    handleItem(item);
+#else
     try
     {
-        std::unique_lock<std::mutex>(actionLock);
-        guard->baseHandleReception(std::unique_ptr<const IMessage>(message));
+        handleItem(item);
+    }
+    catch (const SkyError::Exception& e)
+    {
+        onError(e.getError());
     }
     catch (const std::runtime_error& e)
     {
-        handleError(e.what());
+        // actions and monitors that still throw, first error is handled
+        if (false == pendingError.isError())
+        {
+            handleError(e.what());
+        }
+    }
+#endif // __SKYDIVE_NO_EXCEPTIONS__
+    if (pendingError.isError())
+    {
+        const SkyError error = pendingError;
+        pendingError = SkyError();
+        handleError(error);
+    }
+    releaseRetiredActions();
+    updateStateDwell();
+}
+
+void SkyDevice::handleItem(const MailboxItem& item)
+{
+    switch (item.type)
+    {
+    case MailboxItem::RECEPTION:
+        notifyReception(item.data, item.length, item.endOfChunk);
+        break;
+
+    case MailboxItem::PILOT_EVENT:
+        notifyPilotEvent(item.pilotEvent.get());
+        break;
+
+    case MailboxItem::TIMER_TICK:
+    {
+        auto it = timers.find(item.timerId);
+        if (timers.end() != it)
+        {
+            it->second->fire(item.timerGeneration);
+        }
+        break;
+    }
+
+    case MailboxItem::CONNECTED:
+        SkyTrace::info(SkyTrace::DEVICE_CONNECTED);
+        action->start();
+        break;
+
+    case MailboxItem::DISCONNECTED:
+        SkyTrace::info(SkyTrace::DEVICE_DISCONNECTED);
+        transmitScheduler.clear();
+        break;
+
+    case MailboxItem::ERROR:
+        handleError(item.message);
+        break;
     }
 }
 
+void SkyDevice::retireAction(void)
+{
+    if (nullptr != action)
+    {
+        retiredActions.push_back(action);
+        action = nullptr;
+    }
+}
+
+void SkyDevice::releaseRetiredActions(void)
+{
+    for (ISkyDeviceAction* retired : retiredActions)
+    {
+        actionPool.release(retired);
+    }
+    retiredActions.clear();
+}
+
+void SkyDevice::notifyPilotEvent(const PilotEvent* const operatorEvent)
+{
+    SkyTrace::debug(SkyTrace::PILOT_EVENT, operatorEvent->getType(), action->getType(), action->getStateName());
+    action->handleUserEvent(*operatorEvent);
+}
+
+void SkyDevice::notifyReception(const unsigned char* data, const size_t length, const bool endOfChunk)
+{
+    // whole chunk is framed before any message is handled
+    IMessage::PreambleType receivedPreamble;
+    for (unsigned i = 0; i < length; i++)
+    {
+        receivedPreamble = dispatcher.putChar(data[i]);
+        if (IMessage::EMPTY != receivedPreamble)
+        {
+            frameMessage(receivedPreamble);
+        }
+    }
+    metrics.onChunk(length);
+    metrics.setReceptionFailures(dispatcher.getCrcFailures(),
+                                 dispatcher.getPreambleCollisions(),
+                                 dispatcher.getIncompletePayloads());
+    if (endOfChunk)
+    {
+        handleReceptionStage();
+    }
+}
+
+void SkyDevice::frameMessage(const IMessage::PreambleType preamble)
+{
+    // flight loop messages are copied to stage by value, only signal payloads are created on heap
+    switch (preamble)
+    {
+    case IMessage::CONTROL:
+        switch (action->getExpectedControlMessageType())
+        {
+        case IMessage::DEBUG_DATA:
+            stageMessage(dispatcher.getDebugData());
+            break;
+
+        case IMessage::CONTROL_DATA:
+            stageMessage(dispatcher.getControlData());
+            break;
+
+        case IMessage::SENSORS_DATA:
+            stageMessage(dispatcher.getSensorsData());
+            break;
+
+        default:
+            break;
+        }
+        break;
+
+    case IMessage::AUTOPILOT:
+        stageMessage(dispatcher.getAutopilotData());
+        break;
+
+    case IMessage::SIGNAL:
+        if (SignalData::hasPayload(dispatcher.getCommand()))
+        {
+            std::unique_ptr<const IMessage> message(dispatcher.retriveSignalMessage());
+            if (message)
+            {
+                stageMessage(*message);
+            }
+        }
+        else
+        {
+            stageMessage(dispatcher.getSignalData());
+        }
+        break;
+
+    default:
+        break;
+    }
+}
+
+void SkyDevice::stageMessage(const IMessage& message)
+{
+    metrics.onFrame(SkyMetrics::RECEIVED, message.getMessageType(), message.getMessageSize());
+    receptionStage.push(message);
+}
+
+void SkyDevice::handleReceptionStage(void)
+{
+    const ISkyDeviceAction* const receivingAction = action;
+    DeviceEventRecord record;
+    // messages left after error are dropped with the stage
+    while (false == pendingError.isError() && receptionStage.pop(record))
+    {
+        notifyReception(record.getMessage());
+        if (action != receivingAction)
+        {
+            // telemetry was framed for finished action
+            receptionStage.dropTelemetry();
+        }
+    }
+}
+
+void SkyDevice::notifyReception(const IMessage& message)
+{
+    //monitor->trace("HandleReception reception: " + message->getMessageName() + " at: " + action->getName());
+
+    receptionFeed = true;
+    if (connectionLost)
+    {
+        connectionLost = false;
+        monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CONNECTION_RECOVERED));
+    }
+
+    telemetry.update(message);
+
+    // action can change during reception handling, replaced one is released later
+    action->baseHandleReception(message);
+}
+
 void SkyDevice::handleError(const std::string& message)
 {
-    monitor->trace("SkyDevice::handleError: " + message);
+    SkyTrace::error(SkyTrace::INTERFACE_ERROR);
+    handleError(DeviceEventRecord(DeviceEventMessage::ERROR, message));
+}
+
+void SkyDevice::handleError(const SkyError& error)
+{
+    // text of error is formatted only when consumer reads it
+    SkyTrace::error(SkyTrace::ACTION_ERROR, error.getDescriptor().name, error.getAction(), error.getState());
+    handleError(DeviceEventRecord(error));
+}
+
+void SkyDevice::handleError(const DeviceEventRecord& errorEvent)
+{
     enablePingTask(false);
     enableConnectionTimeoutTask(false);
-    std::shared_ptr<ISkyDeviceAction> newAction = std::make_shared<IdleAction>(this);
-    std::unique_lock<std::mutex>(actionLock);
-    action.swap(newAction);
-    monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::ERROR, message));
-    interface->disconnect();
+    transmitScheduler.clear();
+    receptionStage.clear();
+    retireAction();
+    action = actionPool.create<IdleAction>(this);
+    state = action->getType();
+    monitor->notifyDeviceEvent(errorEvent);
+    if (nullptr != interface)
+    {
+        interface->disconnect();
+    }
 }
 
 void SkyDevice::pingTimerHandler(void)
 {
-    sentPingValue = std::rand() * 163;
-    sentPingTime = clock();
-    send(SignalData(SignalData::PING_VALUE, sentPingValue));
+    if (linkQuality.expire() > 0)
+    {
+        updateRateController();
+    }
+    pingSequence = (pingSequence + 1) & 0x7FFFFFFF;
+    linkQuality.onPingSent(pingSequence);
+    send(SignalData(SignalData::PING_VALUE, pingSequence));
 }
 
-void SkyDevice::handlePong(const SignalData& signalData) const
+void SkyDevice::handlePong(const SignalData& signalData)
 {
-    if (signalData.getParameterValue() == sentPingValue)
+    if (linkQuality.onPongReceived(signalData.getParameterValue()))
     {
-        unsigned ping = (unsigned)(((clock() - sentPingTime) / 2.0f) + 0.5f);
-        monitor->notifyDeviceEvent(new DeviceEventConnectionStatus(
+        updateRateController();
+        const SkyLinkQuality::Figures figures = linkQuality.getFigures();
+        const unsigned ping = (unsigned)(figures.lastRtt / 2000.0f + 0.5f);
+        monitor->notifyDeviceEvent(DeviceEventRecord(
                                        ping,
                                        dispatcher.getSucessfullReceptions(),
-                                       dispatcher.getFailedReceptions()));
+                                       dispatcher.getFailedReceptions(),
+                                       figures));
+    }
+}
+
+void SkyDevice::updateRateController(void)
+{
+    if (rateController)
+    {
+        rateController->update(linkQuality.getFigures(),
+                               dispatcher.getSucessfullReceptions(),
+                               dispatcher.getFailedReceptions(),
+                               nullptr != interface ? interface->getSendQueueSize() : 0);
     }
 }
 
@@ -109,7 +525,7 @@ void SkyDevice::connectionTimerHandler(void)
         {
             // first time
             connectionLost = true;
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CONNECTION_LOST));
+            monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CONNECTION_LOST));
         }
     }
     receptionFeed = false;
@@ -117,32 +533,33 @@ void SkyDevice::connectionTimerHandler(void)
 
 void SkyDevice::onConnected()
 {
-    monitor->trace("SkyDevice::onConnected");
-    std::unique_lock<std::mutex>(actionLock);
-    action->start();
+    post(acquireItem(MailboxItem::CONNECTED));
 }
 
 void SkyDevice::onDisconnected()
 {
-    monitor->trace("SkyDevice::onDisconnected");
+    post(acquireItem(MailboxItem::DISCONNECTED));
 }
 
 void SkyDevice::onError(const std::string& message)
 {
-    handleError(message);
+    // called by interface and by actions, in both cases error is handled
+    // after ongoing item, when action is not on stack anymore
+    MailboxItem* item = acquireItem(MailboxItem::ERROR);
+    item->message = message;
+    post(item);
 }
 
 void SkyDevice::onReceived(const unsigned char* data, const size_t length)
 {
-    IMessage::PreambleType receivedPreamble;
-    for (unsigned i = 0; i < length; i++)
+    // chunks are posted by the same thread one by one, so order is preserved
+    for (size_t offset = 0; offset < length; offset += MailboxItem::CHUNK_CAPACITY)
     {
-        receivedPreamble = dispatcher.putChar(data[i]);
-        if (IMessage::EMPTY != receivedPreamble)
-        {
-            notifyReception(action, dispatcher.retriveMessage(
-                                receivedPreamble, action->getExpectedControlMessageType()));
-        }
+        MailboxItem* item = acquireItem(MailboxItem::RECEPTION);
+        item->length = std::min(MailboxItem::CHUNK_CAPACITY, length - offset);
+        item->endOfChunk = offset + item->length >= length;
+        std::memcpy(item->data, data + offset, item->length);
+        post(item);
     }
 }
 
@@ -151,31 +568,54 @@ ISkyDeviceMonitor* SkyDevice::getMonitor(void)
     return monitor;
 }
 
+ISkyTimer* SkyDevice::createTimer(std::function<void(void)> exec)
+{
+    if (idleTimers.empty())
+    {
+        return new MailboxTimer(this, exec);
+    }
+    MailboxTimer* timer = idleTimers.back();
+    idleTimers.pop_back();
+    timer->reset(exec);
+    return timer;
+}
+
+void SkyDevice::releaseTimer(ISkyTimer* timer)
+{
+    MailboxTimer* mailboxTimer = static_cast<MailboxTimer*>(timer);
+    mailboxTimer->reset(nullptr);
+    idleTimers.push_back(mailboxTimer);
+}
+
 bool SkyDevice::setupProtocolVersion(const unsigned version)
 {
-    monitor->trace("Setting up protocol version: " + std::to_string(version) +
-                   ", compiled version: " + std::to_string(IMessage::PROTOCOL_VERSION));
+    SkyTrace::info(SkyTrace::PROTOCOL_VERSION, version, IMessage::PROTOCOL_VERSION);
     // TODO currenty protocol version handling is not supported
     return IMessage::PROTOCOL_VERSION == version;
 }
 
+SkyActionPool& SkyDevice::getActionPool(void)
+{
+    return actionPool;
+}
+
 void SkyDevice::startAction(ISkyDeviceAction* newAction, bool immediateStart)
 {
-    monitor->trace("Starting new action: " + newAction->getName());
+    SkyTrace::info(SkyTrace::ACTION_STARTED, newAction->getType(), newAction->getStateName());
 
     if (false == action->isActionDone())
     {
-        std::string message = "Previous action (" + action->getName() +
-                ") not done, when performing: " + newAction->getName() + ".";
-        throw std::runtime_error(message.c_str());
+        onError(SkyError(SkyError::ACTION_NOT_DONE, newAction->getType())
+                .at(ISkyDeviceAction::toString(action->getType()), action->getStateName()));
+        actionPool.release(newAction);
+        return;
     }
 
-    std::shared_ptr<ISkyDeviceAction> newActionGuard(newAction);
-
-    std::unique_lock<std::mutex>(actionLock);
     action->end();
 
-    action.swap(newActionGuard);
+    retireAction();
+    action = newAction;
+    state = action->getType();
 
     if (immediateStart)
     {
@@ -188,19 +628,94 @@ void SkyDevice::onPongReception(const SignalData& pong)
     handlePong(pong);
 }
 
+void SkyDevice::onSignalResponse(const SignalData::Command command,
+                                 const std::chrono::steady_clock::duration roundTrip)
+{
+    metrics.recordSignalRoundTrip(command, roundTrip);
+}
+
+void SkyDevice::onError(const SkyError& error)
+{
+    // called only by executor, when mailbox item is handled
+    if (false == pendingError.isError())
+    {
+        pendingError = error;
+    }
+}
+
 void SkyDevice::send(const IMessage& message)
 {
     message.serializeMessage(messageBuildingBuffer);
-    interface->send(messageBuildingBuffer, message.getMessageSize());
+    transmit(SkyTransmitScheduler::getPriority(message), message.getMessageType(), message.getMessageSize());
 }
 
 void SkyDevice::send(const ISignalPayloadMessage& message)
 {
+    // payload frames are interleaved with time critical frames by scheduler
     ISignalPayloadMessage::MessagesBuilder builder(&message);
     while (builder.hasNext())
     {
         builder.getNext(messageBuildingBuffer);
-        interface->send(messageBuildingBuffer, IMessage::SIGNAL_DATA_MESSAGE_SIZE);
+        transmit(SkyTransmitScheduler::BULK, message.getMessageType(), IMessage::SIGNAL_DATA_MESSAGE_SIZE);
+    }
+}
+
+void SkyDevice::transmit(const SkyTransmitScheduler::Priority priority,
+                         const IMessage::MessageType type,
+                         const size_t length)
+{
+    metrics.onFrame(SkyMetrics::SENT, type, length);
+    if (transmitScheduler.send(priority, type, messageBuildingBuffer, length) || transmitPending)
+    {
+        pumpTransmission();
+    }
+    else
+    {
+        updateSendQueueMetrics();
+    }
+}
+
+void SkyDevice::pumpTransmission(void)
+{
+    SkyTransmitScheduler::Clock::duration wait;
+    if (transmitScheduler.pump(wait))
+    {
+        transmitTimer->start(1.0 / std::chrono::duration<double>(wait).count());
+        transmitPending = true;
+    }
+    else if (transmitPending)
+    {
+        transmitTimer->stop();
+        transmitPending = false;
+    }
+    updateSendQueueMetrics();
+}
+
+void SkyDevice::updateSendQueueMetrics(void)
+{
+    size_t frames = 0;
+    for (unsigned i = 0; i < SkyTransmitScheduler::PRIORITIES_COUNT; i++)
+    {
+        frames += transmitScheduler.getQueuedCount(static_cast<SkyTransmitScheduler::Priority>(i));
+    }
+    metrics.setSendQueue(frames, nullptr != interface ? interface->getSendQueueSize() : 0);
+}
+
+void SkyDevice::updateStateDwell(void)
+{
+    // names are static, state changed when pointers differ
+    const char* const actionName = ISkyDeviceAction::toString(action->getType());
+    const char* const stateName = action->getStateName();
+    if (actionName != dwellAction || stateName != dwellState)
+    {
+        const SkyMetrics::Clock::time_point now = SkyMetrics::Clock::now();
+        if (nullptr != dwellState)
+        {
+            metrics.recordStateDwell(dwellAction, dwellState, now - dwellStart);
+        }
+        dwellAction = actionName;
+        dwellState = stateName;
+        dwellStart = now;
     }
 }
 
@@ -208,12 +723,13 @@ void SkyDevice::enablePingTask(bool enable)
 {
     if (enable)
     {
-        monitor->trace("Starting ping task");
+        SkyTrace::debug(SkyTrace::PING_TASK_STARTED);
+        linkQuality.reset();
         pingTimer->start(pingFreq);
     }
     else
     {
-        monitor->trace("Ending ping task");
+        SkyTrace::debug(SkyTrace::PING_TASK_ENDED);
         pingTimer->stop();
     }
 }
@@ -222,12 +738,12 @@ void SkyDevice::enableConnectionTimeoutTask(bool enable)
 {
     if (enable)
     {
-        monitor->trace("Starting connection timeout task");
+        SkyTrace::debug(SkyTrace::CONNECTION_TIMEOUT_TASK_STARTED);
         connetionTimer->start(connectionTimeoutFreq);
     }
     else
     {
-        monitor->trace("Ending connection timeout task");
+        SkyTrace::debug(SkyTrace::CONNECTION_TIMEOUT_TASK_ENDED);
         connetionTimer->stop();
     }
 }
@@ -235,6 +751,7 @@ void SkyDevice::enableConnectionTimeoutTask(bool enable)
 void SkyDevice::connectInterface(ISkyCommInterface* _interface)
 {
     interface = _interface;
+    transmitScheduler.setInterface(interface);
     interface->setListener(this);
     interface->connect();
 }
@@ -0,0 +1,186 @@
+#include "endpoint/device/SkyError.hpp"
+
+#include "communication/SignalData.hpp"
+
+#include "endpoint/device/PilotEvent.hpp"
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+#include <cstdlib>
+
+const SkyError::Descriptor SkyError::DESCRIPTORS[CODES_COUNT] =
+{
+    {NONE, "NONE", "No error", NO_DETAIL},
+    {UNEXPECTED_MESSAGE, "UNEXPECTED_MESSAGE", "Message received in unexpected state", MESSAGE},
+    {UNEXPECTED_SIGNAL_PARAMETER, "UNEXPECTED_SIGNAL_PARAMETER", "Unexpected signal parameter received", PARAMETER},
+    {UNEXPECTED_PILOT_EVENT, "UNEXPECTED_PILOT_EVENT", "Unexpected pilot event received", PILOT_EVENT},
+    {UNEXPECTED_TIMEOUT, "UNEXPECTED_TIMEOUT", "Unexpected timeout event occurred", NO_DETAIL},
+    {UNEXPECTED_ACTION, "UNEXPECTED_ACTION", "Unexpected action to start", ACTION},
+    {UNSUPPORTED_PROTOCOL, "UNSUPPORTED_PROTOCOL", "Target uses unsupported SkyComm protocol version, "
+                                                   "cannot proceed with connection procedure", VALUE},
+    {SIGNAL_TIMEOUT, "SIGNAL_TIMEOUT", "Timeout waiting for signal", SIGNAL},
+    {SIGNAL_PAYLOAD_RECEPTION, "SIGNAL_PAYLOAD_RECEPTION", "Error while receiving signal payload", COMMAND},
+    {SIGNAL_PAYLOAD_UPLOAD, "SIGNAL_PAYLOAD_UPLOAD", "Retransmission counter exceeded "
+                                                     "when uploading signal payload", PARAMETER},
+    {UNEXPECTED_PAYLOAD_TYPE, "UNEXPECTED_PAYLOAD_TYPE", "Unexpected type of signal payload", VALUE},
+    {ACTION_NOT_DONE, "ACTION_NOT_DONE", "Previous action not done when starting next one", ACTION},
+    {INVALID_TRANSITION, "INVALID_TRANSITION", "Invalid transition in state machine", VALUE},
+    {INVALID_EVENT_ACCESS, "INVALID_EVENT_ACCESS", "Action event does not hold accessed input", VALUE},
+    {NO_MESSAGE, "NO_MESSAGE", "Device event has no message", NO_DETAIL},
+    {MESSAGE_NOT_COPIED, "MESSAGE_NOT_COPIED", "Message can not be copied into device event", MESSAGE},
+    {FRAME_TOO_LONG, "FRAME_TOO_LONG", "Frame too long to be sent", VALUE}
+};
+
+SkyError::SkyError(void):
+    SkyError(NONE)
+{
+}
+
+SkyError::SkyError(const Code _code, const int _value, const int _command, const int _parameter):
+    code(_code),
+    action(""),
+    state(""),
+    value(_value),
+    command(_command),
+    parameter(_parameter)
+{
+}
+
+SkyError::SkyError(const Code _code, const IMessage& message):
+    SkyError(_code, message.getMessageType())
+{
+    if (IMessage::SIGNAL_DATA == message.getMessageType())
+    {
+        command = static_cast<const SignalData&>(message).getCommand();
+        parameter = static_cast<const SignalData&>(message).getParameter();
+    }
+}
+
+SkyError& SkyError::at(const char* const _action, const char* const _state)
+{
+    action = _action;
+    state = _state;
+    return *this;
+}
+
+bool SkyError::isError(void) const
+{
+    return NONE != code;
+}
+
+SkyError::Code SkyError::getCode(void) const
+{
+    return code;
+}
+
+const SkyError::Descriptor& SkyError::getDescriptor(void) const
+{
+    return getDescriptor(code);
+}
+
+int SkyError::getValue(void) const
+{
+    return value;
+}
+
+int SkyError::getCommand(void) const
+{
+    return command;
+}
+
+int SkyError::getParameter(void) const
+{
+    return parameter;
+}
+
+const char* SkyError::getAction(void) const
+{
+    return action;
+}
+
+const char* SkyError::getState(void) const
+{
+    return state;
+}
+
+std::string SkyError::toString(void) const
+{
+    const Descriptor& descriptor = getDescriptor();
+    std::string text = descriptor.text;
+    if ('\0' != *action)
+    {
+        text += std::string(" at ") + action + " @ " + state;
+    }
+    switch (descriptor.detail)
+    {
+    case MESSAGE:
+        text += " message: " + IMessage::toString(static_cast<IMessage::MessageType>(value));
+        if (IMessage::SIGNAL_DATA == value)
+        {
+            text += " (" + SignalData::toString(static_cast<SignalData::Command>(command)) + ", " +
+                    SignalData::toString(static_cast<SignalData::Parameter>(parameter)) + ")";
+        }
+        break;
+
+    case SIGNAL:
+        text += ": " + SignalData::toString(static_cast<SignalData::Command>(value));
+        if (value == command)
+        {
+            text += " after sending: (" + SignalData::toString(static_cast<SignalData::Command>(command)) + ", " +
+                    SignalData::toString(static_cast<SignalData::Parameter>(parameter)) + ")";
+        }
+        break;
+
+    case COMMAND:
+        text += " command: " + SignalData::toString(static_cast<SignalData::Command>(value));
+        break;
+
+    case PARAMETER:
+        text += " parameter: " + SignalData::toString(static_cast<SignalData::Parameter>(value));
+        break;
+
+    case PILOT_EVENT:
+        text += " event: " + PilotEvent::toString(static_cast<PilotEvent::Type>(value));
+        break;
+
+    case ACTION:
+        text += std::string(" action: ") + ISkyDeviceAction::toString(static_cast<ISkyDeviceAction::Type>(value));
+        break;
+
+    case VALUE:
+        text += " value: " + std::to_string(value);
+        break;
+
+    default:
+        break;
+    }
+    return text;
+}
+
+void SkyError::raise(void) const
+{
+#ifdef __SKYDIVE_NO_EXCEPTIONS__
+    std::abort();
+#else
+    throw Exception(*this);
+#endif // __SKYDIVE_NO_EXCEPTIONS__
+}
+
+const SkyError::Descriptor& SkyError::getDescriptor(const Code code)
+{
+    return code < CODES_COUNT ? DESCRIPTORS[code] : DESCRIPTORS[NONE];
+}
+
+#ifndef __SKYDIVE_NO_EXCEPTIONS__
+
+SkyError::Exception::Exception(const SkyError& _error):
+    std::runtime_error(_error.toString()),
+    error(_error)
+{
+}
+
+const SkyError& SkyError::Exception::getError(void) const
+{
+    return error;
+}
+
+#endif // __SKYDIVE_NO_EXCEPTIONS__
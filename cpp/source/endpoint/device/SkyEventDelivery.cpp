@@ -0,0 +1,241 @@
+#include "endpoint/device/SkyEventDelivery.hpp"
+
+#include "endpoint/device/ISkyDeviceMonitor.hpp"
+
+SkyEventDelivery::SkyEventDelivery(ISkyDeviceMonitor* const _monitor,
+                                   const size_t capacity,
+                                   const size_t _maxBatch):
+    monitor(_monitor),
+    maxBatch(_maxBatch > 0 ? _maxBatch : 1),
+    highWatermark(capacity - capacity / 4),
+    ring(capacity),
+    overflowPopped(0),
+    overflowing(false),
+    batch(maxBatch),
+    waiting(false),
+    running(false),
+    publishedCount(0),
+    deliveredCount(0),
+    batchesCount(0),
+    coalescedCount(0),
+    droppedCount(0),
+    overflowCount(0)
+{
+}
+
+SkyEventDelivery::~SkyEventDelivery(void)
+{
+    stop();
+}
+
+void SkyEventDelivery::publish(const DeviceEventRecord& event)
+{
+    publishedCount.fetch_add(1, std::memory_order_relaxed);
+    const Policy policy = getPolicy(event);
+    if (policy >= COALESCE_DEBUG_DATA && (overflowing || ring.size() >= highWatermark))
+    {
+        // telemetry under backpressure, coalesced in overflow list
+        pushOverflow(event, policy);
+        return;
+    }
+    if (false == overflowing && ring.push(event))
+    {
+        wake();
+        return;
+    }
+    if (DROPPABLE == policy)
+    {
+        droppedCount.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    pushOverflow(event, policy);
+}
+
+size_t SkyEventDelivery::deliver(void)
+{
+    size_t total = 0;
+    for (;;)
+    {
+        size_t count = ring.drain(batch.data(), maxBatch);
+        if (count < maxBatch && overflowing)
+        {
+            std::lock_guard<std::mutex> lock(overflowMutex);
+            // device could push to ring before its newer events went to overflow,
+            // overflow waits until ring is empty
+            if (0 == ring.size())
+            {
+                while (count < maxBatch && false == overflow.empty())
+                {
+                    batch[count++] = overflow.front();
+                    overflow.pop_front();
+                    overflowPopped++;
+                }
+                if (overflow.empty())
+                {
+                    overflowing = false;
+                    coalescingPositions.clear();
+                    keptPositions.clear();
+                }
+            }
+        }
+        if (0 == count)
+        {
+            if (ring.size() > 0)
+            {
+                // record is being published
+                continue;
+            }
+            break;
+        }
+        monitor->notifyDeviceEvents(batch.data(), count);
+        deliveredCount.fetch_add(count, std::memory_order_relaxed);
+        batchesCount.fetch_add(1, std::memory_order_relaxed);
+        total += count;
+    }
+    return total;
+}
+
+void SkyEventDelivery::start(void)
+{
+    if (false == running.exchange(true))
+    {
+        thread = std::thread(&SkyEventDelivery::run, this);
+    }
+}
+
+void SkyEventDelivery::stop(void)
+{
+    if (running.exchange(false))
+    {
+        {
+            std::lock_guard<std::mutex> lock(wakeMutex);
+            wakeCondition.notify_one();
+        }
+        thread.join();
+    }
+}
+
+bool SkyEventDelivery::isRunning(void) const
+{
+    return running;
+}
+
+uint64_t SkyEventDelivery::getPublishedCount(void) const
+{
+    return publishedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyEventDelivery::getDeliveredCount(void) const
+{
+    return deliveredCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyEventDelivery::getBatchesCount(void) const
+{
+    return batchesCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyEventDelivery::getCoalescedCount(void) const
+{
+    return coalescedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyEventDelivery::getDroppedCount(void) const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyEventDelivery::getOverflowCount(void) const
+{
+    return overflowCount.load(std::memory_order_relaxed);
+}
+
+SkyEventDelivery::Policy SkyEventDelivery::getPolicy(const DeviceEventRecord& event)
+{
+    switch (event.getType())
+    {
+    case DeviceEvent::DATA_RECEIVED:
+        switch (event.getMessage().getMessageType())
+        {
+        case IMessage::DEBUG_DATA: return COALESCE_DEBUG_DATA;
+        case IMessage::SENSORS_DATA: return COALESCE_SENSORS_DATA;
+        default: return KEEP;
+        }
+
+    case DeviceEvent::DATA_SENT:
+        return IMessage::CONTROL_DATA == event.getMessage().getMessageType() ? DROPPABLE : KEEP;
+
+    case DeviceEvent::CONNECTION_STATUS:
+        return COALESCE_CONNECTION_STATUS;
+
+    default:
+        return KEEP;
+    }
+}
+
+void SkyEventDelivery::pushOverflow(const DeviceEventRecord& event, const Policy policy)
+{
+    {
+        std::lock_guard<std::mutex> lock(overflowMutex);
+        const uint64_t position = overflowPopped + overflow.size();
+        if (policy >= COALESCE_DEBUG_DATA)
+        {
+            // queued value of the same device and kind is replaced, unless other event
+            // of that device follows it
+            const CoalescingKey key(event.getOrigin(), policy);
+            const auto queued = coalescingPositions.find(key);
+            if (coalescingPositions.end() != queued && queued->second >= overflowPopped)
+            {
+                const auto kept = keptPositions.find(event.getOrigin());
+                if (keptPositions.end() == kept || kept->second < queued->second)
+                {
+                    overflow[queued->second - overflowPopped] = event;
+                    coalescedCount.fetch_add(1, std::memory_order_relaxed);
+                    return;
+                }
+            }
+            coalescingPositions[key] = position;
+        }
+        else
+        {
+            keptPositions[event.getOrigin()] = position;
+        }
+        overflow.push_back(event);
+        overflowing = true;
+    }
+    overflowCount.fetch_add(1, std::memory_order_relaxed);
+    wake();
+}
+
+bool SkyEventDelivery::hasPending(void) const
+{
+    return ring.size() > 0 || overflowing;
+}
+
+void SkyEventDelivery::wake(void)
+{
+    // delivery thread announces sleep before last check, so wakeup is never lost
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (waiting)
+    {
+        std::lock_guard<std::mutex> lock(wakeMutex);
+        wakeCondition.notify_one();
+    }
+}
+
+void SkyEventDelivery::run(void)
+{
+    while (running)
+    {
+        deliver();
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        waiting = true;
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        wakeCondition.wait(lock, [this]()
+        {
+            return false == running || hasPending();
+        });
+        waiting = false;
+    }
+    deliver();
+}
@@ -0,0 +1,229 @@
+#include "endpoint/device/SkyLinkQuality.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// RFC 6298 constants
+constexpr double ALPHA = 1.0 / 8.0;
+constexpr double BETA = 1.0 / 4.0;
+constexpr double K = 4.0;
+// clock granularity G, steady clock is much finer, timers tick in milliseconds
+constexpr double GRANULARITY = 0.001;
+
+double toSeconds(const SkyLinkQuality::Clock::duration duration)
+{
+    return std::chrono::duration<double>(duration).count();
+}
+
+uint32_t toMicroseconds(const double seconds)
+{
+    return (uint32_t)(seconds * 1e6 + 0.5);
+}
+
+}
+
+SkyLinkQuality::Settings::Settings(const unsigned _throughput,
+                                   const unsigned _maxOutstanding,
+                                   const unsigned _lossWindow,
+                                   const Clock::duration _lossTimeout,
+                                   const Clock::duration _minRto,
+                                   const Clock::duration _maxRto,
+                                   const Clock::duration _initialRto):
+    throughput(_throughput > 0 ? _throughput : 1),
+    maxOutstanding(_maxOutstanding > 0 ? _maxOutstanding : 1),
+    lossWindow(std::min(std::max(_lossWindow, 1u), 64u)),
+    lossTimeout(_lossTimeout),
+    minRto(_minRto),
+    maxRto(_maxRto),
+    initialRto(_initialRto)
+{
+}
+
+SkyLinkQuality::Figures::Figures(void):
+    valid(false),
+    lastRtt(0),
+    minRtt(0),
+    smoothedRtt(0),
+    rttVariance(0),
+    rto(0),
+    lossRate(0.0f),
+    outstanding(0),
+    sent(0),
+    answered(0),
+    lost(0)
+{
+}
+
+SkyLinkQuality::SkyLinkQuality(const Settings& _settings):
+    settings(_settings),
+    throughput(settings.throughput),
+    pings(settings.maxOutstanding)
+{
+    reset();
+}
+
+void SkyLinkQuality::onPingSent(const int value, const Clock::time_point time)
+{
+    Ping& ping = pings[pingsHead];
+    if (ping.pending)
+    {
+        // no room for another outstanding ping, oldest one will not be answered in time
+        ping.pending = false;
+        current.outstanding--;
+        resolve(true);
+    }
+    ping.value = value;
+    ping.time = time;
+    ping.pending = true;
+    pingsHead = (pingsHead + 1) % pings.size();
+    current.outstanding++;
+    current.sent++;
+    publish();
+}
+
+bool SkyLinkQuality::onPongReceived(const int value, const Clock::time_point time)
+{
+    for (Ping& ping : pings)
+    {
+        if (ping.pending && ping.value == value)
+        {
+            ping.pending = false;
+            current.outstanding--;
+            current.answered++;
+            sample(time - ping.time);
+            resolve(false);
+            publish();
+            return true;
+        }
+    }
+    return false;
+}
+
+unsigned SkyLinkQuality::expire(const Clock::time_point time)
+{
+    unsigned expired = 0;
+    // oldest first, so loss window keeps sending order
+    for (size_t i = 0; i < pings.size(); i++)
+    {
+        Ping& ping = pings[(pingsHead + i) % pings.size()];
+        if (ping.pending && time - ping.time >= settings.lossTimeout)
+        {
+            ping.pending = false;
+            current.outstanding--;
+            resolve(true);
+            expired++;
+        }
+    }
+    if (expired > 0)
+    {
+        publish();
+    }
+    return expired;
+}
+
+void SkyLinkQuality::reset(void)
+{
+    for (Ping& ping : pings)
+    {
+        ping.pending = false;
+    }
+    pingsHead = 0;
+    lossBits = 0;
+    lossSamples = 0;
+    hasSample = false;
+    srtt = 0.0;
+    rttvar = 0.0;
+    rto = toSeconds(settings.initialRto);
+    const Figures empty;
+    current = empty;
+    publish();
+}
+
+SkyLinkQuality::Figures SkyLinkQuality::getFigures(void) const
+{
+    std::lock_guard<std::mutex> lock(figuresMutex);
+    return figures;
+}
+
+SkyLinkQuality::Clock::duration SkyLinkQuality::getSmoothedRtt(void) const
+{
+    return std::chrono::microseconds(getFigures().smoothedRtt);
+}
+
+SkyLinkQuality::Clock::duration SkyLinkQuality::getRto(void) const
+{
+    return std::chrono::microseconds(getFigures().rto);
+}
+
+float SkyLinkQuality::getLossRate(void) const
+{
+    return getFigures().lossRate;
+}
+
+SkyLinkQuality::Clock::duration SkyLinkQuality::getTransmitTime(const unsigned bytes) const
+{
+    return std::chrono::microseconds((uint64_t)bytes * 1000000 / throughput.load(std::memory_order_relaxed));
+}
+
+void SkyLinkQuality::setThroughput(const unsigned bytesPerSecond)
+{
+    throughput.store(bytesPerSecond > 0 ? bytesPerSecond : 1, std::memory_order_relaxed);
+}
+
+void SkyLinkQuality::resolve(const bool lost)
+{
+    lossBits = (lossBits << 1) | (lost ? 1 : 0);
+    if (lossSamples < settings.lossWindow)
+    {
+        lossSamples++;
+    }
+    if (lost)
+    {
+        current.lost++;
+    }
+}
+
+void SkyLinkQuality::sample(const Clock::duration rtt)
+{
+    const double r = toSeconds(rtt);
+    if (false == hasSample)
+    {
+        // RFC 6298 2.2
+        srtt = r;
+        rttvar = r / 2.0;
+        hasSample = true;
+        current.minRtt = toMicroseconds(r);
+    }
+    else
+    {
+        // RFC 6298 2.3, RTTVAR is updated with SRTT from before this sample
+        rttvar = (1.0 - BETA) * rttvar + BETA * std::fabs(srtt - r);
+        srtt = (1.0 - ALPHA) * srtt + ALPHA * r;
+        current.minRtt = std::min(current.minRtt, toMicroseconds(r));
+    }
+    rto = srtt + std::max(GRANULARITY, K * rttvar);
+    rto = std::min(std::max(rto, toSeconds(settings.minRto)), toSeconds(settings.maxRto));
+    current.lastRtt = toMicroseconds(r);
+}
+
+void SkyLinkQuality::publish(void)
+{
+    const uint64_t mask = settings.lossWindow < 64 ? (1ull << settings.lossWindow) - 1 : ~0ull;
+    unsigned lostInWindow = 0;
+    for (uint64_t bits = lossBits & mask; 0 != bits; bits &= bits - 1)
+    {
+        lostInWindow++;
+    }
+
+    current.valid = hasSample;
+    current.smoothedRtt = toMicroseconds(srtt);
+    current.rttVariance = toMicroseconds(rttvar);
+    current.rto = toMicroseconds(rto);
+    current.lossRate = lossSamples > 0 ? (float)lostInWindow / lossSamples : 0.0f;
+
+    std::lock_guard<std::mutex> lock(figuresMutex);
+    figures = current;
+}
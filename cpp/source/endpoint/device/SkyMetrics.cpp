@@ -0,0 +1,166 @@
+#include "endpoint/device/SkyMetrics.hpp"
+
+constexpr unsigned SkyMetrics::MESSAGE_TYPES_COUNT;
+constexpr unsigned SkyMetrics::COMMANDS_COUNT;
+constexpr unsigned SkyMetrics::MAX_STATES;
+
+SkyMetrics::SkyMetrics(void):
+    receivedBytes(0),
+    crcFailures(0),
+    preambleCollisions(0),
+    incompletePayloads(0),
+    sendQueueFrames(0),
+    sendQueueFramesMax(0),
+    sendQueueBytes(0),
+    statesCount(0)
+{
+    for (unsigned direction = 0; direction < DIRECTIONS_COUNT; direction++)
+    {
+        for (unsigned type = 0; type < MESSAGE_TYPES_COUNT; type++)
+        {
+            frames[direction][type].store(0, std::memory_order_relaxed);
+            bytes[direction][type].store(0, std::memory_order_relaxed);
+        }
+    }
+    for (unsigned i = 0; i < COMMANDS_COUNT; i++)
+    {
+        signalRoundTrip[i].store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+SkyMetrics::~SkyMetrics(void)
+{
+    for (unsigned i = 0; i < COMMANDS_COUNT; i++)
+    {
+        delete signalRoundTrip[i].load(std::memory_order_relaxed);
+    }
+    const unsigned count = statesCount.load(std::memory_order_relaxed);
+    for (unsigned i = 0; i < count; i++)
+    {
+        delete states[i].histogram;
+    }
+}
+
+void SkyMetrics::onFrame(const Direction direction, const IMessage::MessageType type, const size_t length)
+{
+    if ((unsigned)type < MESSAGE_TYPES_COUNT)
+    {
+        add(frames[direction][type], 1);
+        add(bytes[direction][type], length);
+    }
+}
+
+void SkyMetrics::onChunk(const size_t length)
+{
+    add(receivedBytes, length);
+}
+
+void SkyMetrics::setReceptionFailures(const unsigned crc, const unsigned preamble, const unsigned payload)
+{
+    set(crcFailures, crc);
+    set(preambleCollisions, preamble);
+    set(incompletePayloads, payload);
+}
+
+void SkyMetrics::setSendQueue(const size_t frames, const size_t bytes)
+{
+    set(sendQueueFrames, frames);
+    set(sendQueueBytes, bytes);
+    if (frames > sendQueueFramesMax.load(std::memory_order_relaxed))
+    {
+        set(sendQueueFramesMax, frames);
+    }
+}
+
+void SkyMetrics::recordSignalRoundTrip(const SignalData::Command command, const Clock::duration duration)
+{
+    const unsigned index = (unsigned)(command - SignalData::START_CMD);
+    if (index >= COMMANDS_COUNT)
+    {
+        return;
+    }
+    SkyLatencyHistogram* histogram = signalRoundTrip[index].load(std::memory_order_relaxed);
+    if (nullptr == histogram)
+    {
+        histogram = new SkyLatencyHistogram();
+        signalRoundTrip[index].store(histogram, std::memory_order_release);
+    }
+    histogram->record(toNanoseconds(duration));
+}
+
+void SkyMetrics::recordStateDwell(const char* const action, const char* const state, const Clock::duration duration)
+{
+    const unsigned count = statesCount.load(std::memory_order_relaxed);
+    for (unsigned i = 0; i < count; i++)
+    {
+        // names are static, so pointers identify them
+        if (states[i].action == action && states[i].state == state)
+        {
+            states[i].histogram->record(toNanoseconds(duration));
+            return;
+        }
+    }
+    if (count < MAX_STATES)
+    {
+        StateSlot& slot = states[count];
+        slot.action = action;
+        slot.state = state;
+        slot.histogram = new SkyLatencyHistogram();
+        slot.histogram->record(toNanoseconds(duration));
+        statesCount.store(count + 1, std::memory_order_release);
+    }
+}
+
+SkyMetrics::Snapshot SkyMetrics::getSnapshot(void) const
+{
+    Snapshot snapshot;
+    for (unsigned direction = 0; direction < DIRECTIONS_COUNT; direction++)
+    {
+        for (unsigned type = 0; type < MESSAGE_TYPES_COUNT; type++)
+        {
+            snapshot.frames[direction][type] = frames[direction][type].load(std::memory_order_relaxed);
+            snapshot.bytes[direction][type] = bytes[direction][type].load(std::memory_order_relaxed);
+        }
+    }
+    snapshot.receivedBytes = receivedBytes.load(std::memory_order_relaxed);
+    snapshot.crcFailures = crcFailures.load(std::memory_order_relaxed);
+    snapshot.preambleCollisions = preambleCollisions.load(std::memory_order_relaxed);
+    snapshot.incompletePayloads = incompletePayloads.load(std::memory_order_relaxed);
+    snapshot.sendQueueFrames = sendQueueFrames.load(std::memory_order_relaxed);
+    snapshot.sendQueueFramesMax = sendQueueFramesMax.load(std::memory_order_relaxed);
+    snapshot.sendQueueBytes = sendQueueBytes.load(std::memory_order_relaxed);
+    return snapshot;
+}
+
+const SkyLatencyHistogram* SkyMetrics::getSignalRoundTrip(const SignalData::Command command) const
+{
+    const unsigned index = (unsigned)(command - SignalData::START_CMD);
+    return index < COMMANDS_COUNT ? signalRoundTrip[index].load(std::memory_order_acquire) : nullptr;
+}
+
+unsigned SkyMetrics::getStatesCount(void) const
+{
+    return statesCount.load(std::memory_order_acquire);
+}
+
+SkyMetrics::StateDwell SkyMetrics::getStateDwell(const unsigned index) const
+{
+    const StateSlot& slot = states[index];
+    return StateDwell{slot.action, slot.state, slot.histogram};
+}
+
+void SkyMetrics::add(std::atomic<uint64_t>& counter, const uint64_t value)
+{
+    counter.store(counter.load(std::memory_order_relaxed) + value, std::memory_order_relaxed);
+}
+
+void SkyMetrics::set(std::atomic<uint64_t>& counter, const uint64_t value)
+{
+    counter.store(value, std::memory_order_relaxed);
+}
+
+uint64_t SkyMetrics::toNanoseconds(const Clock::duration duration)
+{
+    const auto nanoseconds = std::chrono::duration_cast<std::chrono::nanoseconds>(duration).count();
+    return nanoseconds > 0 ? (uint64_t)nanoseconds : 0;
+}
@@ -0,0 +1,333 @@
+#include "endpoint/device/SkyMetricsExporter.hpp"
+
+#include <algorithm>
+#include <cstdio>
+
+#ifdef __linux__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+
+#include <cerrno>
+#include <cstring>
+#endif // __linux__
+
+namespace
+{
+
+const double QUANTILES[] = {0.5, 0.9, 0.99, 0.999};
+
+const char* const DIRECTIONS[SkyMetrics::DIRECTIONS_COUNT] = {"received", "sent"};
+
+void appendSample(std::string& text, const char* const name, const std::string& labels, const uint64_t value)
+{
+    text += name;
+    text += '{';
+    text += labels;
+    text += "} ";
+    text += std::to_string(value);
+    text += '\n';
+}
+
+void appendHeader(std::string& text, const char* const name, const char* const type, const char* const help)
+{
+    text += "# HELP ";
+    text += name;
+    text += ' ';
+    text += help;
+    text += "\n# TYPE ";
+    text += name;
+    text += ' ';
+    text += type;
+    text += '\n';
+}
+
+}
+
+SkyMetricsExporter::SkyMetricsExporter(void):
+    fd(-1)
+{
+}
+
+SkyMetricsExporter::~SkyMetricsExporter(void)
+{
+#ifdef __linux__
+    close();
+#endif // __linux__
+}
+
+void SkyMetricsExporter::add(const std::string& device, const SkyMetrics* const metrics)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sources.push_back(Source{escape(device), metrics});
+}
+
+void SkyMetricsExporter::remove(const SkyMetrics* const metrics)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    sources.erase(std::remove_if(sources.begin(), sources.end(),
+                                 [metrics](const Source& source) { return source.metrics == metrics; }),
+                  sources.end());
+}
+
+std::string SkyMetricsExporter::format(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<SkyMetrics::Snapshot> snapshots;
+    snapshots.reserve(sources.size());
+    for (const Source& source : sources)
+    {
+        snapshots.push_back(source.metrics->getSnapshot());
+    }
+
+    std::string text;
+    text.reserve(4096 * (sources.size() + 1));
+
+    appendHeader(text, "skydive_frames_total", "counter", "Frames by message type and direction.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        for (unsigned direction = 0; direction < SkyMetrics::DIRECTIONS_COUNT; direction++)
+        {
+            for (unsigned type = 0; type < SkyMetrics::MESSAGE_TYPES_COUNT; type++)
+            {
+                appendSample(text, "skydive_frames_total",
+                             "device=\"" + sources[i].device + "\",direction=\"" + DIRECTIONS[direction] +
+                             "\",type=\"" + IMessage::toString(static_cast<IMessage::MessageType>(type)) + "\"",
+                             snapshots[i].frames[direction][type]);
+            }
+        }
+    }
+
+    appendHeader(text, "skydive_frame_bytes_total", "counter", "Bytes of frames by message type and direction.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        for (unsigned direction = 0; direction < SkyMetrics::DIRECTIONS_COUNT; direction++)
+        {
+            for (unsigned type = 0; type < SkyMetrics::MESSAGE_TYPES_COUNT; type++)
+            {
+                appendSample(text, "skydive_frame_bytes_total",
+                             "device=\"" + sources[i].device + "\",direction=\"" + DIRECTIONS[direction] +
+                             "\",type=\"" + IMessage::toString(static_cast<IMessage::MessageType>(type)) + "\"",
+                             snapshots[i].bytes[direction][type]);
+            }
+        }
+    }
+
+    appendHeader(text, "skydive_received_bytes_total", "counter", "All bytes read from link, including not framed.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        appendSample(text, "skydive_received_bytes_total", "device=\"" + sources[i].device + "\"",
+                     snapshots[i].receivedBytes);
+    }
+
+    appendHeader(text, "skydive_reception_failures_total", "counter", "Failed receptions by cause.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const std::string labels = "device=\"" + sources[i].device + "\",cause=\"";
+        appendSample(text, "skydive_reception_failures_total", labels + "crc\"", snapshots[i].crcFailures);
+        appendSample(text, "skydive_reception_failures_total", labels + "preamble_collision\"",
+                     snapshots[i].preambleCollisions);
+        appendSample(text, "skydive_reception_failures_total", labels + "incomplete_payload\"",
+                     snapshots[i].incompletePayloads);
+    }
+
+    appendHeader(text, "skydive_send_queue_frames", "gauge", "Frames waiting in transmit scheduler.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        appendSample(text, "skydive_send_queue_frames", "device=\"" + sources[i].device + "\"",
+                     snapshots[i].sendQueueFrames);
+    }
+
+    appendHeader(text, "skydive_send_queue_frames_max", "gauge", "Most frames ever waiting in transmit scheduler.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        appendSample(text, "skydive_send_queue_frames_max", "device=\"" + sources[i].device + "\"",
+                     snapshots[i].sendQueueFramesMax);
+    }
+
+    appendHeader(text, "skydive_send_queue_bytes", "gauge", "Bytes buffered by interface.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        appendSample(text, "skydive_send_queue_bytes", "device=\"" + sources[i].device + "\"",
+                     snapshots[i].sendQueueBytes);
+    }
+
+    appendHeader(text, "skydive_signal_round_trip_seconds", "summary", "Time from sending signal to its response.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        for (unsigned c = 0; c < SkyMetrics::COMMANDS_COUNT; c++)
+        {
+            const SignalData::Command command = static_cast<SignalData::Command>(SignalData::START_CMD + c);
+            const SkyLatencyHistogram* histogram = sources[i].metrics->getSignalRoundTrip(command);
+            if (nullptr != histogram)
+            {
+                formatSummary(text, "skydive_signal_round_trip_seconds",
+                              "device=\"" + sources[i].device + "\",command=\"" + SignalData::toString(command) + "\"",
+                              *histogram);
+            }
+        }
+    }
+
+    appendHeader(text, "skydive_state_dwell_seconds", "summary", "Time spent in action state.");
+    for (size_t i = 0; i < sources.size(); i++)
+    {
+        const unsigned count = sources[i].metrics->getStatesCount();
+        for (unsigned s = 0; s < count; s++)
+        {
+            const SkyMetrics::StateDwell dwell = sources[i].metrics->getStateDwell(s);
+            formatSummary(text, "skydive_state_dwell_seconds",
+                          "device=\"" + sources[i].device + "\",action=\"" + dwell.action +
+                          "\",state=\"" + dwell.state + "\"",
+                          *dwell.histogram);
+        }
+    }
+    return text;
+}
+
+bool SkyMetricsExporter::writeFile(const std::string& path) const
+{
+    const std::string text = format();
+    const std::string temporary = path + ".tmp";
+    FILE* file = std::fopen(temporary.c_str(), "w");
+    if (nullptr == file)
+    {
+        return false;
+    }
+    const bool written = text.size() == std::fwrite(text.data(), 1, text.size(), file);
+    if (0 != std::fclose(file) || false == written)
+    {
+        std::remove(temporary.c_str());
+        return false;
+    }
+    return 0 == std::rename(temporary.c_str(), path.c_str());
+}
+
+#ifdef __linux__
+
+bool SkyMetricsExporter::listen(const std::string& path)
+{
+    close();
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    if (path.size() >= sizeof(address.sun_path))
+    {
+        return false;
+    }
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+    fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    ::unlink(path.c_str());
+    if (0 != ::bind(fd, reinterpret_cast<const sockaddr*>(&address), sizeof(address))
+            || 0 != ::listen(fd, 16))
+    {
+        ::close(fd);
+        fd = -1;
+        return false;
+    }
+    socketPath = path;
+    return true;
+}
+
+int SkyMetricsExporter::getFd(void) const
+{
+    return fd;
+}
+
+size_t SkyMetricsExporter::serve(void)
+{
+    size_t served = 0;
+    int client;
+    while (fd >= 0 && (client = ::accept4(fd, nullptr, nullptr, SOCK_CLOEXEC)) >= 0)
+    {
+        // text is small, blocking write of whole text to local reader
+        const std::string text = format();
+        size_t offset = 0;
+        while (offset < text.size())
+        {
+            const ssize_t written = ::send(client, text.data() + offset, text.size() - offset, MSG_NOSIGNAL);
+            if (written < 0 && EINTR == errno)
+            {
+                continue;
+            }
+            if (written <= 0)
+            {
+                break;
+            }
+            offset += (size_t)written;
+        }
+        ::close(client);
+        served++;
+    }
+    return served;
+}
+
+void SkyMetricsExporter::close(void)
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+        ::unlink(socketPath.c_str());
+        fd = -1;
+        socketPath.clear();
+    }
+}
+
+#endif // __linux__
+
+void SkyMetricsExporter::formatSummary(std::string& text,
+                                       const char* const name,
+                                       const std::string& labels,
+                                       const SkyLatencyHistogram& histogram)
+{
+    char value[32];
+    for (const double quantile : QUANTILES)
+    {
+        std::snprintf(value, sizeof(value), "%g", quantile);
+        text += name;
+        text += '{';
+        text += labels;
+        text += ",quantile=\"";
+        text += value;
+        text += "\"} ";
+        std::snprintf(value, sizeof(value), "%.9g", histogram.getPercentile(quantile) / 1e9);
+        text += value;
+        text += '\n';
+    }
+    const uint64_t count = histogram.getCount();
+    std::snprintf(value, sizeof(value), "%.9g", histogram.getMean() * count / 1e9);
+    text += name;
+    text += "_sum{";
+    text += labels;
+    text += "} ";
+    text += value;
+    text += '\n';
+    text += name;
+    text += "_count{";
+    text += labels;
+    text += "} ";
+    text += std::to_string(count);
+    text += '\n';
+}
+
+std::string SkyMetricsExporter::escape(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value)
+    {
+        switch (c)
+        {
+        case '\\': escaped += "\\\\"; break;
+        case '"': escaped += "\\\""; break;
+        case '\n': escaped += "\\n"; break;
+        default: escaped += c; break;
+        }
+    }
+    return escaped;
+}
@@ -0,0 +1,114 @@
+#include "endpoint/device/SkyRateController.hpp"
+
+#include <algorithm>
+
+SkyRateController::Settings::Settings(const double _minControlRate,
+                                      const double _maxControlRate,
+                                      const double _minTelemetryRate,
+                                      const double _maxTelemetryRate,
+                                      const double _increaseStep,
+                                      const double _decreaseFactor,
+                                      const double _rttInflation,
+                                      const Clock::duration _rttMargin,
+                                      const double _maxFailureRate,
+                                      const size_t _maxQueueSize):
+    minControlRate(_minControlRate),
+    maxControlRate(std::max(_minControlRate, _maxControlRate)),
+    minTelemetryRate(_minTelemetryRate),
+    maxTelemetryRate(std::max(_minTelemetryRate, _maxTelemetryRate)),
+    increaseStep(_increaseStep),
+    decreaseFactor(_decreaseFactor),
+    rttInflation(_rttInflation),
+    rttMargin(_rttMargin),
+    maxFailureRate(_maxFailureRate),
+    maxQueueSize(_maxQueueSize)
+{
+}
+
+SkyRateController::SkyRateController(const Settings& _settings, const double initialControlRate):
+    settings(_settings),
+    controlRate(std::min(std::max(initialControlRate, settings.minControlRate), settings.maxControlRate)),
+    telemetryRate(settings.maxTelemetryRate),
+    congested(false),
+    decreasesCount(0),
+    lastReceived(0),
+    lastFailed(0),
+    lastLost(0)
+{
+}
+
+void SkyRateController::update(const SkyLinkQuality::Figures& linkQuality,
+                               const unsigned received,
+                               const unsigned failed,
+                               const size_t queueSize,
+                               const Clock::time_point time)
+{
+    bool isCongested = queueSize > settings.maxQueueSize;
+
+    if (linkQuality.valid)
+    {
+        // queueing delay shows as RTT growth over RTT of empty link
+        const double minRtt = linkQuality.minRtt / 1e6;
+        const double margin = std::chrono::duration<double>(settings.rttMargin).count();
+        const double allowedRtt = std::max(minRtt * settings.rttInflation, minRtt + margin);
+        isCongested |= linkQuality.lastRtt / 1e6 > allowedRtt;
+    }
+
+    isCongested |= linkQuality.lost > lastLost;
+
+    const unsigned newReceived = received - lastReceived;
+    const unsigned newFailed = failed - lastFailed;
+    if (newReceived + newFailed > 0)
+    {
+        isCongested |= (double)newFailed / (newReceived + newFailed) > settings.maxFailureRate;
+    }
+
+    lastReceived = received;
+    lastFailed = failed;
+    lastLost = linkQuality.lost;
+
+    double rate = controlRate.load(std::memory_order_relaxed);
+    if (isCongested)
+    {
+        // data sent before decrease is still in queues, react once per round trip
+        const Clock::duration holdoff = std::chrono::microseconds(linkQuality.smoothedRtt);
+        if (0 == decreasesCount || time - lastDecrease >= holdoff)
+        {
+            rate = std::max(settings.minControlRate, rate * settings.decreaseFactor);
+            lastDecrease = time;
+            decreasesCount++;
+        }
+    }
+    else
+    {
+        rate = std::min(settings.maxControlRate, rate + settings.increaseStep);
+    }
+
+    const double range = settings.maxControlRate - settings.minControlRate;
+    const double part = range > 0.0 ? (rate - settings.minControlRate) / range : 1.0;
+
+    controlRate.store(rate, std::memory_order_relaxed);
+    telemetryRate.store(settings.minTelemetryRate + part * (settings.maxTelemetryRate - settings.minTelemetryRate),
+                        std::memory_order_relaxed);
+    congested.store(isCongested, std::memory_order_relaxed);
+}
+
+double SkyRateController::getControlRate(void) const
+{
+    return controlRate.load(std::memory_order_relaxed);
+}
+
+double SkyRateController::getTelemetryRate(void) const
+{
+    return telemetryRate.load(std::memory_order_relaxed);
+}
+
+bool SkyRateController::isCongested(void) const
+{
+    return congested.load(std::memory_order_relaxed);
+}
+
+unsigned SkyRateController::getDecreasesCount(void) const
+{
+    return decreasesCount.load(std::memory_order_relaxed);
+}
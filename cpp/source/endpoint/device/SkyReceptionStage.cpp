@@ -0,0 +1,125 @@
+#include "endpoint/device/SkyReceptionStage.hpp"
+
+#include <algorithm>
+
+constexpr size_t SkyReceptionStage::ORDERED_CAPACITY;
+
+SkyReceptionStage::SkyReceptionStage(void):
+    orderedHead(0),
+    framedCount(0),
+    coalescedCount(0),
+    droppedCount(0)
+{
+    ordered.reserve(ORDERED_CAPACITY);
+    std::fill(hasLatest, hasLatest + TELEMETRY_COUNT, false);
+}
+
+SkyReceptionStage::~SkyReceptionStage(void)
+{
+}
+
+void SkyReceptionStage::push(const IMessage& message)
+{
+    framedCount.fetch_add(1, std::memory_order_relaxed);
+    const int telemetry = getTelemetry(message);
+    if (telemetry < 0)
+    {
+        ordered.push_back(DeviceEventRecord(DeviceEvent::DATA_RECEIVED, message));
+        return;
+    }
+    if (hasLatest[telemetry])
+    {
+        coalescedCount.fetch_add(1, std::memory_order_relaxed);
+    }
+    latest[telemetry] = DeviceEventRecord(DeviceEvent::DATA_RECEIVED, message);
+    hasLatest[telemetry] = true;
+}
+
+bool SkyReceptionStage::pop(DeviceEventRecord& record)
+{
+    if (orderedHead < ordered.size())
+    {
+        record = ordered[orderedHead++];
+        if (orderedHead == ordered.size())
+        {
+            // storage is kept for next chunk
+            ordered.clear();
+            orderedHead = 0;
+        }
+        return true;
+    }
+    for (unsigned i = 0; i < TELEMETRY_COUNT; i++)
+    {
+        if (hasLatest[i])
+        {
+            record = latest[i];
+            hasLatest[i] = false;
+            return true;
+        }
+    }
+    return false;
+}
+
+void SkyReceptionStage::dropTelemetry(void)
+{
+    // control frames waiting in order (SensorsData of logger) were framed with type
+    // expected by finished action as well
+    size_t kept = orderedHead;
+    for (size_t i = orderedHead; i < ordered.size(); i++)
+    {
+        if (IMessage::CONTROL == ordered[i].getMessage().getPreambleType())
+        {
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+        else
+        {
+            ordered[kept++] = ordered[i];
+        }
+    }
+    ordered.resize(kept);
+    if (orderedHead == ordered.size())
+    {
+        ordered.clear();
+        orderedHead = 0;
+    }
+    for (unsigned i = 0; i < TELEMETRY_COUNT; i++)
+    {
+        if (hasLatest[i])
+        {
+            hasLatest[i] = false;
+            droppedCount.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+}
+
+void SkyReceptionStage::clear(void)
+{
+    ordered.clear();
+    orderedHead = 0;
+    std::fill(hasLatest, hasLatest + TELEMETRY_COUNT, false);
+}
+
+uint64_t SkyReceptionStage::getFramedCount(void) const
+{
+    return framedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyReceptionStage::getCoalescedCount(void) const
+{
+    return coalescedCount.load(std::memory_order_relaxed);
+}
+
+uint64_t SkyReceptionStage::getDroppedCount(void) const
+{
+    return droppedCount.load(std::memory_order_relaxed);
+}
+
+int SkyReceptionStage::getTelemetry(const IMessage& message)
+{
+    switch (message.getMessageType())
+    {
+    case IMessage::DEBUG_DATA: return DEBUG;
+    // every logged sample counts, SensorsData keeps arrival order
+    default: return -1;
+    }
+}
@@ -0,0 +1,436 @@
+#include "endpoint/device/SkyScenario.hpp"
+
+#include "communication/ISignalPayloadMessage.hpp"
+
+SkyScenario::Step::Step(const Type _type):
+    type(_type),
+    value(0),
+    command(SignalData::DUMMY),
+    parameter(SignalData::DUMMY_PARAMETER),
+    duration(0)
+{
+}
+
+SkyScenario::SkyScenario(const double _pingFreq,
+                         const double _controlFreq,
+                         const double _connectionTimeout):
+    device(this, _pingFreq, _controlFreq, _connectionTimeout),
+    waitLimit(std::chrono::seconds(60)),
+    pingAnswers(true),
+    connected(false),
+    eventsHead(0),
+    stepIndex(0)
+{
+    listener = nullptr;
+}
+
+SkyScenario::~SkyScenario(void)
+{
+}
+
+SkyScenario& SkyScenario::connectDevice(const ISkyDeviceAction::Type connectionType)
+{
+    return pilot(new PilotEventConnect(connectionType, this));
+}
+
+SkyScenario& SkyScenario::pilot(const PilotEvent* const pilotEvent)
+{
+    addStep(Step::PILOT_EVENT).pilotEvent.reset(pilotEvent);
+    return *this;
+}
+
+SkyScenario& SkyScenario::pilot(const PilotEvent::Type type)
+{
+    return pilot(new PilotEvent(type));
+}
+
+SkyScenario& SkyScenario::receive(const IMessage& message)
+{
+    Step& step = addStep(Step::RECEIVE);
+    if (message.isSignalPayloadMessage())
+    {
+        unsigned char buffer[IMessage::SIGNAL_DATA_MESSAGE_SIZE];
+        ISignalPayloadMessage::MessagesBuilder builder(reinterpret_cast<const ISignalPayloadMessage*>(&message));
+        while (builder.hasNext())
+        {
+            builder.getNext(buffer);
+            step.data.insert(step.data.end(), buffer, buffer + IMessage::SIGNAL_DATA_MESSAGE_SIZE);
+        }
+    }
+    else
+    {
+        step.data.resize(message.getMessageSize());
+        message.serializeMessage(step.data.data());
+    }
+    step.value = message.getMessageType();
+    return *this;
+}
+
+SkyScenario& SkyScenario::receive(const unsigned char* data, const size_t length)
+{
+    Step& step = addStep(Step::RECEIVE);
+    step.data.assign(data, data + length);
+    step.value = -1;
+    return *this;
+}
+
+SkyScenario& SkyScenario::advance(const Duration duration)
+{
+    addStep(Step::ADVANCE).duration = duration;
+    return *this;
+}
+
+SkyScenario& SkyScenario::expectSignal(const SignalData::Command command, const SignalData::Parameter parameter)
+{
+    Step& step = addStep(Step::EXPECT_SIGNAL);
+    step.command = command;
+    step.parameter = parameter;
+    return *this;
+}
+
+SkyScenario& SkyScenario::expectSent(const IMessage::MessageType type)
+{
+    addStep(Step::EXPECT_SENT).value = type;
+    return *this;
+}
+
+SkyScenario& SkyScenario::expectEvent(const DeviceEvent::Type type)
+{
+    addStep(Step::EXPECT_EVENT).value = type;
+    return *this;
+}
+
+SkyScenario& SkyScenario::expectError(const SkyError::Code code)
+{
+    addStep(Step::EXPECT_ERROR).value = code;
+    return *this;
+}
+
+SkyScenario& SkyScenario::expectState(const ISkyDeviceAction::Type state)
+{
+    addStep(Step::EXPECT_STATE).value = state;
+    return *this;
+}
+
+void SkyScenario::setWaitLimit(const Duration limit)
+{
+    waitLimit = limit;
+}
+
+void SkyScenario::setPingAnswers(const bool enabled)
+{
+    pingAnswers = enabled;
+}
+
+bool SkyScenario::run(void)
+{
+    failure.clear();
+    for (stepIndex = 0; stepIndex < steps.size(); stepIndex++)
+    {
+        if (false == runStep(steps[stepIndex]))
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+const std::string& SkyScenario::getFailure(void) const
+{
+    return failure;
+}
+
+SkyDevice& SkyScenario::getDevice(void)
+{
+    return device;
+}
+
+SkyVirtualClock& SkyScenario::getClock(void)
+{
+    return clock;
+}
+
+const std::vector<DeviceEventRecord>& SkyScenario::getEvents(void) const
+{
+    return events;
+}
+
+SkyScenario::Step& SkyScenario::addStep(const Step::Type type)
+{
+    steps.push_back(Step(type));
+    return steps.back();
+}
+
+bool SkyScenario::runStep(Step& step)
+{
+    switch (step.type)
+    {
+    case Step::PILOT_EVENT:
+        if (nullptr == step.pilotEvent)
+        {
+            return fail("pilot event already pushed, script is run once");
+        }
+        device.pushPilotEvent(std::move(step.pilotEvent));
+        parseSent();
+        return true;
+
+    case Step::RECEIVE:
+        if (false == connected || nullptr == listener)
+        {
+            return fail("board sends when link is not connected");
+        }
+        onReceived(step.data.data(), step.data.size());
+        parseSent();
+        return true;
+
+    case Step::ADVANCE:
+        clock.advanceBy(step.duration);
+        parseSent();
+        return true;
+
+    case Step::EXPECT_SIGNAL:
+    {
+        const std::string expected = "(" + SignalData::toString(step.command) + ", "
+                + SignalData::toString(step.parameter) + ")";
+        Frame frame;
+        if (false == waitFor([&]() { return takeSignal(frame); }))
+        {
+            return fail("signal " + expected + " not sent");
+        }
+        if (frame.command != step.command || frame.parameter != step.parameter)
+        {
+            return fail("expected signal " + expected + ", sent ("
+                        + SignalData::toString(frame.command) + ", "
+                        + SignalData::toString(frame.parameter) + ")");
+        }
+        return true;
+    }
+
+    case Step::EXPECT_SENT:
+        if (false == waitFor([&]() { return takeSent(static_cast<IMessage::MessageType>(step.value)); }))
+        {
+            return fail(IMessage::toString(static_cast<IMessage::MessageType>(step.value)) + " not sent");
+        }
+        return true;
+
+    case Step::EXPECT_EVENT:
+        if (false == waitFor([&]() { return takeEvent(step); }))
+        {
+            return fail("device event " + DeviceEvent(static_cast<DeviceEvent::Type>(step.value)).toString() + " not emitted");
+        }
+        return true;
+
+    case Step::EXPECT_ERROR:
+        if (false == waitFor([&]() { return takeEvent(step); }))
+        {
+            return fail(std::string("error ") + SkyError::getDescriptor(static_cast<SkyError::Code>(step.value)).name
+                        + " not reported");
+        }
+        return true;
+
+    case Step::EXPECT_STATE:
+        if (false == waitFor([&]() { return step.value == device.getState(); }))
+        {
+            return fail(std::string("state ") + ISkyDeviceAction::toString(static_cast<ISkyDeviceAction::Type>(step.value))
+                        + " not reached, device is in " + ISkyDeviceAction::toString(device.getState()));
+        }
+        return true;
+    }
+    return fail("unknown step");
+}
+
+template <typename Predicate>
+bool SkyScenario::waitFor(Predicate predicate)
+{
+    const Duration deadline = clock.now() + waitLimit;
+    while (true)
+    {
+        parseSent();
+        if (predicate())
+        {
+            return true;
+        }
+        Duration expiry;
+        if (false == clock.getNextExpiry(expiry) || expiry > deadline)
+        {
+            return false;
+        }
+        clock.advanceToNext();
+    }
+}
+
+bool SkyScenario::takeSignal(Frame& frame)
+{
+    while (false == sentFrames.empty())
+    {
+        frame = sentFrames.front();
+        sentFrames.pop_front();
+        if (IMessage::SIGNAL_DATA == frame.type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SkyScenario::takeSent(const IMessage::MessageType type)
+{
+    while (false == sentFrames.empty())
+    {
+        const Frame frame = sentFrames.front();
+        sentFrames.pop_front();
+        if (type == frame.type)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SkyScenario::takeEvent(const Step& step)
+{
+    while (eventsHead < events.size())
+    {
+        const DeviceEventRecord& event = events[eventsHead++];
+        if (Step::EXPECT_ERROR == step.type
+                ? step.value == event.getError().getCode() && event.getError().isError()
+                : step.value == event.getType())
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+void SkyScenario::parseSent(void)
+{
+    // replies can make device send more, so bytes are taken in batches
+    std::vector<unsigned char> bytes;
+    while (false == sentBytes.empty())
+    {
+        bytes.swap(sentBytes);
+        sentBytes.clear();
+        for (const unsigned char byte : bytes)
+        {
+            const IMessage::PreambleType preamble = dispatcher.putChar(byte);
+            Frame frame;
+            frame.command = SignalData::DUMMY;
+            frame.parameter = SignalData::DUMMY_PARAMETER;
+            switch (preamble)
+            {
+            case IMessage::CONTROL:
+                frame.type = IMessage::CONTROL_DATA;
+                break;
+
+            case IMessage::AUTOPILOT:
+                frame.type = IMessage::AUTOPILOT_DATA;
+                break;
+
+            case IMessage::SIGNAL:
+                if (SignalData::hasPayload(dispatcher.getCommand()))
+                {
+                    std::unique_ptr<const IMessage> message(dispatcher.retriveSignalMessage());
+                    if (nullptr == message)
+                    {
+                        continue;
+                    }
+                    frame.type = message->getMessageType();
+                    frame.command = reinterpret_cast<const ISignalPayloadMessage&>(*message).getSignalDataCommand();
+                }
+                else
+                {
+                    const SignalData signal = dispatcher.getSignalData();
+                    if (SignalData::PING_VALUE == signal.getCommand())
+                    {
+                        // pong, link quality is measured in real time, so round trip is almost 0
+                        if (pingAnswers)
+                        {
+                            reply(signal);
+                        }
+                        continue;
+                    }
+                    frame.type = IMessage::SIGNAL_DATA;
+                    frame.command = signal.getCommand();
+                    frame.parameter = signal.getParameter();
+                }
+                break;
+
+            default:
+                continue;
+            }
+            sentFrames.push_back(frame);
+        }
+        bytes.clear();
+    }
+}
+
+void SkyScenario::reply(const SignalData& signal)
+{
+    if (connected && nullptr != listener)
+    {
+        unsigned char buffer[IMessage::SIGNAL_DATA_MESSAGE_SIZE];
+        signal.serializeMessage(buffer);
+        onReceived(buffer, signal.getMessageSize());
+    }
+}
+
+bool SkyScenario::fail(const std::string& text)
+{
+    failure = "step " + std::to_string(stepIndex) + " at "
+            + std::to_string(std::chrono::duration_cast<std::chrono::milliseconds>(clock.now()).count())
+            + " ms: " + text;
+    for (size_t i = events.size(); i > 0; i--)
+    {
+        // error that broke the flow is usually cause of failure
+        if (events[i - 1].getError().isError())
+        {
+            failure += ", last error: " + events[i - 1].getError().toString();
+            break;
+        }
+    }
+    return false;
+}
+
+void SkyScenario::connect(void)
+{
+    connected = true;
+    dispatcher.reset();
+    sentBytes.clear();
+    onConnected();
+}
+
+void SkyScenario::disconnect(void)
+{
+    if (connected)
+    {
+        connected = false;
+        onDisconnected();
+    }
+}
+
+void SkyScenario::send(const unsigned char* data, const size_t length)
+{
+    if (connected)
+    {
+        sentBytes.insert(sentBytes.end(), data, data + length);
+    }
+}
+
+void SkyScenario::notifyDeviceEvent(const DeviceEventRecord& event)
+{
+    events.push_back(event);
+}
+
+ControlData SkyScenario::getControlDataToSend(void)
+{
+    return ControlData();
+}
+
+ISkyTimer* SkyScenario::createTimer(std::function<void(void)> exec)
+{
+    return clock.createTimer(exec);
+}
+
+void SkyScenario::trace(const std::string&)
+{
+}
@@ -0,0 +1,183 @@
+#include "endpoint/device/SkyTelemetryStore.hpp"
+
+#include <chrono>
+#include <cstring>
+
+SkyTelemetryStore::Snapshot::Snapshot(void):
+    debugDataTime(0),
+    sensorsDataTime(0),
+    autopilotDataTime(0)
+{
+}
+
+SkyTelemetryStore::Slot::Slot(void):
+    sequence(0),
+    time(0)
+{
+    for (unsigned i = 0; i < WORDS; i++)
+    {
+        words[i].store(0, std::memory_order_relaxed);
+    }
+}
+
+void SkyTelemetryStore::Slot::write(const IMessage& message, const int64_t _time)
+{
+    uint64_t buffer[WORDS] = {};
+    message.serialize(reinterpret_cast<unsigned char*>(buffer));
+
+    // odd sequence marks write in progress
+    const unsigned begin = sequence.load(std::memory_order_relaxed) + 1;
+    sequence.store(begin, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    time.store(_time, std::memory_order_relaxed);
+    for (unsigned i = 0; i < WORDS; i++)
+    {
+        words[i].store(buffer[i], std::memory_order_relaxed);
+    }
+    sequence.store(begin + 1, std::memory_order_release);
+}
+
+int64_t SkyTelemetryStore::Slot::read(unsigned char* data) const
+{
+    uint64_t buffer[WORDS];
+    int64_t result;
+    for (;;)
+    {
+        const unsigned begin = sequence.load(std::memory_order_acquire);
+        if (begin & 1)
+        {
+            continue;
+        }
+        result = time.load(std::memory_order_relaxed);
+        for (unsigned i = 0; i < WORDS; i++)
+        {
+            buffer[i] = words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (sequence.load(std::memory_order_relaxed) == begin)
+        {
+            break;
+        }
+    }
+    memcpy(data, buffer, sizeof(buffer));
+    return result;
+}
+
+SkyTelemetryStore::SkyTelemetryStore(void):
+    updatesCount(0)
+{
+}
+
+void SkyTelemetryStore::update(const IMessage& message)
+{
+    // slot is written by serialize, which copies from memory layout of whole object
+    static_assert(sizeof(DebugData) <= Slot::SIZE && sizeof(SensorsData) <= Slot::SIZE
+                  && sizeof(AutopilotData) <= Slot::SIZE, "telemetry slot smaller than stored message");
+
+    Slot* slot;
+    switch (message.getMessageType())
+    {
+    case IMessage::DEBUG_DATA:
+        slot = &debugDataSlot;
+        break;
+
+    case IMessage::SENSORS_DATA:
+        slot = &sensorsDataSlot;
+        break;
+
+    case IMessage::AUTOPILOT_DATA:
+        slot = &autopilotDataSlot;
+        break;
+
+    default:
+        return;
+    }
+    const int64_t now = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+    slot->write(message, now);
+    updatesCount.fetch_add(1, std::memory_order_release);
+}
+
+bool SkyTelemetryStore::read(DebugData& debugData) const
+{
+    unsigned char data[Slot::SIZE];
+    const int64_t time = debugDataSlot.read(data);
+    debugData = DebugData(data);
+    return 0 != time;
+}
+
+bool SkyTelemetryStore::read(SensorsData& sensorsData) const
+{
+    unsigned char data[Slot::SIZE];
+    const int64_t time = sensorsDataSlot.read(data);
+    sensorsData = SensorsData(data);
+    return 0 != time;
+}
+
+bool SkyTelemetryStore::read(AutopilotData& autopilotData) const
+{
+    unsigned char data[Slot::SIZE];
+    const int64_t time = autopilotDataSlot.read(data);
+    autopilotData = AutopilotData(data);
+    return 0 != time;
+}
+
+void SkyTelemetryStore::read(Snapshot& snapshot) const
+{
+    unsigned char data[Slot::SIZE];
+    snapshot.debugDataTime = debugDataSlot.read(data);
+    snapshot.debugData = DebugData(data);
+    snapshot.sensorsDataTime = sensorsDataSlot.read(data);
+    snapshot.sensorsData = SensorsData(data);
+    snapshot.autopilotDataTime = autopilotDataSlot.read(data);
+    snapshot.autopilotData = AutopilotData(data);
+}
+
+uint64_t SkyTelemetryStore::getUpdatesCount(void) const
+{
+    return updatesCount.load(std::memory_order_acquire);
+}
+
+void SkyFleetTelemetry::add(const unsigned deviceId, const SkyTelemetryStore* const store)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Record& record : records)
+    {
+        if (deviceId == record.deviceId)
+        {
+            record.store = store;
+            return;
+        }
+    }
+    records.push_back(Record{deviceId, store});
+}
+
+void SkyFleetTelemetry::remove(const unsigned deviceId)
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    for (auto it = records.begin(); it != records.end(); ++it)
+    {
+        if (deviceId == it->deviceId)
+        {
+            records.erase(it);
+            return;
+        }
+    }
+}
+
+void SkyFleetTelemetry::snapshot(std::vector<Entry>& entries) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.resize(records.size());
+    for (unsigned i = 0; i < records.size(); i++)
+    {
+        entries[i].deviceId = records[i].deviceId;
+        records[i].store->read(entries[i].snapshot);
+    }
+}
+
+unsigned SkyFleetTelemetry::size(void) const
+{
+    std::lock_guard<std::mutex> lock(mutex);
+    return records.size();
+}
@@ -0,0 +1,320 @@
+#include "endpoint/device/SkyTrace.hpp"
+
+#include "communication/SignalData.hpp"
+
+#include "endpoint/device/PilotEvent.hpp"
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+constexpr size_t SkyTrace::MAX_ARGUMENTS;
+
+const SkyTrace::Descriptor SkyTrace::DESCRIPTORS[POINTS_COUNT] =
+{
+    {TEXT, "TEXT", "%s"},
+    {DEVICE_CONNECTED, "DEVICE_CONNECTED", "SkyDevice::onConnected"},
+    {DEVICE_DISCONNECTED, "DEVICE_DISCONNECTED", "SkyDevice::onDisconnected"},
+    {PILOT_EVENT, "PILOT_EVENT", "Handling pilot event: %E at: %A @ %s"},
+    {INTERFACE_ERROR, "INTERFACE_ERROR", "SkyDevice::handleError: interface error"},
+    {ACTION_ERROR, "ACTION_ERROR", "SkyDevice::handleError: %s at %s @ %s"},
+    {PROTOCOL_VERSION, "PROTOCOL_VERSION", "Setting up protocol version: %d, compiled version: %d"},
+    {ACTION_STARTED, "ACTION_STARTED", "Starting new action: %A @ %s"},
+    {PING_TASK_STARTED, "PING_TASK_STARTED", "Starting ping task"},
+    {PING_TASK_ENDED, "PING_TASK_ENDED", "Ending ping task"},
+    {CONNECTION_TIMEOUT_TASK_STARTED, "CONNECTION_TIMEOUT_TASK_STARTED", "Starting connection timeout task"},
+    {CONNECTION_TIMEOUT_TASK_ENDED, "CONNECTION_TIMEOUT_TASK_ENDED", "Ending connection timeout task"},
+    {SIGNAL_RECEIVED, "SIGNAL_RECEIVED", "HandleSignalReception with %A @ %s param: %P"},
+    {SIGNAL_TIMEOUT_STARTED, "SIGNAL_TIMEOUT_STARTED", "Starting signal reception %C with timeout: %d ms"},
+    {SIGNAL_PAYLOAD_RECEPTION, "SIGNAL_PAYLOAD_RECEPTION", "Initializing signal payload reception: %C"},
+    {SIGNAL_PAYLOAD_TIMEOUT, "SIGNAL_PAYLOAD_TIMEOUT", "Timeout when receiving over signal payload, errors: %d / %d"},
+    {SIGNAL_PAYLOAD_INVALID, "SIGNAL_PAYLOAD_INVALID", "Invalid data received over signal payload, errors: %d / %d"},
+    {SIGNAL_PAYLOAD_REJECTED, "SIGNAL_PAYLOAD_REJECTED", "Receiver reports fail over signal payload, errors: %d / %d"},
+    {BREAK_COMMAND, "BREAK_COMMAND", "FlightAction::controlTaskHandler:setting break command"},
+    {BREAK_STATE, "BREAK_STATE", "FlightAction::controlTaskHandler:setting break state"},
+    {CONTROL_RATE, "CONTROL_RATE", "FlightAction::adaptRates:control rate: %f Hz"},
+    {TELEMETRY_RATE, "TELEMETRY_RATE", "FlightAction::adaptRates:requesting telemetry rate: %d Hz"},
+    {RADIO_CALIBRATION_ACK, "RADIO_CALIBRATION_ACK", "Calibrate radio response: ACK, chanel: %d"}
+};
+
+std::atomic<int> SkyTrace::runtimeLevel(INFO);
+
+namespace
+{
+
+// records per thread, power of two
+constexpr size_t RING_CAPACITY = 1024;
+constexpr size_t RING_MASK = RING_CAPACITY - 1;
+
+uint64_t getTicks(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+#endif
+}
+
+uint64_t getNanoseconds(void)
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+// single producer (owner thread), single consumer (reader) ring
+struct Ring
+{
+    Ring(const uint32_t _thread):
+        thread(_thread),
+        records(new SkyTrace::Record[RING_CAPACITY]),
+        head(0),
+        tail(0),
+        dropped(0),
+        retired(false)
+    {
+    }
+
+    const uint32_t thread;
+    std::unique_ptr<SkyTrace::Record[]> records;
+
+    // writer and reader positions on separate cache lines
+    char paddingBefore[64];
+    std::atomic<uint64_t> head;
+    char paddingMiddle[64];
+    std::atomic<uint64_t> tail;
+    char paddingAfter[64];
+
+    std::atomic<uint64_t> dropped;
+
+    // owner thread exited, ring is freed by reader when drained
+    std::atomic<bool> retired;
+};
+
+// rings of all threads, lock is taken by thread only at its first trace and exit
+struct Registry
+{
+    Registry(void):
+        threadsCount(0),
+        retiredDropped(0),
+        startTicks(getTicks()),
+        startTime(getNanoseconds())
+    {
+    }
+
+    std::mutex mutex;
+    std::vector<std::unique_ptr<Ring>> rings;
+    uint32_t threadsCount;
+    uint64_t retiredDropped;
+
+    // clock ticks are converted to time with rate measured since start
+    const uint64_t startTicks;
+    const uint64_t startTime;
+
+    double getNanosecondsPerTick(void) const
+    {
+        const uint64_t ticks = getTicks() - startTicks;
+        return ticks > 0 ? (double)(getNanoseconds() - startTime) / ticks : 1.0;
+    }
+};
+
+Registry& getRegistry(void)
+{
+    static Registry registry;
+    return registry;
+}
+
+// marks ring of exiting thread as retired
+struct RingOwner
+{
+    Ring* ring;
+
+    ~RingOwner(void)
+    {
+        if (nullptr != ring)
+        {
+            ring->retired.store(true, std::memory_order_release);
+        }
+    }
+};
+
+thread_local Ring* threadRing = nullptr;
+thread_local RingOwner ringOwner = {nullptr};
+
+Ring* createRing(void)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    registry.rings.push_back(std::unique_ptr<Ring>(new Ring(registry.threadsCount++)));
+    threadRing = registry.rings.back().get();
+    ringOwner.ring = threadRing;
+    return threadRing;
+}
+
+std::string toString(const SkyTrace::Argument& argument, const char conversion)
+{
+    char buffer[32];
+    switch (conversion)
+    {
+    case 'd':
+        return std::to_string(argument.integer);
+
+    case 'f':
+        std::snprintf(buffer, sizeof(buffer), "%g", argument.real);
+        return buffer;
+
+    case 's':
+        return nullptr != argument.text ? argument.text : "null";
+
+    case 'C':
+        return SignalData::toString(static_cast<SignalData::Command>(argument.integer));
+
+    case 'P':
+        return SignalData::toString(static_cast<SignalData::Parameter>(argument.integer));
+
+    case 'E':
+        return PilotEvent::toString(static_cast<PilotEvent::Type>(argument.integer));
+
+    case 'A':
+        return ISkyDeviceAction::toString(static_cast<ISkyDeviceAction::Type>(argument.integer));
+
+    case 'M':
+        return IMessage::toString(static_cast<IMessage::MessageType>(argument.integer));
+
+    default:
+        return "?";
+    }
+}
+
+}
+
+void SkyTrace::setLevel(const Level level)
+{
+    runtimeLevel.store(level, std::memory_order_relaxed);
+}
+
+SkyTrace::Level SkyTrace::getLevel(void)
+{
+    return static_cast<Level>(runtimeLevel.load(std::memory_order_relaxed));
+}
+
+size_t SkyTrace::drain(Record* records, const size_t maxCount)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    const double nanosecondsPerTick = registry.getNanosecondsPerTick();
+    size_t count = 0;
+    auto it = registry.rings.begin();
+    while (registry.rings.end() != it)
+    {
+        Ring& ring = **it;
+        // retired is read first, so head includes last record of exited thread
+        const bool retired = ring.retired.load(std::memory_order_acquire);
+        const uint64_t head = ring.head.load(std::memory_order_acquire);
+        uint64_t tail = ring.tail.load(std::memory_order_relaxed);
+        for (; tail != head && count < maxCount; tail++, count++)
+        {
+            Record& record = records[count];
+            record = ring.records[tail & RING_MASK];
+            record.time = (uint64_t)((record.time - registry.startTicks) * nanosecondsPerTick);
+        }
+        ring.tail.store(tail, std::memory_order_release);
+        if (retired && tail == head)
+        {
+            registry.retiredDropped += ring.dropped.load(std::memory_order_relaxed);
+            it = registry.rings.erase(it);
+        }
+        else
+        {
+            ++it;
+        }
+    }
+    return count;
+}
+
+uint64_t SkyTrace::getDroppedCount(void)
+{
+    Registry& registry = getRegistry();
+    std::lock_guard<std::mutex> lock(registry.mutex);
+    uint64_t dropped = registry.retiredDropped;
+    for (const std::unique_ptr<Ring>& ring : registry.rings)
+    {
+        dropped += ring->dropped.load(std::memory_order_relaxed);
+    }
+    return dropped;
+}
+
+std::string SkyTrace::format(const Record& record)
+{
+    char prefix[48];
+    std::snprintf(prefix, sizeof(prefix), "%.6f [%u] %s: ", record.time / 1e9, record.thread,
+                  toString(static_cast<Level>(record.level)));
+    std::string text = prefix;
+    unsigned argument = 0;
+    for (const char* c = getDescriptor(static_cast<Point>(record.point)).format; '\0' != *c; c++)
+    {
+        if ('%' != *c || '\0' == c[1])
+        {
+            text += *c;
+        }
+        else if ('%' == *++c)
+        {
+            text += '%';
+        }
+        else
+        {
+            text += argument < record.count ? ::toString(record.arguments[argument], *c) : "?";
+            argument++;
+        }
+    }
+    return text;
+}
+
+const SkyTrace::Descriptor& SkyTrace::getDescriptor(const Point point)
+{
+    return point < POINTS_COUNT ? DESCRIPTORS[point] : DESCRIPTORS[TEXT];
+}
+
+const char* SkyTrace::toString(const Level level)
+{
+    switch (level)
+    {
+    case DEBUG: return "DEBUG";
+    case INFO: return "INFO";
+    case WARNING: return "WARNING";
+    case ERROR: return "ERROR";
+    case OFF: return "OFF";
+    default: return "UNKNOWN";
+    }
+}
+
+void SkyTrace::write(const Level level, const Point point, const Argument* arguments, const size_t count)
+{
+    Ring* ring = threadRing;
+    if (nullptr == ring)
+    {
+        ring = createRing();
+    }
+    const uint64_t head = ring->head.load(std::memory_order_relaxed);
+    if (head - ring->tail.load(std::memory_order_acquire) >= RING_CAPACITY)
+    {
+        ring->dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+    Record& record = ring->records[head & RING_MASK];
+    record.time = getTicks();
+    record.thread = ring->thread;
+    record.point = (uint16_t)point;
+    record.level = (uint8_t)level;
+    record.count = (uint8_t)count;
+    std::copy(arguments, arguments + count, record.arguments);
+    ring->head.store(head + 1, std::memory_order_release);
+}
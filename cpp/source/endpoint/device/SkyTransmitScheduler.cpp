@@ -0,0 +1,255 @@
+#include "endpoint/device/SkyTransmitScheduler.hpp"
+
+#include "communication/SignalData.hpp"
+
+#include "endpoint/device/SkyError.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+
+// interface queue is polled, it does not report when it drains
+constexpr SkyTransmitScheduler::Clock::duration QUEUE_POLL_INTERVAL = std::chrono::milliseconds(1);
+
+// initial capacity of queues [frames], control data replaces queued one
+constexpr size_t CONTROL_QUEUE_CAPACITY = 4;
+constexpr size_t AUTOPILOT_QUEUE_CAPACITY = 4;
+constexpr size_t SIGNAL_QUEUE_CAPACITY = 8;
+constexpr size_t BULK_QUEUE_CAPACITY = 32;
+
+}
+
+SkyTransmitScheduler::FrameQueue::FrameQueue(const size_t capacity):
+    frames(capacity),
+    head(0),
+    count(0)
+{
+}
+
+bool SkyTransmitScheduler::FrameQueue::empty(void) const
+{
+    return 0 == count;
+}
+
+size_t SkyTransmitScheduler::FrameQueue::size(void) const
+{
+    return count;
+}
+
+SkyTransmitScheduler::Frame& SkyTransmitScheduler::FrameQueue::at(const size_t index)
+{
+    return frames[(head + index) % frames.size()];
+}
+
+SkyTransmitScheduler::Frame& SkyTransmitScheduler::FrameQueue::front(void)
+{
+    return frames[head];
+}
+
+SkyTransmitScheduler::Frame& SkyTransmitScheduler::FrameQueue::emplaceBack(void)
+{
+    if (count == frames.size())
+    {
+        // queue is full, ring is unrolled into bigger storage
+        std::vector<Frame> grown(2 * frames.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            grown[i] = at(i);
+        }
+        frames.swap(grown);
+        head = 0;
+    }
+    count++;
+    return at(count - 1);
+}
+
+void SkyTransmitScheduler::FrameQueue::popFront(void)
+{
+    head = (head + 1) % frames.size();
+    count--;
+}
+
+void SkyTransmitScheduler::FrameQueue::clear(void)
+{
+    head = 0;
+    count = 0;
+}
+
+SkyTransmitScheduler::Settings::Settings(const unsigned _bitrate,
+                                         const unsigned _burst,
+                                         const size_t _maxInterfaceQueue):
+    bitrate(_bitrate),
+    burst(_burst),
+    maxInterfaceQueue(_maxInterfaceQueue)
+{
+}
+
+SkyTransmitScheduler::SkyTransmitScheduler(const Settings& _settings):
+    settings(_settings),
+    interface(nullptr),
+    queues{FrameQueue(CONTROL_QUEUE_CAPACITY),
+           FrameQueue(AUTOPILOT_QUEUE_CAPACITY),
+           FrameQueue(SIGNAL_QUEUE_CAPACITY),
+           FrameQueue(BULK_QUEUE_CAPACITY)},
+    tokens(settings.burst),
+    lastRefill(Clock::now()),
+    replacedCount(0)
+{
+    std::fill(sentCount, sentCount + PRIORITIES_COUNT, 0);
+}
+
+void SkyTransmitScheduler::setInterface(ISkyCommInterface* const _interface)
+{
+    interface = _interface;
+}
+
+void SkyTransmitScheduler::setBitrate(const unsigned bitrate)
+{
+    settings.bitrate = bitrate;
+}
+
+SkyTransmitScheduler::Priority SkyTransmitScheduler::getPriority(const IMessage& message)
+{
+    switch (message.getMessageType())
+    {
+    case IMessage::CONTROL_DATA:
+        return CONTROL;
+
+    case IMessage::AUTOPILOT_DATA:
+        return AUTOPILOT;
+
+    case IMessage::SIGNAL_DATA:
+        // ping measures link delay, it can not wait in queues
+        return SignalData::PING_VALUE == static_cast<const SignalData&>(message).getCommand() ?
+                    CONTROL : SIGNAL;
+
+    default:
+        return message.isSignalPayloadMessage() ? BULK : SIGNAL;
+    }
+}
+
+bool SkyTransmitScheduler::send(const Priority priority,
+                                const IMessage::MessageType type,
+                                const unsigned char* data,
+                                const size_t length,
+                                const Clock::time_point time)
+{
+    if (length > IMessage::MAX_DATA_SIZE)
+    {
+        SkyError(SkyError::FRAME_TOO_LONG, (int)length).raise();
+    }
+
+    FrameQueue& queue = queues[priority];
+    Frame* frame = nullptr;
+    if (IMessage::CONTROL_DATA == type)
+    {
+        for (size_t i = 0; i < queue.size(); i++)
+        {
+            if (IMessage::CONTROL_DATA == queue.at(i).type)
+            {
+                frame = &queue.at(i);
+                replacedCount++;
+                break;
+            }
+        }
+    }
+    if (nullptr == frame)
+    {
+        frame = &queue.emplaceBack();
+    }
+    frame->type = type;
+    frame->length = length;
+    std::memcpy(frame->data, data, length);
+
+    Clock::duration wait;
+    return pump(wait, time);
+}
+
+bool SkyTransmitScheduler::pump(Clock::duration& wait, const Clock::time_point time)
+{
+    refill(time);
+    while (hasQueued())
+    {
+        if (nullptr == interface)
+        {
+            clear();
+            return false;
+        }
+        if (settings.bitrate > 0 && tokens < 0.0)
+        {
+            wait = std::chrono::duration_cast<Clock::duration>(
+                        std::chrono::duration<double>(-tokens / settings.bitrate));
+            wait = std::max(wait, Clock::duration(std::chrono::microseconds(100)));
+            return true;
+        }
+        if (interface->getSendQueueSize() > settings.maxInterfaceQueue)
+        {
+            wait = QUEUE_POLL_INTERVAL;
+            return true;
+        }
+
+        unsigned priority = CONTROL;
+        while (queues[priority].empty())
+        {
+            priority++;
+        }
+        FrameQueue& queue = queues[priority];
+        const Frame& frame = queue.front();
+        interface->send(frame.data, frame.length);
+        if (settings.bitrate > 0)
+        {
+            tokens -= frame.length;
+        }
+        sentCount[priority]++;
+        queue.popFront();
+    }
+    wait = Clock::duration::zero();
+    return false;
+}
+
+void SkyTransmitScheduler::clear(void)
+{
+    for (FrameQueue& queue : queues)
+    {
+        queue.clear();
+    }
+}
+
+size_t SkyTransmitScheduler::getQueuedCount(const Priority priority) const
+{
+    return queues[priority].size();
+}
+
+uint64_t SkyTransmitScheduler::getSentCount(const Priority priority) const
+{
+    return sentCount[priority];
+}
+
+uint64_t SkyTransmitScheduler::getReplacedCount(void) const
+{
+    return replacedCount;
+}
+
+void SkyTransmitScheduler::refill(const Clock::time_point time)
+{
+    if (time > lastRefill)
+    {
+        const double elapsed = std::chrono::duration<double>(time - lastRefill).count();
+        tokens = std::min((double)settings.burst, tokens + elapsed * settings.bitrate);
+        lastRefill = time;
+    }
+}
+
+bool SkyTransmitScheduler::hasQueued(void) const
+{
+    for (const FrameQueue& queue : queues)
+    {
+        if (false == queue.empty())
+        {
+            return true;
+        }
+    }
+    return false;
+}
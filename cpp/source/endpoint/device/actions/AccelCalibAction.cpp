@@ -2,15 +2,44 @@
 
 #include "endpoint/device/actions/AppAction.hpp"
 
+const char* const AccelCalibAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "CALIBRATION",
+    "CALIBRATION_RECEPTION"
+};
+
+const AccelCalibAction::StateMachine::Transition AccelCalibAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &AccelCalibAction::onInitialAck, CALIBRATION},
+
+    {CALIBRATION, SkyActionEvent::onSignal(SignalData::DONE),
+     nullptr, &AccelCalibAction::onCalibrationDone, CALIBRATION_RECEPTION},
+    {CALIBRATION, SkyActionEvent::onSignal(SignalData::NON_STATIC),
+     nullptr, &AccelCalibAction::onNonStatic, IDLE},
+
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &AccelCalibAction::isSignalPayloadReceived, &AccelCalibAction::onCalibrationReceived, IDLE},
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, CALIBRATION_RECEPTION},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &AccelCalibAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &AccelCalibAction::onIdleReception, INITIAL_COMMAND}
+};
+
 AccelCalibAction::AccelCalibAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void AccelCalibAction::start(void)
 {
-    monitor->trace("Accelerometer calibration procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Accelerometer calibration procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::CALIBRATE_ACCEL, SignalData::START);
 }
@@ -25,83 +54,49 @@ ISkyDeviceAction::Type AccelCalibAction::getType(void) const
     return ACCEL_CALIB;
 }
 
-std::string AccelCalibAction::getStateName(void) const
+const char* AccelCalibAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string AccelCalibAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const AccelCalibAction::StateMachine& AccelCalibAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
+
+bool AccelCalibAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+void AccelCalibAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Accelerometer calibration procedure started");
+    startSignalTimeout(SignalData::CALIBRATE_ACCEL, 2500);
+}
+
+void AccelCalibAction::onCalibrationDone(const SkyActionEvent&)
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case CALIBRATION: return "CALIBRATION";
-    case CALIBRATION_RECEPTION: return "CALIBRATION_RECEPTION";
-    default:
-        throw std::runtime_error("AccelCalibAction::throw std::runtime_errorexpected state");
-    }
+    SkyTrace::info(SkyTrace::TEXT, "Accelerometer calibration done");
+    initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
 }
 
-void AccelCalibAction::handleReception(const IMessage& message)
+void AccelCalibAction::onNonStatic(const SkyActionEvent&)
 {
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
-
-    case CALIBRATION_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::WARNING,
+                                                "Accelerometer calibration aborted.\n"
+                                                "Was preformed in non-static conditions."));
+    listener->startAction(createAction<AppAction>());
 }
 
-void AccelCalibAction::handleSignalReception(const Parameter parameter)
+void AccelCalibAction::onCalibrationReceived(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Accelerometer calibration procedure started");
-            startSignalTimeout(SignalData::CALIBRATE_ACCEL, 2500);
-            state = CALIBRATION;
-            break;
-
-        default:
-            except("Unexpected signal parameter message received");
-        }
-        break;
-
-    case CALIBRATION:
-        switch (parameter)
-        {
-        case SignalData::DONE:
-            monitor->trace("Accelerometer calibration done");
-            initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
-            state = CALIBRATION_RECEPTION;
-            break;
-
-        case SignalData::NON_STATIC:
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::WARNING,
-                                                        "Accelerometer calibration aborted.\n"
-                                                        "Was preformed in non-static conditions."));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter received");
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state");
-    }
+    notifyReceived(event.getMessage());
+    listener->startAction(createAction<AppAction>());
 }
@@ -17,10 +17,30 @@
 #include "endpoint/device/actions/EscCalibAction.hpp"
 
 #include <functional>
-#include <stdexcept>
+
+const char* const AppAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "APP_LOOP"
+};
+
+const AppAction::StateMachine::Transition AppAction::TRANSITIONS[] =
+{
+    {APP_LOOP, SkyActionEvent::onMessage(IMessage::DEBUG_DATA),
+     nullptr, &AppAction::onReceived, APP_LOOP},
+    {APP_LOOP, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &AppAction::isPong, &AppAction::onPong, APP_LOOP},
+
+    {APP_LOOP, SkyActionEvent::onPilotEvent(PilotEvent::ACTION),
+     nullptr, &AppAction::onUserEventAction, APP_LOOP},
+    {APP_LOOP, SkyActionEvent::onPilotEvent(PilotEvent::UPLOAD),
+     nullptr, &AppAction::onUserEventUpload, APP_LOOP},
+    {APP_LOOP, SkyActionEvent::onPilotEvent(PilotEvent::DOWNLOAD),
+     nullptr, &AppAction::onUserEventDownload, APP_LOOP}
+};
 
 AppAction::AppAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
@@ -48,117 +68,85 @@ ISkyDeviceAction::Type AppAction::getType(void) const
     return APP;
 }
 
-std::string AppAction::getStateName(void) const
+const char* AppAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case APP_LOOP: return "APP_LOOP";
-    default:
-        throw std::runtime_error("AppAction::getStateName::Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void AppAction::handleReception(const IMessage& message)
+std::string AppAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case APP_LOOP:
-        if (IMessage::DEBUG_DATA == message.getMessageType())
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        else if (isPingMessage(message))
-        {
-            listener->onPongReception(reinterpret_cast<const SignalData&>(message));
-        }
-        else
-        {
-            except("Unexpected message received", message);
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void AppAction::handleUserEvent(const PilotEvent& event)
+const AppAction::StateMachine& AppAction::getStateMachine(void)
 {
-    switch (event.getType())
-    {
-    case PilotEvent::ACTION:
-        handleUserUavEventAction(reinterpret_cast<const PilotEventAction&>(event));
-        break;
-
-    case PilotEvent::UPLOAD:
-        handleUserUavEventUpload(reinterpret_cast<const PilotEventUpload&>(event));
-        break;
-
-    case PilotEvent::DOWNLOAD:
-        handleUserUavEventDownload(reinterpret_cast<const PilotEventDownload&>(event));
-        break;
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
 
-    default:
-        except("Unexpected user event received");
-    }
+bool AppAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
 }
 
-void AppAction::handleUserUavEventAction(const PilotEventAction& event)
+void AppAction::onUserEventAction(const SkyActionEvent& event)
 {
-    switch (event.getAction())
+    const ISkyDeviceAction::Type action = static_cast<const PilotEventAction&>(event.getPilotEvent()).getAction();
+    switch (action)
     {
     case UPGRADE:
-        listener->startAction(new UpgradeAction(listener));
+        listener->startAction(createAction<UpgradeAction>());
         break;
 
     case DISCONNECT:
-        listener->startAction(new DisconnectAction(listener));
+        listener->startAction(createAction<DisconnectAction>());
         break;
 
     case FLIGHT_INITIALIZATION:
-        listener->startAction(new FlightInitializationAction(listener));
+        listener->startAction(createAction<FlightInitializationAction>());
         break;
 
     case ACCEL_CALIB:
-        listener->startAction(new AccelCalibAction(listener));
+        listener->startAction(createAction<AccelCalibAction>());
         break;
 
     case MAGNET_CALIB:
-        listener->startAction(new MagnetCalibAction(listener));
+        listener->startAction(createAction<MagnetCalibAction>());
         break;
 
     case SENSORS_LOGGER:
-        listener->startAction(new SensorsLoggerAction(listener));
+        listener->startAction(createAction<SensorsLoggerAction>());
         break;
 
     case RADIO_CHECK:
-        listener->startAction(new RadioCheckAction(listener));
+        listener->startAction(createAction<RadioCheckAction>());
         break;
 
     case RADIO_CALIB:
-        listener->startAction(new RadioCalibAction(listener));
+        listener->startAction(createAction<RadioCalibAction>());
         break;
 
     case ESC_CALIB:
-        listener->startAction(new EscCalibAction(listener));
+        listener->startAction(createAction<EscCalibAction>());
         break;
 
     case RESET:
-        listener->startAction(new ResetAction(listener));
+        listener->startAction(createAction<ResetAction>());
         break;
 
     default:
-        except("Unexpected action to start");
+        fail(SkyError::UNEXPECTED_ACTION, action);
     }
 }
 
-void AppAction::handleUserUavEventUpload(const PilotEventUpload& event)
+void AppAction::onUserEventUpload(const SkyActionEvent& event)
 {
-    listener->startAction(new UploadSignalPayload(listener, *event.getData().clone()));
+    const PilotEventUpload& upload = static_cast<const PilotEventUpload&>(event.getPilotEvent());
+    listener->startAction(createAction<UploadSignalPayload>(*upload.getData().clone()));
 }
 
-void AppAction::handleUserUavEventDownload(const PilotEventDownload& event)
+void AppAction::onUserEventDownload(const SkyActionEvent& event)
 {
-    listener->startAction(new DownloadSignalPaylod(listener, event.getDataType()));
+    const PilotEventDownload& download = static_cast<const PilotEventDownload&>(event.getPilotEvent());
+    listener->startAction(createAction<DownloadSignalPaylod>(download.getDataType()));
 }
@@ -4,8 +4,43 @@
 
 #include "communication/CalibrationSettings.hpp"
 
+const char* const ConnectAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "PROTOCOL_VERSION",
+    "CALIBRATION",
+    "CALIBRATION_RECEPTION",
+    "FINAL_COMMAND"
+};
+
+const ConnectAction::StateMachine::Transition ConnectAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &ConnectAction::onInitialAck, PROTOCOL_VERSION},
+
+    // protocol version is sent as plain value
+    {PROTOCOL_VERSION, SkyActionEvent::ANY_SIGNAL,
+     &ConnectAction::isProtocolSupported, &ConnectAction::onProtocolVersion, CALIBRATION},
+    {PROTOCOL_VERSION, SkyActionEvent::ANY_SIGNAL,
+     nullptr, &ConnectAction::onProtocolNotSupported, PROTOCOL_VERSION},
+
+    {CALIBRATION, SkyActionEvent::onSignal(SignalData::READY),
+     nullptr, &ConnectAction::onCalibrationReady, CALIBRATION_RECEPTION},
+    {CALIBRATION, SkyActionEvent::onSignal(SignalData::NON_STATIC),
+     nullptr, &ConnectAction::onCalibrationNonStatic, CALIBRATION},
+
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &ConnectAction::isSignalPayloadReceived, &ConnectAction::onCalibrationReceived, FINAL_COMMAND},
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, CALIBRATION_RECEPTION},
+
+    {FINAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &ConnectAction::onFinalAck, IDLE}
+};
+
 ConnectAction::ConnectAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
     wasNonStatic = false;
@@ -13,7 +48,7 @@ ConnectAction::ConnectAction(Listener* const _listener):
 
 void ConnectAction::start(void)
 {
-    monitor->trace("ConnectAction::start");
+    SkyTrace::info(SkyTrace::TEXT, "ConnectAction::start");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::START_CMD, SignalData::START);
 }
@@ -28,115 +63,78 @@ ISkyDeviceAction::Type ConnectAction::getType(void) const
     return CONNECT;
 }
 
-std::string ConnectAction::getStateName(void) const
+const char* ConnectAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case PROTOCOL_VERSION: return "PROTOCOL_VERSION";
-    case CALIBRATION: return "CALIBRATION";
-    case CALIBRATION_RECEPTION: return "CALIBRATION_RECEPTION";
-    case FINAL_COMMAND: return "FINAL_COMMAND";
-    default:
-        throw std::runtime_error("ConnectAction::getStateName::Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void ConnectAction::handleReception(const IMessage& message)
+std::string ConnectAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case CALIBRATION_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            state = FINAL_COMMAND;
-            listener->send(SignalData(SignalData::APP_LOOP, SignalData::START));
-            startSignalTimeout(SignalData::APP_LOOP);
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const ConnectAction::StateMachine& ConnectAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
+
+bool ConnectAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+bool ConnectAction::isProtocolSupported(const SkyActionEvent& event)
+{
+    return listener->setupProtocolVersion(static_cast<unsigned>(event.getParameter()));
+}
+
+void ConnectAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Initial command successfull");
+    startSignalTimeout(SignalData::PROTOCOL_VERSION_VALUE);
+}
+
+void ConnectAction::onProtocolVersion(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Protocol setup done");
+    listener->send(SignalData(SignalData::PROTOCOL_VERSION, SignalData::ACK));
+    startSignalTimeout(SignalData::CALIBRATION_SETTINGS);
+}
+
+void ConnectAction::onProtocolNotSupported(const SkyActionEvent& event)
+{
+    sendSignal(SignalData::PROTOCOL_VERSION, SignalData::NOT_ALLOWED);
+    fail(SkyError::UNSUPPORTED_PROTOCOL, event.getParameter());
 }
 
-void ConnectAction::handleSignalReception(const Parameter parameter)
+void ConnectAction::onCalibrationReady(const SkyActionEvent&)
 {
-    switch (state)
+    SkyTrace::info(SkyTrace::TEXT, "Calibration done");
+    initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
+}
+
+void ConnectAction::onCalibrationNonStatic(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Calibration non-static");
+    startSignalTimeout(SignalData::CALIBRATION_SETTINGS);
+    if (!wasNonStatic)
     {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Initial command successfull");
-            startSignalTimeout(SignalData::PROTOCOL_VERSION_VALUE);
-            state = PROTOCOL_VERSION;
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case PROTOCOL_VERSION:
-        if (listener->setupProtocolVersion(static_cast<const unsigned>(parameter)))
-        {
-            monitor->trace("Protocol setup done");
-            listener->send(SignalData(SignalData::PROTOCOL_VERSION, SignalData::ACK));
-            startSignalTimeout(SignalData::CALIBRATION_SETTINGS);
-            state = CALIBRATION;
-        }
-        else
-        {
-            sendSignal(SignalData::PROTOCOL_VERSION, SignalData::NOT_ALLOWED);
-            except("Target uses unsupported SkyComm protocol version (" +
-                   std::to_string(static_cast<unsigned>(parameter)) +
-                   "). Cannot proceed with connection procedure");
-        }
-        break;
-
-    case CALIBRATION:
-        switch (parameter)
-        {
-        case SignalData::READY:
-            monitor->trace("Calibration done");
-            initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
-            state = CALIBRATION_RECEPTION;
-            break;
-
-        case SignalData::NON_STATIC:
-            monitor->trace("Calibration non-static");
-            startSignalTimeout(SignalData::CALIBRATION_SETTINGS);
-            if (!wasNonStatic)
-            {
-                wasNonStatic = true;
-                monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATION_NON_STATIC));
-            }
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    case FINAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("App loop ready");
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::APPLICATION_LOOP_STARTED));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
+        wasNonStatic = true;
+        monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATION_NON_STATIC));
     }
 }
+
+void ConnectAction::onCalibrationReceived(const SkyActionEvent& event)
+{
+    listener->send(SignalData(SignalData::APP_LOOP, SignalData::START));
+    startSignalTimeout(SignalData::APP_LOOP);
+    notifyReceived(event.getMessage());
+}
+
+void ConnectAction::onFinalAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "App loop ready");
+    listener->startAction(createAction<AppAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::APPLICATION_LOOP_STARTED));
+}
@@ -2,15 +2,38 @@
 
 #include "endpoint/device/actions/IdleAction.hpp"
 
+const char* const DisconnectAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "DISCONNECTING"
+};
+
+const DisconnectAction::StateMachine::Transition DisconnectAction::TRANSITIONS[] =
+{
+    {DISCONNECTING, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     nullptr, &DisconnectAction::onBreakAck, IDLE},
+
+    // link is being closed, other responses are ignored
+    {IDLE, SkyActionEvent::ANY_SIGNAL,
+     nullptr, nullptr, IDLE},
+    {DISCONNECTING, SkyActionEvent::ANY_SIGNAL,
+     nullptr, nullptr, DISCONNECTING},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &DisconnectAction::onIdleReception, IDLE},
+    {DISCONNECTING, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &DisconnectAction::onIdleReception, DISCONNECTING}
+};
+
 DisconnectAction::DisconnectAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void DisconnectAction::start(void)
 {
-    monitor->trace("Disconnect procedure started");
+    SkyTrace::info(SkyTrace::TEXT, "Disconnect procedure started");
     state = DISCONNECTING;
     sendSignal(SignalData::APP_LOOP, SignalData::BREAK);
 }
@@ -25,30 +48,31 @@ ISkyDeviceAction::Type DisconnectAction::getType(void) const
     return DISCONNECT;
 }
 
-std::string DisconnectAction::getStateName(void) const
+const char* DisconnectAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string DisconnectAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const DisconnectAction::StateMachine& DisconnectAction::getStateMachine(void)
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case DISCONNECTING: return "DISCONNECTING";
-    default:
-        throw std::runtime_error("AppAction::getStateName::Unexpected state");
-    }
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void DisconnectAction::handleReception(const IMessage& message)
+bool DisconnectAction::dispatch(const SkyActionEvent& event)
 {
-    handleIdleReception(message);
+    return getStateMachine().dispatch(*this, state, event);
 }
 
-void DisconnectAction::handleSignalReception(const Parameter parameter)
+void DisconnectAction::onBreakAck(const SkyActionEvent&)
 {
-    if (DISCONNECTING == state && SignalData::BREAK_ACK == parameter)
-    {
-        monitor->trace("App. loop disconnected");
-        state = IDLE;
-        listener->startAction(new IdleAction(listener));
-        listener->disconnectInterface();
-        monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::APPLICATION_LOOP_ENDED));
-    }
+    SkyTrace::info(SkyTrace::TEXT, "App. loop disconnected");
+    listener->startAction(createAction<IdleAction>());
+    listener->disconnectInterface();
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::APPLICATION_LOOP_ENDED));
 }
@@ -2,8 +2,35 @@
 
 #include "endpoint/device/actions/AppAction.hpp"
 
+#include "communication/ControlSettings.hpp"
+
+const char* const DownloadSignalPaylod::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "DATA_RECEPTION"
+};
+
+const DownloadSignalPaylod::StateMachine::Transition DownloadSignalPaylod::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &DownloadSignalPaylod::onInitialAck, DATA_RECEPTION},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::FAIL),
+     nullptr, &DownloadSignalPaylod::onFail, IDLE},
+
+    {DATA_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &DownloadSignalPaylod::isSignalPayloadReceived, &DownloadSignalPaylod::onDataReceived, IDLE},
+    {DATA_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, DATA_RECEPTION},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &DownloadSignalPaylod::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &DownloadSignalPaylod::onIdleReception, INITIAL_COMMAND}
+};
+
 DownloadSignalPaylod::DownloadSignalPaylod(Listener* const _listener, const SignalData::Command _type):
-    ISkyDeviceAction(_listener),
+    ISkyTableAction(_listener),
     type(_type),
     downloadCommand(getDownloadCommand())
 {
@@ -12,7 +39,12 @@ DownloadSignalPaylod::DownloadSignalPaylod(Listener* const _listener, const Sign
 
 void DownloadSignalPaylod::start(void)
 {
-    monitor->trace("Signal payload download procedure requested");
+    if (SignalData::DUMMY == downloadCommand)
+    {
+        fail(SkyError::UNEXPECTED_PAYLOAD_TYPE, type);
+        return;
+    }
+    SkyTrace::info(SkyTrace::TEXT, "Signal payload download procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(downloadCommand, SignalData::START);
 }
@@ -27,68 +59,43 @@ ISkyDeviceAction::Type DownloadSignalPaylod::getType(void) const
     return DOWNLOAD_SIGNAL_PAYLOAD;
 }
 
-std::string DownloadSignalPaylod::getStateName(void) const
+const char* DownloadSignalPaylod::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case DATA_RECEPTION: return "DATA_RECEPTION";
-    default:
-        throw std::runtime_error("DownloadSignalPaylothrow std::runtime_error:Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void DownloadSignalPaylod::handleReception(const IMessage& message)
+std::string DownloadSignalPaylod::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
-
-    case DATA_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        break;
+    return getStateMachine().toDot(toString(getType()));
+}
 
-    default:
-        except("Message received in unexpected state", message);
-    }
+const DownloadSignalPaylod::StateMachine& DownloadSignalPaylod::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void DownloadSignalPaylod::handleSignalReception(const Parameter parameter)
+bool DownloadSignalPaylod::dispatch(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Signal payload download procedure started");
-            initializeSignalPayloadReception(type);
-            state = DATA_RECEPTION;
-            break;
-
-        case SignalData::FAIL:
-            monitor->notifyDeviceEvent(new DeviceEvent(getMonitorFailEvent()));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
+    return getStateMachine().dispatch(*this, state, event);
+}
 
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+void DownloadSignalPaylod::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Signal payload download procedure started");
+    initializeSignalPayloadReception(type, getExpectedPayloadSize());
+}
+
+void DownloadSignalPaylod::onFail(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(getMonitorFailEvent()));
+    listener->startAction(createAction<AppAction>());
+}
+
+void DownloadSignalPaylod::onDataReceived(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<AppAction>());
+    notifyReceived(event.getMessage());
 }
 
 SignalData::Command DownloadSignalPaylod::getDownloadCommand(void) const
@@ -98,7 +105,8 @@ SignalData::Command DownloadSignalPaylod::getDownloadCommand(void) const
     case SignalData::CONTROL_SETTINGS: return SignalData::DOWNLOAD_SETTINGS;
     case SignalData::ROUTE_CONTAINER: return SignalData::DOWNLOAD_ROUTE;
     default:
-        throw std::runtime_error("DownloadSignalPaylod::getDownloadCommand::Unexpected type");
+        // reported by start
+        return SignalData::DUMMY;
     }
 }
 
@@ -107,8 +115,19 @@ DeviceEvent::Type DownloadSignalPaylod::getMonitorFailEvent(void) const
     switch (type)
     {
     case SignalData::CONTROL_SETTINGS: return DeviceEvent::CONTROLS_DOWNLOAD_FAIL;
-    case SignalData::ROUTE_CONTAINER: return DeviceEvent::ROUTE_DOWNLOAD_FAIL;
     default:
-        throw std::runtime_error("DownloadSignalPaylod::getMonitorFailEvent::Unexpected type");
+        // other types are reported when action is started
+        return DeviceEvent::ROUTE_DOWNLOAD_FAIL;
+    }
+}
+
+unsigned DownloadSignalPaylod::getExpectedPayloadSize(void) const
+{
+    switch (type)
+    {
+    case SignalData::CONTROL_SETTINGS: return ControlSettings().getDataSize();
+    default:
+        // route size is not known before reception
+        return 0;
     }
 }
@@ -4,8 +4,62 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+const char* const EscCalibAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "ESC_DISCONNECT",
+    "ESC_DISCONNECT_ACK",
+    "ESC_CONNECT",
+    "ESC_CONNECT_ACK",
+    "CALIBRATING",
+    "FINAL_ESC_DISCONNECT",
+    "FINAL_ESC_DISCONNECT_ACK"
+};
+
+const EscCalibAction::StateMachine::Transition EscCalibAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &EscCalibAction::onInitialAck, ESC_DISCONNECT},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::NOT_ALLOWED),
+     nullptr, &EscCalibAction::onNotAllowed, IDLE},
+
+    {ESC_DISCONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_DONE),
+     nullptr, &EscCalibAction::onProceed, ESC_DISCONNECT_ACK},
+    {ESC_DISCONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_ABORT),
+     nullptr, &EscCalibAction::onProceed, ESC_DISCONNECT_ACK},
+    {ESC_DISCONNECT_ACK, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &EscCalibAction::onStepDone, ESC_CONNECT},
+    {ESC_DISCONNECT_ACK, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     &EscCalibAction::isBreaking, &EscCalibAction::onBreakAck, IDLE},
+
+    {ESC_CONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_DONE),
+     nullptr, &EscCalibAction::onProceed, ESC_CONNECT_ACK},
+    {ESC_CONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_ABORT),
+     nullptr, &EscCalibAction::onProceed, ESC_CONNECT_ACK},
+    {ESC_CONNECT_ACK, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &EscCalibAction::onConnectAck, CALIBRATING},
+    {ESC_CONNECT_ACK, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     &EscCalibAction::isBreaking, &EscCalibAction::onBreakAck, IDLE},
+
+    {CALIBRATING, SkyActionEvent::onSignal(SignalData::DONE),
+     nullptr, &EscCalibAction::onStepDone, FINAL_ESC_DISCONNECT},
+
+    {FINAL_ESC_DISCONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_DONE),
+     nullptr, &EscCalibAction::onFinalProceed, FINAL_ESC_DISCONNECT_ACK},
+    {FINAL_ESC_DISCONNECT, SkyActionEvent::onPilotEvent(PilotEvent::ESC_CALIB_ABORT),
+     nullptr, &EscCalibAction::onFinalProceed, FINAL_ESC_DISCONNECT_ACK},
+    {FINAL_ESC_DISCONNECT_ACK, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &EscCalibAction::onFinalAck, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &EscCalibAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &EscCalibAction::onIdleReception, INITIAL_COMMAND}
+};
+
 EscCalibAction::EscCalibAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
     breaking = false;
@@ -13,7 +67,7 @@ EscCalibAction::EscCalibAction(Listener* const _listener):
 
 void EscCalibAction::start(void)
 {
-    monitor->trace("ESC calibration procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "ESC calibration procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::CALIBRATE_ESC, SignalData::START);
 }
@@ -28,176 +82,88 @@ ISkyDeviceAction::Type EscCalibAction::getType(void) const
     return ESC_CALIB;
 }
 
-std::string EscCalibAction::getStateName(void) const
+const char* EscCalibAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case ESC_DISCONNECT: return "ESC_DISCONNECT";
-    case ESC_DISCONNECT_ACK: return "ESC_DISCONNECT_ACK";
-    case ESC_CONNECT: return "ESC_CONNECT";
-    case ESC_CONNECT_ACK: return "ESC_CONNECT_ACK";
-    case CALIBRATING: return "CALIBRATING";
-    case FINAL_ESC_DISCONNECT: return "FINAL_ESC_DISCONNECT";
-    case FINAL_ESC_DISCONNECT_ACK: return "FINAL_ESC_DISCONNECT_ACK";
-    default:
-        throw std::runtime_error("EscCalib::getStateName::Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void EscCalibAction::proceed(const Parameter userCommand)
+std::string EscCalibAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case ESC_CONNECT:
-        state = ESC_CONNECT_ACK;
-        sendSignal(Command::CALIBRATE_ESC, userCommand);
-        break;
-
-    case ESC_DISCONNECT:
-        state = ESC_DISCONNECT_ACK;
-        sendSignal(Command::CALIBRATE_ESC, userCommand);
-        break;
-
-    case FINAL_ESC_DISCONNECT:
-        state = FINAL_ESC_DISCONNECT_ACK;
-        sendSignal(Command::CALIBRATE_ESC, Parameter::READY);
-        break;
-
-    default:
-        except("Uav event received at unexpected state");
-    }
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void EscCalibAction::handleReception(const IMessage& message)
+const EscCalibAction::StateMachine& EscCalibAction::getStateMachine(void)
 {
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
+
+bool EscCalibAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+bool EscCalibAction::isBreaking(const SkyActionEvent&)
+{
+    return breaking;
+}
+
+void EscCalibAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "ESC calibration procedure started");
+    listener->enableConnectionTimeoutTask(false);
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_ESC_STARTED));
+}
 
-    default:
-        except("Message received in unexpected state", message);
+void EscCalibAction::onNotAllowed(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "ESC calibration not allowed");
+    listener->startAction(createAction<AppAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_ESC_NOT_ALLOWED));
+}
+
+void EscCalibAction::onProceed(const SkyActionEvent& event)
+{
+    if (PilotEvent::ESC_CALIB_ABORT == event.getPilotEvent().getType())
+    {
+        breaking = true;
+        sendSignal(Command::CALIBRATE_ESC, Parameter::BREAK_FAIL, 3000);
+    }
+    else
+    {
+        sendSignal(Command::CALIBRATE_ESC, Parameter::DONE, 3000);
     }
 }
 
-void EscCalibAction::handleSignalReception(const Parameter parameter)
+void EscCalibAction::onFinalProceed(const SkyActionEvent& event)
 {
-    switch (state)
+    if (PilotEvent::ESC_CALIB_ABORT == event.getPilotEvent().getType())
     {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("ESC calibration procedure started");
-            listener->enableConnectionTimeoutTask(false);
-            state = ESC_DISCONNECT;
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_ESC_STARTED));
-            break;
-
-        case SignalData::NOT_ALLOWED:
-            monitor->trace("ESC calibration not allowed");
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_ESC_NOT_ALLOWED));
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    case ESC_DISCONNECT_ACK:
-    case ESC_CONNECT_ACK:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            switch (state)
-            {
-            case ESC_DISCONNECT_ACK:
-                state = ESC_CONNECT;
-                break;
-
-            case ESC_CONNECT_ACK:
-                state = CALIBRATING;
-                startSignalTimeout(SignalData::CALIBRATE_ESC, 3000);
-                break;
-
-            default:
-                except("Received unexpected ACK for calibration proceed");
-            }
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_ESC_DONE));
-            break;
-
-        case SignalData::BREAK_ACK:
-            if (breaking)
-            {
-                monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::INFO,
-                                                                  "ESC calibration broken."));
-                state = IDLE;
-                listener->startAction(new AppAction(listener));
-            }
-            else
-            {
-                except("Received unexpected ACK for calibration break", parameter);
-            }
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    case CALIBRATING:
-        switch (parameter)
-        {
-        case SignalData::DONE:
-            state = FINAL_ESC_DISCONNECT;
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_ESC_DONE));
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    case FINAL_ESC_DISCONNECT_ACK:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_ESC_ENDED));
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
+        breaking = true;
     }
+    sendSignal(Command::CALIBRATE_ESC, Parameter::READY, 3000);
 }
 
+void EscCalibAction::onStepDone(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_ESC_DONE));
+}
 
-void EscCalibAction::handleUserEvent(const PilotEvent& event)
+void EscCalibAction::onConnectAck(const SkyActionEvent&)
 {
-    switch (event.getType())
-    {
-    case PilotEvent::ESC_CALIB_DONE:
-        proceed(Parameter::DONE);
-        break;
+    startSignalTimeout(SignalData::CALIBRATE_ESC, 3000);
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_ESC_DONE));
+}
 
-    case PilotEvent::ESC_CALIB_ABORT:
-        breaking = true;
-        proceed(Parameter::BREAK_FAIL);
-        break;
+void EscCalibAction::onBreakAck(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::INFO,
+                                                      "ESC calibration broken."));
+    listener->startAction(createAction<AppAction>());
+}
 
-    default:
-        except("Unexpected user event received");
-    }
+void EscCalibAction::onFinalAck(const SkyActionEvent&)
+{
+    listener->startAction(createAction<AppAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_ESC_ENDED));
 }
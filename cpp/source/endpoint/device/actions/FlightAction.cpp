@@ -4,30 +4,74 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+#include <cmath>
 #include <functional>
 
+const char* const FlightAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "FLING",
+    "BREAKING"
+};
+
+// flight loop messages are received without signal procedure, board signals come as SignalData
+const FlightAction::StateMachine::Transition FlightAction::TRANSITIONS[] =
+{
+    {FLING, SkyActionEvent::onMessage(IMessage::DEBUG_DATA),
+     nullptr, &FlightAction::onReceived, FLING},
+    {FLING, SkyActionEvent::onMessage(IMessage::AUTOPILOT_DATA),
+     nullptr, &FlightAction::onAutopilotReceived, FLING},
+    {FLING, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &FlightAction::isPong, &FlightAction::onPong, FLING},
+    {FLING, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &FlightAction::isBreak, &FlightAction::onBrokenByBoard, IDLE},
+
+    {BREAKING, SkyActionEvent::onMessage(IMessage::DEBUG_DATA),
+     nullptr, &FlightAction::onReceived, BREAKING},
+    {BREAKING, SkyActionEvent::onMessage(IMessage::AUTOPILOT_DATA),
+     nullptr, &FlightAction::onAutopilotReceived, BREAKING},
+    {BREAKING, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &FlightAction::isPong, &FlightAction::onPong, BREAKING},
+    {BREAKING, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &FlightAction::isBreakAck, &FlightAction::onBreakAck, IDLE},
+    {BREAKING, SkyActionEvent::onMessage(IMessage::SIGNAL_DATA),
+     &FlightAction::isBreak, &FlightAction::onBrokenByBoard, IDLE},
+
+    {FLING, SkyActionEvent::onPilotEvent(PilotEvent::BREAK_FLIGHT_LOOP),
+     nullptr, &FlightAction::onBreakRequested, BREAKING},
+    {FLING, SkyActionEvent::onPilotEvent(PilotEvent::AUTOPILOT),
+     nullptr, &FlightAction::onAutopilotTarget, FLING},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &FlightAction::onIdleReception, IDLE}
+};
+
 FlightAction::FlightAction(Listener* const _listener, const double _controlFreq):
-    ISkyDeviceAction(_listener),
-    controlFreq(_controlFreq)
+    ISkyTableAction(_listener),
+    controlFreq(_controlFreq),
+    currentControlFreq(_controlFreq),
+    requestedTelemetryRate(0)
 {
     state = IDLE;
 
-    controlTimer = monitor->createTimer(std::bind(&FlightAction::controlTaskHandler, this));
+    controlTimer = listener->createTimer([this]() { controlTaskHandler(); });
 }
 
 FlightAction::~FlightAction(void)
 {
-    delete controlTimer;
+    listener->releaseTimer(controlTimer);
 }
 
 void FlightAction::start(void)
 {
-    monitor->trace("Flight final start command");
+    SkyTrace::info(SkyTrace::TEXT, "Flight final start command");
     state = FLING;
-    monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::FLIGHT_LOOP_STARTED));
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_STARTED));
     listener->send(SignalData(SignalData::FLIGHT_LOOP, SignalData::READY));
     listener->enablePingTask(true);
-    controlTimer->start(controlFreq);
+    const SkyRateController* rateController = listener->getRateController();
+    currentControlFreq = nullptr != rateController ? rateController->getControlRate() : controlFreq;
+    controlTimer->start(currentControlFreq);
 }
 
 bool FlightAction::isActionDone(void) const
@@ -40,109 +84,62 @@ ISkyDeviceAction::Type FlightAction::getType(void) const
     return FLIGHT;
 }
 
-std::string FlightAction::getStateName(void) const
+const char* FlightAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case FLING: return "FLING";
-    case BREAKING: return "BREAKING";
-    default:
-        throw std::runtime_error("FlightAction::getStateName::Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void FlightAction::handleReception(const IMessage& message)
+std::string FlightAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case IDLE:
-        handleIdleReception(message);
-        break;
+    return getStateMachine().toDot(toString(getType()));
+}
 
-    case FLING:
-    case BREAKING:
-        handleRunningReception(message);
-        break;
+const FlightAction::StateMachine& FlightAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
 
-    default:
-        except("Unexpected state");
-    }
+bool FlightAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
 }
 
-void FlightAction::handleUserEvent(const PilotEvent& event)
+bool FlightAction::isBreak(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case FLING:
-        switch (event.getType())
-        {
-        case PilotEvent::BREAK_FLIGHT_LOOP:
-            listener->enablePingTask(false);
-            listener->enableConnectionTimeoutTask(false);
-            state = BREAKING;
-            break;
-
-        case PilotEvent::AUTOPILOT:
-            sendAutopilotTarget(reinterpret_cast<const PilotEventAutopilot&>(event));
-            break;
-
-        default:
-            except("Unexpected user event received");
-        }
-        break;
+    return matchSignalData(SignalData::FLIGHT_LOOP, SignalData::BREAK, event.getMessage());
+}
 
-    default:
-        except("User event received in unexpected state");
-    }
+bool FlightAction::isBreakAck(const SkyActionEvent& event)
+{
+    return matchSignalData(SignalData::FLIGHT_LOOP, SignalData::BREAK_ACK, event.getMessage());
 }
 
-void FlightAction::handleRunningReception(const IMessage& message)
+void FlightAction::onAutopilotReceived(const SkyActionEvent& event)
 {
-    switch (message.getMessageType())
-    {
-    case IMessage::DEBUG_DATA:
-        monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        break;
+    notifyReceived(event.getMessage());
+    handleAutopilotReception(static_cast<const AutopilotData&>(event.getMessage()));
+}
 
-    case IMessage::AUTOPILOT_DATA:
-        monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        handleAutopilotReception(reinterpret_cast<const AutopilotData&>(message));
-        break;
+void FlightAction::onBreakRequested(const SkyActionEvent&)
+{
+    listener->enablePingTask(false);
+    listener->enableConnectionTimeoutTask(false);
+}
 
-    case IMessage::SIGNAL_DATA:
-    {
-        const SignalData signal = reinterpret_cast<const SignalData&>(message);
-        switch (signal.getCommand())
-        {
-        case SignalData::PING_VALUE:
-            listener->onPongReception(signal);
-            break;
-
-        case SignalData::FLIGHT_LOOP:
-            if (SignalData::BREAK_ACK == signal.getParameter() && BREAKING == state)
-            {
-                flightEnded(false);
-            }
-            else if (SignalData::BREAK == signal.getParameter())
-            {
-                flightEnded(true);
-            }
-            else
-            {
-                except("Unexpected message received", message);
-            }
-            break;
-
-        default:
-            except("Unexpected message received", message);
-        }
-        break;
-    }
+void FlightAction::onBrokenByBoard(const SkyActionEvent&)
+{
+    flightEnded(true);
+}
 
-    default:
-        except("Unexpected message received", message);
-    }
+void FlightAction::onBreakAck(const SkyActionEvent&)
+{
+    flightEnded(false);
+}
+
+void FlightAction::onAutopilotTarget(const SkyActionEvent& event)
+{
+    sendAutopilotTarget(static_cast<const PilotEventAutopilot&>(event.getPilotEvent()));
 }
 
 void FlightAction::handleAutopilotReception(const AutopilotData& message)
@@ -154,68 +151,94 @@ void FlightAction::handleAutopilotReception(const AutopilotData& message)
         break;
 
     case AutopilotData::TARGET_ACK:
-        monitor->trace("Target confirmed by board, stopping timeout timer");
+        SkyTrace::info(SkyTrace::TEXT, "Target confirmed by board, stopping timeout timer");
         break;
 
     case AutopilotData::TARGET_NOT_ALLOWED_SETTINGS:
     case AutopilotData::TARGET_NOT_ALLOWED_STATE:
-        monitor->trace("Target rejected by board, stopping timeout timer");
+        SkyTrace::info(SkyTrace::TEXT, "Target rejected by board, stopping timeout timer");
         break;
 
     default:
-        except("Unexpected autopilot message received", message);
+        fail(SkyError::UNEXPECTED_MESSAGE, message);
     }
 }
 
 void FlightAction::controlTaskHandler(void)
 {
-    std::unique_ptr<ControlData> data(new ControlData(monitor->getControlDataToSend()));
+    ControlData data(monitor->getControlDataToSend());
     if (BREAKING == state)
     {
-        monitor->trace("FlightAction::controlTaskHandler:setting break command");
-        data->setControllerCommand(ControlData::STOP);
+        SkyTrace::debug(SkyTrace::BREAK_COMMAND);
+        data.setControllerCommand(ControlData::STOP);
     }
-    else if (data->getControllerCommand() == ControlData::STOP)
+    else if (data.getControllerCommand() == ControlData::STOP)
     {
-        monitor->trace("FlightAction::controlTaskHandler:setting break state");
+        SkyTrace::info(SkyTrace::BREAK_STATE);
         state = BREAKING;
     }
-    listener->send(*data);
-    monitor->notifyDeviceEvent(new DeviceEventSent(*data.release()));
+    listener->send(data);
+    notifySent(data);
+    adaptRates();
+}
+
+void FlightAction::adaptRates(void)
+{
+    const SkyRateController* rateController = listener->getRateController();
+    if (nullptr == rateController || FLING != state)
+    {
+        return;
+    }
+
+    const double rate = rateController->getControlRate();
+    if (std::fabs(rate - currentControlFreq) >= CONTROL_RATE_HYSTERESIS)
+    {
+        SkyTrace::info(SkyTrace::CONTROL_RATE, rate);
+        currentControlFreq = rate;
+        controlTimer->start(currentControlFreq);
+    }
+
+    const int telemetryRate = (int)(rateController->getTelemetryRate() + 0.5);
+    if (telemetryRate != requestedTelemetryRate)
+    {
+        SkyTrace::info(SkyTrace::TELEMETRY_RATE, telemetryRate);
+        requestedTelemetryRate = telemetryRate;
+        listener->send(SignalData(SignalData::TELEMETRY_RATE, telemetryRate));
+    }
 }
 
 void FlightAction::flightEnded(const bool byBoard)
 {
     if (byBoard)
     {
-        monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::FLIGHT_LOOP_TERMINATED));
+        monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_TERMINATED));
     }
     else
     {
-        monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::FLIGHT_LOOP_ENDED));
+        monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_ENDED));
     }
     listener->enablePingTask(false);
     controlTimer->stop();
     state = IDLE;
-    listener->startAction(new AppAction(listener));
+    listener->startAction(createAction<AppAction>());
 }
 
 void FlightAction::sendAutopilotTarget(const PilotEventAutopilot& event)
 {
-    monitor->trace("Sending autopilot data event");
-    std::unique_ptr<AutopilotData> data(new AutopilotData());
-    data->setType(AutopilotData::TARGET);
-    data->setTargetPosition(event.getPosition());
-    data->flags().setFlagState(AutopilotData::ALTITUDE_DEFINED, false);
-    listener->send(*data);
-    monitor->notifyDeviceEvent(new DeviceEventSent(*data.release()));
+    SkyTrace::info(SkyTrace::TEXT, "Sending autopilot data event");
+    AutopilotData data;
+    data.setType(AutopilotData::TARGET);
+    data.setTargetPosition(event.getPosition());
+    data.flags().setFlagState(AutopilotData::ALTITUDE_DEFINED, false);
+    listener->send(data);
+    notifySent(data);
 }
 
 void FlightAction::sendBaseConfirmation(const AutopilotData& base)
 {
-    monitor->trace("Base location received, responding with ACK");
-    std::unique_ptr<AutopilotData> data(new AutopilotData(base));
-    data->setType(AutopilotData::BASE_ACK);
-    listener->send(*data);
-    monitor->notifyDeviceEvent(new DeviceEventSent(*data.release()));
+    SkyTrace::info(SkyTrace::TEXT, "Base location received, responding with ACK");
+    AutopilotData data(base);
+    data.setType(AutopilotData::BASE_ACK);
+    listener->send(data);
+    notifySent(data);
 }
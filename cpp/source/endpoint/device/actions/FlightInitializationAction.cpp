@@ -3,15 +3,54 @@
 #include "endpoint/device/actions/AppAction.hpp"
 #include "endpoint/device/actions/FlightAction.hpp"
 
+const char* const FlightInitializationAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "CONTROLS_RECEPTION",
+    "ROUTE_COMMAND",
+    "ROUTE_RECEPTION"
+};
+
+const FlightInitializationAction::StateMachine::Transition FlightInitializationAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &FlightInitializationAction::onInitialAck, CONTROLS_RECEPTION},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::NOT_ALLOWED),
+     nullptr, &FlightInitializationAction::onNotAllowed, IDLE},
+
+    {CONTROLS_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &FlightInitializationAction::isSignalPayloadReceived,
+     &FlightInitializationAction::onControlsReceived, ROUTE_COMMAND},
+    {CONTROLS_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, CONTROLS_RECEPTION},
+
+    {ROUTE_COMMAND, SkyActionEvent::onSignal(SignalData::VIA_ROUTE_ALLOWED),
+     nullptr, &FlightInitializationAction::onRouteAllowed, ROUTE_RECEPTION},
+    {ROUTE_COMMAND, SkyActionEvent::onSignal(SignalData::VIA_ROUTE_NOT_ALLOWED),
+     nullptr, &FlightInitializationAction::onRouteNotAllowed, IDLE},
+
+    {ROUTE_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &FlightInitializationAction::isSignalPayloadReceived,
+     &FlightInitializationAction::onRouteReceived, IDLE},
+    {ROUTE_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, ROUTE_RECEPTION},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &FlightInitializationAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &FlightInitializationAction::onIdleReception, INITIAL_COMMAND}
+};
+
 FlightInitializationAction::FlightInitializationAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void FlightInitializationAction::start(void)
 {
-    monitor->trace("Flight initialization procedure started");
+    SkyTrace::info(SkyTrace::TEXT, "Flight initialization procedure started");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::FLIGHT_LOOP, SignalData::START);
 }
@@ -26,102 +65,66 @@ ISkyDeviceAction::Type FlightInitializationAction::getType(void) const
     return FLIGHT_INITIALIZATION;
 }
 
-std::string FlightInitializationAction::getStateName(void) const
-{
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case CONTROLS_RECEPTION: return "CONTROLS_RECEPTION";
-    case ROUTE_COMMAND: return "ROUTE_COMMAND";
-    case ROUTE_RECEPTION: return "ROUTE_RECEPTION";
-    default:
-        throw std::runtime_error("FlightAction::getStateName::Unexpected state");
-    }
+const char* FlightInitializationAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string FlightInitializationAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const FlightInitializationAction::StateMachine& FlightInitializationAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void FlightInitializationAction::handleReception(const IMessage& message)
-{
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
-
-    case CONTROLS_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            startSignalTimeout(SignalData::FLIGHT_LOOP);
-            state = ROUTE_COMMAND;
-        }
-        break;
-
-    case ROUTE_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            flightReady();
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+bool FlightInitializationAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+void FlightInitializationAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Flight initial command received");
+    initializeSignalPayloadReception(SignalData::CONTROL_SETTINGS);
 }
 
-void FlightInitializationAction::handleSignalReception(const Parameter parameter)
-{
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Flight initial command received");
-            initializeSignalPayloadReception(SignalData::CONTROL_SETTINGS);
-            state = CONTROLS_RECEPTION;
-            break;
-
-        case SignalData::NOT_ALLOWED:
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::FLIGHT_LOOP_NOT_ALLOWED));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case ROUTE_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::VIA_ROUTE_ALLOWED:
-            monitor->trace("Via route allowed, receiving route");
-            initializeSignalPayloadReception(SignalData::ROUTE_CONTAINER);
-            state = ROUTE_RECEPTION;
-            break;
-
-        case SignalData::VIA_ROUTE_NOT_ALLOWED:
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
-            flightReady();
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+void FlightInitializationAction::onNotAllowed(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::FLIGHT_LOOP_NOT_ALLOWED));
+    listener->startAction(createAction<AppAction>());
+}
+
+void FlightInitializationAction::onControlsReceived(const SkyActionEvent& event)
+{
+    notifyReceived(event.getMessage());
+    startSignalTimeout(SignalData::FLIGHT_LOOP);
+}
+
+void FlightInitializationAction::onRouteAllowed(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Via route allowed, receiving route");
+    initializeSignalPayloadReception(SignalData::ROUTE_CONTAINER);
+}
+
+void FlightInitializationAction::onRouteNotAllowed(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
+    flightReady();
+}
+
+void FlightInitializationAction::onRouteReceived(const SkyActionEvent& event)
+{
+    notifyReceived(event.getMessage());
+    flightReady();
 }
 
 void FlightInitializationAction::flightReady(void)
 {
-    monitor->trace("Flight initialization procedure done, switching to FLIGHT");
+    SkyTrace::info(SkyTrace::TEXT, "Flight initialization procedure done, switching to FLIGHT");
     state = IDLE;
-    listener->startAction(new FlightAction(listener, monitor->getControlDataSendingFreq()));
+    listener->startAction(createAction<FlightAction>(monitor->getControlDataSendingFreq()));
 }
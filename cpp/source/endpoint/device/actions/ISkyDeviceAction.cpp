@@ -2,8 +2,13 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <memory>
 
+constexpr unsigned ISkyDeviceAction::MIN_SIGNAL_TIMEOUT;
+constexpr unsigned ISkyDeviceAction::MAX_SIGNAL_TIMEOUT;
+
 ISkyDeviceAction::Listener::~Listener(void)
 {
 }
@@ -13,12 +18,15 @@ ISkyDeviceAction::ISkyDeviceAction(Listener* const _listener):
     monitor(listener->getMonitor())
 {
     wasSignalReceptionProcedure = false;
-    signalTimer = monitor->createTimer(std::bind(&ISkyDeviceAction::baseHandleTimeout, this));
+    wasSignalPayloadReceptionProcedure = false;
+    receivedSignalPayloadSize = 0;
+    receptionErrors = 0;
+    signalTimer = listener->createTimer([this]() { baseHandleTimeout(); });
 }
 
 ISkyDeviceAction::~ISkyDeviceAction()
 {
-    delete signalTimer;
+    listener->releaseTimer(signalTimer);
 }
 
 void ISkyDeviceAction::end(void)
@@ -26,25 +34,23 @@ void ISkyDeviceAction::end(void)
     // nothing to do in generic action end
 }
 
-void ISkyDeviceAction::baseHandleReception(std::unique_ptr<const IMessage> message)
+void ISkyDeviceAction::baseHandleReception(const IMessage& message)
 {
-    // filter any SignalData to propper reception handler
-    if (IMessage::SIGNAL_DATA == message->getMessageType())
+    // filter any SignalData to propper reception handler,
+    // message is owned by device, events notified by handlers keep own copies
+    if (IMessage::SIGNAL_DATA == message.getMessageType())
     {
-        handleReception(reinterpret_cast<const SignalData&>(*message));
+        handleReception(reinterpret_cast<const SignalData&>(message));
     }
     else
     {
-        handleReception(*message);
-        // after successfull reception handling release message from RAII
-        // it will be passed forward as UavEvent parameter
-        message.release();
+        handleReception(message);
     }
 }
 
 void ISkyDeviceAction::handleUserEvent(const PilotEvent& event)
 {
-    except("Unexpected user uav event received", event);
+    fail(SkyError::UNEXPECTED_PILOT_EVENT, event.getType());
 }
 
 IMessage::MessageType ISkyDeviceAction::getExpectedControlMessageType(void) const
@@ -54,10 +60,10 @@ IMessage::MessageType ISkyDeviceAction::getExpectedControlMessageType(void) cons
 
 std::string ISkyDeviceAction::getName(void) const
 {
-    return toString(getType()) + " @ " + getStateName();
+    return std::string(toString(getType())) + " @ " + getStateName();
 }
 
-std::string ISkyDeviceAction::toString(const Type type)
+const char* ISkyDeviceAction::toString(const Type type)
 {
     switch (type)
     {
@@ -78,7 +84,8 @@ std::string ISkyDeviceAction::toString(const Type type)
     case RADIO_CALIB: return "RADIO_CALIB";
     case ESC_CALIB: return "ESC_CALIB";
     case RESET: return "RESET";
-    default: throw std::runtime_error("ICommAction::toString::Unexpected action type");
+    case DIRECT_FLIGHT: return "DIRECT_FLIGHT";
+    default: return "UNKNOWN";
     }
 }
 
@@ -88,9 +95,12 @@ void ISkyDeviceAction::handleReception(const SignalData& message)
     {
         if (message.getCommand() == expectedSignalCommand)
         {
+            if (sentSignal.getCommand() == expectedSignalCommand)
+            {
+                listener->onSignalResponse(expectedSignalCommand, std::chrono::steady_clock::now() - sentSignalTime);
+            }
             endSignalTimeout();
-            monitor->trace("HandleSignalReception with " + getName() +
-                           " param: " + SignalData::toString(message.getParameter()));
+            SkyTrace::debug(SkyTrace::SIGNAL_RECEIVED, getType(), getStateName(), message.getParameter());
             handleSignalReception(message.getParameter());
         }
     }
@@ -103,7 +113,7 @@ void ISkyDeviceAction::handleReception(const SignalData& message)
 
 void ISkyDeviceAction::handleSignalReception(const Parameter parameter)
 {
-    except("Unexpected handleSignalReception event ocured", parameter);
+    fail(SkyError::UNEXPECTED_SIGNAL_PARAMETER, parameter);
 }
 
 void ISkyDeviceAction::baseHandleTimeout(void)
@@ -111,23 +121,21 @@ void ISkyDeviceAction::baseHandleTimeout(void)
     signalTimer->stop();
     if (wasSignalReceptionProcedure)
     {
-        listener->onError("Timeout waiting for " + SignalData::toString(expectedSignalCommand) +
-                          (expectedSignalCommand == sentSignal.getCommand() ?
-                               " after sending: (" + sentSignal.toString() + ")" : ""));
+        fail(SkyError(SkyError::SIGNAL_TIMEOUT, expectedSignalCommand,
+                      sentSignal.getCommand(), sentSignal.getParameter()));
     }
     else if (wasSignalPayloadReceptionProcedure)
     {
         receptionErrors++;
-        monitor->trace("Timeout when receiving over signal payload, errors: " +
-                       std::to_string(receptionErrors) + " / " + std::to_string(MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS));
+        SkyTrace::warning(SkyTrace::SIGNAL_PAYLOAD_TIMEOUT, receptionErrors, MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS);
         if (receptionErrors < MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS)
         {
             listener->send(SignalData(receivedSignalPayload, SignalData::TIMEOUT));
-            signalTimer->start(1000.0 / (1.5 * DEFAULT_SIGNAL_TIMEOUT));
+            startSignalTimeoutTimer(getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, receivedSignalPayloadSize, receptionErrors));
         }
         else
         {
-            listener->onError("Error while receiving signal payload: " + SignalData::toString(receivedSignalPayload));
+            fail(SkyError::SIGNAL_PAYLOAD_RECEPTION, receivedSignalPayload);
         }
     }
     else
@@ -138,23 +146,24 @@ void ISkyDeviceAction::baseHandleTimeout(void)
 
 void ISkyDeviceAction::handleTimeout(void)
 {
-    except("Unexpected timeout event occurred");
+    fail(SkyError::UNEXPECTED_TIMEOUT);
 }
 
 void ISkyDeviceAction::sendSignal(const Command command, const Parameter parameter, const unsigned timeout)
 {
     sentSignal = SignalData(command, parameter);
+    sentSignalTime = std::chrono::steady_clock::now();
     startSignalTimeout(command, timeout);
     listener->send(sentSignal);
 }
 
 void ISkyDeviceAction::startSignalTimeout(const Command expectedCommand, const unsigned timeout)
 {
-    monitor->trace("Starting signal reception " + SignalData::toString(expectedCommand) +
-                   " with timeout: " + std::to_string(timeout) + " ms");
+    const unsigned signalTimeout = getSignalTimeout(timeout);
+    SkyTrace::debug(SkyTrace::SIGNAL_TIMEOUT_STARTED, expectedCommand, signalTimeout);
     expectedSignalCommand = expectedCommand;
     wasSignalReceptionProcedure = true;
-    startSignalTimeoutTimer(timeout);
+    startSignalTimeoutTimer(signalTimeout);
 }
 
 void ISkyDeviceAction::startSignalTimeoutTimer(const unsigned timeout)
@@ -162,6 +171,29 @@ void ISkyDeviceAction::startSignalTimeoutTimer(const unsigned timeout)
     signalTimer->start(1000.0 / timeout);
 }
 
+unsigned ISkyDeviceAction::getSignalTimeout(const unsigned timeout,
+                                            const unsigned payloadSize,
+                                            const unsigned attempt) const
+{
+    const SkyLinkQuality& linkQuality = listener->getLinkQuality();
+    const SkyLinkQuality::Figures figures = linkQuality.getFigures();
+
+    // signal payload goes in fixed size signal messages
+    const unsigned messagesCount = (payloadSize + IMessage::SIGNAL_DATA_PAYLOAD_SIZE - 1) / IMessage::SIGNAL_DATA_PAYLOAD_SIZE;
+    const unsigned transmitTime = (unsigned)std::chrono::duration_cast<std::chrono::milliseconds>(
+                linkQuality.getTransmitTime(messagesCount * IMessage::SIGNAL_DATA_MESSAGE_SIZE)).count();
+
+    unsigned adaptive = (figures.valid ? (figures.rto + 999) / 1000 : DEFAULT_SIGNAL_TIMEOUT) + transmitTime;
+    adaptive = std::max(adaptive, MIN_SIGNAL_TIMEOUT);
+    // exponential backoff
+    for (unsigned i = 0; i < attempt && adaptive < MAX_SIGNAL_TIMEOUT; i++)
+    {
+        adaptive *= 2;
+    }
+    adaptive = std::min(adaptive, MAX_SIGNAL_TIMEOUT);
+    return std::max(adaptive, timeout);
+}
+
 void ISkyDeviceAction::endSignalTimeout(void)
 {
     signalTimer->stop();
@@ -171,13 +203,15 @@ void ISkyDeviceAction::endSignalTimeout(void)
     sentSignal = SignalData(SignalData::DUMMY, SignalData::DUMMY_PARAMETER);
 }
 
-void ISkyDeviceAction::initializeSignalPayloadReception(const SignalData::Command& command)
+void ISkyDeviceAction::initializeSignalPayloadReception(const SignalData::Command& command,
+                                                        const unsigned payloadSize)
 {
-    monitor->trace("ICommAction::initializeSignalPayloadReception: " + SignalData::toString(command));
+    SkyTrace::info(SkyTrace::SIGNAL_PAYLOAD_RECEPTION, command);
     receivedSignalPayload = command;
+    receivedSignalPayloadSize = payloadSize;
     wasSignalPayloadReceptionProcedure = true;
     receptionErrors = 0;
-    signalTimer->start(1000.0 / (1.5 * DEFAULT_SIGNAL_TIMEOUT));
+    startSignalTimeoutTimer(getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, receivedSignalPayloadSize));
 }
 
 bool ISkyDeviceAction::handleSignalPayloadReception(const IMessage& message)
@@ -197,32 +231,41 @@ bool ISkyDeviceAction::handleSignalPayloadReception(const IMessage& message)
             else
             {
                 receptionErrors++;
-                monitor->trace("Invalid data received over signal payload, errors: " +
-                               std::to_string(receptionErrors) + " / " + std::to_string(MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS));
+                SkyTrace::warning(SkyTrace::SIGNAL_PAYLOAD_INVALID, receptionErrors, MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS);
                 if (receptionErrors < MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS)
                 {
                     listener->send(SignalData(receivedSignalPayload, SignalData::DATA_INVALID));
-                    signalTimer->start(1000.0 / (1.5 * DEFAULT_SIGNAL_TIMEOUT));
+                    startSignalTimeoutTimer(getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, receivedSignalPayloadSize, receptionErrors));
                 }
                 else
                 {
-                    except("Error while receiving signal payloada: " + SignalData::toString(receivedSignalPayload));
+                    fail(SkyError::SIGNAL_PAYLOAD_RECEPTION, receivedSignalPayload);
                 }
             }
         }
     }
     else
     {
-        except("Unexpected message received when waiting for signal payload data");
+        fail(SkyError::UNEXPECTED_MESSAGE, message);
     }
     return false;
 }
 
+void ISkyDeviceAction::notifyReceived(const IMessage& message) const
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_RECEIVED, message));
+}
+
+void ISkyDeviceAction::notifySent(const IMessage& message) const
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_SENT, message));
+}
+
 void ISkyDeviceAction::handleIdleReception(const IMessage& message) const
 {
     if (!(getExpectedControlMessageType() == message.getMessageType() || isPingMessage(message)))
     {
-        except("Unexpected message in idle reception", message);
+        fail(SkyError::UNEXPECTED_MESSAGE, message);
     }
 }
 
@@ -259,26 +302,22 @@ bool ISkyDeviceAction::matchSignalData(const SignalData::Command command,
     return matchSignalData(SignalData(command, parameter), received);
 }
 
-void ISkyDeviceAction::except(const std::string& message) const
-{
-    std::string msg = message + " at " + getName();
-    throw std::runtime_error(msg.c_str());
-}
-
-void ISkyDeviceAction::except(const std::string& message, const IMessage& received) const
+void ISkyDeviceAction::fail(SkyError error) const
 {
-    std::string msg = message + " at " + getName() + " message: " + received.toString();
-    throw std::runtime_error(msg.c_str());
+    error.at(toString(getType()), getStateName());
+#ifdef __SKYDIVE_ERROR_EXCEPTIONS__
+    error.raise();
+#else
+    listener->onError(error);
+#endif // __SKYDIVE_ERROR_EXCEPTIONS__
 }
 
-void ISkyDeviceAction::except(const std::string& message, const PilotEvent& event) const
+void ISkyDeviceAction::fail(const SkyError::Code code, const int value) const
 {
-    std::string msg = message + " at " + getName() + " event: " + event.toString();
-    throw std::runtime_error(msg.c_str());
+    fail(SkyError(code, value));
 }
 
-void ISkyDeviceAction::except(const std::string& message, const SignalData::Parameter parameter) const
+void ISkyDeviceAction::fail(const SkyError::Code code, const IMessage& received) const
 {
-    std::string msg = message + " at " + getName() + " parameter: " + SignalData::toString(parameter);
-    throw std::runtime_error(msg.c_str());
+    fail(SkyError(code, received));
 }
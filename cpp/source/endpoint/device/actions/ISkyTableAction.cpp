@@ -0,0 +1,57 @@
+#include "endpoint/device/actions/ISkyTableAction.hpp"
+
+#include "endpoint/device/PilotEvent.hpp"
+
+ISkyTableAction::ISkyTableAction(Listener* const _listener):
+    ISkyDeviceAction(_listener)
+{
+}
+
+void ISkyTableAction::handleReception(const IMessage& message)
+{
+    if (!dispatch(SkyActionEvent(message)))
+    {
+        fail(SkyError::UNEXPECTED_MESSAGE, message);
+    }
+}
+
+void ISkyTableAction::handleSignalReception(const Parameter parameter)
+{
+    if (!dispatch(SkyActionEvent(parameter)))
+    {
+        fail(SkyError::UNEXPECTED_SIGNAL_PARAMETER, parameter);
+    }
+}
+
+void ISkyTableAction::handleUserEvent(const PilotEvent& event)
+{
+    if (!dispatch(SkyActionEvent(event)))
+    {
+        fail(SkyError::UNEXPECTED_PILOT_EVENT, event.getType());
+    }
+}
+
+void ISkyTableAction::onIdleReception(const SkyActionEvent& event)
+{
+    handleIdleReception(event.getMessage());
+}
+
+void ISkyTableAction::onReceived(const SkyActionEvent& event)
+{
+    notifyReceived(event.getMessage());
+}
+
+void ISkyTableAction::onPong(const SkyActionEvent& event)
+{
+    listener->onPongReception(static_cast<const SignalData&>(event.getMessage()));
+}
+
+bool ISkyTableAction::isSignalPayloadReceived(const SkyActionEvent& event)
+{
+    return handleSignalPayloadReception(event.getMessage());
+}
+
+bool ISkyTableAction::isPong(const SkyActionEvent& event)
+{
+    return isPingMessage(event.getMessage());
+}
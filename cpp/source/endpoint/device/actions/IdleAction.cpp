@@ -10,8 +10,26 @@
 #include "communication/ControlSettings.hpp"
 #include "communication/RouteContainer.hpp"
 
+const char* const IdleAction::STATE_NAMES[] =
+{
+    "IDLE"
+};
+
+const IdleAction::StateMachine::Transition IdleAction::TRANSITIONS[] =
+{
+    {IDLE, SkyActionEvent::onPilotEvent(PilotEvent::CONNECT),
+     &IdleAction::isAppConnection, &IdleAction::onAppConnect, IDLE},
+    {IDLE, SkyActionEvent::onPilotEvent(PilotEvent::CONNECT),
+     &IdleAction::isUpgradeConnection, &IdleAction::onUpgradeConnect, IDLE},
+    {IDLE, SkyActionEvent::onPilotEvent(PilotEvent::CONNECT),
+     &IdleAction::isWhoAmIConnection, &IdleAction::onWhoAmIConnect, IDLE},
+    {IDLE, SkyActionEvent::onPilotEvent(PilotEvent::CONNECT),
+     &IdleAction::isDirectFlightConnection, &IdleAction::onDirectFlightConnect, IDLE}
+};
+
 IdleAction::IdleAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener),
+    state(IDLE)
 {
 }
 
@@ -29,56 +47,72 @@ ISkyDeviceAction::Type IdleAction::getType(void) const
     return IDLE_ACTION;
 }
 
-std::string IdleAction::getStateName(void) const
+const char* IdleAction::getStateName(void) const
 {
-    return "IDLE";
+    return getStateMachine().getStateName(state);
 }
 
-void IdleAction::handleReception(const IMessage& message)
+std::string IdleAction::getStateGraph(void) const
 {
-    except("Unexpected message received", message);
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void IdleAction::handleUserEvent(const PilotEvent& event)
+const IdleAction::StateMachine& IdleAction::getStateMachine(void)
 {
-    switch (event.getType())
-    {
-    case PilotEvent::CONNECT:
-    {
-        const PilotEventConnect& ev = reinterpret_cast<const PilotEventConnect&>(event);
-        switch (ev.getConnectionType())
-        {
-        case ISkyDeviceAction::APP:
-            listener->startAction(new ConnectAction(listener), false);
-            listener->connectInterface(ev.getCommInnterface());
-            break;
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
 
-        case ISkyDeviceAction::UPGRADE:
-            listener->startAction(new UpgradeAction(listener), false);
-            listener->connectInterface(ev.getCommInnterface());
-            break;
+bool IdleAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
 
-        case ISkyDeviceAction::WHO_AM_I:
-            listener->startAction(new WhoAmIAction(listener), false);
-            listener->connectInterface(ev.getCommInnterface());
-            break;
+const PilotEventConnect& IdleAction::getConnectEvent(const SkyActionEvent& event)
+{
+    return static_cast<const PilotEventConnect&>(event.getPilotEvent());
+}
 
-        case ISkyDeviceAction::DIRECT_FLIGHT:
-            handleDirectFlightCommand(ev);
-            break;
+bool IdleAction::isAppConnection(const SkyActionEvent& event)
+{
+    return ISkyDeviceAction::APP == getConnectEvent(event).getConnectionType();
+}
 
-        default:
-            except("Unexpected connection type");
-        }
-        break;
-    }
+bool IdleAction::isUpgradeConnection(const SkyActionEvent& event)
+{
+    return ISkyDeviceAction::UPGRADE == getConnectEvent(event).getConnectionType();
+}
 
-    default:
-        except("Unexpected user event received");
-    }
+bool IdleAction::isWhoAmIConnection(const SkyActionEvent& event)
+{
+    return ISkyDeviceAction::WHO_AM_I == getConnectEvent(event).getConnectionType();
 }
 
-void IdleAction::handleDirectFlightCommand(const PilotEventConnect& ev) {
+bool IdleAction::isDirectFlightConnection(const SkyActionEvent& event)
+{
+    return ISkyDeviceAction::DIRECT_FLIGHT == getConnectEvent(event).getConnectionType();
+}
+
+void IdleAction::onAppConnect(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<ConnectAction>(), false);
+    listener->connectInterface(getConnectEvent(event).getCommInnterface());
+}
+
+void IdleAction::onUpgradeConnect(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<UpgradeAction>(), false);
+    listener->connectInterface(getConnectEvent(event).getCommInnterface());
+}
+
+void IdleAction::onWhoAmIConnect(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<WhoAmIAction>(), false);
+    listener->connectInterface(getConnectEvent(event).getCommInnterface());
+}
+
+void IdleAction::onDirectFlightConnect(const SkyActionEvent& event)
+{
     // Configuration data needs to be created and filled with predefined values,
     // as it is not possible to fetch it from Device in direcct mode.
     // It could be deliverd in operation context, but keep it simple for now.
@@ -88,9 +122,9 @@ void IdleAction::handleDirectFlightCommand(const PilotEventConnect& ev) {
     control.initialSolverMode = ControlData::ANGLE;
     control.manualThrottleMode = ControlSettings::DYNAMIC;
 
-    monitor->notifyDeviceEvent(new DeviceEventReceived(*new CalibrationSettings(calib)));
-    monitor->notifyDeviceEvent(new DeviceEventReceived(*new ControlSettings(control)));
-    monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
-    listener->startAction(new FlightAction(listener, monitor->getControlDataSendingFreq()), false);
-    listener->connectInterface(ev.getCommInnterface());
+    notifyReceived(calib);
+    notifyReceived(control);
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
+    listener->startAction(createAction<FlightAction>(monitor->getControlDataSendingFreq()), false);
+    listener->connectInterface(getConnectEvent(event).getCommInnterface());
 }
@@ -4,15 +4,58 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+const char* const MagnetCalibAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "CALIBRATION",
+    "CALIBRATION_RESULT",
+    "CALIBRATION_SKIP_RESULT",
+    "CALIBRATION_RECEPTION"
+};
+
+const MagnetCalibAction::StateMachine::Transition MagnetCalibAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &MagnetCalibAction::onInitialAck, CALIBRATION},
+
+    {CALIBRATION, SkyActionEvent::onPilotEvent(PilotEvent::MAGNET_CALIB_DONE),
+     nullptr, &MagnetCalibAction::onUserDone, CALIBRATION_RESULT},
+    {CALIBRATION, SkyActionEvent::onPilotEvent(PilotEvent::MAGNET_CALIB_ABORT),
+     nullptr, &MagnetCalibAction::onUserAbort, CALIBRATION_SKIP_RESULT},
+
+    {CALIBRATION_RESULT, SkyActionEvent::onSignal(SignalData::DONE),
+     nullptr, &MagnetCalibAction::onCalibrationDone, CALIBRATION_RECEPTION},
+    {CALIBRATION_RESULT, SkyActionEvent::onSignal(SignalData::FAIL),
+     nullptr, &MagnetCalibAction::onCalibrationFail, IDLE},
+
+    {CALIBRATION_SKIP_RESULT, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &MagnetCalibAction::onSkipAck, IDLE},
+
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &MagnetCalibAction::isSignalPayloadReceived, &MagnetCalibAction::onCalibrationReceived, IDLE},
+    {CALIBRATION_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, CALIBRATION_RECEPTION},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &MagnetCalibAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &MagnetCalibAction::onIdleReception, INITIAL_COMMAND},
+    {CALIBRATION_RESULT, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &MagnetCalibAction::onIdleReception, CALIBRATION_RESULT},
+    {CALIBRATION_SKIP_RESULT, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &MagnetCalibAction::onIdleReception, CALIBRATION_SKIP_RESULT}
+};
+
 MagnetCalibAction::MagnetCalibAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void MagnetCalibAction::start(void)
 {
-    monitor->trace("Magnetometer calibration procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Magnetometer calibration procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::CALIBRATE_MAGNET, SignalData::START);
 }
@@ -27,129 +70,67 @@ ISkyDeviceAction::Type MagnetCalibAction::getType(void) const
     return MAGNET_CALIB;
 }
 
-std::string MagnetCalibAction::getStateName(void) const
-{
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case CALIBRATION: return "CALIBRATION";
-    case CALIBRATION_RESULT: return "CALIBRATION_RESULT";
-    case CALIBRATION_SKIP_RESULT: return "CALIBRATION_SKIP_RESULT";
-    case CALIBRATION_RECEPTION: return "IDLE";
-    default:
-        throw std::runtime_error("MagnetCalibAction::getStateName::Unexpected state");
-    }
+const char* MagnetCalibAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string MagnetCalibAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const MagnetCalibAction::StateMachine& MagnetCalibAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void MagnetCalibAction::handleReception(const IMessage& message)
-{
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-    case CALIBRATION_RESULT:
-    case CALIBRATION_SKIP_RESULT:
-        handleIdleReception(message);
-        break;
-
-    case CALIBRATION_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+bool MagnetCalibAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
 }
 
-void MagnetCalibAction::handleSignalReception(const Parameter parameter)
-{
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Magnetometer calibration procedure started");
-            listener->enableConnectionTimeoutTask(false);
-            state = CALIBRATION;
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_MAGNET_STARTED));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case CALIBRATION_RESULT:
-        switch (parameter)
-        {
-        case SignalData::DONE:
-            monitor->trace("Magnetometer calibration done, receiving settings");
-            initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
-            state = CALIBRATION_RECEPTION;
-            break;
-
-        case SignalData::FAIL:
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::WARNING,
-                                                              "Error during solving magnetometer calibration!\n"
-                                                              "Bad data acquired."));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
-
-    case CALIBRATION_SKIP_RESULT:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+void MagnetCalibAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Magnetometer calibration procedure started");
+    listener->enableConnectionTimeoutTask(false);
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_MAGNET_STARTED));
 }
 
+void MagnetCalibAction::onUserDone(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_MAGNET, SignalData::DONE, 2000);
+    listener->enableConnectionTimeoutTask(true);
+}
 
-void MagnetCalibAction::handleUserEvent(const PilotEvent& event)
-{
-    if (CALIBRATION == state)
-    {
-        switch (event.getType())
-        {
-        case PilotEvent::MAGNET_CALIB_DONE:
-            state = CALIBRATION_RESULT;
-            sendSignal(SignalData::CALIBRATE_MAGNET, SignalData::DONE, 2000);
-            break;
-
-        case PilotEvent::MAGNET_CALIB_ABORT:
-            state = CALIBRATION_SKIP_RESULT;
-            sendSignal(SignalData::CALIBRATE_MAGNET, SignalData::SKIP);
-            break;
-
-        default:
-            except("Unexpected user uav event received");
-        }
-        listener->enableConnectionTimeoutTask(true);
-    }
-    else
-    {
-        except("User uav event received at unexpected state");
-    }
+void MagnetCalibAction::onUserAbort(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_MAGNET, SignalData::SKIP, 2000);
+    listener->enableConnectionTimeoutTask(true);
+}
+
+void MagnetCalibAction::onCalibrationDone(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Magnetometer calibration done, receiving settings");
+    initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
+}
+
+void MagnetCalibAction::onCalibrationFail(const SkyActionEvent&)
+{
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::WARNING,
+                                                      "Error during solving magnetometer calibration!\n"
+                                                      "Bad data acquired."));
+    listener->startAction(createAction<AppAction>());
+}
+
+void MagnetCalibAction::onSkipAck(const SkyActionEvent&)
+{
+    listener->startAction(createAction<AppAction>());
+}
+
+void MagnetCalibAction::onCalibrationReceived(const SkyActionEvent& event)
+{
+    notifyReceived(event.getMessage());
+    listener->startAction(createAction<AppAction>());
 }
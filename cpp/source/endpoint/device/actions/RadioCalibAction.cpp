@@ -4,8 +4,69 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+const char* const RadioCalibAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "CALIBRATION_COMMAND",
+    "CALIBRATION_RESPONSE",
+    "BREAKING",
+    "CHECK",
+    "FINAL_COMMAND",
+    "CALIBRATION_RECEPTION"
+};
+
+const RadioCalibAction::StateMachine::Transition RadioCalibAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &RadioCalibAction::onInitialAck, CALIBRATION_COMMAND},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::NOT_ALLOWED),
+     nullptr, &RadioCalibAction::onNotAllowed, IDLE},
+
+    {CALIBRATION_COMMAND, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CALIBRATION_DONE),
+     nullptr, &RadioCalibAction::onChannelDone, CALIBRATION_RESPONSE},
+    {CALIBRATION_COMMAND, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CALIBRATION_SKIP),
+     nullptr, &RadioCalibAction::onChannelSkip, CALIBRATION_RESPONSE},
+    {CALIBRATION_COMMAND, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CALIBRATION_BREAK),
+     nullptr, &RadioCalibAction::onBreak, BREAKING},
+
+    {CALIBRATION_RESPONSE, SkyActionEvent::onSignal(SignalData::ACK),
+     &RadioCalibAction::isLastChannel, &RadioCalibAction::onChannelAck, CHECK},
+    {CALIBRATION_RESPONSE, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &RadioCalibAction::onChannelAck, CALIBRATION_COMMAND},
+    {CALIBRATION_RESPONSE, SkyActionEvent::onSignal(SignalData::FAIL),
+     nullptr, &RadioCalibAction::onChannelFail, CALIBRATION_COMMAND},
+
+    {BREAKING, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     nullptr, &RadioCalibAction::onBreakAck, IDLE},
+
+    {CHECK, SkyActionEvent::onMessage(IMessage::CONTROL_DATA),
+     nullptr, &RadioCalibAction::onReceived, CHECK},
+    {CHECK, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CALIBRATION_DONE),
+     nullptr, &RadioCalibAction::onCheckDone, FINAL_COMMAND},
+    {CHECK, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CALIBRATION_SKIP),
+     nullptr, &RadioCalibAction::onCheckSkip, FINAL_COMMAND},
+
+    {FINAL_COMMAND, SkyActionEvent::onMessage(IMessage::CONTROL_DATA),
+     nullptr, &RadioCalibAction::onReceived, FINAL_COMMAND},
+    {FINAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &RadioCalibAction::onFinalAck, CALIBRATION_RECEPTION},
+    {FINAL_COMMAND, SkyActionEvent::onSignal(SignalData::BREAK_FAIL),
+     nullptr, &RadioCalibAction::onFinalBreakFail, IDLE},
+    {FINAL_COMMAND, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     nullptr, &RadioCalibAction::onFinalBreakAck, IDLE},
+
+    {CALIBRATION_RECEPTION, SkyActionEvent::onMessage(IMessage::CALIBRATION_SETTINGS),
+     &RadioCalibAction::isSignalPayloadReceived, &RadioCalibAction::onCalibrationReceived, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &RadioCalibAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &RadioCalibAction::onIdleReception, INITIAL_COMMAND}
+};
+
 RadioCalibAction::RadioCalibAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
@@ -13,7 +74,7 @@ RadioCalibAction::RadioCalibAction(Listener* const _listener):
 void RadioCalibAction::start(void)
 {
     current = 0;
-    monitor->trace("Calibrate radio procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Calibrate radio procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::CALIBRATE_RADIO, SignalData::START);
 }
@@ -33,221 +94,126 @@ ISkyDeviceAction::Type RadioCalibAction::getType(void) const
     return RADIO_CALIB;
 }
 
-std::string RadioCalibAction::getStateName(void) const
+const char* RadioCalibAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case CALIBRATION_COMMAND: return "CALIBRATION_COMMAND";
-    case BREAKING: return "BREAKING";
-    case CHECK: return "CHECK";
-    case CALIBRATION_RESPONSE: return "CALIBRATION_RESPONSE";
-    case FINAL_COMMAND: return "FINAL_COMMAND";
-    case CALIBRATION_RECEPTION: return "CALIBRATION_RECEPTION";
-    default:
-        throw std::runtime_error("RadioCalibAction::getStateName::Unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void RadioCalibAction::handleReception(const IMessage& message)
+std::string RadioCalibAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
-
-    case FINAL_COMMAND:
-    case CHECK:
-        if (IMessage::CONTROL_DATA == message.getMessageType())
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        else
-        {
-            except("Unexpeted message received", message);
-        }
-        break;
-
-    case CALIBRATION_RECEPTION:
-        if (IMessage::CALIBRATION_SETTINGS == message.getMessageType())
-        {
-            monitor->trace("Calibration settings received, radio calibration successfull");
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_ENDED));
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::INFO,
-                                                              "Radio receiver calibration successfull."));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-        }
-        else
-        {
-            except("Unexpeted message received", message);
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void RadioCalibAction::handleSignalReception(const Parameter parameter)
+const RadioCalibAction::StateMachine& RadioCalibAction::getStateMachine(void)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Calibrate radio procedure started");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_STARTED));
-            state = CALIBRATION_COMMAND;
-            break;
-
-        case SignalData::NOT_ALLOWED:
-            monitor->trace("Calibrate radio not allowed, breaking");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_NOT_ALLOWED));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case CALIBRATION_RESPONSE:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            current++;
-            monitor->trace("Calibrate radio response: ACK, chanel: " + std::to_string(current));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_ACK));
-            if (current >= 8)
-            {
-                monitor->trace("Switching to CHECK");
-                state = CHECK;
-            }
-            else
-            {
-                state = CALIBRATION_COMMAND;
-            }
-            break;
-
-        case SignalData::FAIL:
-            monitor->trace("Calibrate radio response: FAIL");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_FAIL));
-            state = CALIBRATION_COMMAND;
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case BREAKING:
-        switch (parameter)
-        {
-        case SignalData::BREAK_ACK:
-            monitor->trace("Radio calibration broken");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_ENDED));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case FINAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Radio calibration final command ACK");
-            state = CALIBRATION_RECEPTION;
-            initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
-            break;
-
-        case SignalData::BREAK_FAIL:
-            monitor->trace("Radio calibration final command FAIL");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_ENDED));
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::WARNING,
-                                                              "Error while safing data to internal memory."
-                                                              "Calibration results discarded."));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        case SignalData::BREAK_ACK:
-            monitor->trace("Radio calibration final command BREAK_ACK");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CALIBRATE_RADIO_ENDED));
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::INFO,
-                                                              "Calibration results discarded."));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
+
+bool RadioCalibAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+bool RadioCalibAction::isLastChannel(const SkyActionEvent&)
+{
+    // acknowledged channel is counted by effect
+    return current + 1 >= 8;
+}
+
+void RadioCalibAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Calibrate radio procedure started");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_STARTED));
+}
+
+void RadioCalibAction::onNotAllowed(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Calibrate radio not allowed, breaking");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_NOT_ALLOWED));
+    listener->startAction(createAction<AppAction>());
+}
+
+void RadioCalibAction::onChannelDone(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_RADIO, SignalData::DONE, 2000);
+}
+
+void RadioCalibAction::onChannelSkip(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_RADIO, SignalData::SKIP, 2000);
+}
+
+void RadioCalibAction::onBreak(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK);
 }
 
-void RadioCalibAction::handleUserEvent(const PilotEvent& event)
+void RadioCalibAction::onChannelAck(const SkyActionEvent&)
 {
-    switch (state)
+    current++;
+    SkyTrace::info(SkyTrace::RADIO_CALIBRATION_ACK, current);
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_ACK));
+    if (CHECK == state)
     {
-    case CALIBRATION_COMMAND:
-        switch (event.getType())
-        {
-        case PilotEvent::RADIO_CALIBRATION_DONE:
-            state = CALIBRATION_RESPONSE;
-            sendSignal(SignalData::CALIBRATE_RADIO, SignalData::DONE);
-            break;
-
-        case PilotEvent::RADIO_CALIBRATION_SKIP:
-            state = CALIBRATION_RESPONSE;
-            sendSignal(SignalData::CALIBRATE_RADIO, SignalData::SKIP);
-            break;
-
-        case PilotEvent::RADIO_CALIBRATION_BREAK:
-            state = BREAKING;
-            sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK);
-            break;
-
-        default:
-            except("Unexpected user uav event received");
-        }
-        break;
-
-    case CHECK:
-        switch (event.getType())
-        {
-        case PilotEvent::RADIO_CALIBRATION_DONE:
-            state = FINAL_COMMAND;
-            sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK);
-            break;
-
-        case PilotEvent::RADIO_CALIBRATION_SKIP:
-            state = FINAL_COMMAND;
-            sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK_FAIL);
-            break;
-
-        default:
-            except("Unexpected user uav event received");
-        }
-        break;
-
-    default:
-        except("Uav event received at unexpected state");
+        SkyTrace::info(SkyTrace::TEXT, "Switching to CHECK");
     }
 }
 
+void RadioCalibAction::onChannelFail(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Calibrate radio response: FAIL");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_FAIL));
+}
+
+void RadioCalibAction::onBreakAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Radio calibration broken");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_ENDED));
+    listener->startAction(createAction<AppAction>());
+}
+
+void RadioCalibAction::onCheckDone(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK);
+}
+
+void RadioCalibAction::onCheckSkip(const SkyActionEvent&)
+{
+    sendSignal(SignalData::CALIBRATE_RADIO, SignalData::BREAK_FAIL);
+}
 
+void RadioCalibAction::onFinalAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Radio calibration final command ACK");
+    initializeSignalPayloadReception(SignalData::CALIBRATION_SETTINGS);
+}
+
+void RadioCalibAction::onFinalBreakFail(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Radio calibration final command FAIL");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_ENDED));
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::WARNING,
+                                                      "Error while safing data to internal memory."
+                                                      "Calibration results discarded."));
+    listener->startAction(createAction<AppAction>());
+}
+
+void RadioCalibAction::onFinalBreakAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Radio calibration final command BREAK_ACK");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_ENDED));
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::INFO,
+                                                      "Calibration results discarded."));
+    listener->startAction(createAction<AppAction>());
+}
+
+void RadioCalibAction::onCalibrationReceived(const SkyActionEvent& event)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Calibration settings received, radio calibration successfull");
+    notifyReceived(event.getMessage());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CALIBRATE_RADIO_ENDED));
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::INFO,
+                                                      "Radio receiver calibration successfull."));
+    listener->startAction(createAction<AppAction>());
+}
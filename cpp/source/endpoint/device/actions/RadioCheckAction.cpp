@@ -4,15 +4,52 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+const char* const RadioCheckAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "CONTROLS_RECEPTION",
+    "RUNNING",
+    "BREAKING"
+};
+
+const RadioCheckAction::StateMachine::Transition RadioCheckAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &RadioCheckAction::onInitialAck, CONTROLS_RECEPTION},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::NOT_ALLOWED),
+     nullptr, &RadioCheckAction::onNotAllowed, IDLE},
+
+    {CONTROLS_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     &RadioCheckAction::isSignalPayloadReceived, &RadioCheckAction::onControlsReceived, RUNNING},
+    {CONTROLS_RECEPTION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, nullptr, CONTROLS_RECEPTION},
+
+    {RUNNING, SkyActionEvent::onMessage(IMessage::CONTROL_DATA),
+     nullptr, &RadioCheckAction::onReceived, RUNNING},
+    {RUNNING, SkyActionEvent::onPilotEvent(PilotEvent::RADIO_CHECK_DONE),
+     nullptr, &RadioCheckAction::onUserDone, BREAKING},
+
+    {BREAKING, SkyActionEvent::onMessage(IMessage::CONTROL_DATA),
+     nullptr, &RadioCheckAction::onReceived, BREAKING},
+    {BREAKING, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     nullptr, &RadioCheckAction::onBreakAck, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &RadioCheckAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &RadioCheckAction::onIdleReception, INITIAL_COMMAND}
+};
+
 RadioCheckAction::RadioCheckAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void RadioCheckAction::start(void)
 {
-    monitor->trace("Check radio procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Check radio procedure requested");
     state = INITIAL_COMMAND;
     listener->enableConnectionTimeoutTask(true);
     sendSignal(SignalData::CHECK_RADIO, SignalData::START);
@@ -33,121 +70,57 @@ ISkyDeviceAction::Type RadioCheckAction::getType(void) const
     return RADIO_CHECK;
 }
 
-std::string RadioCheckAction::getStateName(void) const
-{
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case CONTROLS_RECEPTION: return "CONTROLS_RECEPTION";
-    case RUNNING: return "RUNNING";
-    case BREAKING: return "BREAKING";
-    default:
-        throw std::runtime_error("RadioCheckAction::getStateName::Unexpected state");
-    }
+const char* RadioCheckAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
 }
 
-void RadioCheckAction::handleReception(const IMessage& message)
-{
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
-
-    case CONTROLS_RECEPTION:
-        if (handleSignalPayloadReception(message))
-        {
-            monitor->trace("Check radio started");
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CHECK_RADIO_STARTED));
-            state = RUNNING;
-        }
-        break;
-
-    case BREAKING:
-    case RUNNING:
-        if (IMessage::CONTROL_DATA == message.getMessageType())
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        else
-        {
-            except("Unexpeted message received", message);
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+std::string RadioCheckAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void RadioCheckAction::handleSignalReception(const Parameter parameter)
-{
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Controls reception started");
-            listener->enableConnectionTimeoutTask(false);
-            initializeSignalPayloadReception(SignalData::CONTROL_SETTINGS);
-            state = CONTROLS_RECEPTION;
-            break;
-
-        case SignalData::NOT_ALLOWED:
-            monitor->trace("Check radio not allowed, breaking");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CHECK_RADIO_NOT_ALLOWED));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case BREAKING:
-        switch (parameter)
-        {
-        case SignalData::BREAK_ACK:
-            monitor->trace("Check radio done");
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::CHECK_RADIO_ENDED));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+const RadioCheckAction::StateMachine& RadioCheckAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void RadioCheckAction::handleUserEvent(const PilotEvent& event)
-{
-    if (RUNNING == state)
-    {
-        switch (event.getType())
-        {
-        case PilotEvent::RADIO_CHECK_DONE:
-            state = BREAKING;
-            listener->enableConnectionTimeoutTask(false);
-            sendSignal(SignalData::CHECK_RADIO, SignalData::BREAK);
-            break;
-
-        default:
-            except("Unexpected user uav event received");
-        }
-    }
-    else
-    {
-        except("Uav event received at unexpected state");
-    }
+bool RadioCheckAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
 }
 
+void RadioCheckAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Controls reception started");
+    listener->enableConnectionTimeoutTask(false);
+    initializeSignalPayloadReception(SignalData::CONTROL_SETTINGS);
+}
+
+void RadioCheckAction::onNotAllowed(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Check radio not allowed, breaking");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CHECK_RADIO_NOT_ALLOWED));
+    listener->startAction(createAction<AppAction>());
+}
+
+void RadioCheckAction::onControlsReceived(const SkyActionEvent& event)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Check radio started");
+    notifyReceived(event.getMessage());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CHECK_RADIO_STARTED));
+}
+
+void RadioCheckAction::onUserDone(const SkyActionEvent&)
+{
+    listener->enableConnectionTimeoutTask(false);
+    sendSignal(SignalData::CHECK_RADIO, SignalData::BREAK);
+}
+
+void RadioCheckAction::onBreakAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Check radio done");
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CHECK_RADIO_ENDED));
+    listener->startAction(createAction<AppAction>());
+}
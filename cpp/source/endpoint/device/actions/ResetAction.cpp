@@ -2,17 +2,34 @@
 
 #include "endpoint/device/actions/IdleAction.hpp"
 
+const char* const ResetAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND"
+};
+
+const ResetAction::StateMachine::Transition ResetAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &ResetAction::onInitialAck, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &ResetAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &ResetAction::onIdleReception, INITIAL_COMMAND}
+};
+
 ResetAction::ResetAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void ResetAction::start(void)
 {
-    monitor->trace("Board reset procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Board reset procedure requested");
     state = INITIAL_COMMAND;
-    sendSignal(SignalData::SYSTEM_RESET, SignalData::START);
+    sendSignal(SignalData::SYSTEM_RESET, SignalData::START, 3000);
 }
 
 bool ResetAction::isActionDone(void) const
@@ -25,44 +42,31 @@ ISkyDeviceAction::Type ResetAction::getType(void) const
     return RESET;
 }
 
-std::string ResetAction::getStateName(void) const
+const char* ResetAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    default:
-        throw std::runtime_error("ResetAction::getthrow std::runtime_errorected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void ResetAction::handleReception(const IMessage& message)
+std::string ResetAction::getStateGraph(void) const
 {
-    handleIdleReception(message);
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void ResetAction::handleSignalReception(const Parameter parameter)
+const ResetAction::StateMachine& ResetAction::getStateMachine(void)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Board reset procedure started");
-            state = IDLE;
-            listener->startAction(new IdleAction(listener));
-            listener->disconnectInterface();
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::APPLICATION_LOOP_TERMINATED));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
 
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+bool ResetAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
 }
 
+void ResetAction::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Board reset procedure started");
+    listener->startAction(createAction<IdleAction>());
+    listener->disconnectInterface();
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::APPLICATION_LOOP_TERMINATED));
+}
@@ -4,15 +4,44 @@
 
 #include "endpoint/device/PilotEvent.hpp"
 
+const char* const SensorsLoggerAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "LOGGING",
+    "BREAKING"
+};
+
+const SensorsLoggerAction::StateMachine::Transition SensorsLoggerAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &SensorsLoggerAction::onInitialAck, LOGGING},
+
+    {LOGGING, SkyActionEvent::onMessage(IMessage::SENSORS_DATA),
+     nullptr, &SensorsLoggerAction::onReceived, LOGGING},
+    {LOGGING, SkyActionEvent::onPilotEvent(PilotEvent::BREAK_SENSORS_LOGGER),
+     nullptr, &SensorsLoggerAction::onBreakRequested, BREAKING},
+
+    {BREAKING, SkyActionEvent::onSignal(SignalData::BREAK_ACK),
+     nullptr, &SensorsLoggerAction::onBreakAck, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &SensorsLoggerAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &SensorsLoggerAction::onIdleReception, INITIAL_COMMAND},
+    {BREAKING, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &SensorsLoggerAction::onIdleReception, BREAKING}
+};
+
 SensorsLoggerAction::SensorsLoggerAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void SensorsLoggerAction::start(void)
 {
-    monitor->trace("Sensors looger initialization procedure started");
+    SkyTrace::info(SkyTrace::TEXT, "Sensors looger initialization procedure started");
     listener->enableConnectionTimeoutTask(true);
     state = INITIAL_COMMAND;
     sendSignal(SignalData::SENSORS_LOGGER, SignalData::START);
@@ -33,91 +62,40 @@ ISkyDeviceAction::Type SensorsLoggerAction::getType(void) const
     return SENSORS_LOGGER;
 }
 
-std::string SensorsLoggerAction::getStateName(void) const
+const char* SensorsLoggerAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string SensorsLoggerAction::getStateGraph(void) const
+{
+    return getStateMachine().toDot(toString(getType()));
+}
+
+const SensorsLoggerAction::StateMachine& SensorsLoggerAction::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
+
+bool SensorsLoggerAction::dispatch(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case LOGGING: return "LOGGING";
-    case BREAKING: return "BREAKING";
-    default:
-        throw std::runtime_error("SensorsLoggerAction::getStateName::Unexpected state");
-    }
+    return getStateMachine().dispatch(*this, state, event);
 }
 
-void SensorsLoggerAction::handleReception(const IMessage& message)
+void SensorsLoggerAction::onInitialAck(const SkyActionEvent&)
 {
-    switch (state)
-    {
-    case IDLE:
-    case INITIAL_COMMAND:
-    case BREAKING:
-        handleIdleReception(message);
-        break;
-
-    case LOGGING:
-        if (IMessage::SENSORS_DATA == message.getMessageType())
-        {
-            monitor->notifyDeviceEvent(new DeviceEventReceived(message));
-        }
-        else
-        {
-            except("Unexpected message received", message);
-        }
-        break;
-
-    default:
-        except("Message received in unexpected state", message);
-    }
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::SENSORS_LOGGER_STARTED));
 }
 
-void SensorsLoggerAction::handleSignalReception(const Parameter parameter)
+void SensorsLoggerAction::onBreakRequested(const SkyActionEvent&)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            state = LOGGING;
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::SENSORS_LOGGER_STARTED));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case BREAKING:
-        switch (parameter)
-        {
-        case SignalData::BREAK_ACK:
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::SENSORS_LOGGER_ENDED));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+    listener->enableConnectionTimeoutTask(false);
+    sendSignal(SignalData::SENSORS_LOGGER, SignalData::BREAK);
 }
 
-void SensorsLoggerAction::handleUserEvent(const PilotEvent& event)
+void SensorsLoggerAction::onBreakAck(const SkyActionEvent&)
 {
-    if (LOGGING == state && PilotEvent::BREAK_SENSORS_LOGGER == event.getType())
-    {
-        state = BREAKING;
-        listener->enableConnectionTimeoutTask(false);
-        sendSignal(SignalData::SENSORS_LOGGER, SignalData::BREAK);
-    }
-    else
-    {
-        except("User event received in unexpected state", event);
-    }
+    listener->startAction(createAction<AppAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::SENSORS_LOGGER_ENDED));
 }
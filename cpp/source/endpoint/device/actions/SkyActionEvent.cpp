@@ -0,0 +1,111 @@
+#include "endpoint/device/actions/SkyActionEvent.hpp"
+
+#include "endpoint/device/SkyError.hpp"
+
+constexpr unsigned SkyActionEvent::SIGNAL_VALUE;
+constexpr unsigned SkyActionEvent::ANY_SIGNAL;
+constexpr unsigned SkyActionEvent::ANY_PILOT_EVENT;
+constexpr unsigned SkyActionEvent::ANY_MESSAGE;
+constexpr unsigned SkyActionEvent::EVENTS_COUNT;
+
+SkyActionEvent::SkyActionEvent(const SignalData::Parameter _parameter):
+    kind(SIGNAL),
+    id(onSignal(_parameter)),
+    parameter(_parameter),
+    pilotEvent(nullptr),
+    message(nullptr)
+{
+}
+
+SkyActionEvent::SkyActionEvent(const PilotEvent& _pilotEvent):
+    kind(PILOT_EVENT),
+    id(onPilotEvent(_pilotEvent.getType())),
+    parameter(SignalData::DUMMY_PARAMETER),
+    pilotEvent(&_pilotEvent),
+    message(nullptr)
+{
+}
+
+SkyActionEvent::SkyActionEvent(const IMessage& _message):
+    kind(MESSAGE),
+    id(onMessage(_message.getMessageType())),
+    parameter(SignalData::DUMMY_PARAMETER),
+    pilotEvent(nullptr),
+    message(&_message)
+{
+}
+
+SkyActionEvent::Kind SkyActionEvent::getKind(void) const
+{
+    return kind;
+}
+
+unsigned SkyActionEvent::getId(void) const
+{
+    return id;
+}
+
+SignalData::Parameter SkyActionEvent::getParameter(void) const
+{
+    return parameter;
+}
+
+const PilotEvent& SkyActionEvent::getPilotEvent(void) const
+{
+    if (nullptr == pilotEvent)
+    {
+        SkyError(SkyError::INVALID_EVENT_ACCESS, id).raise();
+    }
+    return *pilotEvent;
+}
+
+const IMessage& SkyActionEvent::getMessage(void) const
+{
+    if (nullptr == message)
+    {
+        SkyError(SkyError::INVALID_EVENT_ACCESS, id).raise();
+    }
+    return *message;
+}
+
+unsigned SkyActionEvent::getWildcard(const unsigned id)
+{
+    if (id <= ANY_SIGNAL)
+    {
+        return ANY_SIGNAL;
+    }
+    return id <= ANY_PILOT_EVENT ? ANY_PILOT_EVENT : ANY_MESSAGE;
+}
+
+std::string SkyActionEvent::getName(const unsigned id)
+{
+    if (SIGNAL_VALUE == id)
+    {
+        return "SIGNAL_VALUE";
+    }
+    else if (id < ANY_SIGNAL)
+    {
+        return SignalData::toString(static_cast<SignalData::Parameter>(SignalData::START + id - SIGNAL_VALUE - 1));
+    }
+    else if (ANY_SIGNAL == id)
+    {
+        return "ANY_SIGNAL";
+    }
+    else if (id < ANY_PILOT_EVENT)
+    {
+        return PilotEvent::toString(static_cast<PilotEvent::Type>(id - ANY_SIGNAL - 1));
+    }
+    else if (ANY_PILOT_EVENT == id)
+    {
+        return "ANY_PILOT_EVENT";
+    }
+    else if (id < ANY_MESSAGE)
+    {
+        return IMessage::toString(static_cast<IMessage::MessageType>(id - ANY_PILOT_EVENT - 1));
+    }
+    else if (ANY_MESSAGE == id)
+    {
+        return "ANY_MESSAGE";
+    }
+    return "UNKNOWN";
+}
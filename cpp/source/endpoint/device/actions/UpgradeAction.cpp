@@ -3,15 +3,41 @@
 #include "endpoint/device/actions/IdleAction.hpp"
 #include "endpoint/device/actions/AppAction.hpp"
 
+const char* const UpgradeAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "BOARD_VERSION"
+};
+
+const UpgradeAction::StateMachine::Transition UpgradeAction::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &UpgradeAction::onInitialAck, BOARD_VERSION},
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::NOT_ALLOWED),
+     nullptr, &UpgradeAction::onNotAllowed, IDLE},
+
+    // board type is sent as plain value
+    {BOARD_VERSION, SkyActionEvent::ANY_SIGNAL,
+     nullptr, &UpgradeAction::onBoardVersion, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &UpgradeAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &UpgradeAction::onIdleReception, INITIAL_COMMAND},
+    {BOARD_VERSION, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &UpgradeAction::onIdleReception, BOARD_VERSION}
+};
+
 UpgradeAction::UpgradeAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void UpgradeAction::start(void)
 {
-    monitor->trace("Upgrade procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Upgrade procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::SOFTWARE_UPGRADE, SignalData::START);
 }
@@ -26,57 +52,44 @@ ISkyDeviceAction::Type UpgradeAction::getType(void) const
     return UPGRADE;
 }
 
-std::string UpgradeAction::getStateName(void) const
+const char* UpgradeAction::getStateName(void) const
+{
+    return getStateMachine().getStateName(state);
+}
+
+std::string UpgradeAction::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case BOARD_VERSION: return "BOARD_VERSION";
-    default:
-        throw std::runtime_error("UpgradeAction::unexpected state");
-    }
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void UpgradeAction::handleReception(const IMessage& message)
+const UpgradeAction::StateMachine& UpgradeAction::getStateMachine(void)
 {
-    handleIdleReception(message);
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void UpgradeAction::handleSignalReception(const Parameter parameter)
+bool UpgradeAction::dispatch(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            state = BOARD_VERSION;
-            startSignalTimeout(SignalData::WHO_AM_I_VALUE);
-            break;
-
-        case SignalData::NOT_ALLOWED:
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            monitor->notifyDeviceEvent(new DeviceEventMessage(DeviceEventMessage::WARNING,
-                                                              "Board refused upgrade command, cannot"
-                                                              " be done over wireless interface."));
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case BOARD_VERSION:
-        state = IDLE;
-        listener->startAction(new IdleAction(listener));
-        monitor->notifyDeviceEvent(new DeviceEventUpgradeStarted(static_cast<CalibrationSettings::BoardType>(parameter)));
-        listener->disconnectInterface();
-        break;
-
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+    return getStateMachine().dispatch(*this, state, event);
 }
 
+void UpgradeAction::onInitialAck(const SkyActionEvent&)
+{
+    startSignalTimeout(SignalData::WHO_AM_I_VALUE);
+}
+
+void UpgradeAction::onNotAllowed(const SkyActionEvent&)
+{
+    listener->startAction(createAction<AppAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEventMessage::WARNING,
+                                                      "Board refused upgrade command, cannot"
+                                                      " be done over wireless interface."));
+}
+
+void UpgradeAction::onBoardVersion(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<IdleAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::UPGRADE_STARTED,
+                                                 static_cast<CalibrationSettings::BoardType>(event.getParameter())));
+    listener->disconnectInterface();
+}
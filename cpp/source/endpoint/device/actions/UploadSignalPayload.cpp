@@ -2,8 +2,31 @@
 
 #include "endpoint/device/actions/AppAction.hpp"
 
+const char* const UploadSignalPayload::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND",
+    "UPLOAD"
+};
+
+const UploadSignalPayload::StateMachine::Transition UploadSignalPayload::TRANSITIONS[] =
+{
+    {INITIAL_COMMAND, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &UploadSignalPayload::onInitialAck, UPLOAD},
+
+    {UPLOAD, SkyActionEvent::onSignal(SignalData::ACK),
+     nullptr, &UploadSignalPayload::onUploadAck, IDLE},
+    {UPLOAD, SkyActionEvent::onSignal(SignalData::DATA_INVALID),
+     nullptr, &UploadSignalPayload::onUploadError, UPLOAD},
+    {UPLOAD, SkyActionEvent::onSignal(SignalData::TIMEOUT),
+     nullptr, &UploadSignalPayload::onUploadError, UPLOAD},
+
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &UploadSignalPayload::onIdleReception, INITIAL_COMMAND}
+};
+
 UploadSignalPayload::UploadSignalPayload(Listener* const _listener,  const ISignalPayloadMessage& _data):
-    ISkyDeviceAction(_listener),
+    ISkyTableAction(_listener),
     data(_data),
     command(getUploadCommand(data.getMessageType()))
 {
@@ -11,9 +34,19 @@ UploadSignalPayload::UploadSignalPayload(Listener* const _listener,  const ISign
     retransmissionCounter = 0;
 }
 
+UploadSignalPayload::~UploadSignalPayload(void)
+{
+    delete &data;
+}
+
 void UploadSignalPayload::start(void)
 {
-    monitor->trace("Upload signal data payload procedure requested");
+    if (SignalData::DUMMY == command)
+    {
+        fail(SkyError::UNEXPECTED_PAYLOAD_TYPE, data.getMessageType());
+        return;
+    }
+    SkyTrace::info(SkyTrace::TEXT, "Upload signal data payload procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(command, SignalData::START);
 }
@@ -28,84 +61,55 @@ ISkyDeviceAction::Type UploadSignalPayload::getType(void) const
     return UPLOAD_SIGNAL_PAYLOAD;
 }
 
-std::string UploadSignalPayload::getStateName(void) const
+const char* UploadSignalPayload::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    case UPLOAD: return "UPLOAD";
-    default:
-        throw std::runtime_error("UploadSignalPayload:throw std::runtime_errornexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void UploadSignalPayload::handleReception(const IMessage& message)
+std::string UploadSignalPayload::getStateGraph(void) const
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        handleIdleReception(message);
-        break;
+    return getStateMachine().toDot(toString(getType()));
+}
 
-    default:
-        except("Message received in unexpected state", message);
-    }
+const UploadSignalPayload::StateMachine& UploadSignalPayload::getStateMachine(void)
+{
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
 }
 
-void UploadSignalPayload::handleSignalReception(const Parameter parameter)
+bool UploadSignalPayload::dispatch(const SkyActionEvent& event)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Upload signal data payload procedure started");
-            state = UPLOAD;
-            listener->send(data);
-            startSignalTimeout(data.getSignalDataCommand(), DEFAULT_SIGNAL_TIMEOUT + 500);
-            break;
-
-        default:
-            except("Unexpected signal parameter message received", parameter);
-        }
-        break;
-
-    case UPLOAD:
-        switch (parameter)
-        {
-        case SignalData::ACK:
-            monitor->trace("Upload successfull");
-            monitor->notifyDeviceEvent(new DeviceEventSent(data));
-            state = IDLE;
-            listener->startAction(new AppAction(listener));
-            break;
-
-        case SignalData::DATA_INVALID:
-        case SignalData::TIMEOUT:
-            retransmissionCounter++;
-            monitor->trace("Receiver reports file over signal payload, errors: " +
-                           std::to_string(retransmissionCounter) + " / " + std::to_string(MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS));
-            if (retransmissionCounter < MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS)
-            {
-                monitor->trace("Upload timeout, retring");
-                listener->send(data);
-                startSignalTimeout(data.getSignalDataCommand(), DEFAULT_SIGNAL_TIMEOUT + 500);
-            }
-            else
-            {
-                except("Retransmission counter exceeded when uploading signal paylod data", parameter);
-            }
-            break;
-
-        default:
-            except("Unexpected signal parameter received", parameter);
-        }
-        break;
+    return getStateMachine().dispatch(*this, state, event);
+}
 
-    default:
-        except("Signal parameter in unexpected state", parameter);
+void UploadSignalPayload::onInitialAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Upload signal data payload procedure started");
+    listener->send(data);
+    startSignalTimeout(data.getSignalDataCommand(), getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, data.getDataSize()));
+}
+
+void UploadSignalPayload::onUploadAck(const SkyActionEvent&)
+{
+    SkyTrace::info(SkyTrace::TEXT, "Upload successfull");
+    notifySent(data);
+    listener->startAction(createAction<AppAction>());
+}
+
+void UploadSignalPayload::onUploadError(const SkyActionEvent& event)
+{
+    retransmissionCounter++;
+    SkyTrace::warning(SkyTrace::SIGNAL_PAYLOAD_REJECTED, retransmissionCounter, MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS);
+    if (retransmissionCounter < MAX_SIGNAL_PAYLOAD_RECEPTION_ERRORS)
+    {
+        SkyTrace::info(SkyTrace::TEXT, "Upload timeout, retring");
+        listener->send(data);
+        startSignalTimeout(data.getSignalDataCommand(),
+                           getSignalTimeout(ADAPTIVE_SIGNAL_TIMEOUT, data.getDataSize(), retransmissionCounter));
+    }
+    else
+    {
+        fail(SkyError::SIGNAL_PAYLOAD_UPLOAD, event.getParameter());
     }
 }
 
@@ -117,6 +121,7 @@ SignalData::Command UploadSignalPayload::getUploadCommand(const IMessage::Messag
     case IMessage::ROUTE_CONTAINER: return SignalData::UPLOAD_ROUTE;
     case IMessage::WIFI_CONFIGURATION: return SignalData::WIFI_CONFIGURATION;
     default:
-        throw std::runtime_error("DownloadSignalPaylod::getDownloadCommand::Unexpected type");
+        // reported by start
+        return SignalData::DUMMY;
     }
 }
@@ -3,15 +3,33 @@
 #include "endpoint/device/actions/IdleAction.hpp"
 #include "endpoint/device/actions/AppAction.hpp"
 
+const char* const WhoAmIAction::STATE_NAMES[] =
+{
+    "IDLE",
+    "INITIAL_COMMAND"
+};
+
+const WhoAmIAction::StateMachine::Transition WhoAmIAction::TRANSITIONS[] =
+{
+    // board type is sent as plain value
+    {INITIAL_COMMAND, SkyActionEvent::ANY_SIGNAL,
+     nullptr, &WhoAmIAction::onBoardType, IDLE},
+
+    {IDLE, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &WhoAmIAction::onIdleReception, IDLE},
+    {INITIAL_COMMAND, SkyActionEvent::ANY_MESSAGE,
+     nullptr, &WhoAmIAction::onIdleReception, INITIAL_COMMAND}
+};
+
 WhoAmIAction::WhoAmIAction(Listener* const _listener):
-    ISkyDeviceAction(_listener)
+    ISkyTableAction(_listener)
 {
     state = IDLE;
 }
 
 void WhoAmIAction::start(void)
 {
-    monitor->trace("Who am I procedure requested");
+    SkyTrace::info(SkyTrace::TEXT, "Who am I procedure requested");
     state = INITIAL_COMMAND;
     sendSignal(SignalData::WHO_AM_I_VALUE, SignalData::START);
 }
@@ -26,35 +44,32 @@ ISkyDeviceAction::Type WhoAmIAction::getType(void) const
     return WHO_AM_I;
 }
 
-std::string WhoAmIAction::getStateName(void) const
+const char* WhoAmIAction::getStateName(void) const
 {
-    switch (state)
-    {
-    case IDLE: return "IDLE";
-    case INITIAL_COMMAND: return "INITIAL_COMMAND";
-    default:
-        throw std::runtime_error("WhoAmIAction::unexpected state");
-    }
+    return getStateMachine().getStateName(state);
 }
 
-void WhoAmIAction::handleReception(const IMessage& message)
+std::string WhoAmIAction::getStateGraph(void) const
 {
-    handleIdleReception(message);
+    return getStateMachine().toDot(toString(getType()));
 }
 
-void WhoAmIAction::handleSignalReception(const Parameter parameter)
+const WhoAmIAction::StateMachine& WhoAmIAction::getStateMachine(void)
 {
-    switch (state)
-    {
-    case INITIAL_COMMAND:
-        state = IDLE;
-        listener->startAction(new IdleAction(listener));
-        monitor->notifyDeviceEvent(new DeviceEventWhoAmI(static_cast<CalibrationSettings::BoardType>(parameter)));
-        monitor->notifyDeviceEvent(new DeviceEvent(DeviceEvent::APPLICATION_LOOP_TERMINATED));
-        listener->disconnectInterface();
-        break;
+    static const StateMachine stateMachine(STATE_NAMES, TRANSITIONS);
+    return stateMachine;
+}
 
-    default:
-        except("Signal parameter in unexpected state", parameter);
-    }
+bool WhoAmIAction::dispatch(const SkyActionEvent& event)
+{
+    return getStateMachine().dispatch(*this, state, event);
+}
+
+void WhoAmIAction::onBoardType(const SkyActionEvent& event)
+{
+    listener->startAction(createAction<IdleAction>());
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::WHO_AM_I,
+                                                 static_cast<CalibrationSettings::BoardType>(event.getParameter())));
+    monitor->notifyDeviceEvent(DeviceEventRecord(DeviceEvent::APPLICATION_LOOP_TERMINATED));
+    listener->disconnectInterface();
 }
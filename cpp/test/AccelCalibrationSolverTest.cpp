@@ -0,0 +1,202 @@
+// AccelCalibrationSolver on synthetic six position calibration with known scale and bias:
+// segment detection and orientation classification, recovered model and residual,
+// rejection of tilted segment, insufficient orientations and processLog text input.
+
+#include "common/AccelCalibrationSolver.hpp"
+
+#include "SkyTest.hpp"
+
+#include <cmath>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace
+{
+
+const unsigned STATIC_SAMPLES = 600;
+const unsigned MOTION_SAMPLES = 100;
+
+// sensor with known calibration, raw = scale^-1 * (calibrated - bias)
+struct Sensor
+{
+    Mat3Dd scale;
+    Vect3Dd bias;
+    Mat3Dd inverse;
+    std::mt19937 generator;
+    std::normal_distribution<double> noise;
+
+    Sensor(void):
+        scale(1.02, 0.01, -0.02,
+              0.005, 0.97, 0.01,
+              -0.01, 0.02, 1.05),
+        bias(0.3, -0.2, 0.15),
+        generator(7),
+        noise(0.0, 0.02)
+    {
+        inverse = scale.getInv();
+    }
+
+    Vect3Df raw(const Vect3Dd& calibrated)
+    {
+        const Vect3Dd value = inverse * (calibrated - bias);
+        return Vect3Df(value.x + noise(generator), value.y + noise(generator), value.z + noise(generator));
+    }
+};
+
+Vect3Dd gravityAlong(const unsigned orientation)
+{
+    Vect3Dd result = Vect3Dd::zeros();
+    result(orientation / 2 + 1) = orientation % 2 ? -roboLib::gravity : roboLib::gravity;
+    return result;
+}
+
+// static positions (in Orientation order) separated by motion, optionally one tilted position
+std::vector<Vect3Df> calibrationRun(const unsigned orientations, const bool tilted)
+{
+    Sensor sensor;
+    std::vector<Vect3Df> samples;
+    const double g = roboLib::gravity;
+    for (unsigned o = 0; o < orientations; o++)
+    {
+        for (unsigned i = 0; i < STATIC_SAMPLES; i++)
+        {
+            samples.push_back(sensor.raw(gravityAlong(o)));
+        }
+        for (unsigned i = 0; i < MOTION_SAMPLES; i++)
+        {
+            samples.push_back(sensor.raw(Vect3Dd(5.0 * std::sin(0.3 * i), 3.0 * std::cos(0.2 * i), g)));
+        }
+        if (tilted && 2 == o)
+        {
+            // 45 deg between X and Z, direction is not known
+            for (unsigned i = 0; i < STATIC_SAMPLES; i++)
+            {
+                samples.push_back(sensor.raw(Vect3Dd(g * std::sqrt(0.5), 0.0, g * std::sqrt(0.5))));
+            }
+            for (unsigned i = 0; i < MOTION_SAMPLES; i++)
+            {
+                samples.push_back(sensor.raw(Vect3Dd(5.0 * std::sin(0.3 * i), 3.0 * std::cos(0.2 * i), g)));
+            }
+        }
+    }
+    return samples;
+}
+
+void checkModel(const AccelCalibrationSolver& solver)
+{
+    const Sensor sensor;
+    for (unsigned i = 0; i < 9; i++)
+    {
+        SKY_CHECK_NEAR(solver.getScale().mat[i], sensor.scale.mat[i], 2e-3);
+    }
+    for (unsigned i = 1; i <= 3; i++)
+    {
+        SKY_CHECK_NEAR(solver.getBias()(i), sensor.bias(i), 1e-2);
+    }
+    SKY_CHECK(solver.getResidual() < 5e-3f);
+}
+
+void sixPositions(void)
+{
+    AccelCalibrationSolver solver;
+    bool sawStatic = false;
+    bool sawMotion = false;
+    const std::vector<Vect3Df> samples = calibrationRun(AccelCalibrationSolver::ORIENTATIONS_COUNT, true);
+    for (unsigned i = 0; i < samples.size(); i++)
+    {
+        solver.putSample(samples[i]);
+        // middle of first static position and of following motion
+        if (STATIC_SAMPLES / 2 == i)
+        {
+            sawStatic = solver.isStatic();
+        }
+        if (STATIC_SAMPLES + MOTION_SAMPLES / 2 == i)
+        {
+            sawMotion = false == solver.isStatic();
+        }
+    }
+    solver.flush();
+    SKY_CHECK(sawStatic);
+    SKY_CHECK(sawMotion);
+    SKY_CHECK(samples.size() == solver.getSamplesCount());
+    SKY_CHECK(6u == solver.getSegmentsCount());
+    SKY_CHECK(1u == solver.getRejectedSegmentsCount());
+    SKY_CHECK(6u == solver.getCoveredOrientationsCount());
+    // classification maps 1-based axis of dominant component to orientation
+    for (unsigned o = 0; o < AccelCalibrationSolver::ORIENTATIONS_COUNT; o++)
+    {
+        SKY_CHECK(1u == solver.getOrientationSegmentsCount((AccelCalibrationSolver::Orientation)o));
+    }
+
+    SKY_CHECK(solver.solve());
+    SKY_CHECK(solver.isSolved());
+    checkModel(solver);
+
+    Sensor sensor;
+    sensor.noise = std::normal_distribution<double>(0.0, 0.0);
+    const Vect3Df calibrated = solver.apply(sensor.raw(gravityAlong(AccelCalibrationSolver::Y_DOWN)));
+    SKY_CHECK_NEAR(calibrated.x, 0.0, 1e-2);
+    SKY_CHECK_NEAR(calibrated.y, -roboLib::gravity, 1e-2);
+    SKY_CHECK_NEAR(calibrated.z, 0.0, 1e-2);
+}
+
+void insufficientOrientations(void)
+{
+    AccelCalibrationSolver solver;
+    for (const Vect3Df& sample : calibrationRun(3, false))
+    {
+        solver.putSample(sample);
+    }
+    solver.flush();
+    SKY_CHECK(3u == solver.getCoveredOrientationsCount());
+    SKY_CHECK(false == solver.solve());
+    SKY_CHECK(false == solver.isSolved());
+
+    // short static segments are not accepted at all
+    AccelCalibrationSolver strict(50, 0.01f, STATIC_SAMPLES * 2);
+    for (const Vect3Df& sample : calibrationRun(AccelCalibrationSolver::ORIENTATIONS_COUNT, false))
+    {
+        strict.putSample(sample);
+    }
+    strict.flush();
+    SKY_CHECK(0u == strict.getSegmentsCount());
+    SKY_CHECK(0u == strict.getRejectedSegmentsCount());
+}
+
+void processLog(void)
+{
+    const std::vector<Vect3Df> samples = calibrationRun(AccelCalibrationSolver::ORIENTATIONS_COUNT, false);
+    std::stringstream log;
+    log << "time omega accel magnet pressure\n";
+    for (unsigned i = 0; i < samples.size(); i++)
+    {
+        log << i * 0.01 << " 0.1 -0.2 0.3 "
+            << samples[i].x << " " << samples[i].y << " " << samples[i].z << " 0.2 0.1 0.4 1013.2\n";
+        if (1000 == i)
+        {
+            log << "0.5 1.0 broken\n";
+        }
+    }
+
+    AccelCalibrationSolver solver;
+    SKY_CHECK(samples.size() == solver.processLog(log));
+    SKY_CHECK(6u == solver.getSegmentsCount());
+    SKY_CHECK(solver.solve());
+    checkModel(solver);
+
+    solver.reset();
+    SKY_CHECK(0u == solver.getSamplesCount());
+    SKY_CHECK(false == solver.isSolved());
+    SKY_CHECK(0u == solver.processLogFile("/nonexistent/accel.log"));
+}
+
+}
+
+int main(void)
+{
+    sixPositions();
+    insufficientOrientations();
+    processLog();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,57 @@
+// ControlDataSlot with writer and busy reader in separate threads: read value is never
+// torn (all fields come from one write) and never goes back, last write is always seen.
+
+#include "endpoint/device/ControlDataSlot.hpp"
+
+#include "SkyTest.hpp"
+
+#include <atomic>
+#include <thread>
+
+int main(void)
+{
+    const unsigned writes = 1000000;
+    ControlDataSlot slot;
+    std::atomic<bool> done(false);
+
+    std::thread writer([&]()
+    {
+        ControlData data;
+        for (unsigned i = 1; i <= writes; i++)
+        {
+            const float value = (float)i;
+            data.setEuler(Vect3Df(value, value, value));
+            data.setThrottle(value);
+            slot.write(data);
+        }
+        done = true;
+    });
+
+    unsigned torn = 0, regressed = 0;
+    unsigned long reads = 0;
+    float last = -1.0f;
+    while (false == done)
+    {
+        const ControlData& data = slot.read();
+        const float throttle = data.getThrottle();
+        const Vect3Df euler = data.getEuler();
+        if (euler.x != throttle || euler.y != throttle || euler.z != throttle)
+        {
+            torn++;
+        }
+        if (throttle < last)
+        {
+            regressed++;
+        }
+        last = throttle;
+        reads++;
+    }
+    writer.join();
+
+    SKY_CHECK(0 == torn);
+    SKY_CHECK(0 == regressed);
+    SKY_CHECK(reads > 0);
+    SKY_CHECK((float)writes == slot.read().getThrottle());
+    std::printf("reads %lu\n", reads);
+    return SKY_TEST_RESULT();
+}
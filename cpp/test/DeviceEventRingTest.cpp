@@ -0,0 +1,116 @@
+// DeviceEventRing: records of concurrent producers are delivered exactly once and in order
+// of each producer, full ring rejects and counts records, signal payload is shared
+// between record copies, legacy conversion keeps event type.
+
+#include "endpoint/device/DeviceEventRing.hpp"
+
+#include "SkyTest.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void concurrentProducers(void)
+{
+    const unsigned producers = 4;
+    const unsigned records = 50000;
+    DeviceEventRing ring(1024);
+    std::vector<std::thread> threads;
+    for (unsigned p = 0; p < producers; p++)
+    {
+        threads.push_back(std::thread([&ring, p]()
+        {
+            // producer id and sequence are carried by DebugData euler
+            DebugData debugData;
+            for (unsigned i = 1; i <= records; i++)
+            {
+                debugData.setEuler(Vect3Df((float)p, (float)i, 0.0f));
+                const DeviceEventRecord record(DeviceEvent::DATA_RECEIVED, debugData);
+                while (false == ring.push(record))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        }));
+    }
+
+    std::vector<unsigned> last(producers, 0);
+    std::vector<DeviceEventRecord> batch(64);
+    unsigned long delivered = 0;
+    unsigned orderErrors = 0;
+    while (delivered < producers * records)
+    {
+        const size_t count = ring.drain(batch.data(), batch.size());
+        for (size_t i = 0; i < count; i++)
+        {
+            const Vect3Df euler = static_cast<const DebugData&>(batch[i].getMessage()).getEuler();
+            const unsigned producer = (unsigned)euler.x;
+            if ((unsigned)euler.y != last[producer] + 1)
+            {
+                orderErrors++;
+            }
+            last[producer] = (unsigned)euler.y;
+        }
+        delivered += count;
+        if (0 == count)
+        {
+            std::this_thread::yield();
+        }
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    SKY_CHECK(0 == orderErrors);
+    SKY_CHECK(0 == ring.size());
+    DeviceEventRecord record;
+    SKY_CHECK(false == ring.pop(record));
+}
+
+void fullRing(void)
+{
+    DeviceEventRing ring(5);
+    SKY_CHECK(8 == ring.getCapacity());
+    const DeviceEventRecord record(DeviceEvent::DATA_SENT, ControlData());
+    unsigned accepted = 0;
+    for (unsigned i = 0; i < 10; i++)
+    {
+        accepted += ring.push(record) ? 1 : 0;
+    }
+    SKY_CHECK(8 == accepted);
+    SKY_CHECK(2 == ring.getRejectedCount());
+    DeviceEventRecord out;
+    SKY_CHECK(ring.pop(out));
+    SKY_CHECK(DeviceEvent::DATA_SENT == out.getType());
+    SKY_CHECK(IMessage::CONTROL_DATA == out.getMessage().getMessageType());
+    SKY_CHECK(ring.push(record));
+}
+
+void records(void)
+{
+    const DeviceEventRecord payload(DeviceEvent::DATA_RECEIVED, CalibrationSettings::createDefault());
+    const DeviceEventRecord copy = payload;
+    SKY_CHECK(&payload.getMessage() == &copy.getMessage());
+    SKY_CHECK(IMessage::CALIBRATION_SETTINGS == copy.getMessage().getMessageType());
+
+    std::unique_ptr<const DeviceEvent> event = copy.toDeviceEvent();
+    SKY_CHECK(DeviceEvent::DATA_RECEIVED == event->getType());
+
+    const DeviceEventRecord status(10, 20, 1);
+    SKY_CHECK(DeviceEvent::CONNECTION_STATUS == status.getType());
+    SKY_CHECK(10 == status.getPing() && 20 == status.getReceived() && 1 == status.getFails());
+    SKY_CHECK(false == status.hasMessage());
+}
+
+}
+
+int main(void)
+{
+    concurrentProducers();
+    fullRing();
+    records();
+    return SKY_TEST_RESULT();
+}
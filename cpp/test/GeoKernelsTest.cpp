@@ -0,0 +1,152 @@
+// Accuracy of GeoKernels against long double reference (printed as report),
+// consistency of batch entry points and edge cases (antipode, empty input).
+
+#include "common/GeoKernels.hpp"
+
+#include "SkyTest.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+static long double referenceDistance(long double lat1, long double lon1, long double lat2, long double lon2)
+{
+    const long double toRad = 3.14159265358979323846264338327950288L / 180.0L;
+    lat1 *= toRad; lon1 *= toRad; lat2 *= toRad; lon2 *= toRad;
+    const long double x1 = cosl(lat1) * cosl(lon1), y1 = cosl(lat1) * sinl(lon1), z1 = sinl(lat1);
+    const long double x2 = cosl(lat2) * cosl(lon2), y2 = cosl(lat2) * sinl(lon2), z2 = sinl(lat2);
+    const long double cx = y1 * z2 - z1 * y2, cy = z1 * x2 - x1 * z2, cz = x1 * y2 - y1 * x2;
+    return (long double)roboLib::rEarth * atan2l(sqrtl(cx * cx + cy * cy + cz * cz), x1 * x2 + y1 * y2 + z1 * z2);
+}
+
+static long double referenceBearing(long double lat1, long double lon1, long double lat2, long double lon2)
+{
+    const long double toRad = 3.14159265358979323846264338327950288L / 180.0L;
+    lat1 *= toRad; lon1 *= toRad; lat2 *= toRad; lon2 *= toRad;
+    const long double bearing = atan2l(sinl(lon2 - lon1) * cosl(lat2),
+                                       cosl(lat1) * sinl(lat2) - sinl(lat1) * cosl(lat2) * cosl(lon2 - lon1)) / toRad;
+    return bearing < 0 ? bearing + 360.0L : bearing;
+}
+
+int main(void)
+{
+    // half of points near origin (short distances), half all over the globe,
+    // more than PARALLEL_THRESHOLD so batch is split
+    const unsigned count = 1u << 17;
+    const double lat0 = 50.0, lon0 = 20.0;
+    std::mt19937 generator(3);
+    std::uniform_real_distribution<double> anyLat(-90.0, 90.0), anyLon(-180.0, 180.0), near(-0.01, 0.01);
+    std::vector<double> lat(count), lon(count), result(count), pairResult(count);
+    std::vector<Vect2Dd> points(count);
+    for (unsigned i = 0; i < count; i++)
+    {
+        lat[i] = i % 2 ? anyLat(generator) : lat0 + near(generator);
+        lon[i] = i % 2 ? anyLon(generator) : lon0 + near(generator);
+        points[i] = Vect2Dd(lat[i], lon[i]);
+    }
+
+    GeoKernels::distances(lat0, lon0, lat.data(), lon.data(), count, result.data());
+    GeoKernels::distances(Vect2Dd(lat0, lon0), points.data(), count, pairResult.data());
+    long double distanceError = 0.0L;
+    double overloadDifference = 0.0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        distanceError = std::max(distanceError, fabsl(result[i] - referenceDistance(lat0, lon0, lat[i], lon[i])));
+        overloadDifference = std::max(overloadDifference, std::fabs(result[i] - pairResult[i]));
+    }
+    std::printf("distances max error %.3Le m\n", distanceError);
+    SKY_CHECK(distanceError < GeoKernels::MAX_DISTANCE_ERROR);
+    SKY_CHECK(0.0 == overloadDifference);
+
+    GeoKernels::bearings(lat0, lon0, lat.data(), lon.data(), count, result.data());
+    GeoKernels::bearings(Vect2Dd(lat0, lon0), points.data(), count, pairResult.data());
+    long double bearingError = 0.0L;
+    overloadDifference = 0.0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        long double error = fabsl(result[i] - referenceBearing(lat0, lon0, lat[i], lon[i]));
+        bearingError = std::max(bearingError, error > 180.0L ? 360.0L - error : error);
+        overloadDifference = std::max(overloadDifference, std::fabs(result[i] - pairResult[i]));
+        SKY_CHECK(result[i] >= 0.0 && result[i] < 360.0);
+    }
+    std::printf("bearings max error %.3Le deg\n", bearingError);
+    // points about 1 km from origin lose precision in unit vector difference
+    SKY_CHECK(bearingError < 1e-7L);
+    SKY_CHECK(0.0 == overloadDifference);
+
+    const unsigned matrixSize = 600;
+    std::vector<double> matrix(matrixSize * matrixSize);
+    GeoKernels::distanceMatrix(lat.data(), lon.data(), matrixSize, matrix.data());
+    long double matrixError = 0.0L;
+    for (unsigned i = 0; i < matrixSize; i += 7)
+    {
+        for (unsigned j = 0; j < matrixSize; j++)
+        {
+            matrixError = std::max(matrixError,
+                                   fabsl(matrix[i * matrixSize + j] - referenceDistance(lat[i], lon[i], lat[j], lon[j])));
+        }
+        SKY_CHECK(matrix[i * matrixSize + i] < GeoKernels::MAX_DISTANCE_ERROR);
+    }
+    std::printf("distance matrix max error %.3Le m\n", matrixError);
+    SKY_CHECK(matrixError < GeoKernels::MAX_DISTANCE_ERROR);
+
+    double nearestDistance = -1.0;
+    const unsigned nearest = GeoKernels::nearest(10.0, 10.0, lat.data(), lon.data(), count, &nearestDistance);
+    unsigned expected = 0;
+    long double expectedDistance = 1e30L;
+    for (unsigned i = 0; i < count; i++)
+    {
+        const long double distance = referenceDistance(10.0, 10.0, lat[i], lon[i]);
+        if (distance < expectedDistance)
+        {
+            expectedDistance = distance;
+            expected = i;
+        }
+    }
+    SKY_CHECK(expected == nearest);
+    SKY_CHECK_NEAR(nearestDistance, expectedDistance, GeoKernels::MAX_DISTANCE_ERROR);
+
+    nearestDistance = -1.0;
+    SKY_CHECK(GeoKernels::NO_POINT == GeoKernels::nearest(10.0, 10.0, lat.data(), lon.data(), 0, &nearestDistance));
+    SKY_CHECK(-1.0 == nearestDistance);
+
+    const unsigned pathCount = 10000;
+    long double pathReference = 0.0L;
+    for (unsigned i = 1; i < pathCount; i++)
+    {
+        pathReference += referenceDistance(lat[i - 1], lon[i - 1], lat[i], lon[i]);
+    }
+    const double path = GeoKernels::pathLength(lat.data(), lon.data(), pathCount);
+    std::printf("path length error %.3Le m over %u legs\n", fabsl(path - pathReference), pathCount - 1);
+    SKY_CHECK(fabsl(path - pathReference) < GeoKernels::MAX_DISTANCE_ERROR * pathCount);
+    SKY_CHECK(0.0 == GeoKernels::pathLength(lat.data(), lon.data(), 1));
+
+    // antipode and origin itself
+    const double edgeLat[2] = {-lat0, lat0};
+    const double edgeLon[2] = {lon0 - 180.0, lon0};
+    double edge[2];
+    GeoKernels::distances(lat0, lon0, edgeLat, edgeLon, 2, edge);
+    SKY_CHECK_NEAR(edge[0], roboLib::pi * roboLib::rEarth, GeoKernels::MAX_DISTANCE_ERROR);
+    SKY_CHECK_NEAR(edge[1], 0.0, GeoKernels::MAX_DISTANCE_ERROR);
+
+    double sinError = 0.0, cosError = 0.0, atanError = 0.0;
+    for (double x = -7.0; x < 7.0; x += 1e-4)
+    {
+        double sinX, cosX;
+        GeoKernels::fastSinCos(x, sinX, cosX);
+        sinError = std::max(sinError, std::fabs(sinX - std::sin(x)));
+        cosError = std::max(cosError, std::fabs(cosX - std::cos(x)));
+    }
+    for (unsigned i = 0; i < 100000; i++)
+    {
+        const double y = i % 5 ? anyLon(generator) : 0.0;
+        const double x = i % 3 ? anyLon(generator) : 0.0;
+        atanError = std::max(atanError, std::fabs(GeoKernels::fastAtan2(y, x) - std::atan2(y, x)));
+    }
+    std::printf("sin %.2e cos %.2e atan2 %.2e rad\n", sinError, cosError, atanError);
+    SKY_CHECK(sinError < GeoKernels::MAX_ANGLE_ERROR);
+    SKY_CHECK(cosError < GeoKernels::MAX_ANGLE_ERROR);
+    SKY_CHECK(atanError < GeoKernels::MAX_ANGLE_ERROR);
+
+    return SKY_TEST_RESULT();
+}
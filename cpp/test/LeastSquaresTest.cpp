@@ -0,0 +1,264 @@
+// LeastSquares engines against scalar long double reference (normal equations) on known
+// 6 and 12 parameter models with noise: blocked and unblocked QR, merge of two halves,
+// residual sum of squares, multiple outputs, RLS convergence and forgetting factor
+// (tracking changed model over long stream without divergence of covariance),
+// and SIMD dot/axpy against scalar loops.
+
+#include "common/LeastSquares.hpp"
+
+#include "SkyTest.hpp"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+const unsigned SAMPLES = 5000;
+
+template <unsigned N>
+struct Problem
+{
+    double truth[N];
+    std::vector<double> regressors;
+    std::vector<double> measurements;
+
+    Problem(const unsigned samples, const unsigned seed)
+    {
+        std::mt19937 generator(seed);
+        std::normal_distribution<double> normal(0.0, 1.0);
+        for (unsigned i = 0; i < N; i++)
+        {
+            truth[i] = 0.5 * i - 2.0;
+        }
+        for (unsigned s = 0; s < samples; s++)
+        {
+            double y = 0.0;
+            for (unsigned i = 0; i < N; i++)
+            {
+                const double x = 0 == i ? 1.0 : normal(generator) * (1.0 + i);
+                regressors.push_back(x);
+                y += x * truth[i];
+            }
+            measurements.push_back(y + 0.05 * normal(generator));
+        }
+    }
+
+    const double* regressor(const unsigned sample) const
+    {
+        return &regressors[sample * N];
+    }
+
+    // normal equations solved by gaussian elimination in long double
+    void reference(double* theta, double& rss) const
+    {
+        long double A[N][N + 1] = {};
+        for (unsigned s = 0; s < measurements.size(); s++)
+        {
+            const double* x = regressor(s);
+            for (unsigned i = 0; i < N; i++)
+            {
+                for (unsigned j = 0; j < N; j++)
+                {
+                    A[i][j] += (long double)x[i] * x[j];
+                }
+                A[i][N] += (long double)x[i] * measurements[s];
+            }
+        }
+        for (unsigned c = 0; c < N; c++)
+        {
+            for (unsigned r = c + 1; r < N; r++)
+            {
+                const long double f = A[r][c] / A[c][c];
+                for (unsigned k = c; k <= N; k++)
+                {
+                    A[r][k] -= f * A[c][k];
+                }
+            }
+        }
+        for (int i = N - 1; i >= 0; i--)
+        {
+            long double sum = A[i][N];
+            for (unsigned j = i + 1; j < N; j++)
+            {
+                sum -= A[i][j] * theta[j];
+            }
+            theta[i] = (double)(sum / A[i][i]);
+        }
+        long double sse = 0.0L;
+        for (unsigned s = 0; s < measurements.size(); s++)
+        {
+            long double e = measurements[s];
+            for (unsigned i = 0; i < N; i++)
+            {
+                e -= (long double)regressor(s)[i] * theta[i];
+            }
+            sse += e * e;
+        }
+        rss = (double)sse;
+    }
+};
+
+template <unsigned N>
+double maxDifference(const double* a, const double* b)
+{
+    double result = 0.0;
+    for (unsigned i = 0; i < N; i++)
+    {
+        result = std::max(result, std::fabs(a[i] - b[i]));
+    }
+    return result;
+}
+
+template <unsigned N>
+void householder(void)
+{
+    const Problem<N> problem(SAMPLES, N);
+    double expected[N];
+    double expectedRss;
+    problem.reference(expected, expectedRss);
+    SKY_CHECK(maxDifference<N>(expected, problem.truth) < 1e-2);
+
+    HouseholderLeastSquares<double, N> blocked;
+    HouseholderLeastSquares<double, N, 1, 1> unblocked;
+    HouseholderLeastSquares<double, N> first, second;
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        blocked.add(problem.regressor(s), problem.measurements[s]);
+        unblocked.add(problem.regressor(s), problem.measurements[s]);
+        (s < SAMPLES / 3 ? first : second).add(problem.regressor(s), problem.measurements[s]);
+    }
+    first.merge(second);
+
+    double theta[N];
+    SKY_CHECK(blocked.solve(theta));
+    SKY_CHECK(maxDifference<N>(theta, expected) < 1e-9);
+    SKY_CHECK_NEAR(blocked.getResidualSumOfSquares(), expectedRss, 1e-9 * expectedRss);
+    SKY_CHECK(SAMPLES == blocked.getSamplesCount());
+
+    double thetaUnblocked[N];
+    SKY_CHECK(unblocked.solve(thetaUnblocked));
+    SKY_CHECK(maxDifference<N>(theta, thetaUnblocked) < 1e-10);
+    SKY_CHECK_NEAR(unblocked.getResidualSumOfSquares(), blocked.getResidualSumOfSquares(), 1e-9 * expectedRss);
+
+    double thetaMerged[N];
+    SKY_CHECK(first.solve(thetaMerged));
+    SKY_CHECK(maxDifference<N>(theta, thetaMerged) < 1e-10);
+    SKY_CHECK_NEAR(first.getResidualSumOfSquares(), expectedRss, 1e-9 * expectedRss);
+    SKY_CHECK(SAMPLES == first.getSamplesCount());
+
+    RecursiveLeastSquares<double, N> rls;
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        rls.update(problem.regressor(s), problem.measurements[s]);
+    }
+    SKY_CHECK(maxDifference<N>(rls.getParameters(), expected) < 1e-6);
+    SKY_CHECK_NEAR(rls.getParameter(N), expected[N - 1], 1e-6);
+    SKY_CHECK_NEAR(rls.predict(problem.regressor(0)), problem.measurements[0], 0.5);
+    SKY_CHECK(SAMPLES == rls.getSamplesCount());
+
+    // no samples, factor is singular
+    HouseholderLeastSquares<double, N> empty;
+    SKY_CHECK(false == empty.solve(theta));
+}
+
+void multipleOutputs(void)
+{
+    const Problem<6> a(SAMPLES, 1);
+    HouseholderLeastSquares<double, 6, 2> joint;
+    HouseholderLeastSquares<double, 6> single;
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        // second output is scaled first one
+        const double y[2] = {a.measurements[s], 3.0 * a.measurements[s]};
+        joint.add(a.regressor(s), y);
+        single.add(a.regressor(s), a.measurements[s]);
+    }
+    double theta[12];
+    double expected[6];
+    SKY_CHECK(joint.solve(theta));
+    SKY_CHECK(single.solve(expected));
+    SKY_CHECK(maxDifference<6>(theta, expected) < 1e-12);
+    for (unsigned i = 0; i < 6; i++)
+    {
+        SKY_CHECK_NEAR(theta[6 + i], 3.0 * expected[i], 1e-10);
+    }
+    SKY_CHECK_NEAR(joint.getResidualSumOfSquares(1), 9.0 * single.getResidualSumOfSquares(), 1e-8);
+}
+
+void forgettingFactor(void)
+{
+    // model changes in half of stream, only forgetting estimator follows it
+    const Problem<6> before(SAMPLES, 2);
+    Problem<6> after(SAMPLES, 3);
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        after.measurements[s] += 4.0 * after.regressor(s)[1];
+    }
+    RecursiveLeastSquares<double, 6> remembering;
+    RecursiveLeastSquares<double, 6> forgetting(0.98);
+    SKY_CHECK(0.98 == forgetting.getForgettingFactor());
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        remembering.update(before.regressor(s), before.measurements[s]);
+        forgetting.update(before.regressor(s), before.measurements[s]);
+    }
+    for (unsigned s = 0; s < SAMPLES; s++)
+    {
+        remembering.update(after.regressor(s), after.measurements[s]);
+        forgetting.update(after.regressor(s), after.measurements[s]);
+    }
+    const double changed = after.truth[1] + 4.0;
+    SKY_CHECK_NEAR(forgetting.getParameters()[1], changed, 1e-2);
+    SKY_CHECK_NEAR(remembering.getParameters()[1], after.truth[1] + 2.0, 0.1);
+
+    remembering.setForgettingFactor(0.5);
+    remembering.reset();
+    SKY_CHECK(0u == remembering.getSamplesCount());
+    SKY_CHECK(0.0 == remembering.getParameters()[1]);
+}
+
+template <typename _Tp>
+void simdKernels(const double tolerance)
+{
+    std::mt19937 generator(11);
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    for (unsigned n = 0; n <= 37; n++)
+    {
+        std::vector<_Tp> a(n + 1), b(n + 1), y(n + 1), yScalar(n + 1);
+        for (unsigned i = 0; i <= n; i++)
+        {
+            a[i] = (_Tp)uniform(generator);
+            b[i] = (_Tp)uniform(generator);
+            y[i] = yScalar[i] = (_Tp)uniform(generator);
+        }
+        // unaligned start
+        const _Tp* x = a.data() + 1;
+        long double dot = 0.0L;
+        for (unsigned i = 0; i < n; i++)
+        {
+            dot += (long double)x[i] * b[i];
+            yScalar[i] += (_Tp)0.75 * x[i];
+        }
+        SKY_CHECK_NEAR(roboLib::simd::dot(x, b.data(), n), dot, tolerance * (1 + n));
+        roboLib::simd::axpy((_Tp)0.75, x, y.data(), n);
+        for (unsigned i = 0; i <= n; i++)
+        {
+            SKY_CHECK(y[i] == yScalar[i]);
+        }
+    }
+}
+
+}
+
+int main(void)
+{
+    householder<6>();
+    householder<12>();
+    multipleOutputs();
+    forgettingFactor();
+    simdKernels<double>(1e-14);
+    simdKernels<float>(1e-6);
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,279 @@
+// SkyBoardSimulator against SkyDevice on virtual clock: every flow reaches expected
+// device and board state without errors, settings crc survives upload and download,
+// invalid calibration and unsupported protocol end connection.
+
+#include "endpoint/SkyBoardSimulator.hpp"
+#include "endpoint/SkyVirtualClock.hpp"
+#include "endpoint/device/SkyDevice.hpp"
+
+#include "SkyTest.hpp"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+typedef ISkyDeviceAction Action;
+typedef SkyBoardSimulator Board;
+
+class EventMonitor : public ISkyDeviceMonitor
+{
+public:
+    std::vector<DeviceEvent::Type> events;
+    unsigned errors;
+
+    EventMonitor(SkyVirtualClock* const _clock):
+        errors(0),
+        clock(_clock)
+    {
+        ControlData control;
+        control.setControllerCommand(ControlData::MANUAL);
+        control.setSolverMode(ControlData::ANGLE);
+        control.setThrottle(0.4f);
+        pushControlData(control);
+    }
+
+    void notifyDeviceEvent(const DeviceEventRecord& event) override
+    {
+        if (event.getError().isError())
+        {
+            errors++;
+        }
+        events.push_back(event.getType());
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return getPushedControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return clock->createTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    bool emitted(const DeviceEvent::Type type) const
+    {
+        for (const DeviceEvent::Type event : events)
+        {
+            if (type == event)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    SkyVirtualClock* const clock;
+};
+
+struct Link
+{
+    SkyVirtualClock clock;
+    EventMonitor monitor;
+    Board board;
+    SkyDevice device;
+
+    Link(const Board::Settings& settings = Board::Settings()):
+        monitor(&clock),
+        board([this](std::function<void(void)> exec) { return clock.createTimer(exec); }, settings),
+        device(&monitor, 1.0, 25.0, 1.0)
+    {
+    }
+
+    void run(const double seconds)
+    {
+        clock.advanceBy(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>(seconds)));
+    }
+
+    void action(const Action::Type type)
+    {
+        device.pushPilotEvent(new PilotEventAction(type));
+    }
+
+    void pilot(const PilotEvent::Type type)
+    {
+        device.pushPilotEvent(new PilotEvent(type));
+    }
+
+    void connect(const Action::Type type)
+    {
+        device.pushPilotEvent(new PilotEventConnect(type, &board));
+        run(2.0);
+    }
+};
+
+void settingsCrc(void)
+{
+    ControlSettings controls = ControlSettings::createDefault();
+    controls.uavType = ControlSettings::QUADROCOPTER_X;
+    controls.initialSolverMode = ControlData::ANGLE;
+    controls.manualThrottleMode = ControlSettings::STATIC;
+    controls.setCrc();
+    SKY_CHECK(controls.isValid());
+    const unsigned crc = controls.getCrc();
+    controls.maxAutoVelocity += 1.0f;
+    SKY_CHECK(false == controls.isValid());
+    controls.setCrc();
+    SKY_CHECK(crc != controls.getCrc());
+
+    CalibrationSettings calibration = CalibrationSettings::createDefault();
+    calibration.setCrc();
+    SKY_CHECK(calibration.isValid());
+    calibration.boardType = CalibrationSettings::TYPE_PRO_V1;
+    SKY_CHECK(false == calibration.isValid());
+}
+
+void applicationFlows(void)
+{
+    Link link;
+    link.connect(Action::APP);
+    SKY_CHECK(Action::APP == link.device.getState());
+    SKY_CHECK(Board::APP_LOOP == link.board.getStage());
+    SKY_CHECK(link.monitor.emitted(DeviceEvent::APPLICATION_LOOP_STARTED));
+
+    link.action(Action::FLIGHT_INITIALIZATION);
+    link.run(5.0);
+    SKY_CHECK(Action::FLIGHT == link.device.getState());
+    SKY_CHECK(Board::FLIGHT_LOOP == link.board.getStage());
+    SKY_CHECK(link.monitor.emitted(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
+    SKY_CHECK(link.board.getStatistics().controlFrames > 100);
+    link.pilot(PilotEvent::BREAK_FLIGHT_LOOP);
+    link.run(1.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+    SKY_CHECK(link.monitor.emitted(DeviceEvent::FLIGHT_LOOP_ENDED));
+
+    ControlSettings controls = link.board.getControlSettings();
+    controls.maxAutoVelocity = 0.77f;
+    controls.setCrc();
+    link.device.pushPilotEvent(new PilotEventUpload(*new ControlSettings(controls)));
+    link.run(2.0);
+    SKY_CHECK(0.77f == link.board.getControlSettings().maxAutoVelocity);
+    SKY_CHECK(link.board.getControlSettings().isValid());
+    link.device.pushPilotEvent(new PilotEventDownload(SignalData::CONTROL_SETTINGS));
+    link.run(2.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+
+    std::vector<Waypoint> waypoints;
+    for (unsigned i = 0; i < 5; i++)
+    {
+        waypoints.push_back(Waypoint(Location(Vect2Dd(52.0 + i * 0.001, 21.0), 100.0f, 10.0f), 5.0f));
+    }
+    RouteContainer route(waypoints.data(), (unsigned)waypoints.size(), 3.0f, 5.0f);
+    route.setCrc();
+    link.device.pushPilotEvent(new PilotEventUpload(*new RouteContainer(route)));
+    link.run(2.0);
+    SKY_CHECK(5u == link.board.getRoute().getRouteSize());
+    link.monitor.events.clear();
+    link.action(Action::FLIGHT_INITIALIZATION);
+    link.run(2.0);
+    SKY_CHECK(Action::FLIGHT == link.device.getState());
+    SKY_CHECK(false == link.monitor.emitted(DeviceEvent::VIA_ROUTE_NOT_ALLOWED));
+    link.pilot(PilotEvent::BREAK_FLIGHT_LOOP);
+    link.run(1.0);
+
+    link.action(Action::ACCEL_CALIB);
+    link.run(2.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+    link.action(Action::MAGNET_CALIB);
+    link.run(2.0);
+    SKY_CHECK(Board::MAGNET_CALIBRATION == link.board.getStage());
+    link.pilot(PilotEvent::MAGNET_CALIB_DONE);
+    link.run(2.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+
+    link.action(Action::RADIO_CALIB);
+    link.run(1.0);
+    for (unsigned channel = 0; channel < 8; channel++)
+    {
+        link.pilot(channel % 2 ? PilotEvent::RADIO_CALIBRATION_SKIP : PilotEvent::RADIO_CALIBRATION_DONE);
+        link.run(0.2);
+    }
+    SKY_CHECK(Board::RADIO_CALIBRATION_CHECK == link.board.getStage());
+    link.pilot(PilotEvent::RADIO_CALIBRATION_DONE);
+    link.run(2.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+    SKY_CHECK(Board::APP_LOOP == link.board.getStage());
+
+    link.action(Action::RADIO_CHECK);
+    link.run(2.0);
+    SKY_CHECK(Board::RADIO_CHECK == link.board.getStage());
+    link.pilot(PilotEvent::RADIO_CHECK_DONE);
+    link.run(2.0);
+    link.action(Action::ESC_CALIB);
+    link.run(1.0);
+    for (unsigned step = 0; step < 3; step++)
+    {
+        link.pilot(PilotEvent::ESC_CALIB_DONE);
+        link.run(1.0);
+    }
+    SKY_CHECK(Board::APP_LOOP == link.board.getStage());
+    link.action(Action::SENSORS_LOGGER);
+    link.run(3.0);
+    SKY_CHECK(Board::SENSORS_LOGGER == link.board.getStage());
+    link.pilot(PilotEvent::BREAK_SENSORS_LOGGER);
+    link.run(1.0);
+    SKY_CHECK(Action::APP == link.device.getState());
+
+    link.action(Action::DISCONNECT);
+    link.run(2.0);
+    SKY_CHECK(Action::IDLE_ACTION == link.device.getState());
+    SKY_CHECK(Board::DISCONNECTED == link.board.getStage());
+
+    link.monitor.events.clear();
+    link.connect(Action::WHO_AM_I);
+    SKY_CHECK(link.monitor.emitted(DeviceEvent::WHO_AM_I));
+    link.connect(Action::DIRECT_FLIGHT);
+    SKY_CHECK(Action::FLIGHT == link.device.getState());
+    link.pilot(PilotEvent::BREAK_FLIGHT_LOOP);
+    link.run(1.0);
+    link.action(Action::RESET);
+    link.run(2.0);
+    SKY_CHECK(Action::IDLE_ACTION == link.device.getState());
+
+    const Board::Statistics& statistics = link.board.getStatistics();
+    SKY_CHECK(0u == link.monitor.errors);
+    SKY_CHECK(0u == statistics.unexpectedSignals);
+    SKY_CHECK(0u == statistics.failedReceptions);
+    SKY_CHECK(0u == statistics.invalidPayloads);
+}
+
+void rejectedConnections(void)
+{
+    {
+        Link link;
+        // crc not updated
+        link.board.getCalibrationSettings().boardType = CalibrationSettings::TYPE_PRO_V1;
+        link.connect(Action::APP);
+        link.run(30.0);
+        SKY_CHECK(Action::IDLE_ACTION == link.device.getState());
+        SKY_CHECK(Board::DISCONNECTED == link.board.getStage());
+        SKY_CHECK(link.board.getStatistics().payloadRetransmissions >= 2);
+    }
+    {
+        Board::Settings settings;
+        settings.protocolVersion = IMessage::PROTOCOL_VERSION + 1;
+        Link link(settings);
+        link.connect(Action::APP);
+        SKY_CHECK(Action::IDLE_ACTION == link.device.getState());
+        SKY_CHECK(1u == link.monitor.errors);
+    }
+}
+
+}
+
+int main(void)
+{
+    SkyTrace::setLevel(SkyTrace::OFF);
+    settingsCrc();
+    applicationFlows();
+    rejectedConnections();
+    return SKY_TEST_RESULT();
+}
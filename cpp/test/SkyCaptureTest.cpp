@@ -0,0 +1,218 @@
+// SkyRecordingCommInterface captures received and sent chunks and link events,
+// SkyReplayCommInterface passes them back to listener in order, truncated capture
+// stops at last whole record, and time of records is kept with virtual clock.
+
+#include "endpoint/SkyCapture.hpp"
+#include "endpoint/SkyRecordingCommInterface.hpp"
+#include "endpoint/SkyReplayCommInterface.hpp"
+#include "endpoint/SkyVirtualClock.hpp"
+
+#include "SkyTest.hpp"
+
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+class LoopbackInterface : public ISkyCommInterface
+{
+public:
+    size_t sent;
+
+    LoopbackInterface(void):
+        sent(0)
+    {
+    }
+
+    void connect(void) override
+    {
+        onConnected();
+    }
+
+    void disconnect(void) override
+    {
+        onDisconnected();
+    }
+
+    void send(const unsigned char*, const size_t length) override
+    {
+        sent += length;
+    }
+};
+
+class CountingListener : public ISkyCommInterface::Listener
+{
+public:
+    unsigned connected, disconnected, errors;
+    std::vector<size_t> chunks;
+    std::string error;
+
+    CountingListener(void):
+        connected(0),
+        disconnected(0),
+        errors(0)
+    {
+    }
+
+    void onConnected(void) override
+    {
+        connected++;
+    }
+
+    void onDisconnected(void) override
+    {
+        disconnected++;
+    }
+
+    void onError(const std::string& message) override
+    {
+        errors++;
+        error = message;
+    }
+
+    void onReceived(const unsigned char*, const size_t length) override
+    {
+        chunks.push_back(length);
+    }
+};
+
+const std::string path = "/tmp/SkyCaptureTest." + std::to_string(getpid()) + ".skycap";
+
+void recordAndReplay(void)
+{
+    LoopbackInterface link;
+    SkyCaptureWriter writer;
+    SKY_CHECK(writer.open(path));
+    SkyRecordingCommInterface recording(&link, &writer);
+    CountingListener live;
+    recording.setListener(&live);
+
+    unsigned char data[300];
+    std::memset(data, 7, sizeof(data));
+    recording.connect();
+    link.onReceived(data, sizeof(data));
+    recording.send(data, 10);
+    link.onError("link broken");
+    recording.disconnect();
+    writer.close();
+
+    SKY_CHECK(1 == live.connected && 1 == live.disconnected && 1 == live.errors);
+    SKY_CHECK(1 == live.chunks.size() && 300 == live.chunks[0]);
+    SKY_CHECK(10 == link.sent);
+    SKY_CHECK(5 == writer.getRecordsCount());
+
+    SkyCaptureReader reader;
+    SKY_CHECK(reader.open(path));
+    const SkyCapture::Type expected[] = {SkyCapture::CONNECTED, SkyCapture::RECEIVED, SkyCapture::SENT,
+                                         SkyCapture::ERROR, SkyCapture::DISCONNECTED};
+    SkyCapture::Record record;
+    unsigned count = 0;
+    SkyCapture::Duration time(0);
+    while (reader.next(record))
+    {
+        SKY_CHECK(count < 5 && expected[count] == record.type);
+        SKY_CHECK(record.time >= time);
+        time = record.time;
+        count++;
+    }
+    SKY_CHECK(5 == count);
+    SKY_CHECK(false == reader.isBroken());
+
+    // sent chunks are not passed back to listener
+    reader.rewind();
+    SkyReplayCommInterface replay(&reader);
+    CountingListener replayed;
+    replay.setListener(&replayed);
+    replay.connect();
+    replay.replay();
+    SKY_CHECK(1 == replayed.connected && 1 == replayed.disconnected && 1 == replayed.errors);
+    SKY_CHECK("link broken" == replayed.error);
+    SKY_CHECK(1 == replayed.chunks.size() && 300 == replayed.chunks[0]);
+    SKY_CHECK(300 == replay.getReceivedBytes());
+}
+
+void truncated(void)
+{
+    FILE* file = std::fopen(path.c_str(), "rb");
+    std::vector<unsigned char> content(4096);
+    content.resize(std::fread(content.data(), 1, content.size(), file));
+    std::fclose(file);
+
+    // cut inside received chunk, only connect record is whole
+    file = std::fopen(path.c_str(), "wb");
+    std::fwrite(content.data(), 1, SkyCapture::HEADER_SIZE + 100, file);
+    std::fclose(file);
+
+    SkyCaptureReader reader;
+    SKY_CHECK(reader.open(path));
+    SkyCapture::Record record;
+    unsigned count = 0;
+    while (reader.next(record))
+    {
+        count++;
+    }
+    SKY_CHECK(1 == count);
+    SKY_CHECK(reader.isBroken());
+
+    // not capture file
+    file = std::fopen(path.c_str(), "wb");
+    std::fwrite("not a capture", 1, 13, file);
+    std::fclose(file);
+    SKY_CHECK(false == reader.open(path));
+}
+
+void virtualTime(void)
+{
+    SkyCaptureWriter writer;
+    SKY_CHECK(writer.open(path));
+    const unsigned char data[4] = {1, 2, 3, 4};
+    writer.write(SkyCapture::CONNECTED, std::chrono::milliseconds(0), nullptr, 0);
+    writer.write(SkyCapture::RECEIVED, std::chrono::milliseconds(40), data, 4);
+    writer.write(SkyCapture::RECEIVED, std::chrono::seconds(3600), data, 4);
+    // earlier time is moved to previous record
+    writer.write(SkyCapture::RECEIVED, std::chrono::milliseconds(10), data, 4);
+    writer.close();
+
+    SkyCaptureReader reader;
+    SKY_CHECK(reader.open(path));
+    SKY_CHECK(std::chrono::seconds(3600) == reader.getDuration());
+
+    SkyVirtualClock clock;
+    std::vector<SkyCapture::Duration> fired;
+    ISkyTimer* timer = clock.createTimer([&clock, &fired](void)
+    {
+        fired.push_back(clock.now());
+    });
+    timer->start(50.0);
+
+    SkyReplayCommInterface replay(&reader, &clock);
+    CountingListener listener;
+    replay.setListener(&listener);
+    replay.connect();
+    SKY_CHECK(replay.step());
+    SKY_CHECK(replay.step());
+    // timer fired at 20 ms before chunk of 40 ms was passed
+    SKY_CHECK(std::chrono::milliseconds(40) == clock.now());
+    SKY_CHECK(2 == fired.size() && std::chrono::milliseconds(20) == fired[0]);
+    timer->stop();
+    replay.replay();
+    SKY_CHECK(std::chrono::seconds(3600) == clock.now());
+    SKY_CHECK(3 == listener.chunks.size());
+    delete timer;
+}
+
+}
+
+int main(void)
+{
+    recordAndReplay();
+    truncated();
+    virtualTime();
+    std::remove(path.c_str());
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,277 @@
+// 60 s of simulated direct flight (50 Hz telemetry chunks with pongs, 25 Hz controls,
+// 1 Hz pings, event ring drained every 100 ms) under fatal SkyAllocationGuard, with and
+// without rate control. Any heap allocation in device, actions or monitor path aborts.
+// Built with its own copy of SkyAllocationGuard compiled with __SKYDIVE_ALLOCATION_GUARD__.
+
+#include "endpoint/device/SkyDevice.hpp"
+#include "endpoint/SkyAllocationGuard.hpp"
+
+#include "communication/CommDispatcher.hpp"
+
+#include "SkyTest.hpp"
+
+#include <cstdio>
+#include <vector>
+
+namespace
+{
+
+// timers fired by simulation loop in virtual time
+class ManualClock
+{
+public:
+    class Timer : public ISkyTimer
+    {
+    public:
+        Timer(ManualClock* const _clock, std::function<void(void)> _exec):
+            ISkyTimer(_exec),
+            clock(_clock),
+            period(0),
+            next(0),
+            running(false)
+        {
+            clock->timers.push_back(this);
+        }
+
+        ~Timer(void)
+        {
+            for (Timer*& timer : clock->timers)
+            {
+                timer = this == timer ? nullptr : timer;
+            }
+        }
+
+        void start(const double frequency) override
+        {
+            period = (uint64_t)(1e6 / frequency);
+            period = 0 == period ? 1 : period;
+            next = clock->now + period;
+            running = true;
+        }
+
+        void stop(void) override
+        {
+            running = false;
+        }
+
+    private:
+        friend class ManualClock;
+
+        ManualClock* const clock;
+        uint64_t period; // [us]
+        uint64_t next; // [us]
+        bool running;
+    };
+
+    uint64_t now; // [us]
+
+    ManualClock(void):
+        now(0)
+    {
+        // device creates all its timers before flight, slots are never added during it
+        timers.reserve(64);
+    }
+
+    void step(const uint64_t duration)
+    {
+        now += duration;
+        for (size_t i = 0; i < timers.size(); i++)
+        {
+            Timer* const timer = timers[i];
+            if (nullptr != timer && timer->running && timer->next <= now)
+            {
+                timer->next += timer->period;
+                timer->onTimeout();
+            }
+        }
+    }
+
+private:
+    std::vector<Timer*> timers;
+};
+
+class RingMonitor : public ISkyDeviceMonitor
+{
+public:
+    uint64_t received, sent, errors;
+
+    RingMonitor(ManualClock* const _clock):
+        received(0),
+        sent(0),
+        errors(0),
+        clock(_clock)
+    {
+        enableEventRing(4096);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new ManualClock::Timer(clock, exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        size_t count;
+        while ((count = drainDeviceEvents(events, EVENTS_BATCH)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                switch (events[i].getType())
+                {
+                case DeviceEvent::DATA_RECEIVED: received++; break;
+                case DeviceEvent::DATA_SENT: sent++; break;
+                case DeviceEvent::MESSAGE: errors++; break; // errors and warnings
+                default: break;
+                }
+            }
+        }
+    }
+
+private:
+    static constexpr size_t EVENTS_BATCH = 512;
+
+    ManualClock* const clock;
+    DeviceEventRecord events[EVENTS_BATCH];
+};
+
+constexpr size_t RingMonitor::EVENTS_BATCH;
+
+// board in flight loop, streams DebugData and answers pings in the same chunk
+class FlightBoard : public ISkyCommInterface
+{
+public:
+    uint64_t controls, pings;
+
+    FlightBoard(void):
+        controls(0),
+        pings(0),
+        pongsCount(0)
+    {
+    }
+
+    void connect(void) override
+    {
+        onConnected();
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char* data, const size_t length) override
+    {
+        for (size_t i = 0; i < length; i++)
+        {
+            const IMessage::PreambleType preamble = dispatcher.putChar(data[i]);
+            if (IMessage::CONTROL == preamble)
+            {
+                controls++;
+            }
+            else if (IMessage::SIGNAL == preamble && SignalData::PING_VALUE == dispatcher.getCommand())
+            {
+                pings++;
+                if (pongsCount < MAX_PONGS)
+                {
+                    pongs[pongsCount++] = dispatcher.getSignalData();
+                }
+            }
+        }
+    }
+
+    void stream(const unsigned sample)
+    {
+        DebugData debugData;
+        debugData.euler.x = (float)sample;
+        debugData.serializeMessage(chunk);
+        size_t length = debugData.getMessageSize();
+        for (unsigned i = 0; i < pongsCount; i++)
+        {
+            pongs[i].serializeMessage(chunk + length);
+            length += pongs[i].getMessageSize();
+        }
+        pongsCount = 0;
+        onReceived(chunk, length);
+    }
+
+private:
+    static constexpr unsigned MAX_PONGS = 8;
+
+    CommDispatcher dispatcher;
+    SignalData pongs[MAX_PONGS];
+    unsigned pongsCount;
+    unsigned char chunk[IMessage::MAX_DATA_SIZE * (MAX_PONGS + 1)];
+};
+
+void fly(const bool rateControl)
+{
+    ManualClock clock;
+    RingMonitor monitor(&clock);
+    FlightBoard board;
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+    if (rateControl)
+    {
+        device.enableRateControl();
+    }
+    device.pushPilotEvent(new PilotEventConnect(ISkyDeviceAction::DIRECT_FLIGHT, &board));
+
+    unsigned sample = 0;
+    auto run = [&](const uint64_t duration)
+    {
+        const uint64_t end = clock.now + duration;
+        while (clock.now < end)
+        {
+            clock.step(1000);
+            if (0 == clock.now % 20000)
+            {
+                board.stream(sample++);
+            }
+            if (0 == clock.now % 100000)
+            {
+                monitor.drain();
+            }
+        }
+    };
+
+    // warm up, pools and queues reach their working size
+    run(10000000);
+    SKY_CHECK(ISkyDeviceAction::FLIGHT == device.getState());
+
+    const uint64_t controls = board.controls;
+    const uint64_t pings = board.pings;
+    const uint64_t received = monitor.received;
+    uint64_t allocations;
+    {
+        SkyAllocationGuard guard(true);
+        run(60000000);
+        allocations = guard.getAllocationsCount();
+    }
+    std::printf("rate control %d: 60 s flight, controls %lu, pings %lu, received %lu, allocations %lu\n",
+                rateControl, (unsigned long)(board.controls - controls), (unsigned long)(board.pings - pings),
+                (unsigned long)(monitor.received - received), (unsigned long)allocations);
+
+    SKY_CHECK(0 == allocations);
+    SKY_CHECK(ISkyDeviceAction::FLIGHT == device.getState());
+    SKY_CHECK(0 == monitor.errors);
+    SKY_CHECK(board.controls - controls >= 1400);
+    SKY_CHECK(board.pings - pings >= 55);
+    SKY_CHECK(monitor.received - received >= 2900);
+}
+
+}
+
+int main(void)
+{
+    SKY_CHECK(SkyAllocationGuard::isEnabled());
+    fly(false);
+    fly(true);
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,174 @@
+// SkyError values: message detail, text formatted on demand, raise adapter, and
+// errors reported by device as ERROR events, once per received chunk.
+
+#include "endpoint/device/SkyDevice.hpp"
+
+#include "SkyTest.hpp"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+
+class IdleTimer : public ISkyTimer
+{
+public:
+    IdleTimer(std::function<void(void)> _exec):
+        ISkyTimer(_exec)
+    {
+    }
+
+    void start(const double) override
+    {
+    }
+
+    void stop(void) override
+    {
+    }
+};
+
+class RingMonitor : public ISkyDeviceMonitor
+{
+public:
+    std::vector<SkyError> errors;
+    std::vector<std::string> texts;
+
+    RingMonitor(void)
+    {
+        enableEventRing(256);
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)> exec) override
+    {
+        return new IdleTimer(exec);
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+
+    void drain(void)
+    {
+        DeviceEventRecord events[16];
+        size_t count;
+        while ((count = drainDeviceEvents(events, 16)) > 0)
+        {
+            for (size_t i = 0; i < count; i++)
+            {
+                if (DeviceEvent::MESSAGE == events[i].getType() && events[i].getError().isError())
+                {
+                    errors.push_back(events[i].getError());
+                    texts.push_back(events[i].getText());
+                }
+            }
+        }
+    }
+};
+
+class FeedingBoard : public ISkyCommInterface
+{
+public:
+    void connect(void) override
+    {
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char*, const size_t) override
+    {
+    }
+
+    void feed(const unsigned char* data, const size_t length)
+    {
+        onReceived(data, length);
+    }
+};
+
+void values(void)
+{
+    const SkyError none;
+    SKY_CHECK(false == none.isError());
+    SKY_CHECK(std::string("NONE") == none.getDescriptor().name);
+
+    const SignalData signal(SignalData::FLIGHT_LOOP, SignalData::NOT_ALLOWED);
+    SkyError error(SkyError::UNEXPECTED_MESSAGE, signal);
+    error.at("FLIGHT", "WAITING_FOR_RUNNING");
+    SKY_CHECK(error.isError());
+    SKY_CHECK(SkyError::MESSAGE == error.getDescriptor().detail);
+    SKY_CHECK(IMessage::SIGNAL_DATA == error.getValue());
+    SKY_CHECK(SignalData::FLIGHT_LOOP == error.getCommand());
+    SKY_CHECK(SignalData::NOT_ALLOWED == error.getParameter());
+
+    const std::string text = error.toString();
+    SKY_CHECK(std::string::npos != text.find(" at FLIGHT @ WAITING_FOR_RUNNING"));
+    SKY_CHECK(std::string::npos != text.find(SignalData::toString(SignalData::NOT_ALLOWED)));
+
+    // out of range code falls back to NONE descriptor
+    SKY_CHECK(SkyError::NONE == SkyError::getDescriptor(SkyError::CODES_COUNT).code);
+
+    bool raised = false;
+    try
+    {
+        SkyError(SkyError::FRAME_TOO_LONG, 300).raise();
+    }
+    catch (const SkyError::Exception& exception)
+    {
+        raised = SkyError::FRAME_TOO_LONG == exception.getError().getCode()
+                && std::string::npos != std::string(exception.what()).find("value: 300");
+    }
+    SKY_CHECK(raised);
+}
+
+void reported(void)
+{
+    RingMonitor monitor;
+    FeedingBoard board;
+    SkyDevice device(&monitor, 1.0, 25.0, 1.0);
+    board.setListener(&device);
+
+    static constexpr unsigned FRAMES = 8;
+    unsigned char frames[IMessage::MAX_DATA_SIZE * FRAMES];
+    const DebugData debugData;
+    debugData.serializeMessage(frames);
+    const size_t length = debugData.getMessageSize();
+    for (unsigned i = 1; i < FRAMES; i++)
+    {
+        std::copy(frames, frames + length, frames + i * length);
+    }
+
+    // one error for each chunk, frames staged after error are dropped
+    board.feed(frames, length);
+    board.feed(frames, FRAMES * length);
+    monitor.drain();
+    SKY_CHECK(2 == monitor.errors.size());
+    for (const SkyError& error : monitor.errors)
+    {
+        SKY_CHECK(SkyError::UNEXPECTED_MESSAGE == error.getCode());
+        SKY_CHECK(IMessage::DEBUG_DATA == error.getValue());
+    }
+    SKY_CHECK(2 == monitor.texts.size() && monitor.errors.front().toString() == monitor.texts.front());
+
+    // frame broken by CRC is not an error of action
+    frames[length / 2] ^= 0x5A;
+    board.feed(frames, length);
+    monitor.drain();
+    SKY_CHECK(2 == monitor.errors.size());
+}
+
+}
+
+int main(void)
+{
+    values();
+    reported();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,175 @@
+// SkyEventDelivery started by monitor, two devices publishing while consumer is slow:
+// state events are never lost, every device gets its events in publish order (DebugData
+// published before state event is delivered before it), DebugData is coalesced per device
+// and ends with latest value of each device, stopBatchDelivery in derived destructor
+// delivers everything pending. Records carry origin of enclosing OriginScope.
+
+#include "endpoint/device/ISkyDeviceMonitor.hpp"
+
+#include "SkyTest.hpp"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+const unsigned DEVICES = 2;
+
+// events are published by fake devices, only addresses are used
+const char devices[DEVICES] = {0, 0};
+
+const SkyDevice* device(const unsigned index)
+{
+    return reinterpret_cast<const SkyDevice*>(&devices[index]);
+}
+
+class RecordingMonitor : public ISkyDeviceMonitor
+{
+public:
+    struct Delivered
+    {
+        DeviceEvent::Type type;
+        float value; // DebugData
+    };
+
+    std::vector<Delivered> delivered[DEVICES];
+
+    RecordingMonitor(void)
+    {
+        enableBatchDelivery(64, 16);
+    }
+
+    ~RecordingMonitor(void)
+    {
+        stopBatchDelivery();
+    }
+
+    void notifyDeviceEvents(const DeviceEventRecord* events, const size_t count) override
+    {
+        for (size_t i = 0; i < count; i++)
+        {
+            const unsigned index = device(1) == events[i].getOrigin() ? 1 : 0;
+            if (DeviceEvent::DATA_RECEIVED == events[i].getType())
+            {
+                const float value = static_cast<const DebugData&>(events[i].getMessage()).euler.x;
+                delivered[index].push_back(Delivered{events[i].getType(), value});
+            }
+            else if (DeviceEvent::DATA_SENT != events[i].getType())
+            {
+                delivered[index].push_back(Delivered{events[i].getType(), 0.0f});
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(500));
+    }
+
+    ControlData getControlDataToSend(void) override
+    {
+        return ControlData();
+    }
+
+    ISkyTimer* createTimer(std::function<void(void)>) override
+    {
+        return nullptr;
+    }
+
+    void trace(const std::string&) override
+    {
+    }
+};
+
+void originScope(void)
+{
+    SKY_CHECK(nullptr == DeviceEventRecord(DeviceEvent::CONNECTION_LOST).getOrigin());
+    {
+        const DeviceEventRecord::OriginScope outer(device(0));
+        {
+            const DeviceEventRecord::OriginScope inner(device(1));
+            const DeviceEventRecord record(DeviceEvent::CONNECTION_LOST);
+            SKY_CHECK(device(1) == record.getOrigin());
+            SKY_CHECK(device(1) == DeviceEventRecord(record).getOrigin());
+        }
+        SKY_CHECK(device(0) == DeviceEventRecord(DeviceEvent::CONNECTION_LOST).getOrigin());
+    }
+    SKY_CHECK(nullptr == DeviceEventRecord(DeviceEvent::CONNECTION_LOST).getOrigin());
+}
+
+}
+
+int main(void)
+{
+    const unsigned iterations = 5000;
+
+    originScope();
+
+    RecordingMonitor monitor;
+    monitor.startBatchDelivery();
+    SKY_CHECK(monitor.getEventDelivery()->isRunning());
+
+    DebugData debugData;
+    const ControlData controlData;
+    // DebugData value published just before every state event of device
+    std::vector<float> statesSent[DEVICES];
+    for (unsigned i = 0; i < iterations; i++)
+    {
+        for (unsigned d = 0; d < DEVICES; d++)
+        {
+            const DeviceEventRecord::OriginScope origin(device(d));
+            debugData.euler.x = static_cast<float>(i);
+            monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_RECEIVED, debugData));
+            monitor.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::DATA_SENT, controlData));
+            if (25 * d == i % 50)
+            {
+                monitor.notifyDeviceEvent(DeviceEventRecord(0 == statesSent[d].size() % 2 ? DeviceEvent::CONNECTION_LOST
+                                                                                        : DeviceEvent::FLIGHT_LOOP_ENDED));
+                statesSent[d].push_back(static_cast<float>(i));
+            }
+        }
+    }
+    monitor.stopBatchDelivery();
+    SKY_CHECK(false == monitor.getEventDelivery()->isRunning());
+
+    for (unsigned d = 0; d < DEVICES; d++)
+    {
+        // every state event in publish order, preceded by DebugData published before it,
+        // telemetry coalesced, never reordered, latest value delivered
+        size_t states = 0;
+        size_t debugs = 0;
+        bool ordered = true;
+        float lastDebug = -1.0f;
+        for (const RecordingMonitor::Delivered& event : monitor.delivered[d])
+        {
+            if (DeviceEvent::DATA_RECEIVED == event.type)
+            {
+                ordered = ordered && lastDebug < event.value;
+                lastDebug = event.value;
+                debugs++;
+            }
+            else
+            {
+                ordered = ordered && states < statesSent[d].size() && statesSent[d][states] == lastDebug
+                        && (0 == states % 2 ? DeviceEvent::CONNECTION_LOST : DeviceEvent::FLIGHT_LOOP_ENDED) == event.type;
+                states++;
+            }
+        }
+        SKY_CHECK(ordered);
+        SKY_CHECK(statesSent[d].size() == states);
+        SKY_CHECK(debugs > 0 && debugs <= iterations);
+        SKY_CHECK(static_cast<float>(iterations - 1) == lastDebug);
+    }
+
+    const SkyEventDelivery& delivery = *monitor.getEventDelivery();
+    SKY_CHECK(delivery.getCoalescedCount() > 0);
+    SKY_CHECK(delivery.getPublishedCount() == delivery.getDeliveredCount()
+              + delivery.getCoalescedCount() + delivery.getDroppedCount());
+
+    // restart and stop in destructor of derived monitor
+    {
+        RecordingMonitor second;
+        second.startBatchDelivery();
+        second.notifyDeviceEvent(DeviceEventRecord(DeviceEvent::CONNECTION_LOST));
+    }
+
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,180 @@
+// SkyFdCommInterface on SkyEventLoop: closed peer of socket and pipe is reported by onError
+// and does not raise SIGPIPE, tasks posted by interface are cancelled when it is destroyed,
+// loop timers can not be created from other thread while loop runs.
+
+#include "endpoint/SkyEventLoop.hpp"
+#include "endpoint/SkyFdCommInterface.hpp"
+
+#include "SkyTest.hpp"
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <thread>
+
+namespace
+{
+
+class Listener : public ISkyCommInterface::Listener
+{
+public:
+    Listener(void):
+        connected(0),
+        disconnected(0),
+        errors(0),
+        received(0)
+    {
+    }
+
+    void onConnected(void) override
+    {
+        connected++;
+    }
+
+    void onDisconnected(void) override
+    {
+        disconnected++;
+    }
+
+    void onError(const std::string&) override
+    {
+        errors++;
+    }
+
+    void onReceived(const unsigned char*, const size_t length) override
+    {
+        received += length;
+    }
+
+    std::atomic<unsigned> connected;
+    std::atomic<unsigned> disconnected;
+    std::atomic<unsigned> errors;
+    std::atomic<size_t> received;
+};
+
+// runs task on loop thread and waits for it
+void runOnLoop(SkyEventLoop& loop, std::function<void(void)> task)
+{
+    std::promise<void> done;
+    loop.execute([&]()
+    {
+        task();
+        done.set_value();
+    });
+    done.get_future().wait();
+}
+
+void closedPeer(SkyEventLoop& loop, const int fd, const int peerFd)
+{
+    Listener listener;
+    SkyFdCommInterface interface(&loop, fd);
+    interface.setListener(&listener);
+    interface.connect();
+    close(peerFd);
+
+    const unsigned char data[64] = {0};
+    for (unsigned i = 0; i < 100 && 0 == listener.errors && 0 == listener.disconnected; i++)
+    {
+        interface.send(data, sizeof(data));
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    runOnLoop(loop, []() {});
+    SKY_CHECK(1 == listener.connected);
+    SKY_CHECK(1 == listener.disconnected);
+}
+
+}
+
+int main(void)
+{
+    SkyEventLoop loop;
+    std::thread loopThread([&]() { loop.run(); });
+    runOnLoop(loop, []() {});
+
+    // socket and pipe closed by peer, default SIGPIPE action would terminate test
+    int sockets[2];
+    SKY_CHECK(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    closedPeer(loop, sockets[0], sockets[1]);
+    int pipeFds[2];
+    SKY_CHECK(0 == pipe(pipeFds));
+    closedPeer(loop, pipeFds[1], pipeFds[0]);
+
+    // interface destroyed on loop thread with its connect and send still queued
+    Listener listener;
+    SKY_CHECK(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    runOnLoop(loop, [&]()
+    {
+        SkyFdCommInterface* interface = new SkyFdCommInterface(&loop, sockets[0]);
+        interface->setListener(&listener);
+        interface->connect();
+        std::thread([interface]()
+        {
+            const unsigned char data[8] = {0};
+            interface->send(data, sizeof(data));
+        }).join();
+        delete interface;
+    });
+    runOnLoop(loop, []() {});
+    SKY_CHECK(0 == listener.connected);
+    close(sockets[1]);
+
+    // interface destroyed by other thread waits until tasks posted before are done
+    SKY_CHECK(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, sockets));
+    Listener peerListener;
+    SkyFdCommInterface peer(&loop, sockets[1]);
+    peer.setListener(&peerListener);
+    peer.connect();
+    std::atomic<bool> release(false);
+    loop.execute([&]()
+    {
+        while (false == release)
+        {
+            std::this_thread::yield();
+        }
+    });
+    SkyFdCommInterface* interface = new SkyFdCommInterface(&loop, sockets[0]);
+    interface->setListener(&listener);
+    interface->connect();
+    const unsigned char data[100] = {0};
+    for (unsigned i = 0; i < 10; i++)
+    {
+        interface->send(data, sizeof(data));
+    }
+    std::thread releaser([&]()
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        release = true;
+    });
+    delete interface;
+    releaser.join();
+    for (unsigned i = 0; i < 100 && peerListener.received < 1000; i++)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    SKY_CHECK(1 == listener.connected);
+    SKY_CHECK(1000 == peerListener.received);
+
+    // loop timers only on loop thread while loop runs
+    bool thrown = false;
+    try
+    {
+        delete loop.createTimer([]() {});
+    }
+    catch (const std::logic_error&)
+    {
+        thrown = true;
+    }
+    SKY_CHECK(thrown);
+    runOnLoop(loop, [&]()
+    {
+        delete loop.createTimer([]() {});
+    });
+
+    runOnLoop(loop, [&]() { peer.disconnect(); });
+    loop.stop();
+    loopThread.join();
+    return SKY_TEST_RESULT();
+}
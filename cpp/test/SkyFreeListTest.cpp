@@ -0,0 +1,109 @@
+// SkyFreeList: every slot is handed out once until it is returned, exhausted list
+// reports it, slots keep exclusive owner while four threads take and return them.
+
+#include "endpoint/SkyFreeList.hpp"
+
+#include "SkyTest.hpp"
+
+#include <atomic>
+#include <set>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void sequential(void)
+{
+    SkyFreeList freeList(8);
+    SKY_CHECK(8 == freeList.getCapacity());
+    std::set<size_t> taken;
+    size_t index;
+    while (freeList.pop(index))
+    {
+        SKY_CHECK(index < 8);
+        SKY_CHECK(taken.insert(index).second);
+    }
+    SKY_CHECK(8 == taken.size());
+
+    freeList.push(5);
+    freeList.push(2);
+    SKY_CHECK(freeList.pop(index) && 2 == index);
+    SKY_CHECK(freeList.pop(index) && 5 == index);
+    SKY_CHECK(false == freeList.pop(index));
+
+    SkyFreeList empty(0);
+    SKY_CHECK(false == empty.pop(index));
+}
+
+void concurrent(void)
+{
+    const unsigned threadsCount = 4;
+    const unsigned iterations = 200000;
+    const size_t capacity = 6;
+
+    SkyFreeList freeList(capacity);
+    std::vector<std::atomic<int>> owners(capacity);
+    for (std::atomic<int>& owner : owners)
+    {
+        owner = -1;
+    }
+    std::atomic<unsigned> conflicts(0);
+    std::atomic<unsigned long> exhausted(0);
+
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < threadsCount; t++)
+    {
+        threads.push_back(std::thread([&, t]()
+        {
+            size_t held[2];
+            for (unsigned i = 0; i < iterations; i++)
+            {
+                // two slots held at once, so list gets exhausted now and then
+                unsigned count = 0;
+                while (count < 2 && freeList.pop(held[count]))
+                {
+                    int expected = -1;
+                    if (false == owners[held[count]].compare_exchange_strong(expected, (int)t))
+                    {
+                        conflicts++;
+                    }
+                    count++;
+                }
+                if (count < 2)
+                {
+                    exhausted++;
+                }
+                while (count > 0)
+                {
+                    count--;
+                    owners[held[count]] = -1;
+                    freeList.push(held[count]);
+                }
+            }
+        }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    SKY_CHECK(0 == conflicts);
+    // every slot is back
+    std::set<size_t> returned;
+    size_t index;
+    while (freeList.pop(index))
+    {
+        SKY_CHECK(returned.insert(index).second);
+    }
+    SKY_CHECK(capacity == returned.size());
+}
+
+}
+
+int main(void)
+{
+    sequential();
+    concurrent();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,77 @@
+// SkyLatencyHistogram percentiles stay within bucket resolution of exact ones,
+// for uniform and long tailed samples, also when recorded from many threads.
+
+#include "endpoint/SkyLatencyHistogram.hpp"
+
+#include "SkyTest.hpp"
+
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void checkPercentiles(std::vector<uint64_t> samples)
+{
+    SkyLatencyHistogram histogram;
+    for (const uint64_t sample : samples)
+    {
+        histogram.record(sample);
+    }
+    std::sort(samples.begin(), samples.end());
+    SKY_CHECK(samples.size() == histogram.getCount());
+    SKY_CHECK(samples.back() == histogram.getMax());
+
+    const double quantiles[4] = {0.5, 0.9, 0.99, 0.999};
+    for (const double quantile : quantiles)
+    {
+        const double exact = (double)samples[(size_t)(quantile * (samples.size() - 1))];
+        const double reported = (double)histogram.getPercentile(quantile);
+        // upper bound of bucket, 16 buckets per power of two
+        SKY_CHECK(reported >= exact);
+        SKY_CHECK(reported <= exact * (1.0 + 1.0 / 16.0) + 1.0);
+    }
+}
+
+}
+
+int main(void)
+{
+    std::mt19937_64 generator(7);
+    std::vector<uint64_t> uniform(100000), tail(100000);
+    std::uniform_int_distribution<uint64_t> uniformDistribution(1000, 2000000);
+    std::lognormal_distribution<double> tailDistribution(10.0, 2.0);
+    for (size_t i = 0; i < uniform.size(); i++)
+    {
+        uniform[i] = uniformDistribution(generator);
+        tail[i] = 1 + (uint64_t)tailDistribution(generator);
+    }
+    checkPercentiles(uniform);
+    checkPercentiles(tail);
+
+    SkyLatencyHistogram histogram;
+    SKY_CHECK(0 == histogram.getPercentile(0.5));
+    std::vector<std::thread> threads;
+    for (unsigned t = 0; t < 4; t++)
+    {
+        threads.push_back(std::thread([&histogram, t]()
+        {
+            for (uint64_t i = 1; i <= 100000; i++)
+            {
+                histogram.record(i * (t + 1));
+            }
+        }));
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    SKY_CHECK(400000 == histogram.getCount());
+    SKY_CHECK(400000 == histogram.getMax());
+    histogram.reset();
+    SKY_CHECK(0 == histogram.getCount());
+
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,199 @@
+// SkyLinkQuality on injected time points: RFC 6298 initialisation and update order
+// (RTTVAR with SRTT from before sample), RTO clamping, pongs matched by value out of order,
+// unknown pongs, eviction of oldest ping, expiry after loss timeout and loss rate window.
+
+#include "endpoint/device/SkyLinkQuality.hpp"
+
+#include "SkyTest.hpp"
+
+#include <chrono>
+
+namespace
+{
+
+typedef SkyLinkQuality::Clock Clock;
+typedef SkyLinkQuality::Figures Figures;
+
+const Clock::time_point T0 = Clock::time_point(std::chrono::seconds(1000));
+
+Clock::time_point at(const unsigned ms)
+{
+    return T0 + std::chrono::milliseconds(ms);
+}
+
+void firstSampleAndUpdate(void)
+{
+    SkyLinkQuality quality;
+    Figures figures = quality.getFigures();
+    SKY_CHECK(false == figures.valid);
+    SKY_CHECK(1000000u == figures.rto);
+
+    // RFC 6298 2.2: SRTT = R, RTTVAR = R / 2, RTO = SRTT + 4 * RTTVAR
+    quality.onPingSent(1, at(0));
+    SKY_CHECK(quality.onPongReceived(1, at(100)));
+    figures = quality.getFigures();
+    SKY_CHECK(figures.valid);
+    SKY_CHECK(100000u == figures.lastRtt);
+    SKY_CHECK(100000u == figures.minRtt);
+    SKY_CHECK(100000u == figures.smoothedRtt);
+    SKY_CHECK(50000u == figures.rttVariance);
+    SKY_CHECK(300000u == figures.rto);
+    SKY_CHECK(1u == figures.sent && 1u == figures.answered && 0u == figures.outstanding);
+
+    // RFC 6298 2.3: RTTVAR = 3/4 * 0.05 + 1/4 * |0.1 - 0.2| = 0.0625 with old SRTT
+    // (0.059375 if SRTT was updated first), SRTT = 7/8 * 0.1 + 1/8 * 0.2 = 0.1125
+    quality.onPingSent(2, at(1000));
+    SKY_CHECK(quality.onPongReceived(2, at(1200)));
+    figures = quality.getFigures();
+    SKY_CHECK(200000u == figures.lastRtt);
+    SKY_CHECK(100000u == figures.minRtt);
+    SKY_CHECK_NEAR(figures.rttVariance, 62500, 1);
+    SKY_CHECK_NEAR(figures.smoothedRtt, 112500, 1);
+    SKY_CHECK_NEAR(figures.rto, 362500, 1);
+    SKY_CHECK(std::chrono::microseconds(figures.smoothedRtt) == quality.getSmoothedRtt());
+    SKY_CHECK(std::chrono::microseconds(figures.rto) == quality.getRto());
+
+    quality.reset();
+    figures = quality.getFigures();
+    SKY_CHECK(false == figures.valid);
+    SKY_CHECK(1000000u == figures.rto);
+    SKY_CHECK(0u == figures.sent);
+}
+
+void rtoClamping(void)
+{
+    // 2 ms + 4 ms is below minimal RTO of 50 ms
+    SkyLinkQuality fast;
+    fast.onPingSent(1, at(0));
+    fast.onPongReceived(1, at(2));
+    SKY_CHECK(50000u == fast.getFigures().rto);
+
+    // 4 s + 8 s is above maximal RTO of 10 s
+    SkyLinkQuality slow;
+    slow.onPingSent(1, at(0));
+    slow.onPongReceived(1, at(4000));
+    SKY_CHECK(10000000u == slow.getFigures().rto);
+
+    // custom bounds
+    SkyLinkQuality custom(SkyLinkQuality::Settings(11520, 16, 32, std::chrono::seconds(2),
+                                                   std::chrono::milliseconds(400), std::chrono::milliseconds(500)));
+    custom.onPingSent(1, at(0));
+    custom.onPongReceived(1, at(10));
+    SKY_CHECK(400000u == custom.getFigures().rto);
+    custom.onPingSent(2, at(100));
+    custom.onPongReceived(2, at(2100));
+    SKY_CHECK(500000u == custom.getFigures().rto);
+}
+
+void outOfOrderPongs(void)
+{
+    SkyLinkQuality quality;
+    quality.onPingSent(1, at(0));
+    quality.onPingSent(2, at(10));
+    quality.onPingSent(3, at(20));
+    SKY_CHECK(3u == quality.getFigures().outstanding);
+
+    SKY_CHECK(quality.onPongReceived(3, at(50)));
+    SKY_CHECK(30000u == quality.getFigures().lastRtt);
+    SKY_CHECK(quality.onPongReceived(1, at(60)));
+    SKY_CHECK(60000u == quality.getFigures().lastRtt);
+    SKY_CHECK(30000u == quality.getFigures().minRtt);
+
+    // unknown and already answered pongs
+    SKY_CHECK(false == quality.onPongReceived(7, at(70)));
+    SKY_CHECK(false == quality.onPongReceived(3, at(70)));
+    const Figures figures = quality.getFigures();
+    SKY_CHECK(3u == figures.sent);
+    SKY_CHECK(2u == figures.answered);
+    SKY_CHECK(1u == figures.outstanding);
+    SKY_CHECK(0u == figures.lost);
+}
+
+void eviction(void)
+{
+    SkyLinkQuality quality(SkyLinkQuality::Settings(11520, 4));
+    for (int i = 0; i < 5; i++)
+    {
+        quality.onPingSent(i, at(i * 10));
+    }
+    Figures figures = quality.getFigures();
+    SKY_CHECK(5u == figures.sent);
+    SKY_CHECK(4u == figures.outstanding);
+    SKY_CHECK(1u == figures.lost);
+    SKY_CHECK(1.0f == figures.lossRate);
+
+    // oldest was evicted, next one is still waiting
+    SKY_CHECK(false == quality.onPongReceived(0, at(100)));
+    SKY_CHECK(quality.onPongReceived(1, at(100)));
+    figures = quality.getFigures();
+    SKY_CHECK(90000u == figures.lastRtt);
+    SKY_CHECK(3u == figures.outstanding);
+    SKY_CHECK(0.5f == figures.lossRate);
+}
+
+void expiry(void)
+{
+    SkyLinkQuality quality;
+    quality.onPingSent(1, at(0));
+    quality.onPingSent(2, at(1500));
+    SKY_CHECK(0u == quality.expire(at(1900)));
+    // loss timeout of 2 s is inclusive
+    SKY_CHECK(1u == quality.expire(at(2000)));
+    SKY_CHECK(false == quality.onPongReceived(1, at(2100)));
+    SKY_CHECK(1u == quality.expire(at(3500)));
+    SKY_CHECK(0u == quality.expire(at(10000)));
+
+    const Figures figures = quality.getFigures();
+    SKY_CHECK(2u == figures.lost);
+    SKY_CHECK(0u == figures.outstanding);
+    SKY_CHECK(0u == figures.answered);
+    SKY_CHECK(false == figures.valid);
+    SKY_CHECK(1.0f == quality.getLossRate());
+}
+
+void lossWindow(void)
+{
+    SkyLinkQuality quality;
+    unsigned ms = 0;
+    int value = 0;
+    // 8 lost pings, then 32 answered ones pushing them out of 32 ping window
+    for (unsigned i = 0; i < 8; i++)
+    {
+        quality.onPingSent(value++, at(ms));
+        SKY_CHECK(1u == quality.expire(at(ms + 2000)));
+        ms += 2000;
+    }
+    SKY_CHECK(1.0f == quality.getLossRate());
+    for (unsigned i = 0; i < 32; i++)
+    {
+        quality.onPingSent(value, at(ms));
+        SKY_CHECK(quality.onPongReceived(value++, at(ms + 20)));
+        ms += 100;
+        if (0 == i)
+        {
+            SKY_CHECK_NEAR(quality.getLossRate(), 8.0 / 9.0, 1e-6);
+        }
+        if (23 == i)
+        {
+            SKY_CHECK_NEAR(quality.getLossRate(), 0.25, 1e-6);
+        }
+    }
+    const Figures figures = quality.getFigures();
+    SKY_CHECK(0.0f == figures.lossRate);
+    SKY_CHECK(8u == figures.lost);
+    SKY_CHECK(32u == figures.answered);
+    SKY_CHECK(40u == figures.sent);
+}
+
+}
+
+int main(void)
+{
+    firstSampleAndUpdate();
+    rtoClamping();
+    outOfOrderPongs();
+    eviction();
+    expiry();
+    lossWindow();
+    return SKY_TEST_RESULT();
+}
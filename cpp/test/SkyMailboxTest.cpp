@@ -0,0 +1,171 @@
+// Concurrent producers stress of SkyMailbox: every item is popped exactly once,
+// in order of pushes of each producer, with consumer popping while producers push,
+// and with drain by thread that won the flag (as SkyDevice drains its mailbox).
+
+#include "endpoint/SkyMailbox.hpp"
+
+#include "SkyTest.hpp"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+struct Item : public SkyMailbox::Node
+{
+    unsigned producer;
+    unsigned sequence;
+};
+
+const unsigned PRODUCERS = 8;
+const unsigned ITEMS = 100000;
+
+class Consumer
+{
+public:
+    Consumer(void):
+        lastSequence(PRODUCERS, 0),
+        popped(0),
+        orderErrors(0)
+    {
+    }
+
+    void take(SkyMailbox::Node* node)
+    {
+        Item* item = static_cast<Item*>(node);
+        if (item->sequence != lastSequence[item->producer] + 1)
+        {
+            orderErrors++;
+        }
+        lastSequence[item->producer] = item->sequence;
+        popped++;
+    }
+
+    std::vector<unsigned> lastSequence;
+    unsigned long popped;
+    unsigned orderErrors;
+};
+
+std::vector<Item> createItems(void)
+{
+    std::vector<Item> items(PRODUCERS * ITEMS);
+    for (unsigned p = 0; p < PRODUCERS; p++)
+    {
+        for (unsigned i = 0; i < ITEMS; i++)
+        {
+            items[p * ITEMS + i].producer = p;
+            items[p * ITEMS + i].sequence = i + 1;
+        }
+    }
+    return items;
+}
+
+void dedicatedConsumer(void)
+{
+    SkyMailbox mailbox;
+    std::vector<Item> items = createItems();
+    Consumer consumer;
+    std::atomic<unsigned> finished(0);
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < PRODUCERS; p++)
+    {
+        producers.push_back(std::thread([&, p]()
+        {
+            for (unsigned i = 0; i < ITEMS; i++)
+            {
+                mailbox.push(&items[p * ITEMS + i]);
+            }
+            finished++;
+        }));
+    }
+    while (true)
+    {
+        const bool done = PRODUCERS == finished.load();
+        SkyMailbox::Node* node;
+        while (nullptr != (node = mailbox.pop()))
+        {
+            consumer.take(node);
+        }
+        if (done)
+        {
+            break;
+        }
+        std::this_thread::yield();
+    }
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    SKY_CHECK(PRODUCERS * ITEMS == consumer.popped);
+    SKY_CHECK(0 == consumer.orderErrors);
+    SKY_CHECK(mailbox.isEmpty());
+    SKY_CHECK(nullptr == mailbox.pop());
+}
+
+void drainByWinner(void)
+{
+    SkyMailbox mailbox;
+    std::vector<Item> items = createItems();
+    Consumer consumer;
+    std::atomic<bool> draining(false);
+    std::atomic<unsigned> drainers(0);
+    std::atomic<unsigned> overlaps(0);
+
+    // same protocol as SkyDevice::post, mailbox is checked again after flag is released
+    auto drain = [&]()
+    {
+        while (false == draining.exchange(true, std::memory_order_acquire))
+        {
+            if (0 != drainers.fetch_add(1))
+            {
+                overlaps++;
+            }
+            SkyMailbox::Node* node;
+            while (nullptr != (node = mailbox.pop()))
+            {
+                consumer.take(node);
+            }
+            drainers--;
+            draining.store(false, std::memory_order_release);
+            if (mailbox.isEmpty())
+            {
+                break;
+            }
+        }
+    };
+
+    std::vector<std::thread> producers;
+    for (unsigned p = 0; p < PRODUCERS; p++)
+    {
+        producers.push_back(std::thread([&, p]()
+        {
+            for (unsigned i = 0; i < ITEMS; i++)
+            {
+                mailbox.push(&items[p * ITEMS + i]);
+                drain();
+            }
+        }));
+    }
+    for (std::thread& producer : producers)
+    {
+        producer.join();
+    }
+
+    SKY_CHECK(PRODUCERS * ITEMS == consumer.popped);
+    SKY_CHECK(0 == consumer.orderErrors);
+    SKY_CHECK(0 == overlaps.load());
+    SKY_CHECK(mailbox.isEmpty());
+}
+
+}
+
+int main(void)
+{
+    dedicatedConsumer();
+    drainByWinner();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,131 @@
+// SkyMetrics counters, histograms and send queue peak, Prometheus text of exporter
+// with escaped device name, atomic file export and unix socket serving.
+
+#include "endpoint/device/SkyMetricsExporter.hpp"
+
+#include "SkyTest.hpp"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+namespace
+{
+
+bool contains(const std::string& text, const std::string& line)
+{
+    return std::string::npos != text.find(line);
+}
+
+void counters(void)
+{
+    SkyMetrics metrics;
+    metrics.onChunk(100);
+    metrics.onFrame(SkyMetrics::RECEIVED, IMessage::DEBUG_DATA, 40);
+    metrics.onFrame(SkyMetrics::RECEIVED, IMessage::DEBUG_DATA, 40);
+    metrics.onFrame(SkyMetrics::SENT, IMessage::CONTROL_DATA, 20);
+    metrics.setReceptionFailures(1, 2, 3);
+    metrics.setSendQueue(5, 200);
+    metrics.setSendQueue(2, 80);
+
+    const SkyMetrics::Snapshot snapshot = metrics.getSnapshot();
+    SKY_CHECK(100 == snapshot.receivedBytes);
+    SKY_CHECK(2 == snapshot.frames[SkyMetrics::RECEIVED][IMessage::DEBUG_DATA]);
+    SKY_CHECK(80 == snapshot.bytes[SkyMetrics::RECEIVED][IMessage::DEBUG_DATA]);
+    SKY_CHECK(1 == snapshot.frames[SkyMetrics::SENT][IMessage::CONTROL_DATA]);
+    SKY_CHECK(0 == snapshot.frames[SkyMetrics::SENT][IMessage::DEBUG_DATA]);
+    SKY_CHECK(1 == snapshot.crcFailures && 2 == snapshot.preambleCollisions && 3 == snapshot.incompletePayloads);
+    SKY_CHECK(2 == snapshot.sendQueueFrames && 5 == snapshot.sendQueueFramesMax && 80 == snapshot.sendQueueBytes);
+
+    SKY_CHECK(nullptr == metrics.getSignalRoundTrip(SignalData::FLIGHT_LOOP));
+    metrics.recordSignalRoundTrip(SignalData::FLIGHT_LOOP, std::chrono::milliseconds(10));
+    metrics.recordSignalRoundTrip(SignalData::FLIGHT_LOOP, std::chrono::milliseconds(30));
+    const SkyLatencyHistogram* roundTrip = metrics.getSignalRoundTrip(SignalData::FLIGHT_LOOP);
+    SKY_CHECK(nullptr != roundTrip && 2 == roundTrip->getCount());
+
+    // same static names share one histogram
+    metrics.recordStateDwell("FLIGHT", "FLING", std::chrono::milliseconds(1));
+    metrics.recordStateDwell("FLIGHT", "FLING", std::chrono::milliseconds(2));
+    metrics.recordStateDwell("APP", "RUNNING", std::chrono::milliseconds(3));
+    SKY_CHECK(2 == metrics.getStatesCount());
+    const SkyMetrics::StateDwell dwell = metrics.getStateDwell(0);
+    SKY_CHECK(std::string("FLING") == dwell.state && 2 == dwell.histogram->getCount());
+}
+
+void format(void)
+{
+    SkyMetrics metrics;
+    metrics.onFrame(SkyMetrics::RECEIVED, IMessage::DEBUG_DATA, 40);
+    metrics.recordStateDwell("CONNECT", "WAITING", std::chrono::milliseconds(3));
+
+    SkyMetricsExporter exporter;
+    exporter.add("uav \"1\"", &metrics);
+    const std::string text = exporter.format();
+    SKY_CHECK(contains(text, "skydive_frames_total{device=\"uav \\\"1\\\"\",direction=\"received\",type=\"DEBUG_DATA\"} 1\n"));
+    SKY_CHECK(contains(text, "skydive_frame_bytes_total{device=\"uav \\\"1\\\"\",direction=\"received\",type=\"DEBUG_DATA\"} 40\n"));
+    SKY_CHECK(contains(text, "skydive_state_dwell_seconds_count{device=\"uav \\\"1\\\"\",action=\"CONNECT\",state=\"WAITING\"} 1\n"));
+    SKY_CHECK(contains(text, "quantile=\"0.99\"} 0.003\n"));
+
+    const std::string path = "/tmp/SkyMetricsTest." + std::to_string(getpid()) + ".prom";
+    SKY_CHECK(exporter.writeFile(path));
+    std::ifstream file(path);
+    std::stringstream written;
+    written << file.rdbuf();
+    SKY_CHECK(text == written.str());
+    std::remove(path.c_str());
+
+    exporter.remove(&metrics);
+    SKY_CHECK(false == contains(exporter.format(), "uav"));
+}
+
+void socket(void)
+{
+    SkyMetrics metrics;
+    metrics.onChunk(7);
+    SkyMetricsExporter exporter;
+    exporter.add("uav", &metrics);
+
+    const std::string path = "/tmp/SkyMetricsTest." + std::to_string(getpid()) + ".sock";
+    SKY_CHECK(exporter.listen(path));
+    SKY_CHECK(exporter.getFd() >= 0);
+    SKY_CHECK(0 == exporter.serve());
+
+    const int client = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    std::strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+    SKY_CHECK(0 == ::connect(client, (const sockaddr*)&address, sizeof(address)));
+    SKY_CHECK(1 == exporter.serve());
+
+    std::string text;
+    char buffer[4096];
+    ssize_t count;
+    while ((count = ::read(client, buffer, sizeof(buffer))) > 0)
+    {
+        text.append(buffer, (size_t)count);
+    }
+    ::close(client);
+    SKY_CHECK(text == exporter.format());
+    SKY_CHECK(contains(text, "skydive_received_bytes_total{device=\"uav\"} 7\n"));
+
+    exporter.close();
+    SKY_CHECK(-1 == exporter.getFd());
+    SKY_CHECK(0 != ::access(path.c_str(), F_OK));
+}
+
+}
+
+int main(void)
+{
+    counters();
+    format();
+    socket();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,203 @@
+// SkyRateController on emulated half duplex link (one FIFO of air time, 10 ms propagation)
+// stepping bandwidth 20000, 8000, 3000 and 1500 B/s every 15 s, ControlData and DebugData
+// at controlled rates, pings every 200 ms measuring RTT through the same queue.
+// Fixed 50 Hz rates make ControlData latency grow without bound once link is slower than
+// sent data, adaptive rates keep it bounded.
+
+#include "endpoint/device/SkyRateController.hpp"
+
+#include "communication/ControlData.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/SignalData.hpp"
+
+#include "SkyTest.hpp"
+
+#include <algorithm>
+#include <cstdio>
+#include <deque>
+#include <vector>
+
+namespace
+{
+
+const unsigned PHASES_COUNT = 4;
+const double PHASE_BANDWIDTHS[PHASES_COUNT] = {20000.0, 8000.0, 3000.0, 1500.0}; // [B/s]
+const double PHASE_TIME = 15.0; // [s]
+const double PROPAGATION = 0.010; // [s]
+const double STEP = 0.0001; // [s]
+const double PING_PERIOD = 0.2; // [s]
+
+enum Kind
+{
+    CONTROL,
+    TELEMETRY,
+    PING,
+    PONG
+};
+
+struct Transfer
+{
+    Kind kind;
+    double remaining; // [B] air time left
+    double queued; // [s]
+    int id;
+    size_t size;
+};
+
+struct Arrival
+{
+    double time;
+    Kind kind;
+    int id;
+    double queued;
+};
+
+struct PhaseLatency
+{
+    std::vector<double> samples; // [s]
+
+    double percentile(const double part) const
+    {
+        return samples.empty() ? 0.0 : samples[std::min(samples.size() - 1, (size_t)(samples.size() * part))];
+    }
+};
+
+// ControlData latencies per phase
+std::vector<PhaseLatency> emulate(const bool adaptive)
+{
+    const unsigned controlSize = ControlData().getMessageSize();
+    const unsigned telemetrySize = DebugData().getMessageSize();
+    const unsigned signalSize = SignalData().getMessageSize();
+
+    typedef SkyLinkQuality::Clock Clock;
+    SkyLinkQuality linkQuality;
+    SkyRateController rateController(SkyRateController::Settings(5.0, 50.0, 2.0, 50.0), 50.0);
+
+    std::vector<PhaseLatency> latencies(PHASES_COUNT);
+    std::deque<Transfer> air;
+    std::vector<Arrival> flying;
+    double controlRate = 50.0, telemetryRate = 50.0;
+    double nextControl = 0.0, nextTelemetry = 0.0, nextPing = 0.0;
+    int pingId = 0;
+
+    const Clock::time_point start = Clock::now();
+    const long steps = (long)(PHASES_COUNT * PHASE_TIME / STEP);
+    for (long step = 0; step < steps; step++)
+    {
+        const double time = step * STEP;
+        const unsigned phase = std::min(PHASES_COUNT - 1, (unsigned)(time / PHASE_TIME));
+        const Clock::time_point now = start + std::chrono::microseconds((long)(time * 1e6));
+
+        if (time >= nextControl)
+        {
+            air.push_back(Transfer{CONTROL, (double)controlSize, time, 0, controlSize});
+            nextControl += 1.0 / controlRate;
+        }
+        if (time >= nextTelemetry)
+        {
+            air.push_back(Transfer{TELEMETRY, (double)telemetrySize, time, 0, telemetrySize});
+            nextTelemetry += 1.0 / telemetryRate;
+        }
+        if (time >= nextPing)
+        {
+            pingId++;
+            linkQuality.expire(now);
+            linkQuality.onPingSent(pingId, now);
+            air.push_back(Transfer{PING, (double)signalSize, time, pingId, signalSize});
+            nextPing += PING_PERIOD;
+        }
+
+        double budget = PHASE_BANDWIDTHS[phase] * STEP;
+        while (budget > 0.0 && false == air.empty())
+        {
+            Transfer& transfer = air.front();
+            const double sent = std::min(budget, transfer.remaining);
+            transfer.remaining -= sent;
+            budget -= sent;
+            if (transfer.remaining <= 1e-9)
+            {
+                flying.push_back(Arrival{time + PROPAGATION, transfer.kind, transfer.id, transfer.queued});
+                air.pop_front();
+            }
+        }
+
+        for (size_t i = 0; i < flying.size();)
+        {
+            const Arrival arrival = flying[i];
+            if (arrival.time > time)
+            {
+                i++;
+                continue;
+            }
+            if (CONTROL == arrival.kind)
+            {
+                latencies[phase].samples.push_back(time - arrival.queued);
+            }
+            else if (PING == arrival.kind)
+            {
+                // board answers through the same air
+                air.push_back(Transfer{PONG, (double)signalSize, time, arrival.id, signalSize});
+            }
+            else if (PONG == arrival.kind)
+            {
+                linkQuality.onPongReceived(arrival.id, now);
+                size_t queueSize = 0;
+                for (const Transfer& transfer : air)
+                {
+                    queueSize += CONTROL == transfer.kind || PING == transfer.kind ? transfer.size : 0;
+                }
+                if (adaptive)
+                {
+                    rateController.update(linkQuality.getFigures(), 1000, 0, queueSize, now);
+                    controlRate = rateController.getControlRate();
+                    telemetryRate = rateController.getTelemetryRate();
+                }
+            }
+            flying[i] = flying.back();
+            flying.pop_back();
+        }
+    }
+
+    for (PhaseLatency& latency : latencies)
+    {
+        std::sort(latency.samples.begin(), latency.samples.end());
+    }
+    return latencies;
+}
+
+void print(const char* name, const std::vector<PhaseLatency>& latencies)
+{
+    for (unsigned phase = 0; phase < PHASES_COUNT; phase++)
+    {
+        const PhaseLatency& latency = latencies[phase];
+        std::printf("%-8s %5.0f B/s: control %4zu, latency p50 %8.1f ms, p99 %8.1f ms, max %8.1f ms\n",
+                    name, PHASE_BANDWIDTHS[phase], latency.samples.size(),
+                    latency.percentile(0.5) * 1e3, latency.percentile(0.99) * 1e3,
+                    latency.samples.empty() ? 0.0 : latency.samples.back() * 1e3);
+    }
+}
+
+}
+
+int main(void)
+{
+    const std::vector<PhaseLatency> fixed = emulate(false);
+    const std::vector<PhaseLatency> adaptive = emulate(true);
+    print("fixed", fixed);
+    print("adaptive", adaptive);
+
+    // link slower than fixed rates, queue and latency grow for whole phase
+    SKY_CHECK(fixed[PHASES_COUNT - 1].percentile(0.99) > 5.0);
+
+    for (unsigned phase = 0; phase < PHASES_COUNT; phase++)
+    {
+        // transient of bandwidth drop included, steady state is few times below
+        SKY_CHECK(false == adaptive[phase].samples.empty());
+        SKY_CHECK(adaptive[phase].percentile(0.99) < 0.5);
+        SKY_CHECK(adaptive[phase].samples.back() < 1.0);
+    }
+    // fast link is not throttled
+    SKY_CHECK(adaptive[0].samples.size() == fixed[0].samples.size());
+
+    return SKY_TEST_RESULT();
+}
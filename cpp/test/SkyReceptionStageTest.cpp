@@ -0,0 +1,117 @@
+// SkyReceptionStage: protocol messages first in arrival order, DebugData coalesced
+// to newest frame after them, SensorsData of sensors logger never coalesced and kept
+// in order with protocol messages, telemetry and control frames of finished action dropped.
+
+#include "endpoint/device/SkyReceptionStage.hpp"
+
+#include "communication/AutopilotData.hpp"
+#include "communication/DebugData.hpp"
+#include "communication/SensorsData.hpp"
+#include "communication/SignalData.hpp"
+
+#include "SkyTest.hpp"
+
+#include <vector>
+
+namespace
+{
+
+void flightBurst(void)
+{
+    SkyReceptionStage stage;
+    for (unsigned i = 0; i < 100; i++)
+    {
+        DebugData debugData;
+        debugData.euler.x = (float)i;
+        stage.push(debugData);
+    }
+    AutopilotData autopilotData;
+    autopilotData.setType(AutopilotData::TARGET_ACK);
+    stage.push(autopilotData);
+    stage.push(SignalData(SignalData::FLIGHT_LOOP, SignalData::BREAK));
+
+    DeviceEventRecord record;
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::AUTOPILOT_DATA == record.getMessage().getMessageType());
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::SIGNAL_DATA == record.getMessage().getMessageType());
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::DEBUG_DATA == record.getMessage().getMessageType());
+    SKY_CHECK(99.0f == static_cast<const DebugData&>(record.getMessage()).euler.x);
+    SKY_CHECK(false == stage.pop(record));
+
+    SKY_CHECK(102 == stage.getFramedCount());
+    SKY_CHECK(99 == stage.getCoalescedCount());
+}
+
+void loggerBurst(void)
+{
+    SkyReceptionStage stage;
+    for (unsigned i = 0; i < 50; i++)
+    {
+        SensorsData sensorsData;
+        sensorsData.pressure = (float)i;
+        stage.push(sensorsData);
+    }
+    stage.push(SignalData(SignalData::SENSORS_LOGGER, SignalData::BREAK_ACK));
+
+    std::vector<float> samples;
+    DeviceEventRecord record;
+    while (stage.pop(record))
+    {
+        if (IMessage::SENSORS_DATA == record.getMessage().getMessageType())
+        {
+            samples.push_back(static_cast<const SensorsData&>(record.getMessage()).pressure);
+        }
+        else
+        {
+            // break acknowledge arrived after every sample
+            SKY_CHECK(50 == samples.size());
+        }
+    }
+    SKY_CHECK(50 == samples.size());
+    for (size_t i = 0; i < samples.size(); i++)
+    {
+        SKY_CHECK((float)i == samples[i]);
+    }
+    SKY_CHECK(0 == stage.getCoalescedCount());
+}
+
+void dropTelemetry(void)
+{
+    SkyReceptionStage stage;
+    stage.push(DebugData());
+    stage.push(SignalData(SignalData::APP_LOOP, SignalData::BREAK_ACK));
+
+    DeviceEventRecord record;
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::SIGNAL_DATA == record.getMessage().getMessageType());
+    stage.dropTelemetry();
+    SKY_CHECK(false == stage.pop(record));
+    SKY_CHECK(1 == stage.getDroppedCount());
+
+    // logger samples after break acknowledge belong to finished logger
+    stage.push(SensorsData());
+    stage.push(SignalData(SignalData::SENSORS_LOGGER, SignalData::BREAK_ACK));
+    stage.push(SensorsData());
+    stage.push(SignalData(SignalData::PING_VALUE, 7));
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::SENSORS_DATA == record.getMessage().getMessageType());
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(IMessage::SIGNAL_DATA == record.getMessage().getMessageType());
+    stage.dropTelemetry();
+    SKY_CHECK(stage.pop(record));
+    SKY_CHECK(SignalData::PING_VALUE == static_cast<const SignalData&>(record.getMessage()).getCommand());
+    SKY_CHECK(false == stage.pop(record));
+    SKY_CHECK(2 == stage.getDroppedCount());
+}
+
+}
+
+int main(void)
+{
+    flightBurst();
+    loggerBurst();
+    dropTelemetry();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,673 @@
+// Action suite on SkyScenario: success path of every action and every branch waiting
+// for board signal or signal payload left to time out, each error followed by recovery
+// of device to idle action. Whole suite runs on virtual clock.
+
+#include "endpoint/device/SkyScenario.hpp"
+
+#include "communication/CalibrationSettings.hpp"
+#include "communication/ControlSettings.hpp"
+#include "communication/RouteContainer.hpp"
+
+#include "SkyTest.hpp"
+
+#include <chrono>
+#include <cstdio>
+
+namespace
+{
+
+typedef SignalData Signal;
+
+template <typename Message>
+Message valid(const Message& message)
+{
+    Message result(message);
+    result.setCrc();
+    return result;
+}
+
+CalibrationSettings calibration(void)
+{
+    return valid(CalibrationSettings::createDefault());
+}
+
+ControlSettings controls(void)
+{
+    ControlSettings settings = ControlSettings::createDefault();
+    settings.uavType = ControlSettings::QUADROCOPTER_X;
+    settings.initialSolverMode = ControlData::ANGLE;
+    settings.manualThrottleMode = ControlSettings::STATIC;
+    return valid(settings);
+}
+
+RouteContainer route(void)
+{
+    return valid(RouteContainer());
+}
+
+SkyScenario& connectionStarted(SkyScenario& s)
+{
+    return s.connectDevice()
+            .expectSignal(Signal::START_CMD, Signal::START).receive(Signal(Signal::START_CMD, Signal::ACK))
+            .receive(Signal(Signal::PROTOCOL_VERSION_VALUE, (int)IMessage::PROTOCOL_VERSION))
+            .expectSignal(Signal::PROTOCOL_VERSION, Signal::ACK);
+}
+
+SkyScenario& connected(SkyScenario& s)
+{
+    return connectionStarted(s)
+            .receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::READY)).receive(calibration())
+            .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK)
+            .expectSignal(Signal::APP_LOOP, Signal::START).receive(Signal(Signal::APP_LOOP, Signal::ACK))
+            .expectEvent(DeviceEvent::APPLICATION_LOOP_STARTED).expectState(ISkyDeviceAction::APP);
+}
+
+SkyScenario& action(SkyScenario& s, const ISkyDeviceAction::Type type)
+{
+    return connected(s).pilot(new PilotEventAction(type));
+}
+
+// error is handled by disconnection, device waits for next connection
+SkyScenario& failed(SkyScenario& s, const SkyError::Code code)
+{
+    return s.expectError(code).expectState(ISkyDeviceAction::IDLE_ACTION);
+}
+
+SkyScenario& flightInitialization(SkyScenario& s)
+{
+    return action(s, ISkyDeviceAction::FLIGHT_INITIALIZATION)
+            .expectSignal(Signal::FLIGHT_LOOP, Signal::START).receive(Signal(Signal::FLIGHT_LOOP, Signal::ACK));
+}
+
+SkyScenario& flight(SkyScenario& s)
+{
+    return flightInitialization(s).receive(controls())
+            .expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK)
+            .receive(Signal(Signal::FLIGHT_LOOP, Signal::VIA_ROUTE_NOT_ALLOWED))
+            .expectEvent(DeviceEvent::VIA_ROUTE_NOT_ALLOWED).expectState(ISkyDeviceAction::FLIGHT)
+            .expectSignal(Signal::FLIGHT_LOOP, Signal::READY);
+}
+
+SkyScenario& radioChannels(SkyScenario& s)
+{
+    action(s, ISkyDeviceAction::RADIO_CALIB)
+            .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+            .expectEvent(DeviceEvent::CALIBRATE_RADIO_STARTED);
+    for (unsigned channel = 0; channel < 8; channel++)
+    {
+        s.pilot(PilotEvent::RADIO_CALIBRATION_DONE)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::DONE).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_ACK);
+    }
+    return s;
+}
+
+SkyScenario& radioCheck(SkyScenario& s)
+{
+    return action(s, ISkyDeviceAction::RADIO_CHECK)
+            .expectSignal(Signal::CHECK_RADIO, Signal::START).receive(Signal(Signal::CHECK_RADIO, Signal::ACK))
+            .receive(controls()).expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK)
+            .expectEvent(DeviceEvent::CHECK_RADIO_STARTED)
+            .receive(ControlData());
+}
+
+SkyScenario& escStarted(SkyScenario& s)
+{
+    return action(s, ISkyDeviceAction::ESC_CALIB)
+            .expectSignal(Signal::CALIBRATE_ESC, Signal::START).receive(Signal(Signal::CALIBRATE_ESC, Signal::ACK))
+            .expectEvent(DeviceEvent::CALIBRATE_ESC_STARTED);
+}
+
+SkyScenario& escConnected(SkyScenario& s)
+{
+    return escStarted(s)
+            .pilot(PilotEvent::ESC_CALIB_DONE)
+            .expectSignal(Signal::CALIBRATE_ESC, Signal::DONE).receive(Signal(Signal::CALIBRATE_ESC, Signal::ACK))
+            .expectEvent(DeviceEvent::CALIBRATE_ESC_DONE)
+            .pilot(PilotEvent::ESC_CALIB_DONE)
+            .expectSignal(Signal::CALIBRATE_ESC, Signal::DONE).receive(Signal(Signal::CALIBRATE_ESC, Signal::ACK))
+            .expectEvent(DeviceEvent::CALIBRATE_ESC_DONE);
+}
+
+SkyScenario& magnetStarted(SkyScenario& s)
+{
+    return action(s, ISkyDeviceAction::MAGNET_CALIB)
+            .expectSignal(Signal::CALIBRATE_MAGNET, Signal::START).receive(Signal(Signal::CALIBRATE_MAGNET, Signal::ACK))
+            .expectEvent(DeviceEvent::CALIBRATE_MAGNET_STARTED);
+}
+
+SkyScenario& upload(SkyScenario& s)
+{
+    return connected(s).pilot(new PilotEventUpload(*new ControlSettings(controls())))
+            .expectSignal(Signal::UPLOAD_SETTINGS, Signal::START).receive(Signal(Signal::UPLOAD_SETTINGS, Signal::ACK))
+            .expectSent(IMessage::CONTROL_SETTINGS);
+}
+
+struct Case
+{
+    const char* name;
+    void (*script)(SkyScenario&);
+};
+
+const Case CASES[] =
+{
+    // connection
+    {"connect", [](SkyScenario& s)
+    {
+        connected(s);
+    }},
+    {"connect START_CMD timeout", [](SkyScenario& s)
+    {
+        failed(s.connectDevice().expectSignal(Signal::START_CMD, Signal::START), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"connect protocol version timeout", [](SkyScenario& s)
+    {
+        failed(s.connectDevice().expectSignal(Signal::START_CMD, Signal::START)
+               .receive(Signal(Signal::START_CMD, Signal::ACK)), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"connect unsupported protocol", [](SkyScenario& s)
+    {
+        failed(s.connectDevice().expectSignal(Signal::START_CMD, Signal::START)
+               .receive(Signal(Signal::START_CMD, Signal::ACK)).receive(Signal(Signal::PROTOCOL_VERSION_VALUE, 7))
+               .expectSignal(Signal::PROTOCOL_VERSION, Signal::NOT_ALLOWED), SkyError::UNSUPPORTED_PROTOCOL);
+    }},
+    {"connect calibration command timeout", [](SkyScenario& s)
+    {
+        failed(connectionStarted(s), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"connect calibration non static then ready", [](SkyScenario& s)
+    {
+        connectionStarted(s).receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::NON_STATIC))
+                .expectEvent(DeviceEvent::CALIBRATION_NON_STATIC)
+                .receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::READY)).receive(calibration())
+                .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK).expectSignal(Signal::APP_LOOP, Signal::START);
+    }},
+    {"connect calibration non static timeout", [](SkyScenario& s)
+    {
+        failed(connectionStarted(s).receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::NON_STATIC))
+               .expectEvent(DeviceEvent::CALIBRATION_NON_STATIC), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"connect calibration retransmitted", [](SkyScenario& s)
+    {
+        connectionStarted(s).receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::READY))
+                .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT).receive(calibration())
+                .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK).expectSignal(Signal::APP_LOOP, Signal::START);
+    }},
+    {"connect calibration lost", [](SkyScenario& s)
+    {
+        failed(connectionStarted(s).receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::READY))
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+    {"connect APP_LOOP timeout", [](SkyScenario& s)
+    {
+        failed(connectionStarted(s).receive(Signal(Signal::CALIBRATION_SETTINGS, Signal::READY)).receive(calibration())
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK)
+               .expectSignal(Signal::APP_LOOP, Signal::START), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"who am I", [](SkyScenario& s)
+    {
+        s.connectDevice(ISkyDeviceAction::WHO_AM_I).expectSignal(Signal::WHO_AM_I_VALUE, Signal::START)
+                .receive(Signal(Signal::WHO_AM_I_VALUE, (int)CalibrationSettings::TYPE_PRO_V1))
+                .expectEvent(DeviceEvent::WHO_AM_I).expectState(ISkyDeviceAction::IDLE_ACTION);
+    }},
+    {"who am I timeout", [](SkyScenario& s)
+    {
+        failed(s.connectDevice(ISkyDeviceAction::WHO_AM_I).expectSignal(Signal::WHO_AM_I_VALUE, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+
+    // application loop
+    {"app idle 10 min", [](SkyScenario& s)
+    {
+        connected(s).advance(std::chrono::minutes(10)).expectState(ISkyDeviceAction::APP);
+    }},
+    {"app connection lost", [](SkyScenario& s)
+    {
+        s.setPingAnswers(false);
+        connected(s).expectEvent(DeviceEvent::CONNECTION_LOST);
+    }},
+    {"disconnect", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::DISCONNECT).expectSignal(Signal::APP_LOOP, Signal::BREAK)
+                .receive(Signal(Signal::APP_LOOP, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::APPLICATION_LOOP_ENDED).expectState(ISkyDeviceAction::IDLE_ACTION);
+    }},
+    {"disconnect timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::DISCONNECT).expectSignal(Signal::APP_LOOP, Signal::BREAK),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"reset", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::RESET).expectSignal(Signal::SYSTEM_RESET, Signal::START)
+                .receive(Signal(Signal::SYSTEM_RESET, Signal::ACK))
+                .expectEvent(DeviceEvent::APPLICATION_LOOP_TERMINATED).expectState(ISkyDeviceAction::IDLE_ACTION);
+    }},
+    {"reset timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RESET).expectSignal(Signal::SYSTEM_RESET, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"upgrade", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::UPGRADE).expectSignal(Signal::SOFTWARE_UPGRADE, Signal::START)
+                .receive(Signal(Signal::SOFTWARE_UPGRADE, Signal::ACK))
+                .receive(Signal(Signal::WHO_AM_I_VALUE, (int)CalibrationSettings::TYPE_BASIC_V3))
+                .expectEvent(DeviceEvent::UPGRADE_STARTED).expectState(ISkyDeviceAction::IDLE_ACTION);
+    }},
+    {"upgrade not allowed", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::UPGRADE).expectSignal(Signal::SOFTWARE_UPGRADE, Signal::START)
+                .receive(Signal(Signal::SOFTWARE_UPGRADE, Signal::NOT_ALLOWED)).expectState(ISkyDeviceAction::APP);
+    }},
+    {"upgrade command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::UPGRADE).expectSignal(Signal::SOFTWARE_UPGRADE, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"upgrade board version timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::UPGRADE).expectSignal(Signal::SOFTWARE_UPGRADE, Signal::START)
+               .receive(Signal(Signal::SOFTWARE_UPGRADE, Signal::ACK)), SkyError::SIGNAL_TIMEOUT);
+    }},
+
+    // flight
+    {"flight, ended by pilot", [](SkyScenario& s)
+    {
+        flight(s).expectSent(IMessage::CONTROL_DATA).pilot(PilotEvent::BREAK_FLIGHT_LOOP)
+                .receive(Signal(Signal::FLIGHT_LOOP, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::FLIGHT_LOOP_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"flight, ended by board", [](SkyScenario& s)
+    {
+        flight(s).receive(Signal(Signal::FLIGHT_LOOP, Signal::BREAK))
+                .expectEvent(DeviceEvent::FLIGHT_LOOP_TERMINATED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"flight via route", [](SkyScenario& s)
+    {
+        flightInitialization(s).receive(controls()).expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK)
+                .receive(Signal(Signal::FLIGHT_LOOP, Signal::VIA_ROUTE_ALLOWED))
+                .receive(route()).expectSignal(Signal::ROUTE_CONTAINER, Signal::ACK)
+                .expectState(ISkyDeviceAction::FLIGHT);
+    }},
+    {"flight not allowed", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::FLIGHT_INITIALIZATION)
+                .expectSignal(Signal::FLIGHT_LOOP, Signal::START).receive(Signal(Signal::FLIGHT_LOOP, Signal::NOT_ALLOWED))
+                .expectEvent(DeviceEvent::FLIGHT_LOOP_NOT_ALLOWED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"flight FLIGHT_LOOP timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::FLIGHT_INITIALIZATION).expectSignal(Signal::FLIGHT_LOOP, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"flight controls lost", [](SkyScenario& s)
+    {
+        failed(flightInitialization(s)
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+    {"flight route command timeout", [](SkyScenario& s)
+    {
+        failed(flightInitialization(s).receive(controls()).expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"flight route lost", [](SkyScenario& s)
+    {
+        failed(flightInitialization(s).receive(controls()).expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK)
+               .receive(Signal(Signal::FLIGHT_LOOP, Signal::VIA_ROUTE_ALLOWED))
+               .expectSignal(Signal::ROUTE_CONTAINER, Signal::TIMEOUT)
+               .expectSignal(Signal::ROUTE_CONTAINER, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+
+    // signal payloads
+    {"download", [](SkyScenario& s)
+    {
+        connected(s).pilot(new PilotEventDownload(Signal::CONTROL_SETTINGS))
+                .expectSignal(Signal::DOWNLOAD_SETTINGS, Signal::START).receive(Signal(Signal::DOWNLOAD_SETTINGS, Signal::ACK))
+                .receive(controls()).expectSignal(Signal::CONTROL_SETTINGS, Signal::ACK)
+                .expectEvent(DeviceEvent::DATA_RECEIVED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"download refused", [](SkyScenario& s)
+    {
+        connected(s).pilot(new PilotEventDownload(Signal::CONTROL_SETTINGS))
+                .expectSignal(Signal::DOWNLOAD_SETTINGS, Signal::START).receive(Signal(Signal::DOWNLOAD_SETTINGS, Signal::FAIL))
+                .expectEvent(DeviceEvent::CONTROLS_DOWNLOAD_FAIL).expectState(ISkyDeviceAction::APP);
+    }},
+    {"download command timeout", [](SkyScenario& s)
+    {
+        failed(connected(s).pilot(new PilotEventDownload(Signal::CONTROL_SETTINGS))
+               .expectSignal(Signal::DOWNLOAD_SETTINGS, Signal::START), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"download payload lost", [](SkyScenario& s)
+    {
+        failed(connected(s).pilot(new PilotEventDownload(Signal::CONTROL_SETTINGS))
+               .expectSignal(Signal::DOWNLOAD_SETTINGS, Signal::START).receive(Signal(Signal::DOWNLOAD_SETTINGS, Signal::ACK))
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+    {"upload", [](SkyScenario& s)
+    {
+        upload(s).receive(Signal(Signal::CONTROL_SETTINGS, Signal::ACK))
+                .expectEvent(DeviceEvent::DATA_SENT).expectState(ISkyDeviceAction::APP);
+    }},
+    {"upload command timeout", [](SkyScenario& s)
+    {
+        failed(connected(s).pilot(new PilotEventUpload(*new ControlSettings(controls())))
+               .expectSignal(Signal::UPLOAD_SETTINGS, Signal::START), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"upload retransmitted", [](SkyScenario& s)
+    {
+        upload(s).receive(Signal(Signal::CONTROL_SETTINGS, Signal::DATA_INVALID))
+                .expectSent(IMessage::CONTROL_SETTINGS).receive(Signal(Signal::CONTROL_SETTINGS, Signal::ACK))
+                .expectState(ISkyDeviceAction::APP);
+    }},
+    {"upload rejected", [](SkyScenario& s)
+    {
+        failed(upload(s).receive(Signal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT))
+               .expectSent(IMessage::CONTROL_SETTINGS).receive(Signal(Signal::CONTROL_SETTINGS, Signal::DATA_INVALID))
+               .expectSent(IMessage::CONTROL_SETTINGS).receive(Signal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT)),
+               SkyError::SIGNAL_PAYLOAD_UPLOAD);
+    }},
+    {"upload answer timeout", [](SkyScenario& s)
+    {
+        failed(upload(s), SkyError::SIGNAL_TIMEOUT);
+    }},
+
+    // accelerometer calibration
+    {"accel calibration", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::ACCEL_CALIB)
+                .expectSignal(Signal::CALIBRATE_ACCEL, Signal::START).receive(Signal(Signal::CALIBRATE_ACCEL, Signal::ACK))
+                .receive(Signal(Signal::CALIBRATE_ACCEL, Signal::DONE)).receive(calibration())
+                .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK)
+                .expectEvent(DeviceEvent::DATA_RECEIVED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"accel calibration non static", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::ACCEL_CALIB)
+                .expectSignal(Signal::CALIBRATE_ACCEL, Signal::START).receive(Signal(Signal::CALIBRATE_ACCEL, Signal::ACK))
+                .receive(Signal(Signal::CALIBRATE_ACCEL, Signal::NON_STATIC)).expectState(ISkyDeviceAction::APP);
+    }},
+    {"accel command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::ACCEL_CALIB).expectSignal(Signal::CALIBRATE_ACCEL, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"accel result timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::ACCEL_CALIB)
+               .expectSignal(Signal::CALIBRATE_ACCEL, Signal::START).receive(Signal(Signal::CALIBRATE_ACCEL, Signal::ACK)),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"accel calibration lost", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::ACCEL_CALIB)
+               .expectSignal(Signal::CALIBRATE_ACCEL, Signal::START).receive(Signal(Signal::CALIBRATE_ACCEL, Signal::ACK))
+               .receive(Signal(Signal::CALIBRATE_ACCEL, Signal::DONE))
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+
+    // magnetometer calibration
+    {"magnet calibration", [](SkyScenario& s)
+    {
+        magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_DONE)
+                .expectSignal(Signal::CALIBRATE_MAGNET, Signal::DONE).receive(Signal(Signal::CALIBRATE_MAGNET, Signal::DONE))
+                .receive(calibration()).expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK)
+                .expectEvent(DeviceEvent::DATA_RECEIVED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"magnet calibration failed", [](SkyScenario& s)
+    {
+        magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_DONE)
+                .expectSignal(Signal::CALIBRATE_MAGNET, Signal::DONE).receive(Signal(Signal::CALIBRATE_MAGNET, Signal::FAIL))
+                .expectState(ISkyDeviceAction::APP);
+    }},
+    {"magnet calibration skipped", [](SkyScenario& s)
+    {
+        magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_ABORT)
+                .expectSignal(Signal::CALIBRATE_MAGNET, Signal::SKIP).receive(Signal(Signal::CALIBRATE_MAGNET, Signal::ACK))
+                .expectState(ISkyDeviceAction::APP);
+    }},
+    {"magnet command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::MAGNET_CALIB).expectSignal(Signal::CALIBRATE_MAGNET, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"magnet result timeout", [](SkyScenario& s)
+    {
+        failed(magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_MAGNET, Signal::DONE), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"magnet skip timeout", [](SkyScenario& s)
+    {
+        failed(magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_ABORT)
+               .expectSignal(Signal::CALIBRATE_MAGNET, Signal::SKIP), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"magnet calibration lost", [](SkyScenario& s)
+    {
+        failed(magnetStarted(s).pilot(PilotEvent::MAGNET_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_MAGNET, Signal::DONE).receive(Signal(Signal::CALIBRATE_MAGNET, Signal::DONE))
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+
+    // radio calibration
+    {"radio calibration", [](SkyScenario& s)
+    {
+        radioChannels(s).receive(ControlData()).pilot(PilotEvent::RADIO_CALIBRATION_DONE)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+                .receive(calibration()).expectSignal(Signal::CALIBRATION_SETTINGS, Signal::ACK)
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio calibration discarded", [](SkyScenario& s)
+    {
+        radioChannels(s).pilot(PilotEvent::RADIO_CALIBRATION_SKIP)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK_FAIL)
+                .receive(Signal(Signal::CALIBRATE_RADIO, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio calibration broken", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::RADIO_CALIB)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+                .pilot(PilotEvent::RADIO_CALIBRATION_SKIP)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::SKIP).receive(Signal(Signal::CALIBRATE_RADIO, Signal::FAIL))
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_FAIL)
+                .pilot(PilotEvent::RADIO_CALIBRATION_BREAK)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK).receive(Signal(Signal::CALIBRATE_RADIO, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio not allowed", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::RADIO_CALIB)
+                .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::NOT_ALLOWED))
+                .expectEvent(DeviceEvent::CALIBRATE_RADIO_NOT_ALLOWED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CALIB).expectSignal(Signal::CALIBRATE_RADIO, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio channel done timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CALIB)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+               .pilot(PilotEvent::RADIO_CALIBRATION_DONE)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::DONE), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio channel skip timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CALIB)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+               .pilot(PilotEvent::RADIO_CALIBRATION_SKIP)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::SKIP), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio break timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CALIB)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::START).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+               .pilot(PilotEvent::RADIO_CALIBRATION_BREAK)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio check done timeout", [](SkyScenario& s)
+    {
+        failed(radioChannels(s).pilot(PilotEvent::RADIO_CALIBRATION_DONE)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio check skip timeout", [](SkyScenario& s)
+    {
+        failed(radioChannels(s).pilot(PilotEvent::RADIO_CALIBRATION_SKIP)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK_FAIL), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio calibration lost", [](SkyScenario& s)
+    {
+        failed(radioChannels(s).pilot(PilotEvent::RADIO_CALIBRATION_DONE)
+               .expectSignal(Signal::CALIBRATE_RADIO, Signal::BREAK).receive(Signal(Signal::CALIBRATE_RADIO, Signal::ACK))
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CALIBRATION_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+
+    // radio check
+    {"radio check", [](SkyScenario& s)
+    {
+        radioCheck(s).pilot(PilotEvent::RADIO_CHECK_DONE)
+                .expectSignal(Signal::CHECK_RADIO, Signal::BREAK).receive(Signal(Signal::CHECK_RADIO, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::CHECK_RADIO_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio check not allowed", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::RADIO_CHECK)
+                .expectSignal(Signal::CHECK_RADIO, Signal::START).receive(Signal(Signal::CHECK_RADIO, Signal::NOT_ALLOWED))
+                .expectEvent(DeviceEvent::CHECK_RADIO_NOT_ALLOWED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"radio check command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CHECK).expectSignal(Signal::CHECK_RADIO, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"radio check controls lost", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::RADIO_CHECK)
+               .expectSignal(Signal::CHECK_RADIO, Signal::START).receive(Signal(Signal::CHECK_RADIO, Signal::ACK))
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT)
+               .expectSignal(Signal::CONTROL_SETTINGS, Signal::TIMEOUT), SkyError::SIGNAL_PAYLOAD_RECEPTION);
+    }},
+    {"radio check break timeout", [](SkyScenario& s)
+    {
+        failed(radioCheck(s).pilot(PilotEvent::RADIO_CHECK_DONE)
+               .expectSignal(Signal::CHECK_RADIO, Signal::BREAK), SkyError::SIGNAL_TIMEOUT);
+    }},
+
+    // ESC calibration
+    {"esc calibration", [](SkyScenario& s)
+    {
+        escConnected(s).receive(Signal(Signal::CALIBRATE_ESC, Signal::DONE))
+                .expectEvent(DeviceEvent::CALIBRATE_ESC_DONE)
+                .pilot(PilotEvent::ESC_CALIB_DONE)
+                .expectSignal(Signal::CALIBRATE_ESC, Signal::READY).receive(Signal(Signal::CALIBRATE_ESC, Signal::ACK))
+                .expectEvent(DeviceEvent::CALIBRATE_ESC_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"esc calibration aborted", [](SkyScenario& s)
+    {
+        escStarted(s).pilot(PilotEvent::ESC_CALIB_ABORT)
+                .expectSignal(Signal::CALIBRATE_ESC, Signal::BREAK_FAIL)
+                .receive(Signal(Signal::CALIBRATE_ESC, Signal::BREAK_ACK)).expectState(ISkyDeviceAction::APP);
+    }},
+    {"esc not allowed", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::ESC_CALIB)
+                .expectSignal(Signal::CALIBRATE_ESC, Signal::START).receive(Signal(Signal::CALIBRATE_ESC, Signal::NOT_ALLOWED))
+                .expectEvent(DeviceEvent::CALIBRATE_ESC_NOT_ALLOWED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"esc command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::ESC_CALIB).expectSignal(Signal::CALIBRATE_ESC, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"esc disconnect timeout", [](SkyScenario& s)
+    {
+        failed(escStarted(s).pilot(PilotEvent::ESC_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_ESC, Signal::DONE), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"esc abort timeout", [](SkyScenario& s)
+    {
+        failed(escStarted(s).pilot(PilotEvent::ESC_CALIB_ABORT)
+               .expectSignal(Signal::CALIBRATE_ESC, Signal::BREAK_FAIL), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"esc connect timeout", [](SkyScenario& s)
+    {
+        failed(escStarted(s).pilot(PilotEvent::ESC_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_ESC, Signal::DONE).receive(Signal(Signal::CALIBRATE_ESC, Signal::ACK))
+               .pilot(PilotEvent::ESC_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_ESC, Signal::DONE), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"esc calibrating timeout", [](SkyScenario& s)
+    {
+        failed(escConnected(s), SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"esc final timeout", [](SkyScenario& s)
+    {
+        failed(escConnected(s).receive(Signal(Signal::CALIBRATE_ESC, Signal::DONE))
+               .pilot(PilotEvent::ESC_CALIB_DONE)
+               .expectSignal(Signal::CALIBRATE_ESC, Signal::READY), SkyError::SIGNAL_TIMEOUT);
+    }},
+
+    // sensors logger
+    {"sensors logger", [](SkyScenario& s)
+    {
+        action(s, ISkyDeviceAction::SENSORS_LOGGER)
+                .expectSignal(Signal::SENSORS_LOGGER, Signal::START).receive(Signal(Signal::SENSORS_LOGGER, Signal::ACK))
+                .expectEvent(DeviceEvent::SENSORS_LOGGER_STARTED).receive(SensorsData())
+                .pilot(PilotEvent::BREAK_SENSORS_LOGGER)
+                .expectSignal(Signal::SENSORS_LOGGER, Signal::BREAK).receive(Signal(Signal::SENSORS_LOGGER, Signal::BREAK_ACK))
+                .expectEvent(DeviceEvent::SENSORS_LOGGER_ENDED).expectState(ISkyDeviceAction::APP);
+    }},
+    {"sensors logger command timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::SENSORS_LOGGER).expectSignal(Signal::SENSORS_LOGGER, Signal::START),
+               SkyError::SIGNAL_TIMEOUT);
+    }},
+    {"sensors logger break timeout", [](SkyScenario& s)
+    {
+        failed(action(s, ISkyDeviceAction::SENSORS_LOGGER)
+               .expectSignal(Signal::SENSORS_LOGGER, Signal::START).receive(Signal(Signal::SENSORS_LOGGER, Signal::ACK))
+               .pilot(PilotEvent::BREAK_SENSORS_LOGGER)
+               .expectSignal(Signal::SENSORS_LOGGER, Signal::BREAK), SkyError::SIGNAL_TIMEOUT);
+    }}
+};
+
+// scenario harness itself reports unmet expectation
+void unmetExpectation(void)
+{
+    SkyScenario scenario;
+    scenario.setWaitLimit(std::chrono::seconds(5));
+    scenario.connectDevice().expectSignal(Signal::START_CMD, Signal::ACK);
+    SKY_CHECK(false == scenario.run());
+    SKY_CHECK(false == scenario.getFailure().empty());
+}
+
+}
+
+int main(void)
+{
+    SkyTrace::setLevel(SkyTrace::OFF);
+    double virtualTime = 0.0;
+    for (const Case& test : CASES)
+    {
+        SkyScenario scenario;
+        test.script(scenario);
+        const bool passed = scenario.run();
+        if (!passed)
+        {
+            std::printf("%s: %s\n", test.name, scenario.getFailure().c_str());
+        }
+        SKY_CHECK(passed);
+        virtualTime += std::chrono::duration<double>(scenario.getClock().now()).count();
+    }
+    std::printf("%zu scenarios, %.1f s of virtual time\n", sizeof(CASES) / sizeof(CASES[0]), virtualTime);
+
+    unmetExpectation();
+    return SKY_TEST_RESULT();
+}
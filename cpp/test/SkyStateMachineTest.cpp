@@ -0,0 +1,158 @@
+// SkyStateMachine: exact event rows are tried before wildcard ones, rows of the same
+// state and event in declaration order with first passed guard taken, state changes
+// before effect, unmatched event is reported, invalid row is rejected, Graphviz output.
+
+#include "endpoint/device/actions/SkyStateMachine.hpp"
+
+#include "SkyTest.hpp"
+
+#include <string>
+#include <vector>
+
+namespace
+{
+
+class Door
+{
+public:
+    enum State
+    {
+        CLOSED,
+        OPEN,
+        LOCKED
+    };
+
+    typedef SkyStateMachine<Door, State> StateMachine;
+
+    State state;
+    bool unlockAllowed;
+    std::vector<std::string> effects;
+    State stateInEffect;
+
+    Door(void):
+        state(CLOSED),
+        unlockAllowed(false),
+        stateInEffect(CLOSED)
+    {
+    }
+
+    bool canUnlock(const SkyActionEvent&)
+    {
+        return unlockAllowed;
+    }
+
+    void onOpen(const SkyActionEvent&)
+    {
+        effects.push_back("open");
+        stateInEffect = state;
+    }
+
+    void onRefused(const SkyActionEvent&)
+    {
+        effects.push_back("refused");
+    }
+
+    void onAnySignal(const SkyActionEvent& event)
+    {
+        effects.push_back("any " + SignalData::toString(event.getParameter()));
+    }
+
+    static const StateMachine& getStateMachine(void);
+};
+
+const char* const DOOR_STATE_NAMES[] = {"CLOSED", "OPEN", "LOCKED"};
+
+const Door::StateMachine::Transition DOOR_TRANSITIONS[] =
+{
+    {Door::CLOSED, SkyActionEvent::onSignal(SignalData::START), nullptr, &Door::onOpen, Door::OPEN},
+    {Door::CLOSED, SkyActionEvent::onSignal(SignalData::BREAK), nullptr, nullptr, Door::LOCKED},
+    {Door::OPEN, SkyActionEvent::onSignal(SignalData::BREAK), nullptr, nullptr, Door::CLOSED},
+    {Door::OPEN, SkyActionEvent::ANY_SIGNAL, nullptr, &Door::onAnySignal, Door::OPEN},
+    {Door::LOCKED, SkyActionEvent::onSignal(SignalData::START), &Door::canUnlock, &Door::onOpen, Door::OPEN},
+    {Door::LOCKED, SkyActionEvent::onSignal(SignalData::START), nullptr, &Door::onRefused, Door::LOCKED}
+};
+
+const Door::StateMachine& Door::getStateMachine(void)
+{
+    static const StateMachine stateMachine(DOOR_STATE_NAMES, DOOR_TRANSITIONS);
+    return stateMachine;
+}
+
+bool signal(Door& door, const SignalData::Parameter parameter)
+{
+    return Door::getStateMachine().dispatch(door, door.state, SkyActionEvent(parameter));
+}
+
+void dispatch(void)
+{
+    Door door;
+    SKY_CHECK(signal(door, SignalData::START));
+    SKY_CHECK(Door::OPEN == door.state);
+    // state is changed before effect
+    SKY_CHECK(Door::OPEN == door.stateInEffect);
+
+    // exact row wins over wildcard, wildcard takes the rest
+    SKY_CHECK(signal(door, SignalData::ACK));
+    SKY_CHECK(Door::OPEN == door.state);
+    SKY_CHECK(signal(door, SignalData::BREAK));
+    SKY_CHECK(Door::CLOSED == door.state);
+
+    // no row for ACK in CLOSED
+    SKY_CHECK(false == signal(door, SignalData::ACK));
+    SKY_CHECK(Door::CLOSED == door.state);
+
+    // guarded row first, fallback row after it
+    SKY_CHECK(signal(door, SignalData::BREAK));
+    SKY_CHECK(signal(door, SignalData::START));
+    SKY_CHECK(Door::LOCKED == door.state);
+    door.unlockAllowed = true;
+    SKY_CHECK(signal(door, SignalData::START));
+    SKY_CHECK(Door::OPEN == door.state);
+
+    const std::vector<std::string> expected = {"open", "any " + SignalData::toString(SignalData::ACK), "refused", "open"};
+    SKY_CHECK(expected == door.effects);
+}
+
+void names(void)
+{
+    const Door::StateMachine& stateMachine = Door::getStateMachine();
+    SKY_CHECK(std::string("LOCKED") == stateMachine.getStateName(Door::LOCKED));
+    SKY_CHECK(std::string("UNKNOWN") == stateMachine.getStateName((Door::State)7));
+
+    const std::string dot = stateMachine.toDot("Door");
+    SKY_CHECK(0 == dot.find("digraph Door {"));
+    SKY_CHECK(std::string::npos != dot.find("\"CLOSED\" -> \"OPEN\""));
+    // only guarded row is dashed
+    SKY_CHECK(std::string::npos != dot.find("style=dashed"));
+    SKY_CHECK(dot.find("style=dashed") == dot.rfind("style=dashed"));
+}
+
+void invalidRow(void)
+{
+    const Door::StateMachine::Transition transitions[] =
+    {
+        {Door::CLOSED, SkyActionEvent::onSignal(SignalData::START), nullptr, nullptr, Door::OPEN},
+        {Door::OPEN, SkyActionEvent::onSignal(SignalData::BREAK), nullptr, nullptr, (Door::State)3}
+    };
+    bool raised = false;
+    try
+    {
+        Door::StateMachine stateMachine(DOOR_STATE_NAMES, transitions);
+    }
+    catch (const SkyError::Exception& exception)
+    {
+        raised = SkyError::INVALID_TRANSITION == exception.getError().getCode()
+                && 1 == exception.getError().getValue();
+    }
+    SKY_CHECK(raised);
+}
+
+}
+
+int main(void)
+{
+    dispatch();
+    names();
+    invalidRow();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,126 @@
+// SkyTelemetryStore: every stored message type is read back whole (SensorsData is
+// longer than frame in 64-bit builds), seqlock readers never see torn DebugData
+// while writer updates, fleet snapshot returns entries in order of registration.
+
+#include "endpoint/device/SkyTelemetryStore.hpp"
+
+#include "SkyTest.hpp"
+
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+void roundTrip(void)
+{
+    SkyTelemetryStore store;
+    DebugData debugData;
+    SensorsData sensorsData;
+    AutopilotData autopilotData;
+    SKY_CHECK(false == store.read(debugData));
+    SKY_CHECK(false == store.read(sensorsData));
+    SKY_CHECK(false == store.read(autopilotData));
+
+    debugData.setEuler(Vect3Df(0.1f, 0.2f, 0.3f));
+    sensorsData.pressure = 1013.25f;
+    sensorsData.lat = 50.5f;
+    sensorsData.lon = 19.5f;
+    sensorsData.fixQuality = 3;
+    sensorsData.hdop = 42;
+    store.update(debugData);
+    store.update(sensorsData);
+    store.update(autopilotData);
+    SKY_CHECK(3 == store.getUpdatesCount());
+
+    DebugData debugRead;
+    SensorsData sensorsRead;
+    AutopilotData autopilotRead;
+    SKY_CHECK(store.read(debugRead));
+    SKY_CHECK(store.read(sensorsRead));
+    SKY_CHECK(store.read(autopilotRead));
+    SKY_CHECK(0.3f == debugRead.getEuler().z);
+    SKY_CHECK(1013.25f == sensorsRead.pressure);
+    SKY_CHECK(50.5f == sensorsRead.lat);
+    SKY_CHECK(19.5f == sensorsRead.lon);
+    SKY_CHECK(3 == sensorsRead.fixQuality);
+    SKY_CHECK(42 == sensorsRead.hdop);
+
+    SkyTelemetryStore::Snapshot snapshot;
+    store.read(snapshot);
+    SKY_CHECK(0 != snapshot.debugDataTime && 0 != snapshot.sensorsDataTime && 0 != snapshot.autopilotDataTime);
+    SKY_CHECK(42 == snapshot.sensorsData.hdop);
+}
+
+void concurrentReaders(void)
+{
+    SkyTelemetryStore store;
+    std::atomic<bool> done(false);
+    std::atomic<unsigned> torn(0);
+    std::vector<std::thread> readers;
+    for (unsigned r = 0; r < 3; r++)
+    {
+        readers.push_back(std::thread([&]()
+        {
+            DebugData debugData;
+            while (false == done)
+            {
+                if (store.read(debugData))
+                {
+                    const Vect3Df euler = debugData.getEuler();
+                    if (euler.y != euler.x || euler.z != euler.x)
+                    {
+                        torn++;
+                    }
+                }
+            }
+        }));
+    }
+    DebugData debugData;
+    for (unsigned i = 0; i < 300000; i++)
+    {
+        const float value = (float)i;
+        debugData.setEuler(Vect3Df(value, value, value));
+        store.update(debugData);
+    }
+    done = true;
+    for (std::thread& reader : readers)
+    {
+        reader.join();
+    }
+    SKY_CHECK(0 == torn);
+}
+
+void fleet(void)
+{
+    std::vector<std::unique_ptr<SkyTelemetryStore>> stores;
+    SkyFleetTelemetry fleetTelemetry;
+    for (unsigned i = 0; i < 10; i++)
+    {
+        stores.push_back(std::unique_ptr<SkyTelemetryStore>(new SkyTelemetryStore()));
+        SensorsData sensorsData;
+        sensorsData.lat = (float)i;
+        stores.back()->update(sensorsData);
+        fleetTelemetry.add(100 + i, stores.back().get());
+    }
+    fleetTelemetry.remove(103);
+    std::vector<SkyFleetTelemetry::Entry> entries;
+    fleetTelemetry.snapshot(entries);
+    SKY_CHECK(9 == entries.size());
+    SKY_CHECK(9 == fleetTelemetry.size());
+    SKY_CHECK(104 == entries[3].deviceId);
+    SKY_CHECK(4.0f == entries[3].snapshot.sensorsData.lat);
+    SKY_CHECK(0 == entries[3].snapshot.debugDataTime);
+}
+
+}
+
+int main(void)
+{
+    roundTrip();
+    concurrentReaders();
+    fleet();
+    return SKY_TEST_RESULT();
+}
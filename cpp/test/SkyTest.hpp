@@ -0,0 +1,52 @@
+// =========== roboLib ============
+// ===  *** BARTOSZ NAWROT ***  ===
+// ================================
+#ifndef SKYTEST_HPP
+#define SKYTEST_HPP
+
+#include <cstdio>
+
+/**
+ * =============================================================================================
+ * SkyTest
+ * Minimal checks for tree tests, failed check is printed and counted,
+ * test main returns SKY_TEST_RESULT() so ctest sees failure.
+ * =============================================================================================
+ */
+namespace skytest
+{
+
+inline unsigned& failures(void)
+{
+    static unsigned count = 0;
+    return count;
+}
+
+} // skytest
+
+#define SKY_CHECK(condition) \
+    do { \
+        if (!(condition)) \
+        { \
+            std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+            skytest::failures()++; \
+        } \
+    } while (0)
+
+#define SKY_CHECK_NEAR(value, expected, tolerance) \
+    do { \
+        const double skyValue = (double)(value); \
+        const double skyExpected = (double)(expected); \
+        if (!(skyValue - skyExpected <= (tolerance) && skyExpected - skyValue <= (tolerance))) \
+        { \
+            std::printf("%s:%d: check failed: %s = %g, expected %g +- %g\n", \
+                        __FILE__, __LINE__, #value, skyValue, skyExpected, (double)(tolerance)); \
+            skytest::failures()++; \
+        } \
+    } while (0)
+
+#define SKY_TEST_RESULT() \
+    (0 == skytest::failures() ? (std::printf("passed\n"), 0) \
+                              : (std::printf("%u checks failed\n", skytest::failures()), 1))
+
+#endif // SKYTEST_HPP
@@ -0,0 +1,132 @@
+// SkyTimerWheel on virtual time: timers with periods on every wheel level fire exactly
+// at expected ticks without drift, callbacks can stop, restart and destroy timers.
+
+#include "endpoint/SkyTimerWheel.hpp"
+
+#include "SkyTest.hpp"
+
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace
+{
+
+typedef SkyTimerWheel::Clock Clock;
+
+// timers are started from wall clock tick, so wheel construction and starts have to fit
+// in first half of tick, returns false when thread was preempted and run has to be repeated
+bool exactTicks(void)
+{
+    const Clock::duration halfTick = std::chrono::microseconds(500);
+    const Clock::time_point before = Clock::now();
+    SkyTimerWheel wheel(std::chrono::milliseconds(1));
+    std::mt19937 generator(1);
+    const unsigned count = 2000;
+    const uint64_t end = 300000;
+    uint64_t now = 0;
+    unsigned lateFires = 0;
+
+    std::vector<std::unique_ptr<ISkyTimer>> timers(count);
+    std::vector<uint64_t> period(count), next(count);
+    std::vector<uint64_t> fired(count, 0);
+    for (unsigned i = 0; i < count; i++)
+    {
+        // periods in first, second and third level of wheel
+        period[i] = 0 == i % 3 ? 1 + generator() % 300 : (1 == i % 3 ? 1 + generator() % 70000 : 1 + generator() % 20);
+        timers[i].reset(wheel.createTimer([&, i]()
+        {
+            if (now != next[i])
+            {
+                lateFires++;
+            }
+            fired[i]++;
+            next[i] += period[i];
+        }));
+        timers[i]->start(1000.0 / period[i]);
+        next[i] = period[i];
+    }
+    if (Clock::now() - before >= halfTick)
+    {
+        return false;
+    }
+    // wheel started counting within half of tick after before, samples are taken inside of tick
+    const Clock::time_point base = before + halfTick;
+    while (now < end)
+    {
+        now++;
+        wheel.advance(base + std::chrono::milliseconds(now));
+    }
+
+    unsigned wrongCounts = 0;
+    for (unsigned i = 0; i < count; i++)
+    {
+        if (fired[i] != end / period[i])
+        {
+            wrongCounts++;
+        }
+    }
+    SKY_CHECK(0 == lateFires);
+    SKY_CHECK(0 == wrongCounts);
+    SKY_CHECK(count == wheel.getActiveTimersCount());
+    return true;
+}
+
+void callbacks(void)
+{
+    SkyTimerWheel wheel(std::chrono::milliseconds(1));
+    const Clock::time_point base = Clock::now() + std::chrono::microseconds(500);
+    unsigned a = 0, b = 0, c = 0;
+    std::unique_ptr<ISkyTimer> timerA, timerC;
+    ISkyTimer* timerB = nullptr;
+
+    timerA.reset(wheel.createTimer([&]()
+    {
+        a++;
+        if (2 == a)
+        {
+            // other timer expiring in the same tick is destroyed
+            delete timerB;
+            timerB = nullptr;
+        }
+        if (3 == a)
+        {
+            timerA->stop();
+        }
+    }));
+    timerB = wheel.createTimer([&]() { b++; });
+    timerC.reset(wheel.createTimer([&]()
+    {
+        c++;
+        if (1 == c)
+        {
+            timerC->start(100.0);
+        }
+    }));
+    timerA->start(1000.0);
+    timerB->start(1000.0);
+    timerC->start(1000.0);
+    for (unsigned ms = 1; ms <= 100; ms++)
+    {
+        wheel.advance(base + std::chrono::milliseconds(ms));
+    }
+
+    SKY_CHECK(3 == a);
+    SKY_CHECK(2 == b || 1 == b);
+    SKY_CHECK(10 == c);
+    SKY_CHECK(1 == wheel.getActiveTimersCount());
+    timerC.reset();
+    SKY_CHECK(0 == wheel.getActiveTimersCount());
+    SKY_CHECK(wheel.getTimeToNextExpiry() < Clock::duration::zero());
+}
+
+}
+
+int main(void)
+{
+    while (false == exactTicks())
+    {
+    }
+    callbacks();
+    return SKY_TEST_RESULT();
+}
@@ -0,0 +1,104 @@
+// SkyTrace: runtime level filter, records drained in order with arguments,
+// text formatted by reader, full ring drops and counts, ring of exited thread
+// is drained and freed.
+
+#include "endpoint/device/SkyTrace.hpp"
+
+#include "communication/SignalData.hpp"
+#include "endpoint/device/actions/ISkyDeviceAction.hpp"
+
+#include "SkyTest.hpp"
+
+#include <string>
+#include <thread>
+
+namespace
+{
+
+SkyTrace::Record records[4096];
+
+size_t drainAll(void)
+{
+    size_t count = 0;
+    size_t drained;
+    while ((drained = SkyTrace::drain(records, 4096)) > 0)
+    {
+        count += drained;
+    }
+    return count;
+}
+
+void level(void)
+{
+    drainAll();
+    SkyTrace::setLevel(SkyTrace::WARNING);
+    SKY_CHECK(SkyTrace::WARNING == SkyTrace::getLevel());
+    SKY_CHECK(false == SkyTrace::isEnabled(SkyTrace::INFO));
+    SkyTrace::info(SkyTrace::PING_TASK_STARTED);
+    SkyTrace::error(SkyTrace::INTERFACE_ERROR);
+    SKY_CHECK(1 == SkyTrace::drain(records, 16));
+    SKY_CHECK(SkyTrace::INTERFACE_ERROR == records[0].point);
+    SKY_CHECK(SkyTrace::ERROR == records[0].level);
+    SKY_CHECK(0 == records[0].count);
+    SkyTrace::setLevel(SkyTrace::INFO);
+}
+
+void arguments(void)
+{
+    SkyTrace::setLevel(SkyTrace::DEBUG);
+    SkyTrace::debug(SkyTrace::SIGNAL_RECEIVED, ISkyDeviceAction::FLIGHT, "FLING", SignalData::BREAK);
+    SkyTrace::info(SkyTrace::CONTROL_RATE, 12.5);
+    SkyTrace::info(SkyTrace::TEXT, "static text");
+    SKY_CHECK(3 == SkyTrace::drain(records, 16));
+    SKY_CHECK(3 == records[0].count);
+    SKY_CHECK(ISkyDeviceAction::FLIGHT == records[0].arguments[0].integer);
+    SKY_CHECK(records[0].time <= records[1].time && records[1].time <= records[2].time);
+
+    const std::string signal = SkyTrace::format(records[0]);
+    SKY_CHECK(std::string::npos != signal.find("DEBUG"));
+    SKY_CHECK(std::string::npos != signal.find(std::string("with ") + ISkyDeviceAction::toString(ISkyDeviceAction::FLIGHT)
+                                               + " @ FLING param: " + SignalData::toString(SignalData::BREAK)));
+    SKY_CHECK(std::string::npos != SkyTrace::format(records[1]).find("control rate: 12.5 Hz"));
+    SKY_CHECK(std::string::npos != SkyTrace::format(records[2]).find("static text"));
+    SkyTrace::setLevel(SkyTrace::INFO);
+}
+
+void overflow(void)
+{
+    const uint64_t droppedBefore = SkyTrace::getDroppedCount();
+    for (unsigned i = 0; i < 3000; i++)
+    {
+        SkyTrace::info(SkyTrace::PROTOCOL_VERSION, (int)i, 0);
+    }
+    const size_t drained = drainAll();
+    const uint64_t dropped = SkyTrace::getDroppedCount() - droppedBefore;
+    SKY_CHECK(drained > 0 && drained < 3000);
+    SKY_CHECK(3000 == drained + dropped);
+    // oldest records are kept
+    SKY_CHECK(drained - 1 == (size_t)records[drained - 1].arguments[0].integer);
+}
+
+void exitedThread(void)
+{
+    drainAll();
+    std::thread writer([](void)
+    {
+        SkyTrace::info(SkyTrace::PROTOCOL_VERSION, 7, 8);
+    });
+    writer.join();
+    SKY_CHECK(1 == SkyTrace::drain(records, 16));
+    SKY_CHECK(7 == records[0].arguments[0].integer);
+    SKY_CHECK(records[0].thread > 0);
+    SKY_CHECK(0 == drainAll());
+}
+
+}
+
+int main(void)
+{
+    level();
+    arguments();
+    overflow();
+    exitedThread();
+    return SKY_TEST_RESULT();
+}
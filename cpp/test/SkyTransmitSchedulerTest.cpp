@@ -0,0 +1,123 @@
+// SkyTransmitScheduler: higher class is sent first, newer ControlData replaces queued
+// one, token bucket paces frames at bitrate, interface queue limit holds frames back.
+
+#include "endpoint/device/SkyTransmitScheduler.hpp"
+
+#include "SkyTest.hpp"
+
+#include <vector>
+
+namespace
+{
+
+class RecordingInterface : public ISkyCommInterface
+{
+public:
+    std::vector<unsigned char> sent; // first byte of every frame
+    size_t queueSize;
+
+    RecordingInterface(void):
+        queueSize(0)
+    {
+    }
+
+    void connect(void) override
+    {
+    }
+
+    void disconnect(void) override
+    {
+    }
+
+    void send(const unsigned char* data, const size_t) override
+    {
+        sent.push_back(data[0]);
+    }
+
+    size_t getSendQueueSize(void) const override
+    {
+        return queueSize;
+    }
+};
+
+typedef SkyTransmitScheduler::Clock Clock;
+
+void send(SkyTransmitScheduler& scheduler,
+          const SkyTransmitScheduler::Priority priority,
+          const IMessage::MessageType type,
+          const unsigned char mark,
+          const Clock::time_point time)
+{
+    unsigned char frame[20] = {mark};
+    scheduler.send(priority, type, frame, sizeof(frame), time);
+}
+
+void priorities(void)
+{
+    RecordingInterface interface;
+    interface.queueSize = 1000;
+    SkyTransmitScheduler scheduler;
+    scheduler.setInterface(&interface);
+    const Clock::time_point time = Clock::now();
+
+    send(scheduler, SkyTransmitScheduler::BULK, IMessage::CONTROL_SETTINGS, 1, time);
+    send(scheduler, SkyTransmitScheduler::BULK, IMessage::CONTROL_SETTINGS, 2, time);
+    send(scheduler, SkyTransmitScheduler::SIGNAL, IMessage::SIGNAL_DATA, 3, time);
+    send(scheduler, SkyTransmitScheduler::CONTROL, IMessage::CONTROL_DATA, 4, time);
+    send(scheduler, SkyTransmitScheduler::AUTOPILOT, IMessage::AUTOPILOT_DATA, 5, time);
+    send(scheduler, SkyTransmitScheduler::CONTROL, IMessage::CONTROL_DATA, 6, time);
+    SKY_CHECK(interface.sent.empty());
+    SKY_CHECK(1 == scheduler.getQueuedCount(SkyTransmitScheduler::CONTROL));
+    SKY_CHECK(1 == scheduler.getReplacedCount());
+
+    interface.queueSize = 0;
+    Clock::duration wait;
+    SKY_CHECK(false == scheduler.pump(wait, time));
+    const std::vector<unsigned char> expected = {6, 5, 3, 1, 2};
+    SKY_CHECK(expected == interface.sent);
+    SKY_CHECK(1 == scheduler.getSentCount(SkyTransmitScheduler::CONTROL));
+    SKY_CHECK(2 == scheduler.getSentCount(SkyTransmitScheduler::BULK));
+}
+
+void pacing(void)
+{
+    RecordingInterface interface;
+    // 20 B frames at 1000 B/s, burst of one frame
+    SkyTransmitScheduler scheduler(SkyTransmitScheduler::Settings(1000, 20));
+    scheduler.setInterface(&interface);
+    const Clock::time_point time = Clock::now();
+
+    for (unsigned char i = 0; i < 10; i++)
+    {
+        send(scheduler, SkyTransmitScheduler::BULK, IMessage::CONTROL_SETTINGS, i, time);
+    }
+    const size_t burst = interface.sent.size();
+    SKY_CHECK(burst >= 1 && burst <= 2);
+
+    Clock::duration wait;
+    SKY_CHECK(scheduler.pump(wait, time));
+    SKY_CHECK(wait > Clock::duration::zero());
+    SKY_CHECK(wait <= std::chrono::milliseconds(20));
+
+    // device pumps again after returned wait, every remaining frame takes 20 ms
+    Clock::time_point now = time;
+    while (scheduler.pump(wait, now))
+    {
+        now += wait;
+    }
+    SKY_CHECK(10 == interface.sent.size());
+    const double elapsed = std::chrono::duration<double>(now - time).count();
+    SKY_CHECK_NEAR(elapsed, (10 - burst) * 0.02, 0.025);
+
+    scheduler.clear();
+    SKY_CHECK(0 == scheduler.getQueuedCount(SkyTransmitScheduler::BULK));
+}
+
+}
+
+int main(void)
+{
+    priorities();
+    pacing();
+    return SKY_TEST_RESULT();
+}